@@ -0,0 +1,151 @@
+#ifndef BENCHHARNESS_H
+#define BENCHHARNESS_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <ctime>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+
+/**
+ * Minimal in-tree benchmark harness
+ * ---------------------------
+ * A benchmark is a function taking a bench::Context. It calls ctx.run() once per case; run()
+ * repeats the body until minSeconds of wall time have passed and records items per second.
+ * All benchmarks are single threaded, so items/s is the per-core throughput.
+ *
+ *   static void BM_Example(bench::Context& ctx) {
+ *       ctx.run("example", batch, batch, [&] { ... process batch items ... });
+ *   }
+ *   CAR_BENCHMARK(BM_Example);
+ *
+ * Results are printed as a table and can be written as JSON with writeJson() (car_core_bench --json).
+ */
+namespace bench {
+
+    struct Result {
+        std::string name;
+        std::size_t batch{1};
+        std::size_t iterations{0};
+        double seconds{0.0};
+        double itemsPerIter{1.0};
+
+        double nsPerItem() const { return seconds * 1e9 / (static_cast<double>(iterations) * itemsPerIter); }
+        double itemsPerSec() const { return static_cast<double>(iterations) * itemsPerIter / seconds; }
+    };
+
+    class Context {
+    public:
+        explicit Context(double minSeconds) : minSeconds(minSeconds) {}
+
+        // time fn, which processes itemsPerIter items per call
+        template <class F>
+        void run(const std::string& name, std::size_t batch, std::size_t itemsPerIter, F&& fn) {
+            using clock = std::chrono::steady_clock;
+
+            // warm-up
+            fn();
+
+            Result r;
+            r.name = name;
+            r.batch = batch;
+            r.itemsPerIter = static_cast<double>(itemsPerIter);
+
+            std::size_t iters = 1;
+            const auto start = clock::now();
+            for (;;) {
+                for (std::size_t k = 0; k < iters; ++k) fn();
+                r.iterations += iters;
+                r.seconds = std::chrono::duration<double>(clock::now() - start).count();
+                if (r.seconds >= minSeconds) break;
+                iters *= 2;
+            }
+            results.push_back(r);
+            std::printf("%-48s %10zu %14.2f %16.0f\n", r.name.c_str(), r.batch, r.nsPerItem(), r.itemsPerSec());
+            std::fflush(stdout);
+        }
+
+        const std::vector<Result>& getResults() const { return results; }
+
+    private:
+        double minSeconds{0.25};
+        std::vector<Result> results;
+    };
+
+    using BenchmarkFn = std::function<void(Context&)>;
+
+    struct Registered {
+        std::string name;
+        BenchmarkFn fn;
+    };
+
+    inline std::vector<Registered>& registry() {
+        static std::vector<Registered> benchmarks;
+        return benchmarks;
+    }
+
+    inline bool registerBenchmark(const char* name, BenchmarkFn fn) {
+        registry().push_back({name, std::move(fn)});
+        return true;
+    }
+
+    // keep a value alive so the compiler cannot remove the benchmarked work; an empty asm statement
+    // that reads the value costs no store
+    template <class T>
+    inline void doNotOptimize(const T& value) {
+#if defined(_MSC_VER) && !defined(__clang__)
+        const volatile T* sink = &value;
+        (void)sink;
+        _ReadWriteBarrier();
+#else
+        asm volatile("" : : "g"(value) : "memory");
+#endif
+    }
+
+    /** Write results as JSON
+     * ------------------------------------------------------------------------
+     * {"context": {...}, "benchmarks": [{"name", "batch", "iterations", "seconds", "ns_per_item", "items_per_second"}]}
+     * @param[in] path: output file
+     * @param[in] results: benchmark results
+     * @return bool: false if the file cannot be written
+     */
+    inline bool writeJson(const std::string& path, const std::vector<Result>& results) {
+        std::FILE* f = std::fopen(path.c_str(), "w");
+        if (!f) return false;
+
+        char date[32] = "";
+        const std::time_t now = std::time(nullptr);
+        std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+
+        std::fprintf(f, "{\n  \"context\": {\"date\": \"%s\", \"num_cpus\": %u, \"build_type\": \"%s\"},\n",
+                     date, std::thread::hardware_concurrency(),
+#ifdef NDEBUG
+                     "release"
+#else
+                     "debug"
+#endif
+        );
+        std::fprintf(f, "  \"benchmarks\": [\n");
+        for (std::size_t i = 0; i < results.size(); ++i) {
+            const Result& r = results[i];
+            std::fprintf(f, "    {\"name\": \"%s\", \"batch\": %zu, \"iterations\": %zu, \"seconds\": %.6f, "
+                            "\"ns_per_item\": %.4f, \"items_per_second\": %.1f}%s\n",
+                         r.name.c_str(), r.batch, r.iterations, r.seconds, r.nsPerItem(), r.itemsPerSec(),
+                         i + 1 < results.size() ? "," : "");
+        }
+        std::fprintf(f, "  ]\n}\n");
+        return std::fclose(f) == 0;
+    }
+}
+
+#define CAR_BENCHMARK(fn) static const bool fn##_registered = bench::registerBenchmark(#fn, fn)
+
+#endif
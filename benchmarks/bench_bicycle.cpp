@@ -0,0 +1,139 @@
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "BenchHarness.h"
+#include "vehicledynamics/BicycleModel.h"
+#include "vehicledynamics/VehicleTypes.h"
+
+
+namespace {
+
+    const char* simdPathName(SimdPath path) {
+        switch (path) {
+        case SimdPath::AVX2: return "avx2";
+        case SimdPath::SSE41: return "sse41";
+        default: return "scalar";
+        }
+    }
+
+    struct Fleet {
+        std::vector<float> x, y, psi, v, delta, vy, yawRate;
+        std::vector<VehicleState> states;
+        std::vector<Action> actions;
+
+        explicit Fleet(std::size_t n) : x(n), y(n), psi(n), v(n), delta(n), vy(n, 0.0f), yawRate(n, 0.0f), states(n), actions(n) {
+            std::mt19937 rng(42);
+            std::uniform_real_distribution<float> u(-1.0f, 1.0f);
+            for (std::size_t i = 0; i < n; ++i) {
+                x[i] = 10.0f * u(rng);
+                y[i] = 10.0f * u(rng);
+                psi[i] = 3.0f * u(rng);
+                v[i] = 2.0f * u(rng);
+                states[i] = VehicleState{{x[i], y[i]}, psi[i], v[i], 0.0f};
+                actions[i] = Action{u(rng), 0.5f * u(rng)};
+            }
+        }
+
+        VehicleStateSoA view() {
+            return VehicleStateSoA{x.data(), y.data(), psi.data(), v.data(), delta.data(), x.size(), vy.data(), yawRate.data()};
+        }
+    };
+
+    constexpr std::size_t kBatchSizes[] = {64, 1024, 16384};
+}
+
+
+// scalar kinematicAct, one vehicle per call
+static void BM_KinematicAct(bench::Context& ctx) {
+    for (std::size_t n : kBatchSizes) {
+        Fleet fleet(n);
+        BicycleModel model(CAR_LENGTH);
+        ctx.run("kinematicAct", n, n, [&] {
+            for (std::size_t i = 0; i < n; ++i) {
+                Action a = fleet.actions[i];
+                model.kinematicAct(a, fleet.states[i], 0.01f);
+            }
+            bench::doNotOptimize(fleet.states[0].pos.x);
+        });
+    }
+}
+CAR_BENCHMARK(BM_KinematicAct);
+
+// kinematicActBatch on every SIMD path this CPU supports
+static void BM_KinematicActBatch(bench::Context& ctx) {
+    for (SimdPath path : {SimdPath::Scalar, SimdPath::SSE41, SimdPath::AVX2}) {
+        if (!BicycleModel::isSimdPathSupported(path)) continue;
+        for (std::size_t n : kBatchSizes) {
+            Fleet fleet(n);
+            BicycleModel model(CAR_LENGTH);
+            ctx.run(std::string("kinematicActBatch/") + simdPathName(path), n, n, [&] {
+                model.kinematicActBatch(fleet.actions.data(), fleet.view(), 0.01f, path);
+                bench::doNotOptimize(fleet.x[0]);
+            });
+        }
+    }
+}
+CAR_BENCHMARK(BM_KinematicActBatch);
+
+// kinematicActBatch with exact arc integration (scalar loop), one step replaces 5-10 Euler steps
+static void BM_KinematicArcBatch(bench::Context& ctx) {
+    for (std::size_t n : kBatchSizes) {
+        Fleet fleet(n);
+        BicycleModel model(CAR_LENGTH);
+        model.setIntegrator(KinematicIntegrator::Arc);
+        ctx.run("kinematicActBatch/arc", n, n, [&] {
+            model.kinematicActBatch(fleet.actions.data(), fleet.view(), 0.1f);
+            bench::doNotOptimize(fleet.x[0]);
+        });
+    }
+}
+CAR_BENCHMARK(BM_KinematicArcBatch);
+
+// scalar dynamicAct, one vehicle per call (compare with BM_KinematicAct)
+static void BM_DynamicAct(bench::Context& ctx) {
+    for (std::size_t n : kBatchSizes) {
+        Fleet fleet(n);
+        BicycleModel model(CAR_LENGTH);
+        ctx.run("dynamicAct", n, n, [&] {
+            for (std::size_t i = 0; i < n; ++i) {
+                model.dynamicAct(fleet.actions[i], fleet.states[i], 0.01f);
+            }
+            bench::doNotOptimize(fleet.states[0].pos.x);
+        });
+    }
+}
+CAR_BENCHMARK(BM_DynamicAct);
+
+// dynamicActBatch over SoA state on the scalar and the AVX2 path (compare with BM_KinematicActBatch),
+// then the ratio of the dispatched dynamic and kinematic paths, the cost VecParkingEnv pays for the model
+static void BM_DynamicActBatch(bench::Context& ctx) {
+    for (SimdPath path : {SimdPath::Scalar, SimdPath::AVX2}) {
+        if (!BicycleModel::isSimdPathSupported(path)) continue;
+        for (std::size_t n : kBatchSizes) {
+            Fleet fleet(n);
+            BicycleModel model(CAR_LENGTH);
+            ctx.run(std::string("dynamicActBatch/") + simdPathName(path), n, n, [&] {
+                model.dynamicActBatch(fleet.actions.data(), fleet.view(), 0.01f, path);
+                bench::doNotOptimize(fleet.x[0]);
+            });
+        }
+    }
+
+    const std::size_t n = 1024;
+    Fleet fleet(n);
+    BicycleModel model(CAR_LENGTH);
+    const std::string active = simdPathName(BicycleModel::activeSimdPath());
+    ctx.run("kinematicActBatch/dispatched:" + active, n, n, [&] {
+        model.kinematicActBatch(fleet.actions.data(), fleet.view(), 0.01f);
+        bench::doNotOptimize(fleet.x[0]);
+    });
+    const double kinematicNs = ctx.getResults().back().nsPerItem();
+    ctx.run("dynamicActBatch/dispatched:" + active, n, n, [&] {
+        model.dynamicActBatch(fleet.actions.data(), fleet.view(), 0.01f);
+        bench::doNotOptimize(fleet.x[0]);
+    });
+    std::printf("  dynamic / kinematic (dispatched, %zu vehicles): %.1fx\n", n, ctx.getResults().back().nsPerItem() / kinematicNs);
+}
+CAR_BENCHMARK(BM_DynamicActBatch);
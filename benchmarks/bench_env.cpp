@@ -0,0 +1,282 @@
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "BenchHarness.h"
+#include "envs/ParkingEnv.h"
+#include "envs/VecParkingEnv.h"
+#include "rollout/AsyncEnvPool.h"
+#include "rollout/RolloutRunner.h"
+#include "utilities/Logger.h"
+#include "utilities/Randomizer.h"
+
+
+namespace {
+
+    // random car/slot poses for the pure parking math functions
+    struct PoseSet {
+        std::vector<Position2D> carPos, slotPos;
+        std::vector<float> carYaw, slotYaw;
+
+        explicit PoseSet(std::size_t n) : carPos(n), slotPos(n), carYaw(n), slotYaw(n) {
+            Randomizer randomizer(7);
+            for (std::size_t i = 0; i < n; ++i) {
+                slotPos[i] = {randomizer.randFloat(-15.0f, 15.0f), randomizer.randFloat(-10.0f, 10.0f)};
+                slotYaw[i] = randomizer.randInt(0, 1) * PI * 0.5f;
+                // half of the cars close to their slot so both branches of the checks are taken
+                const float spread = (i % 2 == 0) ? 0.5f : 5.0f;
+                carPos[i] = {slotPos[i].x + randomizer.randFloat(-spread, spread), slotPos[i].y + randomizer.randFloat(-spread, spread)};
+                carYaw[i] = slotYaw[i] + randomizer.randFloat(-0.3f, 0.3f);
+            }
+        }
+    };
+
+    constexpr std::size_t kEnvCounts[] = {1, 64, 1024};
+    constexpr std::size_t kBatchSizes[] = {64, 1024, 16384};
+}
+
+
+// ParkingEnv::step on n independent envs, with debug logging off and on.
+// "on" writes every message to the null device through the async sink; messages that do not fit
+// into the ring are dropped instead of stalling the stepping thread.
+static void BM_ParkingEnvStep(bench::Context& ctx) {
+#ifdef _WIN32
+    std::FILE* nullDevice = std::fopen("NUL", "w");
+#else
+    std::FILE* nullDevice = std::fopen("/dev/null", "w");
+#endif
+    Logger& logger = Logger::instance();
+    const LogLevel previousLevel = logger.getLevel();
+
+    for (LogLevel level : {LogLevel::Off, LogLevel::Debug}) {
+        if (level == LogLevel::Debug && (!nullDevice || CAR_LOG_LEVEL > 1)) continue;  // debug logs compiled out
+        logger.setLevel(level);
+        if (nullDevice) logger.setOutput(nullDevice);
+
+        for (std::size_t n : kEnvCounts) {
+            Randomizer randomizer(1);
+            std::vector<ParkingEnv> envs(n, ParkingEnv(&randomizer));
+            for (std::size_t i = 0; i < n; ++i) {
+                envs[i].setEnvIndex(i);
+                envs[i].reset();
+            }
+            const uint64_t droppedBefore = logger.getDroppedCount();
+            ctx.run(std::string("ParkingEnv::step/log:") + (level == LogLevel::Off ? "off" : "debug"), n, n, [&] {
+                for (auto& env : envs) {
+                    Action a{0.5f, 0.1f};
+                    env.step(a, 0.01f);
+                }
+                bench::doNotOptimize(envs[0].getVehicleState().pos.x);
+            });
+            if (level != LogLevel::Off) {
+                std::printf("  (%llu log messages dropped)\n", static_cast<unsigned long long>(logger.getDroppedCount() - droppedBefore));
+            }
+        }
+    }
+
+    logger.setLevel(previousLevel);
+    logger.setOutput(stdout);
+    if (nullDevice) std::fclose(nullDevice);
+}
+CAR_BENCHMARK(BM_ParkingEnvStep);
+
+// ParkingEnv::stepInto writing flat observations into one contiguous batch buffer
+static void BM_ParkingEnvStepInto(bench::Context& ctx) {
+    for (std::size_t n : kEnvCounts) {
+        Randomizer randomizer(1);
+        std::vector<ParkingEnv> envs(n, ParkingEnv(&randomizer));
+        for (std::size_t i = 0; i < n; ++i) {
+            envs[i].setEnvIndex(i);
+            envs[i].reset();
+        }
+        std::vector<float> obs(n * OBS_FLAT_SIZE);
+        std::vector<StepResult> results(n);
+        const Action action{0.5f, 0.1f};
+        ctx.run("ParkingEnv::stepInto/flat", n, n, [&] {
+            for (std::size_t i = 0; i < n; ++i) {
+                envs[i].stepInto(action, 0.01f, obs.data() + i * OBS_FLAT_SIZE, results[i]);
+            }
+            bench::doNotOptimize(obs[0]);
+        });
+    }
+}
+CAR_BENCHMARK(BM_ParkingEnvStepInto);
+
+// one 10 Hz decision over 100 Hz physics: 10 stepInto calls vs one call with an action repeat of 10
+static void BM_ParkingEnvActionRepeat(bench::Context& ctx) {
+    constexpr int kRepeat = 10;
+    for (int repeat : {1, kRepeat}) {
+        for (std::size_t n : kEnvCounts) {
+            Randomizer randomizer(1);
+            std::vector<ParkingEnv> envs(n, ParkingEnv(&randomizer));
+            for (std::size_t i = 0; i < n; ++i) {
+                envs[i].setEnvIndex(i);
+                envs[i].setActionRepeat(repeat);
+                envs[i].reset();
+            }
+            std::vector<float> obs(n * OBS_FLAT_SIZE);
+            std::vector<StepResult> results(n);
+            const Action action{0.5f, 0.1f};
+            const int calls = kRepeat / repeat;
+            ctx.run(repeat == 1 ? "ParkingEnv::stepInto/10 calls" : "ParkingEnv::stepInto/repeat 10", n, n, [&] {
+                for (std::size_t i = 0; i < n; ++i) {
+                    for (int c = 0; c < calls; ++c) envs[i].stepInto(action, 0.01f, obs.data() + i * OBS_FLAT_SIZE, results[i]);
+                }
+                bench::doNotOptimize(obs[0]);
+            });
+        }
+    }
+}
+CAR_BENCHMARK(BM_ParkingEnvActionRepeat);
+
+// ParkingEnv::reset on n independent envs
+static void BM_ParkingEnvReset(bench::Context& ctx) {
+    for (std::size_t n : kEnvCounts) {
+        Randomizer randomizer(1);
+        std::vector<ParkingEnv> envs(n, ParkingEnv(&randomizer));
+        for (std::size_t i = 0; i < n; ++i) envs[i].setEnvIndex(i);
+        ctx.run("ParkingEnv::reset", n, n, [&] {
+            for (auto& env : envs) env.reset();
+            bench::doNotOptimize(envs[0].getParkingPos().x);
+        });
+    }
+}
+CAR_BENCHMARK(BM_ParkingEnvReset);
+
+// VecParkingEnv::step, the batched counterpart of ParkingEnv::step
+static void BM_VecParkingEnvStep(bench::Context& ctx) {
+    for (std::size_t n : kBatchSizes) {
+        Randomizer randomizer(1);
+        VecParkingEnv vecEnv(n, &randomizer);
+        vecEnv.reset();
+        std::vector<Action> actions(n, Action{0.5f, 0.1f});
+        std::vector<Observation> obs(n);
+        std::vector<float> rewards(n);
+        std::vector<uint8_t> dones(n);
+        ctx.run("VecParkingEnv::step", n, n, [&] {
+            vecEnv.step(actions.data(), obs.data(), rewards.data(), dones.data());
+            bench::doNotOptimize(obs[0].vehicleState.pos.x);
+        });
+    }
+}
+CAR_BENCHMARK(BM_VecParkingEnvStep);
+
+// calculateRelCorners on a batch of poses
+static void BM_CalculateRelCorners(bench::Context& ctx) {
+    Randomizer randomizer(1);
+    ParkingEnv env(&randomizer);
+    for (std::size_t n : kBatchSizes) {
+        PoseSet poses(n);
+        ctx.run("ParkingEnv::calculateRelCorners", n, n, [&] {
+            float acc = 0.0f;
+            for (std::size_t i = 0; i < n; ++i) {
+                acc += env.getCalculateRelCorners(poses.carPos[i], poses.carYaw[i], poses.slotPos[i], poses.slotYaw[i])[0].x;
+            }
+            bench::doNotOptimize(acc);
+        });
+    }
+}
+CAR_BENCHMARK(BM_CalculateRelCorners);
+
+// isParked on a batch of poses
+static void BM_IsParked(bench::Context& ctx) {
+    Randomizer randomizer(1);
+    ParkingEnv env(&randomizer);
+    for (std::size_t n : kBatchSizes) {
+        PoseSet poses(n);
+        ctx.run("ParkingEnv::isParked", n, n, [&] {
+            bool any = false;
+            for (std::size_t i = 0; i < n; ++i) {
+                any ^= env.getIsParked(poses.carPos[i], poses.carYaw[i], poses.slotPos[i], poses.slotYaw[i]);
+            }
+            bench::doNotOptimize(any);
+        });
+    }
+}
+CAR_BENCHMARK(BM_IsParked);
+
+// isParkedAtCenter on a batch of poses
+static void BM_IsParkedAtCenter(bench::Context& ctx) {
+    Randomizer randomizer(1);
+    ParkingEnv env(&randomizer);
+    for (std::size_t n : kBatchSizes) {
+        PoseSet poses(n);
+        ctx.run("ParkingEnv::isParkedAtCenter", n, n, [&] {
+            bool any = false;
+            for (std::size_t i = 0; i < n; ++i) {
+                any ^= env.getIsParkedAtCenter(poses.carPos[i], poses.carYaw[i], poses.slotPos[i], poses.slotYaw[i]);
+            }
+            bench::doNotOptimize(any);
+        });
+    }
+}
+CAR_BENCHMARK(BM_IsParkedAtCenter);
+
+// RolloutRunner steps/s over thread counts, the number to size machines with. 1, 2 and 4 threads always run
+// (oversubscribed on smaller machines, which measures the pool overhead), then powers of two up to the core count
+static void BM_Rollout(bench::Context& ctx) {
+    const std::size_t maxThreads = std::max<std::size_t>(4, std::thread::hardware_concurrency());
+    for (std::size_t threads = 1; threads <= maxThreads; threads *= 2) {
+        RolloutConfig config;
+        config.numEnvs = 1024;
+        config.shardSize = 64;
+        config.stepsPerRun = 16;
+        config.numThreads = threads;
+        config.seed = 1;
+
+        RolloutRunner runner(config);
+        runner.reset();
+        const RolloutPolicy policy = [](std::size_t, const Observation*, Action* actions, std::size_t count) {
+            for (std::size_t i = 0; i < count; ++i) actions[i] = Action{0.5f, 0.1f};
+        };
+        ctx.run("RolloutRunner::run/threads:" + std::to_string(threads), config.numEnvs,
+                config.numEnvs * config.stepsPerRun, [&] { runner.run(policy); });
+    }
+}
+CAR_BENCHMARK(BM_Rollout);
+
+// AsyncEnvPool on a lot (uneven step cost): lock-step batches vs recv of the first quarter and resend
+static void BM_AsyncEnvPool(bench::Context& ctx) {
+    LotLayout layout;
+    layout.aisles = 4;
+    layout.slotsPerRow = 10;
+    const ParkingLot lot = ParkingLot::generate(layout, 1);
+
+    constexpr std::size_t numEnvs = 1024;
+    AsyncEnvPoolConfig config;
+    config.numEnvs = numEnvs;
+    config.maxEpisodeSteps = 200;
+    config.seed = 1;
+    config.lot = &lot;
+    AsyncEnvPool pool(config);
+
+    std::vector<AsyncEnvResult> results(numEnvs);
+    std::vector<uint32_t> ids(numEnvs);
+    std::vector<Action> actions(numEnvs, Action{0.5f, 0.1f});
+    pool.asyncReset();
+    pool.recvResults(numEnvs, results.data());
+    const std::string threads = "/threads:" + std::to_string(pool.getNumThreads());
+
+    for (uint32_t i = 0; i < numEnvs; ++i) ids[i] = i;
+    ctx.run("AsyncEnvPool/sync" + threads, numEnvs, numEnvs, [&] {
+        pool.sendActions(ids.data(), actions.data(), numEnvs);
+        pool.recvResults(numEnvs, results.data());
+    });
+
+    // every env in flight, the first quarter to finish is sent again right away
+    const std::size_t batch = numEnvs / 4;
+    pool.sendActions(ids.data(), actions.data(), numEnvs);
+    ctx.run("AsyncEnvPool/batch:" + std::to_string(batch) + threads, numEnvs, numEnvs, [&] {
+        for (std::size_t k = 0; k < numEnvs / batch; ++k) {
+            const std::size_t got = pool.recvResults(batch, results.data());
+            for (std::size_t j = 0; j < got; ++j) ids[j] = results[j].envId;
+            pool.sendActions(ids.data(), actions.data(), got);
+        }
+    });
+    pool.recvResults(numEnvs, results.data());
+}
+CAR_BENCHMARK(BM_AsyncEnvPool);
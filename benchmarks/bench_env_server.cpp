@@ -0,0 +1,134 @@
+// car_env_server_bench: step round-trip latency of the shared-memory env server (Linux).
+// Forks a server per configuration, drives it with the C client and prints p50 / p99 / mean round trips.
+//
+//   car_env_server_bench [--iterations N] [--envs N]...
+
+#include <algorithm>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "ipc/EnvServer.h"
+#include "ipc/car_env_client.h"
+#include "utilities/Logger.h"
+
+
+namespace {
+    struct Case {
+        const char* label;
+        uint32_t command;
+        int spin;           // spin iterations of both sides, 0 = futex sleep only
+    };
+
+    // round trip [us] of each command
+    std::vector<double> measure(CarEnvClient* client, uint32_t command, int iterations) {
+        std::vector<double> samples(static_cast<std::size_t>(iterations));
+        float* actions = car_env_actions(client);
+        const std::size_t n = car_env_num_envs(client);
+        for (int k = 0; k < iterations; ++k) {
+            for (std::size_t i = 0; i < n; ++i) {
+                actions[2 * i] = 1.0f;
+                actions[2 * i + 1] = 0.01f * static_cast<float>(k % 10);
+            }
+            const auto t0 = std::chrono::steady_clock::now();
+            const int status = (command == CAR_ENV_CMD_PING) ? car_env_ping(client, 5000) : car_env_step(client, 5000);
+            const auto t1 = std::chrono::steady_clock::now();
+            if (status != CAR_ENV_OK) {
+                std::fprintf(stderr, "command failed: %d\n", status);
+                std::exit(1);
+            }
+            samples[static_cast<std::size_t>(k)] = std::chrono::duration<double, std::micro>(t1 - t0).count();
+        }
+        return samples;
+    }
+
+    double percentile(std::vector<double>& sorted, double p) {
+        const std::size_t k = static_cast<std::size_t>(p * static_cast<double>(sorted.size() - 1) + 0.5);
+        return sorted[k];
+    }
+
+    int runCase(const Case& c, std::size_t envs, int iterations) {
+        EnvServerConfig config;
+        config.name = "/car_env_bench_" + std::to_string(getpid());
+        config.numEnvs = envs;
+        config.seed = 1;
+        config.spin = c.spin;
+
+        const pid_t child = fork();
+        if (child < 0) return 1;
+        if (child == 0) {
+            int code = 1;
+            {
+                // the destructor unlinks the segment, so the next case cannot attach to this one
+                EnvServer server(config);
+                if (server.open()) {
+                    server.serve();
+                    code = 0;
+                }
+            }
+            _exit(code);
+        }
+
+        CarEnvClient* client = car_env_connect(config.name.c_str(), 5000);
+        if (!client) {
+            std::fprintf(stderr, "cannot connect to %s\n", config.name.c_str());
+            kill(child, SIGKILL);
+            waitpid(child, nullptr, 0);
+            return 1;
+        }
+        car_env_set_spin(client, c.spin);
+
+        measure(client, c.command, std::max(iterations / 10, 10));  // warm up
+        std::vector<double> samples = measure(client, c.command, iterations);
+        std::sort(samples.begin(), samples.end());
+        double mean = 0.0;
+        for (double s : samples) mean += s;
+        mean /= static_cast<double>(samples.size());
+        std::printf("%-22s %8zu %10.2f %10.2f %10.2f\n", c.label, envs, percentile(samples, 0.5), percentile(samples, 0.99), mean);
+
+        car_env_shutdown(client, 5000);
+        car_env_disconnect(client);
+        waitpid(child, nullptr, 0);
+        return 0;
+    }
+}
+
+
+int main(int argc, char** argv) {
+    int iterations = 20000;
+    std::vector<std::size_t> envs;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--iterations") == 0 && i + 1 < argc) {
+            iterations = std::max(std::atoi(argv[++i]), 1);
+        } else if (std::strcmp(argv[i], "--envs") == 0 && i + 1 < argc) {
+            envs.push_back(static_cast<std::size_t>(std::max(std::atoi(argv[++i]), 1)));
+        } else {
+            std::fprintf(stderr, "usage: %s [--iterations N] [--envs N]...\n", argv[0]);
+            return 1;
+        }
+    }
+    if (envs.empty()) envs = {1, 64, 1024};
+    Logger::instance().setLevel(LogLevel::Warn);
+
+    const Case cases[] = {
+        {"ping/spin", CAR_ENV_CMD_PING, 20000},
+        {"ping/futex", CAR_ENV_CMD_PING, 0},
+        {"step/spin", CAR_ENV_CMD_STEP, 20000},
+        {"step/futex", CAR_ENV_CMD_STEP, 0},
+    };
+    std::printf("%-22s %8s %10s %10s %10s\n", "round trip", "envs", "p50 us", "p99 us", "mean us");
+    for (const Case& c : cases) {
+        for (std::size_t n : envs) {
+            if (c.command == CAR_ENV_CMD_PING && n != envs.front()) continue;  // independent of the batch
+            if (runCase(c, n, iterations) != 0) return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,140 @@
+// car_export_bench: frames/sec of the offscreen video export (EGL context, FBO, PBO readback, encoder thread).
+// Renders the parking scene (generated lot, moving car, growing path) per frame and prints frames/sec for
+// render only, synchronous glReadPixels, double-buffered PBO readback and PBO readback + raw / PNG encoding.
+// Run from the repository root (shader paths are relative), e.g. on a CPU-only node with Mesa llvmpipe:
+//
+//   car_export_bench [--frames N] [--size WxH]
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "core/Config.h"
+#include "OffscreenContext.h"
+#include "recording/FrameEncoder.h"
+#include "renderers/FrameReadback.h"
+#include "renderers/SceneRenderer.h"
+#include "simulator/TrajectoryBuffer.h"
+#include "world/ParkingLot.h"
+
+
+namespace {
+#ifdef _WIN32
+    const char* kNullDevice = "NUL";
+#else
+    const char* kNullDevice = "/dev/null";
+#endif
+
+    enum class Readback { None, Sync, Pbo };
+
+    // the car drives a circle through the lot, one path point per frame
+    struct SceneDriver {
+        TrajectoryBuffer trajectory{65536};
+        VehicleState prev{}, cur{};
+        int frame{0};
+
+        void next() {
+            prev = cur;
+            const float t = 0.02f * static_cast<float>(frame++);
+            cur.pos = {12.0f * std::cos(t), 8.0f * std::sin(t)};
+            cur.psi = t + 1.5708f;
+            cur.delta = 0.3f * std::sin(3.0f * t);
+            trajectory.push(TrajectoryPoint{cur.pos.x, cur.pos.y, t});
+        }
+    };
+
+    double framesPerSecond(SceneRenderer& scene, FrameReadback& target, int frames, Readback readback, FrameEncoder* encoder) {
+        SceneDriver driver;
+        std::vector<uint8_t> scratch(target.getFrameBytes());
+        auto emit = [&](bool last) {
+            if (!target.hasPendingFrame()) {
+                if (!last) target.capture(nullptr);
+                return;
+            }
+            std::vector<uint8_t> frame = encoder ? encoder->acquire() : std::move(scratch);
+            if (last) target.finish(frame.data());
+            else target.capture(frame.data());
+            if (encoder) encoder->submit(std::move(frame));
+            else scratch = std::move(frame);
+        };
+
+        const auto start = std::chrono::steady_clock::now();
+        for (int f = 0; f < frames; ++f) {
+            driver.next();
+            target.bind();
+            scene.draw(driver.prev, driver.cur, 0.5f, driver.trajectory);
+            if (readback == Readback::None) glFinish();
+            else if (readback == Readback::Sync && encoder) {
+                std::vector<uint8_t> frame = encoder->acquire();
+                target.readNow(frame.data());
+                encoder->submit(std::move(frame));
+            }
+            else if (readback == Readback::Sync) target.readNow(scratch.data());
+            else emit(false);
+        }
+        if (readback == Readback::Pbo) emit(true);
+        if (encoder) encoder->close();
+        return frames / std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    void report(const char* label, double fps) {
+        std::printf("%-40s %10.1f frames/s %10.2f ms/frame\n", label, fps, 1000.0 / fps);
+    }
+}
+
+
+int main(int argc, char** argv) {
+    int frames = 300;
+    int width = static_cast<int>(SCR_WIDTH), height = static_cast<int>(SCR_HEIGHT);
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (std::strcmp(argv[i], "--frames") == 0) frames = std::atoi(argv[i + 1]);
+        else if (std::strcmp(argv[i], "--size") == 0) std::sscanf(argv[i + 1], "%dx%d", &width, &height);
+    }
+
+    Logger::instance().setLevel(LogLevel::Warn);
+    OffscreenContext context;
+    if (!context.isValid()) {
+        std::fprintf(stderr, "no offscreen OpenGL context\n");
+        return 1;
+    }
+
+    LotLayout layout;
+    layout.aisles = 2;
+    const ParkingLot lot = ParkingLot::generate(layout, 1);
+    SceneRenderer scene(width, height, 65536);
+    scene.setLot(&lot);
+    scene.setSlot(lot.getSlots().front().pose.t, lot.getSlots().front().yaw);
+    FrameReadback target(width, height);
+    if (!target.isComplete()) return 1;
+
+    std::printf("renderer: %s, %dx%d, %d frames\n", context.getRendererName(), width, height, frames);
+    framesPerSecond(scene, target, 10, Readback::None, nullptr);   // warm up shaders and buffers
+
+    report("render only (glFinish)", framesPerSecond(scene, target, frames, Readback::None, nullptr));
+    report("render + glReadPixels (sync)", framesPerSecond(scene, target, frames, Readback::Sync, nullptr));
+    report("render + PBO readback (double)", framesPerSecond(scene, target, frames, Readback::Pbo, nullptr));
+
+    FrameEncoderConfig config;
+    config.width = width;
+    config.height = height;
+    config.path = kNullDevice;
+    FrameEncoder encoder;
+    if (encoder.open(config)) report("render + sync readback + raw encoder", framesPerSecond(scene, target, frames, Readback::Sync, &encoder));
+    if (encoder.open(config)) report("render + PBO readback + raw encoder", framesPerSecond(scene, target, frames, Readback::Pbo, &encoder));
+
+    if (FrameEncoder::hasPng()) {
+        const std::filesystem::path dir = std::filesystem::temp_directory_path() / "car_export_bench_png";
+        std::filesystem::create_directories(dir);
+        config.format = FrameFormat::Png;
+        config.path = (dir / "frame_%06d.png").string();
+        if (encoder.open(config)) report("render + PBO readback + PNG encoder", framesPerSecond(scene, target, frames / 4, Readback::Pbo, &encoder));
+        std::filesystem::remove_all(dir);
+    }
+    return 0;
+}
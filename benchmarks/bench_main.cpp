@@ -0,0 +1,41 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include "BenchHarness.h"
+
+
+// usage: car_core_bench [--filter <substring>] [--min-time <seconds>] [--json <file>]
+int main(int argc, char** argv) {
+    std::string filter;
+    std::string jsonPath;
+    double minSeconds = 0.25;
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+            filter = argv[++i];
+        } else if (std::strcmp(argv[i], "--min-time") == 0 && i + 1 < argc) {
+            minSeconds = std::atof(argv[++i]);
+        } else if (std::strcmp(argv[i], "--json") == 0 && i + 1 < argc) {
+            jsonPath = argv[++i];
+        } else {
+            std::fprintf(stderr, "usage: %s [--filter <substring>] [--min-time <seconds>] [--json <file>]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    std::printf("%-48s %10s %14s %16s\n", "benchmark", "batch", "ns/item", "items/s/core");
+
+    bench::Context ctx(minSeconds);
+    for (const auto& b : bench::registry()) {
+        if (!filter.empty() && b.name.find(filter) == std::string::npos) continue;
+        b.fn(ctx);
+    }
+
+    if (!jsonPath.empty() && !bench::writeJson(jsonPath, ctx.getResults())) {
+        std::fprintf(stderr, "failed to write %s\n", jsonPath.c_str());
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,74 @@
+#include <string>
+#include <vector>
+
+#include "BenchHarness.h"
+#include "utilities/Randomizer.h"
+
+
+namespace {
+
+    const char* rngModeName(RngMode mode) {
+        return mode == RngMode::MT19937 ? "mt19937" : "philox";
+    }
+
+    constexpr std::size_t kBatchSizes[] = {64, 1024, 16384};
+}
+
+
+// one randFloat call per item
+static void BM_RandFloat(bench::Context& ctx) {
+    for (RngMode mode : {RngMode::Philox, RngMode::MT19937}) {
+        Randomizer randomizer(1, mode);
+        for (std::size_t n : kBatchSizes) {
+            ctx.run(std::string("Randomizer::randFloat/") + rngModeName(mode), n, n, [&] {
+                float acc = 0.0f;
+                for (std::size_t i = 0; i < n; ++i) acc += randomizer.randFloat(-1.0f, 1.0f);
+                bench::doNotOptimize(acc);
+            });
+        }
+    }
+}
+CAR_BENCHMARK(BM_RandFloat);
+
+// one randInt call per item
+static void BM_RandInt(bench::Context& ctx) {
+    for (RngMode mode : {RngMode::Philox, RngMode::MT19937}) {
+        Randomizer randomizer(1, mode);
+        for (std::size_t n : kBatchSizes) {
+            ctx.run(std::string("Randomizer::randInt/") + rngModeName(mode), n, n, [&] {
+                int acc = 0;
+                for (std::size_t i = 0; i < n; ++i) acc += randomizer.randInt(0, 9);
+                bench::doNotOptimize(static_cast<float>(acc));
+            });
+        }
+    }
+}
+CAR_BENCHMARK(BM_RandInt);
+
+// fillUniform of n floats per call
+static void BM_FillUniform(bench::Context& ctx) {
+    for (RngMode mode : {RngMode::Philox, RngMode::MT19937}) {
+        Randomizer randomizer(1, mode);
+        for (std::size_t n : kBatchSizes) {
+            std::vector<float> out(n);
+            ctx.run(std::string("Randomizer::fillUniform/") + rngModeName(mode), n, n, [&] {
+                randomizer.fillUniform(out.data(), n, -1.0f, 1.0f);
+                bench::doNotOptimize(out[n - 1]);
+            });
+        }
+    }
+}
+CAR_BENCHMARK(BM_FillUniform);
+
+// switching streams, the per-reset cost of reproducible env resets
+static void BM_SetStream(bench::Context& ctx) {
+    for (RngMode mode : {RngMode::Philox, RngMode::MT19937}) {
+        Randomizer randomizer(1, mode);
+        const std::size_t n = 1024;
+        ctx.run(std::string("Randomizer::setStream/") + rngModeName(mode), n, n, [&] {
+            for (std::size_t i = 0; i < n; ++i) randomizer.setStream(i, 0);
+            bench::doNotOptimize(randomizer.randFloat(0.0f, 1.0f));
+        });
+    }
+}
+CAR_BENCHMARK(BM_SetStream);
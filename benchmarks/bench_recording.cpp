@@ -0,0 +1,154 @@
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "BenchHarness.h"
+#include "recording/EpisodeLogReader.h"
+#include "recording/EpisodeLogWriter.h"
+#include "simulator/ReplayPlayer.h"
+#include "utilities/Logger.h"
+
+
+namespace {
+#ifdef _WIN32
+    const char* kNullDevice = "NUL";
+#else
+    const char* kNullDevice = "/dev/null";
+#endif
+
+    // synthetic step, the writer does not look at the values
+    EpisodeLogStep makeStep(uint32_t env, uint32_t t) {
+        EpisodeLogStep s{};
+        s.state.pos = {0.01f * static_cast<float>(t), 0.1f * static_cast<float>(env)};
+        s.state.velocity = 1.0f;
+        s.action = Action{0.5f, 0.1f};
+        s.step = t;
+        return s;
+    }
+
+    // episodes x steps, written once, as a real file in the temp directory
+    std::string writeLog(uint32_t numEnvs, uint32_t episodesPerEnv, uint32_t steps) {
+        const std::string path = (std::filesystem::temp_directory_path() / "car_bench_episodes.carlog").string();
+        Randomizer randomizer(1);
+        ParkingEnv env(&randomizer);
+        env.reset();
+
+        EpisodeLogWriter writer;
+        EpisodeLogInfo info;
+        info.numEnvs = numEnvs;
+        writer.open(path, info, nullptr);
+        const StepResult result{};
+        for (uint32_t e = 0; e < episodesPerEnv; ++e) {
+            for (uint32_t i = 0; i < numEnvs; ++i) writer.beginEpisode(i, env);
+            for (uint32_t t = 0; t < steps; ++t) {
+                for (uint32_t i = 0; i < numEnvs; ++i) {
+                    const EpisodeLogStep s = makeStep(i, t);
+                    writer.recordStep(i, s.state, s.action, result);
+                }
+            }
+            for (uint32_t i = 0; i < numEnvs; ++i) writer.endEpisode(i);
+        }
+        writer.close();
+        return path;
+    }
+}
+
+
+// stepping-thread cost of recording: recordStep for every env, an episode ends every 200 steps.
+// The flush thread writes to the null device, so this is the copy and hand-off cost only.
+static void BM_EpisodeLogWrite(bench::Context& ctx) {
+    Randomizer randomizer(1);
+    ParkingEnv env(&randomizer);
+    env.reset();
+    const StepResult result{};
+
+    for (uint32_t numEnvs : {64u, 10000u}) {
+        EpisodeLogWriter writer;
+        EpisodeLogInfo info;
+        info.numEnvs = numEnvs;
+        writer.open(kNullDevice, info, nullptr);
+        for (uint32_t i = 0; i < numEnvs; ++i) writer.beginEpisode(i, env);
+
+        uint32_t t = 0;
+        ctx.run("EpisodeLogWriter::recordStep/envs:" + std::to_string(numEnvs), numEnvs, numEnvs, [&] {
+            for (uint32_t i = 0; i < numEnvs; ++i) {
+                const EpisodeLogStep s = makeStep(i, t);
+                writer.recordStep(i, s.state, s.action, result);
+            }
+            if (++t == 200) {
+                t = 0;
+                for (uint32_t i = 0; i < numEnvs; ++i) {
+                    writer.endEpisode(i);
+                    writer.beginEpisode(i, env);
+                }
+            }
+        });
+        writer.close();
+    }
+}
+CAR_BENCHMARK(BM_EpisodeLogWrite);
+
+// read back 1M steps through the mapping: copy every episode out vs one plain memcpy of the same bytes
+static void BM_EpisodeLogRead(bench::Context& ctx) {
+    const std::string path = writeLog(100, 10, 1000);
+    EpisodeLogReader reader;
+    if (!reader.open(path)) return;
+    const std::size_t steps = static_cast<std::size_t>(reader.getStepCount());
+
+    std::vector<EpisodeLogStep> out(steps);
+    ctx.run("EpisodeLogReader/copy episodes", steps, steps, [&] {
+        EpisodeLogStep* dst = out.data();
+        for (std::size_t k = 0; k < reader.getEpisodeCount(); ++k) {
+            const std::size_t n = reader.getEpisode(k).numSteps;
+            std::memcpy(dst, reader.getSteps(k), n * sizeof(EpisodeLogStep));
+            dst += n;
+        }
+        bench::doNotOptimize(out[steps - 1].state.pos.x);
+    });
+
+    std::vector<EpisodeLogStep> src(out);
+    ctx.run("memcpy (same bytes)", steps, steps, [&] {
+        std::memcpy(out.data(), src.data(), steps * sizeof(EpisodeLogStep));
+        bench::doNotOptimize(out[steps - 1].state.pos.x);
+    });
+
+    reader.close();
+    std::remove(path.c_str());
+}
+CAR_BENCHMARK(BM_EpisodeLogRead);
+
+// replay of one 100k-step episode: open (map, index, lot), random seeks and 60 fps playback. The path
+// has the Simulator's capacity, so a seek includes the path rebuild the front end pays.
+static void BM_ReplaySeek(bench::Context& ctx) {
+    const std::string path = writeLog(1, 1, 100000);
+    Logger& logger = Logger::instance();
+    const LogLevel previousLevel = logger.getLevel();
+    logger.setLevel(LogLevel::Warn);
+    ReplayPlayer player;
+
+    ctx.run("ReplayPlayer::open/steps:100000", 1, 1, [&] {
+        player.open(path);
+        bench::doNotOptimize(player.getNumSteps());
+    });
+
+    uint64_t x = 88172645463325252ull;
+    ctx.run("ReplayPlayer::seek/random", 1, 1, [&] {
+        x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+        player.seek(static_cast<double>(x % 100001));
+        bench::doNotOptimize(player.getCurState().pos.x);
+    });
+
+    player.seek(0.0);
+    ctx.run("ReplayPlayer::advance/60 fps", 1, 1, [&] {
+        player.advance(1.0 / 60.0);
+        if (player.isPaused()) player.setPaused(false);
+        bench::doNotOptimize(player.getCurState().pos.x);
+    });
+
+    player.close();
+    logger.setLevel(previousLevel);
+    std::remove(path.c_str());
+}
+CAR_BENCHMARK(BM_ReplaySeek);
@@ -0,0 +1,120 @@
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "core/Config.h"
+#include "entities/Entity.h"
+#include "renderers/Renderer.h"
+#include "shaders/InstancedRectShader.h"
+#include "shaders/RectShader.h"
+#include "Loader.h"
+
+
+/**
+ * Frame-time benchmark: per-entity draw calls vs one instanced draw call
+ * ---------------------------
+ * Renders N rectangles per frame into a hidden window and reports ms/frame (glFinish per frame).
+ * Run from the repository root (shader paths are relative), e.g. under Mesa llvmpipe:
+ *   LIBGL_ALWAYS_SOFTWARE=1 xvfb-run ./build/car_render_bench
+ */
+namespace {
+    float QUAD_VERTICES[] = {
+        0.5f,  0.5f, 0.0f,
+        0.5f, -0.5f, 0.0f,
+       -0.5f, -0.5f, 0.0f,
+       -0.5f,  0.5f, 0.0f
+    };
+
+    unsigned int QUAD_INDICES[] = {
+        0, 1, 3,
+        1, 2, 3
+    };
+
+    template <class F>
+    double msPerFrame(GLFWwindow* window, int frames, F&& drawFrame) {
+        drawFrame();
+        glFinish();
+
+        const auto start = std::chrono::steady_clock::now();
+        for (int f = 0; f < frames; ++f) {
+            glClear(GL_COLOR_BUFFER_BIT);
+            drawFrame();
+            glfwSwapBuffers(window);
+            glFinish();
+        }
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / frames;
+    }
+}
+
+
+int main(int argc, char** argv) {
+    int frames = 200;
+    if (argc > 2 && std::strcmp(argv[1], "--frames") == 0) frames = std::atoi(argv[2]);
+
+    if (!glfwInit()) {
+        std::fprintf(stderr, "Failed to initialize GLFW\n");
+        return 1;
+    }
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+#ifdef __APPLE__
+    glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
+#endif
+    GLFWwindow* window = glfwCreateWindow(SCR_WIDTH, SCR_HEIGHT, "car_render_bench", NULL, NULL);
+    if (!window) {
+        std::fprintf(stderr, "Failed to create GLFW window\n");
+        glfwTerminate();
+        return 1;
+    }
+    glfwMakeContextCurrent(window);
+    glfwSwapInterval(0);  // measure rendering, not vsync
+    if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) {
+        std::fprintf(stderr, "Failed to initialize GLAD\n");
+        return 1;
+    }
+    std::printf("GL_RENDERER: %s\n", reinterpret_cast<const char*>(glGetString(GL_RENDERER)));
+    {
+        RectShader rectShader;
+        InstancedRectShader instancedShader;
+        Loader quad(QUAD_VERTICES, 12, QUAD_INDICES, 6);
+        Renderer renderer(PPM, SCR_WIDTH, SCR_HEIGHT);
+        renderer.initInstancing(quad);
+
+        std::printf("%10s %18s %18s\n", "rects", "per-entity ms", "instanced ms");
+        for (int n : {16, 256, 4096, 65536}) {
+            // small segments spread over the screen, like a long trajectory
+            std::vector<Entity> entities;
+            entities.reserve(n);
+            for (int i = 0; i < n; ++i) {
+                Entity e(&quad, &rectShader);
+                e.setPos({-18.0f + 36.0f * (i % 256) / 256.0f, -13.0f + 26.0f * (i / 256) / 256.0f});
+                e.setWidth(0.05f);
+                e.setLength(0.1f);
+                e.setYaw(0.01f * i);
+                e.setColor({0.9f, 0.9f, 0.2f, 1.0f});
+                entities.push_back(e);
+            }
+
+            const double perEntity = msPerFrame(window, frames, [&] {
+                for (const auto& e : entities) renderer.draw(e);
+            });
+            const double instanced = msPerFrame(window, frames, [&] {
+                for (const auto& e : entities) renderer.submit(e);
+                renderer.flush(instancedShader);
+            });
+            std::printf("%10d %18.3f %18.3f\n", n, perEntity, instanced);
+        }
+    }
+
+    glfwDestroyWindow(window);
+    glfwTerminate();
+    return 0;
+}
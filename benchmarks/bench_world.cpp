@@ -0,0 +1,256 @@
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "BenchHarness.h"
+#include "envs/ParkingCheck.h"
+#include "envs/ParkingEnv.h"
+#include "envs/VecParkingEnv.h"
+#include "sensors/BevRasterizer.h"
+#include "sensors/RangeSensor.h"
+#include "utilities/Randomizer.h"
+#include "world/ParkingLot.h"
+
+
+namespace {
+    constexpr std::size_t kQueries = 4096;
+
+    // lots of 160, 1600 and 16000 slots
+    constexpr int kAisles[] = {2, 10, 40};
+    constexpr int kSlotsPerRow[] = {40, 80, 200};
+
+    ParkingLot makeLot(int k) {
+        LotLayout layout;
+        layout.aisles = kAisles[k];
+        layout.slotsPerRow = kSlotsPerRow[k];
+        return ParkingLot::generate(layout, 1);
+    }
+
+    std::vector<Position2D> randomPoints(const ParkingLot& lot, std::size_t n) {
+        Randomizer randomizer(3);
+        const AABB2D& b = lot.getBounds();
+        std::vector<Position2D> points(n);
+        for (auto& p : points) p = {randomizer.randFloat(b.minX, b.maxX), randomizer.randFloat(b.minY, b.maxY)};
+        return points;
+    }
+}
+
+
+// nearest free slot: grid ring search against a linear scan over all slots
+static void BM_LotNearestSlot(bench::Context& ctx) {
+    for (int k = 0; k < 3; ++k) {
+        const ParkingLot lot = makeLot(k);
+        const std::vector<Position2D> points = randomPoints(lot, kQueries);
+        const std::string slots = "/slots:" + std::to_string(lot.getSlots().size());
+
+        ctx.run("ParkingLot::nearestSlot" + slots, kQueries, kQueries, [&] {
+            std::size_t acc = 0;
+            for (const auto& p : points) acc += static_cast<std::size_t>(lot.nearestSlot(p));
+            bench::doNotOptimize(acc);
+        });
+
+        ctx.run("linear scan" + slots, kQueries, kQueries, [&] {
+            std::size_t acc = 0;
+            for (const auto& p : points) {
+                int best = -1;
+                float bestD2 = 0.0f;
+                for (std::size_t i = 0; i < lot.getSlots().size(); ++i) {
+                    const ParkingSlot& s = lot.getSlots()[i];
+                    if (s.occupied) continue;
+                    const float dx = s.pose.t.x - p.x, dy = s.pose.t.y - p.y;
+                    const float d2 = dx * dx + dy * dy;
+                    if (best < 0 || d2 < bestD2) { best = static_cast<int>(i); bestD2 = d2; }
+                }
+                acc += static_cast<std::size_t>(best);
+            }
+            bench::doNotOptimize(acc);
+        });
+    }
+}
+CAR_BENCHMARK(BM_LotNearestSlot);
+
+// slot containing a car, and the obstacle candidates around it
+static void BM_LotLocalQueries(bench::Context& ctx) {
+    for (int k = 0; k < 3; ++k) {
+        const ParkingLot lot = makeLot(k);
+        const std::vector<Position2D> points = randomPoints(lot, kQueries);
+        const std::string slots = "/slots:" + std::to_string(lot.getSlots().size());
+
+        ctx.run("ParkingLot::slotContaining" + slots, kQueries, kQueries, [&] {
+            std::size_t acc = 0;
+            for (const auto& p : points) acc += static_cast<std::size_t>(lot.slotContaining(Transform2D::fromPose(p, 0.0f)));
+            bench::doNotOptimize(acc);
+        });
+
+        ctx.run("ParkingLot::queryObstacles" + slots, kQueries, kQueries, [&] {
+            uint32_t candidates[64];
+            std::size_t acc = 0;
+            for (const auto& p : points) {
+                acc += lot.queryObstacles(AABB2D{p.x - 3.0f, p.y - 3.0f, p.x + 3.0f, p.y + 3.0f}, candidates, 64);
+            }
+            bench::doNotOptimize(acc);
+        });
+    }
+}
+CAR_BENCHMARK(BM_LotLocalQueries);
+
+// ParkingEnv::stepInto on a lot: the per-step cost must not grow with the number of slots
+static void BM_ParkingEnvLotStep(bench::Context& ctx) {
+    for (int k = 0; k < 3; ++k) {
+        const ParkingLot lot = makeLot(k);
+        Randomizer randomizer(1);
+        std::vector<ParkingEnv> envs(64, ParkingEnv(&randomizer));
+        for (std::size_t i = 0; i < envs.size(); ++i) {
+            envs[i].setLot(&lot);
+            envs[i].setEnvIndex(i);
+            envs[i].reset();
+        }
+        Observation obs;
+        StepResult result;
+        ctx.run("ParkingEnv::stepInto/slots:" + std::to_string(lot.getSlots().size()), envs.size(), envs.size(), [&] {
+            for (auto& env : envs) {
+                env.stepInto(Action{0.5f, 0.1f}, 0.01f, obs, result);
+                if (result.done) env.reset();
+            }
+            bench::doNotOptimize(obs.vehicleState.pos.x);
+        });
+    }
+}
+CAR_BENCHMARK(BM_ParkingEnvLotStep);
+
+// car vs lot collisions: batched (fastSinCos + SSE2 SAT over the cells under each car) vs brute force SAT
+static void BM_LotCollide(bench::Context& ctx) {
+    for (int k = 0; k < 3; ++k) {
+        const ParkingLot lot = makeLot(k);
+        const std::vector<Position2D> points = randomPoints(lot, kQueries);
+        const std::string slots = "/slots:" + std::to_string(lot.getSlots().size());
+        std::vector<float> x(kQueries), y(kQueries), psi(kQueries);
+        for (std::size_t i = 0; i < kQueries; ++i) {
+            x[i] = points[i].x;
+            y[i] = points[i].y;
+            psi[i] = 0.37f * static_cast<float>(i);
+        }
+        std::vector<uint8_t> contact(kQueries);
+
+        ctx.run("ParkingLot::collideBatch" + slots, kQueries, kQueries, [&] {
+            lot.collideBatch(x.data(), y.data(), psi.data(), kQueries, contact.data());
+            bench::doNotOptimize(contact[0] != 0);
+        });
+
+        if (k == 2) continue;  // brute force is too slow for 16000 slots
+        ctx.run("brute force SAT" + slots, kQueries, kQueries, [&] {
+            std::size_t hits = 0;
+            for (std::size_t i = 0; i < kQueries; ++i) {
+                const Transform2D car = Transform2D::fromPose({x[i], y[i]}, psi[i]);
+                for (const auto& o : lot.getObstacles()) {
+                    if (obbOverlap(car, {CAR_LENGTH * 0.5f, CAR_WIDTH * 0.5f}, o.pose, o.halfExtents)) { ++hits; break; }
+                }
+            }
+            bench::doNotOptimize(hits);
+        });
+    }
+}
+CAR_BENCHMARK(BM_LotCollide);
+
+// 64-beam lidar for 1024 cars: grid + angular culling + SSE2 slab test vs every obstacle, then the VecParkingEnv step cost
+static void BM_RangeSensor(bench::Context& ctx) {
+    constexpr std::size_t kCars = 1024;
+    const RangeSensor sensor(RangeSensorConfig{64, 10.0f, 2.0f * PI, {}});
+    for (int k = 0; k < 3; ++k) {
+        const ParkingLot lot = makeLot(k);
+        const std::vector<Position2D> points = randomPoints(lot, kCars);
+        const std::string slots = "/slots:" + std::to_string(lot.getSlots().size());
+        std::vector<float> x(kCars), y(kCars), psi(kCars), ranges(kCars * 64);
+        for (std::size_t i = 0; i < kCars; ++i) {
+            x[i] = points[i].x;
+            y[i] = points[i].y;
+            psi[i] = 0.37f * static_cast<float>(i);
+        }
+
+        ctx.run("RangeSensor::scanBatch" + slots, kCars, kCars, [&] {
+            sensor.scanBatch(&lot, x.data(), y.data(), psi.data(), kCars, ranges.data());
+            bench::doNotOptimize(ranges[0]);
+        });
+
+        if (k == 0) {
+            ctx.run("brute force rays" + slots, kCars, kCars, [&] {
+                for (std::size_t i = 0; i < kCars; ++i) {
+                    const Transform2D car = Transform2D::fromPose({x[i], y[i]}, psi[i]);
+                    for (int b = 0; b < 64; ++b) {
+                        const float a = psi[i] + sensor.beamAngle(b);
+                        float r = sensor.getMaxRange();
+                        for (const auto& o : lot.getObstacles()) {
+                            r = std::min(r, rayBoxDistance(car.t, std::cos(a), std::sin(a), o.pose, o.halfExtents));
+                        }
+                        ranges[i * 64 + b] = r;
+                    }
+                }
+                bench::doNotOptimize(ranges[0]);
+            });
+        }
+
+        Randomizer randomizer(1);
+        VecParkingEnv vecEnv(kCars, &randomizer);
+        vecEnv.setLot(&lot);
+        vecEnv.setAutoReset(true);
+        vecEnv.reset();
+        std::vector<Action> actions(kCars, Action{0.5f, 0.1f});
+        std::vector<Observation> obs(kCars);
+        std::vector<float> rewards(kCars);
+        std::vector<uint8_t> dones(kCars);
+        for (int beams : {0, 64}) {
+            vecEnv.setRangeSensor(RangeSensorConfig{beams, 10.0f, 2.0f * PI, {}});
+            ctx.run("VecParkingEnv::step/beams:" + std::to_string(beams) + slots, kCars, kCars, [&] {
+                vecEnv.step(actions.data(), obs.data(), rewards.data(), dones.data());
+                bench::doNotOptimize(rewards[0]);
+            });
+        }
+    }
+}
+CAR_BENCHMARK(BM_RangeSensor);
+
+// 64x64 bird's-eye-view images of many cars into one tensor, vs clearing the tensor only
+static void BM_BevRaster(bench::Context& ctx) {
+    constexpr std::size_t kCars = 1024;
+    const BevRasterizer raster(BevConfig{64, 64, 0.1f});
+    std::vector<uint8_t> images(kCars * raster.imageSize());
+    for (int k = 0; k < 2; ++k) {
+        const ParkingLot lot = makeLot(k);
+        const std::vector<Position2D> points = randomPoints(lot, kCars);
+        const std::string slots = "/slots:" + std::to_string(lot.getSlots().size());
+        const Transform2D& target = lot.getSlots()[0].pose;
+
+        ctx.run("BevRasterizer::render/64x64" + slots, kCars, kCars, [&] {
+            for (std::size_t i = 0; i < kCars; ++i) {
+                raster.render(&lot, Transform2D::fromPose(points[i], 0.37f * static_cast<float>(i)), target, images.data() + i * raster.imageSize());
+            }
+            bench::doNotOptimize(images[0] != 0);
+        });
+        if (k == 0) {
+            ctx.run("memset only/64x64", kCars, kCars, [&] {
+                std::memset(images.data(), 0, images.size());
+                bench::doNotOptimize(images[0] != 0);
+            });
+        }
+
+        Randomizer randomizer(1);
+        VecParkingEnv vecEnv(kCars, &randomizer);
+        vecEnv.setLot(&lot);
+        vecEnv.setAutoReset(true);
+        vecEnv.reset();
+        std::vector<Action> actions(kCars, Action{0.5f, 0.1f});
+        std::vector<Observation> obs(kCars);
+        std::vector<float> rewards(kCars);
+        std::vector<uint8_t> dones(kCars);
+        for (int size : {0, 64}) {
+            vecEnv.setBevRaster(BevConfig{size, size, 0.1f});
+            ctx.run("VecParkingEnv::step/bev:" + std::to_string(size) + slots, kCars, kCars, [&] {
+                vecEnv.step(actions.data(), obs.data(), rewards.data(), dones.data());
+                bench::doNotOptimize(rewards[0]);
+            });
+        }
+    }
+}
+CAR_BENCHMARK(BM_BevRaster);
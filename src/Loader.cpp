@@ -45,7 +45,7 @@ Loader::~Loader() {
     glDeleteBuffers(1, &vbo);
     glDeleteVertexArrays(1, &vao);
     glDeleteBuffers(1, &ebo);
-    std::cout << "Loader destructed, VBO, VAO, EBO deleted." << std::endl;
+    CAR_LOG_DEBUG("Loader destructed, VBO, VAO, EBO deleted.");
 };
 
 // getter for VBO, VAO, EBO
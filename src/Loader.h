@@ -3,7 +3,7 @@
 
 
 #include <glad/glad.h>
-#include <iostream>
+#include "utilities/Logger.h"
 
 
 /*
@@ -0,0 +1,118 @@
+#include "OffscreenContext.h"
+
+#include <EGL/eglext.h>
+
+#include <cstring>
+
+#include "utilities/Logger.h"
+
+
+namespace {
+    bool hasExtension(const char* extensions, const char* name) {
+        if (!extensions) return false;
+        const std::size_t n = std::strlen(name);
+        for (const char* p = std::strstr(extensions, name); p; p = std::strstr(p + n, name)) {
+            if ((p == extensions || p[-1] == ' ') && (p[n] == ' ' || p[n] == '\0')) return true;
+        }
+        return false;
+    }
+}
+
+
+// constructor
+// ------------------------------------------------------------------------
+OffscreenContext::OffscreenContext() {
+
+    // Display: Mesa surfaceless platform, else the default display
+    // ------------------------------
+    const char* clientExtensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+    if (hasExtension(clientExtensions, "EGL_MESA_platform_surfaceless")) {
+        auto getPlatformDisplay = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(eglGetProcAddress("eglGetPlatformDisplayEXT"));
+        if (getPlatformDisplay) m_display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+    }
+    if (m_display == EGL_NO_DISPLAY) m_display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+
+    EGLint major = 0, minor = 0;
+    if (m_display == EGL_NO_DISPLAY || !eglInitialize(m_display, &major, &minor)) {
+        CAR_LOG_ERROR("Failed to initialize EGL (0x%x)", eglGetError());
+        m_display = EGL_NO_DISPLAY;
+        return;
+    }
+    if (!eglBindAPI(EGL_OPENGL_API)) {
+        CAR_LOG_ERROR("EGL has no desktop OpenGL");
+        return;
+    }
+
+    // Configure OpenGL context: a pbuffer config if there is one, else no config and no surface
+    // ------------------------------
+    const EGLint configAttribs[] = {
+        EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+        EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+        EGL_RED_SIZE, 8, EGL_GREEN_SIZE, 8, EGL_BLUE_SIZE, 8, EGL_ALPHA_SIZE, 8,
+        EGL_NONE
+    };
+    EGLConfig config = nullptr;
+    EGLint numConfigs = 0;
+    if (!eglChooseConfig(m_display, configAttribs, &config, 1, &numConfigs)) numConfigs = 0;
+
+    const char* displayExtensions = eglQueryString(m_display, EGL_EXTENSIONS);
+    const bool surfaceless = hasExtension(displayExtensions, "EGL_KHR_surfaceless_context")
+                          && hasExtension(displayExtensions, "EGL_KHR_no_config_context");
+    if (numConfigs == 0 && !surfaceless) {
+        CAR_LOG_ERROR("EGL has neither a pbuffer config nor surfaceless contexts");
+        return;
+    }
+
+    const EGLint contextAttribs[] = {
+        EGL_CONTEXT_MAJOR_VERSION, 3,
+        EGL_CONTEXT_MINOR_VERSION, 3,
+        EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+        EGL_NONE
+    };
+    m_context = eglCreateContext(m_display, numConfigs > 0 ? config : EGL_NO_CONFIG_KHR, EGL_NO_CONTEXT, contextAttribs);
+    if (m_context == EGL_NO_CONTEXT) {
+        CAR_LOG_ERROR("Failed to create an OpenGL 3.3 core context (0x%x)", eglGetError());
+        return;
+    }
+
+    // the FBO is the render target, the pbuffer only makes the context current
+    if (numConfigs > 0 && !surfaceless) {
+        const EGLint pbufferAttribs[] = {EGL_WIDTH, 16, EGL_HEIGHT, 16, EGL_NONE};
+        m_surface = eglCreatePbufferSurface(m_display, config, pbufferAttribs);
+        if (m_surface == EGL_NO_SURFACE) {
+            CAR_LOG_ERROR("Failed to create an EGL pbuffer (0x%x)", eglGetError());
+            return;
+        }
+    }
+    if (!eglMakeCurrent(m_display, m_surface, m_surface, m_context)) {
+        CAR_LOG_ERROR("Failed to make the EGL context current (0x%x)", eglGetError());
+        return;
+    }
+
+    // glad: load all OpenGL function pointers
+    // ---------------------------------------
+    if (!gladLoadGLLoader((GLADloadproc)eglGetProcAddress)) {
+        CAR_LOG_ERROR("Failed to initialize GLAD");
+        return;
+    }
+    m_valid = true;
+    CAR_LOG_INFO("Offscreen context: EGL %d.%d, %s", major, minor, getRendererName());
+}
+
+// deconstructor
+// ------------------------------------------------------------------------
+OffscreenContext::~OffscreenContext() {
+    if (m_display == EGL_NO_DISPLAY) return;
+    eglMakeCurrent(m_display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    if (m_surface != EGL_NO_SURFACE) eglDestroySurface(m_display, m_surface);
+    if (m_context != EGL_NO_CONTEXT) eglDestroyContext(m_display, m_context);
+    eglTerminate(m_display);
+}
+
+// renderer name
+// ------------------------------------------------------------------------
+const char* OffscreenContext::getRendererName() const {
+    if (!glGetString) return "";     // GL functions not loaded
+    const GLubyte* name = glGetString(GL_RENDERER);
+    return name ? reinterpret_cast<const char*>(name) : "";
+}
@@ -0,0 +1,40 @@
+#ifndef OFFSCREENCONTEXT_H
+#define OFFSCREENCONTEXT_H
+
+
+#include <glad/glad.h>
+#include <EGL/egl.h>
+
+
+/**
+ * Offscreen Context Class
+ * ---------------------------
+ * OpenGL 3.3 core context without a window, the counterpart of Window for headless nodes. It uses
+ * EGL: the Mesa surfaceless platform when available (no display server, llvmpipe on CPU-only
+ * machines), otherwise the default display with a small pbuffer. Frames are drawn into an FBO
+ * (FrameReadback), so the surface is never presented.
+ */
+class OffscreenContext {
+public:
+    OffscreenContext();
+    ~OffscreenContext();
+
+    OffscreenContext(const OffscreenContext&) = delete;
+    OffscreenContext& operator=(const OffscreenContext&) = delete;
+
+    // return whether it's valid or not (context current and GL functions loaded)
+    // ------------------------------------------------------------------------
+    bool isValid() const { return m_valid; }
+
+    // GL_RENDERER string, e.g. "llvmpipe (LLVM 15.0.6, 256 bits)"
+    const char* getRendererName() const;
+
+private:
+    EGLDisplay m_display{EGL_NO_DISPLAY};
+    EGLContext m_context{EGL_NO_CONTEXT};
+    EGLSurface m_surface{EGL_NO_SURFACE};
+    bool m_valid{false};
+};
+
+
+#endif
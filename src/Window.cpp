@@ -1,6 +1,6 @@
 #include "Window.h"
 
-#include<iostream>
+#include "utilities/Logger.h"
 
 
 bool Window::s_glfwInitialized = false;
@@ -12,7 +12,7 @@ Window::Window(int width, int height, const char* title) {
     // Initialize GLFW once
     if (!s_glfwInitialized) {
         if (!glfwInit()) {
-            std::cerr << "Faild to initialize GLFW\n";
+            CAR_LOG_ERROR("Failed to initialize GLFW");
             return;
         }
         s_glfwInitialized = true;
@@ -32,7 +32,7 @@ Window::Window(int width, int height, const char* title) {
     // --------------------
     m_window = glfwCreateWindow(width, height, "Car Simulator", NULL, NULL);
     if (m_window == NULL) {
-        std::cout << "Failed to create GLFW window" << std::endl;
+        CAR_LOG_ERROR("Failed to create GLFW window");
         glfwTerminate();
         return;
     }
@@ -42,7 +42,7 @@ Window::Window(int width, int height, const char* title) {
     // ---------------------------------------
     if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
     {
-        std::cout << "Failed to initialize GLAD" << std::endl;
+        CAR_LOG_ERROR("Failed to initialize GLAD");
         return;
     }
 
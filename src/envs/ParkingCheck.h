@@ -0,0 +1,92 @@
+#ifndef PARKINGCHECK_H
+#define PARKINGCHECK_H
+
+#include <cmath>
+
+#include "ParkingParams.h"
+#include "../core/Config.h"
+#include "../utilities/MathUtils.h"
+#include "../utilities/Transform2D.h"
+
+
+// cheap reject without trig: the car center must be inside the slot, so within its half diagonal
+inline bool isCarNearSlot(float carX, float carY, float slotX, float slotY) {
+    const float halfSlotLen = PARKING_LENGTH * 0.5f;
+    const float halfSlotWid = PARKING_WIDTH  * 0.5f;
+    const float dx = carX - slotX;
+    const float dy = carY - slotY;
+    return dx * dx + dy * dy <= halfSlotLen * halfSlotLen + halfSlotWid * halfSlotWid;
+}
+
+/**
+ * @brief Strict geometric parking check shared by ParkingEnv and VecParkingEnv.
+ *
+ * The full rotated car rectangle (CAR_LENGTH x CAR_WIDTH) must lie inside the
+ * rotated parking slot rectangle (PARKING_LENGTH x PARKING_WIDTH).
+ * See ParkingEnv::isParked for the derivation of each step.
+ *
+ * @param car   Car frame -> world frame (center, heading).
+ * @param slot  Slot frame -> world frame (center, orientation).
+ *
+ * @return true if all four car corners are inside the slot rectangle.
+ */
+inline bool isCarInSlot(const Transform2D& car, const Transform2D& slot) {
+    // calculate half sizes (meters)
+    const float halfCarLen = CAR_LENGTH * 0.5f;       // along car local x (forward)
+    const float halfCarWid = CAR_WIDTH  * 0.5f;       // along car local y (left)
+    const float halfSlotLen = PARKING_LENGTH * 0.5f;  // along slot local X
+    const float halfSlotWid = PARKING_WIDTH  * 0.5f;  // along slot local Y
+
+    // car frame -> slot frame, no trig: the cached cos/sin of both poses are combined
+    const Transform2D rel = slot.inverse().compose(car);
+
+    // Car corners in car local frame: (±halfLen, ±halfWid)
+    const float cornerX[4] = { +halfCarLen, +halfCarLen, -halfCarLen, -halfCarLen };
+    const float cornerY[4] = { +halfCarWid, -halfCarWid, -halfCarWid, +halfCarWid };
+
+    // Transform each car corner into slot frame and test
+    for (int i = 0; i < 4; ++i) {
+        const Position2D v = rel.apply(Position2D{cornerX[i], cornerY[i]});
+
+        if (std::fabs(v.x) > halfSlotLen || std::fabs(v.y) > halfSlotWid) {
+            // at least one corner is outside → not parked
+            return false;
+        }
+    }
+
+    // all 4 corners are inside the slot box in slot frame → parked
+    return true;
+}
+
+/**
+ * @brief Same check for a car pose and a cached slot transform.
+ *
+ * Far-away cars are rejected before the car cos/sin are computed.
+ *
+ * @param carX, carY   Car center position in world frame [meters].
+ * @param carYaw       Car heading in world frame [radians].
+ * @param slot         Slot frame -> world frame.
+ */
+inline bool isCarInSlot(float carX, float carY, float carYaw, const Transform2D& slot) {
+    if (!isCarNearSlot(carX, carY, slot.t.x, slot.t.y)) return false;
+    return isCarInSlot(Transform2D::fromPose({carX, carY}, carYaw), slot);
+}
+
+// same check from plain poses: slotX, slotY, slotYaw is the slot center and orientation in world frame
+inline bool isCarInSlot(float carX, float carY, float carYaw, float slotX, float slotY, float slotYaw) {
+    if (!isCarNearSlot(carX, carY, slotX, slotY)) return false;
+    return isCarInSlot(Transform2D::fromPose({carX, carY}, carYaw), Transform2D::fromPose({slotX, slotY}, slotYaw));
+}
+
+/**
+ * @brief Lot bounds check shared by ParkingEnv and VecParkingEnv.
+ *
+ * @param carX, carY   Car center position in world frame [meters].
+ *
+ * @return true if the car center is inside the lot bounds (LOT_X_MIN..LOT_Y_MAX).
+ */
+inline bool isCarInLot(float carX, float carY) {
+    return carX >= LOT_X_MIN && carX <= LOT_X_MAX && carY >= LOT_Y_MIN && carY <= LOT_Y_MAX;
+}
+
+#endif
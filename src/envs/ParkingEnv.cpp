@@ -6,119 +6,178 @@ ParkingEnv::ParkingEnv(Randomizer* randomizer) : randomizer(randomizer){};
 
 Observation ParkingEnv::step(Action&action, const float& simDt) {
 
-    // apply the action using bicycle model
-    bicycleModel.kinematicAct(action, vehicleState, simDt);
+    // clamp the caller's action in place as before, then step
+    const BicycleModelLimits limits;
+    action.steeringAngle = std::clamp(action.steeringAngle, -limits.delta_max, limits.delta_max);
+    action.acceleration = std::clamp(action.acceleration, -limits.a_max, limits.a_max);
+
+    Observation out;
+    StepResult result;
+    stepInto(action, simDt, out, result);
+    return out;
+}
 
-    // reward calculation
-    rewardValue = reward();
+// step without copies: observation and result go into caller buffers
+// ------------------------------------------------------------------------
+void ParkingEnv::stepInto(const Action& action, float simDt, Observation& out, StepResult& result) noexcept {
+    advance(action, simDt, result);
+    observe(out);
+}
 
-    // todo: Observation should be calculated for the relative coordinate system of the car from the parking lot corners to the center of the car
-    observation = Observation{
-        calculateRelCorners(vehicleState.pos, vehicleState.psi, parkingPos, parkingYaw),
-        vehicleState
-    };
-    
-    return observation;
+void ParkingEnv::stepInto(const Action& action, float simDt, float* out, StepResult& result) noexcept {
+    advance(action, simDt, result);
+    writeObservation(out);
 }
 
-// reset the environement to initial state
+// apply the action and evaluate the parking check
 // ------------------------------------------------------------------------
-void ParkingEnv::reset() {
-    // random positions and yaw for parking
-    const Position2D randParkingPos = setParkingPos(-15.f, 15.f, -10.f, 10.f);  // temporary values
-    parkingPos = randParkingPos;
-    parkingYaw = setParkingYaw();
-
-    // random positions and yaw for car
-    const float marginX = randomizer->randFloat(-5.0, 5.0), marginY = randomizer->randFloat(-5.0, 5.0);
-    const Position2D randCarPos = {randParkingPos.x + marginX, randParkingPos.y + marginY};
-
-    // set observation of the car state
-    vehicleState.pos = randCarPos;
-    vehicleState.psi = 0.0f;
-    vehicleState.velocity = 0.0f;
-    vehicleState.delta = 0.0f;
-    observation.vehicleState = vehicleState;
-
-    // set observation of the parking lot corners relative to the car position
-    observation.distCorners = calculateRelCorners(randCarPos, vehicleState.psi, parkingPos, parkingYaw);
+void ParkingEnv::advance(const Action& action, float simDt, StepResult& result) noexcept {
+    result = StepResult{};
+    bool parked = false;
+    bool transformCurrent = false;   // carTransform matches vehicleState
+    for (int k = 0; k < actionRepeat && !result.terminated; ++k) {
+        // apply the action using bicycle model
+        if (vehicleModel == VehicleModel::Dynamic) bicycleModel.dynamicAct(action, vehicleState, simDt);
+        else bicycleModel.kinematicAct(action, vehicleState, simDt);
+        ++result.substeps;
+
+        // one sin/cos pair per substep at most: the car transform is built when the collision check needs it
+        // or the car is near the slot, and shared by the parking and collision checks
+        const bool nearSlot = isCarNearSlot(vehicleState.pos.x, vehicleState.pos.y, slotTransform.t.x, slotTransform.t.y);
+        transformCurrent = lot || nearSlot;
+        if (transformCurrent) carTransform = Transform2D::fromPose(vehicleState.pos, vehicleState.psi);
+
+        // reward calculation, the episode ends at the first parked, colliding or out-of-lot substep
+        parked = nearSlot && isCarInSlot(carTransform, slotTransform);
+        result.reward += parked ? 1.0f : 0.0f;
+        bool inLot = isCarInLot(vehicleState.pos.x, vehicleState.pos.y);
+        if (lot) {
+            inLot = lot->contains(vehicleState.pos.x, vehicleState.pos.y);
+            result.collided = lot->carCollides(carTransform);
+            result.reward -= result.collided ? COLLISION_PENALTY : 0.0f;
+        }
+        result.terminated = parked || result.collided || !inLot;
+    }
+
+    // the last substep's transform is kept as the cache for observe() and the sensors
+    if (!transformCurrent) updateCarTransform();
+    updateSensors();
+
+    ++episodeStep;
+    result.truncated = !result.terminated && maxEpisodeSteps != 0 && episodeStep >= maxEpisodeSteps;
+    result.done = result.terminated || result.truncated;
+    rewardValue = result.reward;
+    lastResult = result;
+    CAR_LOG_DEBUG("Parking %s, reward: %.1f", parked ? "success" : "fail", rewardValue);
+    if (result.collided) CAR_LOG_DEBUG("Car collided at (%.2f, %.2f)", vehicleState.pos.x, vehicleState.pos.y);
+    else if (result.terminated && !parked) CAR_LOG_DEBUG("Car left the lot at (%.2f, %.2f)", vehicleState.pos.x, vehicleState.pos.y);
 }
 
-// return reward based on parking-success check
+// write the current observation
 // ------------------------------------------------------------------------
-float ParkingEnv::reward() {
-    // check parking success
-    const bool parkingSuccess = isParked({vehicleState.pos.x, vehicleState.pos.y}, vehicleState.psi, {parkingPos.x, parkingPos.y}, parkingYaw);
+void ParkingEnv::observe(Observation& out) const noexcept {
+    // slot corners relative to the car center, in the car frame (cached transforms, no trig)
+    carTransform.applyInverseN(slotCornersWorld.data(), out.distCorners.data(), 4);
+    out.vehicleState = vehicleState;
+}
 
-    // TODO: reward shaping can be added here later
-    if (parkingSuccess) {
-        rewardValue = 1.0f;
-        std::cout << "Parking Success " << "Reward: " << rewardValue << std::endl;
-        return rewardValue;
-    } else {
-        rewardValue = 0.0f;
-        std::cout << "Parking fail " << "Reward: " << rewardValue << std::endl;
-        return rewardValue;
+// write the current observation as OBS_FLAT_SIZE floats
+// ------------------------------------------------------------------------
+void ParkingEnv::writeObservation(float* out) const noexcept {
+    std::array<Position2D, 4> corners;
+    carTransform.applyInverseN(slotCornersWorld.data(), corners.data(), 4);
+    for (int k = 0; k < 4; ++k) {
+        out[2 * k] = corners[k].x;
+        out[2 * k + 1] = corners[k].y;
     }
+    out[8] = vehicleState.pos.x;
+    out[9] = vehicleState.pos.y;
+    out[10] = vehicleState.psi;
+    out[11] = vehicleState.velocity;
+    out[12] = vehicleState.delta;
 }
 
-// set the parking lot location randomly
+// reset the environement to initial state
 // ------------------------------------------------------------------------
-Position2D ParkingEnv::setParkingPos(float minX, float maxX, float minY, float maxY) {
-    float x = randomizer->randFloat(minX, maxX);
-    float y = randomizer->randFloat(minY, maxY);
-    return {x, y};
-};
+void ParkingEnv::reset() {
+    // one batched draw from this env's stream: slot x, slot y, slot yaw, car margin x, car margin y
+    randomizer->setStream(envIndex, episodeIndex++);
+    float u[SPAWN_DRAW_COUNT];
+    randomizer->fillUniform(u, SPAWN_DRAW_COUNT, 0.0f, 1.0f);
+
+    if (lot && lot->sampleStart(u, vehicleState, targetSlot)) {
+        // car on an aisle of the lot, target is the nearest free slot
+        const ParkingSlot& slot = lot->getSlots()[targetSlot];
+        parkingPos = slot.pose.t;
+        parkingYaw = slot.yaw;
+        slotTransform = slot.pose;
+    } else {
+        // random positions and yaw for parking, yaw is either 0 or 90 degree
+        parkingPos = {SLOT_SPAWN_X_MIN + u[0] * (SLOT_SPAWN_X_MAX - SLOT_SPAWN_X_MIN),
+                      SLOT_SPAWN_Y_MIN + u[1] * (SLOT_SPAWN_Y_MAX - SLOT_SPAWN_Y_MIN)};
+        parkingYaw = (u[2] < 0.5f) ? 0.0f : PI * 0.5f;
+        slotTransform = Transform2D::fromPose(parkingPos, parkingYaw);
+        targetSlot = -1;
+
+        // random positions for car around the parking lot
+        const Position2D randCarPos = {parkingPos.x + CAR_SPAWN_MARGIN * (2.0f * u[3] - 1.0f),
+                                       parkingPos.y + CAR_SPAWN_MARGIN * (2.0f * u[4] - 1.0f)};
+
+        // set the car state, the observation is computed from it on demand (observe)
+        vehicleState = VehicleState{};
+        vehicleState.pos = randCarPos;
+    }
+    slotCornersWorld = calculateRelCorners(Transform2D{}, slotTransform);
+    rewardValue = 0.0f;
+    episodeStep = 0;
+    lastResult = StepResult{};
+    updateCarTransform();
+    updateSensors();
+}
 
-// return yaw either 0 or 90 degree
+// refresh the cached car transform
 // ------------------------------------------------------------------------
-float ParkingEnv::setParkingYaw() {
-    const int k = randomizer->randInt(0, 1);  // Currently yaw degree shall be 0 or 90 degree
-    float yawDeg = (k == 0) ? 0.0f : 90.0f;
-    return yawDeg * PI / 180.0f;
+void ParkingEnv::updateCarTransform() noexcept {
+    carTransform = Transform2D::fromPose(vehicleState.pos, vehicleState.psi);
 }
 
-// rotate car poistion into the parking lot frame
+// set up the lidar
 // ------------------------------------------------------------------------
-Position2D ParkingEnv::worldToSlot(const Position2D& carPos, const Position2D& slotPos, float slotYaw) {
-    const float dx = carPos.x - slotPos.x;
-    const float dy = carPos.y - slotPos.y;
-
-    const float c = cosf(slotYaw);
-    const float s = sinf(slotYaw);
-
-    return Position2D{
-        c * dx + s * dy,
-        -s * dx + c * dy
-    };
+void ParkingEnv::setRangeSensor(const RangeSensorConfig& config) {
+    rangeSensor.configure(config);
+    ranges.assign(static_cast<std::size_t>(rangeSensor.getBeams()), rangeSensor.getMaxRange());
+    updateSensors();
 }
 
-// transform global coordinate to local(car) coordinate system
+// set up the bird's-eye-view image
 // ------------------------------------------------------------------------
-Position2D ParkingEnv::worldToCar(float x, float y, const Position2D carPos, float heading) {
-    // Translate the point to the new origin
-    x -= carPos.x;
-    y -= carPos.y;
-
-    // Rotate the point based on the heading
-    // float angle = heading + PI * 0.5f;
-    const float c = cosf(-heading);
-    const float s = sinf(-heading);
-
-    return Position2D{ x * c - y * s, x * s + y * c };
+void ParkingEnv::setBevRaster(const BevConfig& config) {
+    bevRasterizer.configure(config);
+    bev.assign(bevRasterizer.imageSize(), 0);
+    updateSensors();
 }
 
-// rotate a vector counter-clockwise by yaw angle
+// return reward based on parking-success check
 // ------------------------------------------------------------------------
-Position2D ParkingEnv::rotateCCW(const Position2D& vec, float yaw) {
-    const float c = cosf(yaw);
-    const float s = sinf(yaw);
-    return Position2D{ vec.x * c - vec.y * s, vec.x * s + vec.y * c };
+float ParkingEnv::reward() {
+    // check parking success
+    const bool parkingSuccess = isParked(vehicleState.pos, vehicleState.psi, slotTransform);
+
+    // TODO: reward shaping can be added here later
+    if (parkingSuccess) {
+        rewardValue = 1.0f;
+        CAR_LOG_DEBUG("Parking success, reward: %.1f", rewardValue);
+        return rewardValue;
+    } else {
+        rewardValue = 0.0f;
+        CAR_LOG_DEBUG("Parking fail, reward: %.1f", rewardValue);
+        return rewardValue;
+    }
 }
 
 // calculate the local coordinate system of the car from the parking lot corners to the center of the car
 // ------------------------------------------------------------------------
-std::array<Position2D, 4> ParkingEnv::calculateRelCorners(const Position2D& carPos, float carYaw, const Position2D& parkingPos, float parkingYaw) {
+std::array<Position2D, 4> ParkingEnv::calculateRelCorners(const Transform2D& car, const Transform2D& slot) const noexcept {
 
     // 1: Define the parking lot corners in the parking slot frame
     const float halfLen = PARKING_LENGTH * 0.5f;
@@ -132,25 +191,13 @@ std::array<Position2D, 4> ParkingEnv::calculateRelCorners(const Position2D& carP
         Position2D{-halfWid,  halfLen}   // corner 4: front-left
     };
 
+    // 2: Rotate/translate them into the world frame
     std::array<Position2D, 4> carFrameCorners;
-    for (int i = 0; i < 4; ++i) {
-        // 2: Rotate/translate them into the world frame
-        const Position2D cornerWorld = parkingPos + rotateCCW(cornerSlot[i], parkingYaw);
-
-        // debug
-        // std::cout << "Corner " << (i + 1) << " in world frame: "
-        //           << "(" << cornerWorld.x << ", " << cornerWorld.y << ")\n";
-        
-        // 3: Transform them into the car frame
-        carFrameCorners[i] = worldToCar(cornerWorld.x, cornerWorld.y, carPos, carYaw);
-    }
-    // debug
-    //std::cout << "Car frame corners: "
-    //          << "(" << carFrameCorners[0].x << ", " << carFrameCorners[0].y << "), "
-    //          << "(" << carFrameCorners[1].x << ", " << carFrameCorners[1].y << "), "
-    //          << "(" << carFrameCorners[2].x << ", " << carFrameCorners[2].y << "), "
-    //          << "(" << carFrameCorners[3].x << ", " << carFrameCorners[3].y << ")\n";
-    
+    slot.applyN(cornerSlot.data(), carFrameCorners.data(), 4);
+
+    // 3: Transform them into the car frame
+    car.applyInverseN(carFrameCorners.data(), carFrameCorners.data(), 4);
+
     // TODO: need to normalize the observation later for RL training purpose
     return carFrameCorners;
 }
@@ -163,8 +210,8 @@ std::array<Position2D, 4> ParkingEnv::calculateRelCorners(const Position2D& carP
  * It works entirely in the parking slot frame:
  *
  *  1. Transform the car center from world frame into the parking slot frame
- *     using worldToSlot(carPos, parkingPos, parkingYaw).
- *  2. Compute the relative heading error psiRel = wrapPi(carYaw - parkingYaw).
+ *     using slot.applyInverse(car.t).
+ *  2. Compute the relative heading error psiRel from the relative transform slot^-1 * car.
  *  3. Apply simple tolerances on position and yaw:
  *       - |rel.x| <= PARK_LONG_TOL   (along slot axis / length direction)
  *       - |rel.y| <= PARK_LAT_TOL    (sideways within the slot)
@@ -174,32 +221,30 @@ std::array<Position2D, 4> ParkingEnv::calculateRelCorners(const Position2D& carP
  * ignores yawOk in the returned result, but yawOk is computed and logged and
  * can be enabled later (for example, for RL reward shaping).
  *
- * @param carPos      Car center position in world frame [meters].
- * @param carYaw      Car heading in world frame [radians, CCW+, x-forward].
- * @param parkingPos  Parking slot center in world frame [meters].
- * @param parkingYaw  Parking slot orientation in world frame [radians].
+ * @param car         Car frame -> world frame (center, heading CCW+, x-forward).
+ * @param slot        Parking slot frame -> world frame.
  *
  * @return true if the car center lies within the configured longitudinal and
  *         lateral tolerances of the parking slot center (posOk).
  *         false otherwise.
  */
-bool ParkingEnv::isParkedAtCenter(const Position2D& carPos, const float carYaw, const Position2D& parkingPos, const float& parkingYaw) {
+bool ParkingEnv::isParkedAtCenter(const Transform2D& car, const Transform2D& slot) const noexcept {
 
-    // car center in slot frame
-    Position2D rel = worldToSlot(carPos, parkingPos, parkingYaw);
+    // car pose in slot frame
+    const Transform2D rel = slot.inverse().compose(car);
 
     // heading error in slot frame
-    const float psiRel = wrapPi(carYaw - parkingYaw);
+    const float psiRel = rel.yaw();
     
     // position tolerances (slot frame)
-    const bool posOk = std::fabs(rel.x) <= PARK_LONG_TOL && std::fabs(rel.y) <= PARK_LAT_TOL;
+    const bool posOk = std::fabs(rel.t.x) <= PARK_LONG_TOL && std::fabs(rel.t.y) <= PARK_LAT_TOL;
 
     // yaw tolerance
     const bool yawOk = std::fabs(psiRel) <= PARK_YAW_TOL;
 
     // debug
-    // std::cout << "Slot frame: rel.x=" << rel.x
-    // << " rel.y=" << rel.y
+    // std::cout << "Slot frame: rel.x=" << rel.t.x
+    // << " rel.y=" << rel.t.y
     // << " |psiRel|=" << std::fabs(psiRel)
     // << " |yaw|=" << PARK_YAW_TOL
     // << " posOk=" << posOk
@@ -208,9 +253,9 @@ bool ParkingEnv::isParkedAtCenter(const Position2D& carPos, const float carYaw,
     // temporarily only position is used to check parking success
     // if (posOk && yawOk) {
     if (posOk) {
-        std::cout << "Car is at the center of the parking lot!" << std::endl;
+        CAR_LOG_DEBUG("Car is at the center of the parking lot");
     } else {
-        std::cout << "Not at the center of the parking lot" << std::endl;
+        CAR_LOG_DEBUG("Not at the center of the parking lot");
     }
     
     return posOk; //&& yawOk; 
@@ -231,18 +276,17 @@ bool ParkingEnv::isParkedAtCenter(const Position2D& carPos, const float carYaw,
  *       - Y-axis to the left of X (slot width direction)
  *
  *  3. Transform the car center from world frame into the slot frame:
- *       rel = worldToSlot(carPos, parkingPos, parkingYaw)
+ *       rel = slot^-1 * car   (Transform2D, translation rel.t)
  *
- *  4. Compute the car orientation relative to the slot:
- *       psiRel = wrapPi(carYaw - parkingYaw)
- *       (cRel, sRel) = (cos(psiRel), sin(psiRel))
+ *  4. The car orientation relative to the slot comes with it, without trig:
+ *       (cRel, sRel) = (rel.c, rel.s) = (cos(carYaw - parkingYaw), sin(carYaw - parkingYaw))
  *
  *  5. Construct the four car corners in car-local frame:
  *       (±halfCarLen, ±halfCarWid)
  *     and transform each corner into slot frame via:
  *
- *       [x']   [  cRel  -sRel ] [local.x] + rel.x
- *       [y'] = [  sRel   cRel ] [local.y] + rel.y
+ *       [x']   [  cRel  -sRel ] [local.x] + rel.t.x
+ *       [y'] = [  sRel   cRel ] [local.y] + rel.t.y
  *
  *  6. For each transformed corner (x', y'), check that it lies within the
  *     slot half-extent:
@@ -255,86 +299,39 @@ bool ParkingEnv::isParkedAtCenter(const Position2D& carPos, const float carYaw,
  * Because both car and slot are handled in arbitrary orientations, this
  * works for 0°, 90°, 180°, 270° slots and any car heading in [-π, π].
  *
+ * Cars whose center is farther from the slot center than the slot half diagonal
+ * are rejected first, before the car cos/sin are computed.
+ *
  * @param carPos      Car center position in world frame [meters].
  * @param carYaw      Car heading in world frame [radians, CCW+, x-forward].
- * @param parkingPos  Parking slot center in world frame [meters].
- * @param parkingYaw  Parking slot orientation in world frame [radians].
+ * @param slot        Parking slot frame -> world frame (cached at reset).
  *
  * @return true if all four car corners are inside the parking slot rectangle
  *         in the slot frame; false otherwise.
  */
-bool ParkingEnv::isParked(const Position2D& carPos, float carYaw, const Position2D& parkingPos, float parkingYaw) {
+bool ParkingEnv::isParked(const Position2D& carPos, float carYaw, const Transform2D& slot) const noexcept {
 
     // This code will be used for RL
     // return false if the car is not at the center of the parking lot
-    // if (!(isParkedAtCenter(carPos, carYaw, parkingPos, parkingYaw))) {
+    // if (!(isParkedAtCenter(Transform2D::fromPose(carPos, carYaw), slot))) {
     //     return false;
     // }
-    
-    // calculate half sizes (meters)
-    const float halfCarLen = CAR_LENGTH * 0.5f;       // along car local x (forward)
-    const float halfCarWid = CAR_WIDTH  * 0.5f;       // along car local y (left)
-    const float halfSlotLen = PARKING_LENGTH * 0.5f;  // along slot local X
-    const float halfSlotWid = PARKING_WIDTH  * 0.5f;  // along slot local Y
-
-    // Car center in slot frame
-    // Define slot frame: origin at parkingPos, X along parkingYaw, Y left of X
-    const float dx = carPos.x - parkingPos.x;
-    const float dy = carPos.y - parkingPos.y;
-
-    const float cSlot = std::cos(parkingYaw);
-    const float sSlot = std::sin(parkingYaw);
-
-    // Rotate world -> slot frame
-    // [ X_slot ]   [  cos  sin ] [ dx ]
-    // [ Y_slot ] = [ -sin  cos ] [ dy ]
-    Position2D rel;
-    rel.x =  cSlot * dx + sSlot * dy;  // along slot length
-    rel.y = -sSlot * dx + cSlot * dy;  // along slot width
-
-    // Car orientation relative to slot
-    const float psiRel = wrapPi(carYaw - parkingYaw);
-    const float cRel   = std::cos(psiRel);
-    const float sRel   = std::sin(psiRel);
-
-    // Car corners in *car* local frame (x forward, y left) in CW order
-    // Four corners: (±halfLen, ±halfWid)
-    std::array<Position2D, 4> carLocalCorners = {{
-        { +halfCarLen, +halfCarWid },  // corner 1: front-right
-        { +halfCarLen, -halfCarWid },  // corner 2: rear-right
-        { -halfCarLen, -halfCarWid },  // corner 3: rear-left
-        { -halfCarLen, +halfCarWid }   // corner 4: front-left
-    }};
-
-    // Transform each car corner into slot frame and test
-    for (const auto& local : carLocalCorners) {
-        // Rotate corner from car frame -> slot frame
-        // [x']   [  cRel  -sRel ] [local.x]
-        // [y'] = [  sRel   cRel ] [local.y]
-        const float cx = local.x;
-        const float cy = local.y;
-
-        const float vx = rel.x + (cRel * cx - sRel * cy);
-        const float vy = rel.y + (sRel * cx + cRel * cy);
-
-        const bool insideX = std::fabs(vx) <= halfSlotLen;
-        const bool insideY = std::fabs(vy) <= halfSlotWid;
-
-        if (!insideX || !insideY) {
-            // at least one corner is outside → not parked
-            // std::cout << "Not parked" << std::endl;
-            return false;
-        }
-    }
 
-    // all 4 corners are inside the slot box in slot frame → parked
-    // std::cout << "Parked" << std::endl;
-    return true;
+    // the geometry is shared with VecParkingEnv (see ParkingCheck.h)
+    return isCarInSlot(carPos.x, carPos.y, carYaw, slot);
 }
 
 
-// getter for CI tests
-std::array<Position2D, 4> ParkingEnv::getCalculateRelCorners(const Position2D& carPos, float carYaw, const Position2D& parkingPos, float parkingYaw) {
-    return calculateRelCorners(carPos, carYaw, parkingPos, parkingYaw);
+// getters for CI tests and benchmarks
+std::array<Position2D, 4> ParkingEnv::getCalculateRelCorners(const Position2D& carPos, float carYaw, const Position2D& parkingPos, float parkingYaw) const {
+    return calculateRelCorners(Transform2D::fromPose(carPos, carYaw), Transform2D::fromPose(parkingPos, parkingYaw));
+}
+
+bool ParkingEnv::getIsParked(const Position2D& carPos, float carYaw, const Position2D& parkingPos, float parkingYaw) const {
+    return isParked(carPos, carYaw, Transform2D::fromPose(parkingPos, parkingYaw));
+}
+
+bool ParkingEnv::getIsParkedAtCenter(const Position2D& carPos, float carYaw, const Position2D& parkingPos, float parkingYaw) const {
+    return isParkedAtCenter(Transform2D::fromPose(carPos, carYaw), Transform2D::fromPose(parkingPos, parkingYaw));
 }
 
@@ -1,15 +1,24 @@
 #ifndef PARKINGENV_H
 #define PARKINGENV_H
 
-#include <iostream>
 #include <string>
+#include <algorithm>
 #include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
 
 #include "ParkingParams.h"
+#include "ParkingCheck.h"
 #include "../core/Config.h"
+#include "../sensors/BevRasterizer.h"
+#include "../sensors/RangeSensor.h"
+#include "../utilities/Logger.h"
 #include "../utilities/Randomizer.h" 
+#include "../utilities/Transform2D.h"
 #include "../vehicledynamics/VehicleTypes.h"
 #include "../vehicledynamics/BicycleModel.h"
+#include "../world/ParkingLot.h"
 
 
 // forward declarations at global scope
@@ -26,6 +35,20 @@ struct Observation {
     VehicleState vehicleState;
 };
 
+// flat observation written by ParkingEnv::writeObservation, OBS_FLAT_SIZE floats:
+// [0..7] slot corners in the car frame (x1, y1, ..., x4, y4), [8] x, [9] y, [10] psi, [11] velocity, [12] delta
+constexpr std::size_t OBS_FLAT_SIZE = 13;
+
+// step outcome besides the observation
+struct StepResult {
+    float reward{0.0f};       // summed over the physics substeps: 1 if parked, -COLLISION_PENALTY on a collision, 0 otherwise
+    bool done{false};         // terminated || truncated, the episode is over and the env must be reset
+    bool terminated{false};   // the car parked, collided or left the lot bounds
+    bool collided{false};     // the car body touched a parked car or a curb of the lot (only with a lot)
+    bool truncated{false};    // the episode reached the max episode steps without terminating
+    int substeps{0};          // physics substeps run, less than the action repeat if the episode terminated early
+};
+
 /**
  * Parking Env Class
  * ---------------------------
@@ -40,15 +63,51 @@ public:
     /** 
      * @brief Step the environment by one time step, given an action. 
      * This function advance the world by a fixed amount of simulated time, 
-     * then return observation for now. (reward, done, info, etc will be added later).
+     * then return observation for now. The action is clamped to the model limits in place.
      * 
      * @return Observation
      */
     Observation step(Action&action, const float& simDt);
+
+    /**
+     * @brief Step the environment by one time step and write the results into caller buffers.
+     *
+     * Same dynamics and reward as step(), without copies or allocations. The action is not modified.
+     * With an action repeat K (setActionRepeat) one call runs up to K physics substeps of simDt with the
+     * same action. The parking and lot bounds checks run after each substep (far-away cars are rejected
+     * without trig) and stop the substeps once the episode terminates; the observation is built once at the end.
+     * The episode terminates when the car parks, its center leaves the lot bounds or, with a lot (setLot),
+     * its body touches an obstacle (ParkingLot::carCollides, checked after each substep), and is truncated
+     * after the max episode steps (setMaxEpisodeSteps, counted in step calls, 0 = no limit).
+     * With a range sensor (setRangeSensor) the lidar ranges (getRanges) are refreshed once at the end,
+     * likewise the bird's-eye-view image (setBevRaster, getBev).
+     *
+     * @param[in] action: action (clamped internally)
+     * @param[in] simDt: time step [s]
+     * @param[out] out: observation after the step
+     * @param[out] result: reward and done flag
+     * @return void
+     */
+    void stepInto(const Action& action, float simDt, Observation& out, StepResult& result) noexcept;
+
+    // same as above, the observation is written as OBS_FLAT_SIZE floats (see writeObservation)
+    void stepInto(const Action& action, float simDt, float* out, StepResult& result) noexcept;
+
+    // write the current observation
+    void observe(Observation& out) const noexcept;
+
+    // write the current observation as OBS_FLAT_SIZE floats, e.g. into a row of a training batch
+    void writeObservation(float* out) const noexcept;
     
     /**
      * @brief Reset the environment to an initial state and return observation.
      * 
+     * The random draws come from the Randomizer stream (envIndex, episodeIndex), then episodeIndex
+     * is incremented, so the n-th reset of an env is reproducible for a given seed.
+     * The episode step counter starts again at 0.
+     * Without a lot a single slot is placed at random in empty space; with a lot (setLot) the car
+     * starts on an aisle and the target is the nearest free slot (ParkingLot::sampleStart).
+     * 
      * @return Observation
      * 
     */
@@ -62,13 +121,41 @@ public:
     float reward();
 
     // getter 
-    Observation getObservation() const { return observation; }
-    VehicleState getVehicleState() const { return vehicleState; }
-    Position2D getParkingPos() const { return parkingPos; }
-    float getParkingYaw() const { return parkingYaw; }
-
-    // getter for CI tests
-    std::array<Position2D, 4> getCalculateRelCorners(const Position2D& carPos, float carYaw, const Position2D& parkingPos, float parkingYaw);
+    Observation getObservation() const { Observation out; observe(out); return out; }
+    const VehicleState& getVehicleState() const noexcept { return vehicleState; }
+    float getReward() const noexcept { return rewardValue; }
+    const Position2D& getParkingPos() const noexcept { return parkingPos; }
+    float getParkingYaw() const noexcept { return parkingYaw; }
+    uint64_t getEnvIndex() const { return envIndex; }
+    uint64_t getEpisodeIndex() const { return episodeIndex; }
+    VehicleModel getVehicleModel() const noexcept { return vehicleModel; }
+    int getActionRepeat() const noexcept { return actionRepeat; }
+    std::size_t getMaxEpisodeSteps() const noexcept { return maxEpisodeSteps; }
+    std::size_t getEpisodeStep() const noexcept { return episodeStep; }
+    const StepResult& getLastResult() const noexcept { return lastResult; }
+    KinematicIntegrator getIntegrator() const noexcept { return bicycleModel.getIntegrator(); }
+    const ParkingLot* getLot() const noexcept { return lot; }
+    int getTargetSlot() const noexcept { return targetSlot; }
+    const RangeSensor& getRangeSensor() const noexcept { return rangeSensor; }
+    const float* getRanges() const noexcept { return ranges.data(); }  // getRangeSensor().getBeams() ranges [m] of the current state
+    const BevRasterizer& getBevRasterizer() const noexcept { return bevRasterizer; }
+    const uint8_t* getBev() const noexcept { return bev.data(); }  // getBevRasterizer().imageSize() bytes, C x H x W image of the current state
+
+    // setter
+    void setEnvIndex(uint64_t index) { envIndex = index; }
+    void setEpisodeIndex(uint64_t index) { episodeIndex = index; }
+    void setVehicleModel(VehicleModel model) noexcept { vehicleModel = model; }
+    void setActionRepeat(int repeat) noexcept { actionRepeat = std::max(repeat, 1); }  // physics substeps per step/stepInto call
+    void setMaxEpisodeSteps(std::size_t steps) noexcept { maxEpisodeSteps = steps; }  // 0 = no time limit
+    void setIntegrator(KinematicIntegrator mode) noexcept { bicycleModel.setIntegrator(mode); }  // use Arc for simDt >= 0.05
+    void setLot(const ParkingLot* newLot) noexcept { lot = newLot; }  // shared, read-only lot, nullptr = single slot; applies from the next reset
+    void setRangeSensor(const RangeSensorConfig& config);  // lidar against the lot obstacles, beams = 0 turns it off
+    void setBevRaster(const BevConfig& config);            // bird's-eye-view image, width or height = 0 turns it off
+
+    // getter for CI tests and benchmarks
+    std::array<Position2D, 4> getCalculateRelCorners(const Position2D& carPos, float carYaw, const Position2D& parkingPos, float parkingYaw) const;
+    bool getIsParked(const Position2D& carPos, float carYaw, const Position2D& parkingPos, float parkingYaw) const;
+    bool getIsParkedAtCenter(const Position2D& carPos, float carYaw, const Position2D& parkingPos, float parkingYaw) const;
 
     
 private:
@@ -77,7 +164,6 @@ private:
     std::array<float, 2> actionSpace;       // the dimention of the action
     std::array<float, 2> observationSpace;  // state information
 
-    Observation observation{};              // current observation
     float rewardValue{0.0f};                // reward value
 
     // car attributes
@@ -86,36 +172,39 @@ private:
     // Parking lot attributes
     Position2D parkingPos{0.0f, 0.0f};      // parking lot position
     float parkingYaw{0.0f};                 // parking lot yaw
+    const ParkingLot* lot{nullptr};         // multi-slot world, not owned
+    int targetSlot{-1};                     // index of the target slot in lot, -1 without a lot
+
+    // cached transforms: slot at reset(), car after every step, so observe() and the checks need no trig
+    Transform2D slotTransform{};            // slot frame -> world
+    Transform2D carTransform{};             // car frame -> world
+    std::array<Position2D, 4> slotCornersWorld{};  // slot corners in world frame (CW, see calculateRelCorners)
 
     Randomizer* randomizer{nullptr};
+    uint64_t envIndex{0};                   // random stream of this env
+    uint64_t episodeIndex{0};               // random sub-stream of the next reset
     BicycleModel bicycleModel{CAR_LENGTH};
-
-    // helper functions
-    Position2D setParkingPos(float minX, float maxX, float minY, float maxY);
-    float setParkingYaw();
-
-    // transform car position into the parking lot frame
-    Position2D worldToSlot(const Position2D& carPos, const Position2D& slotPos, float slotYaw);
-    
-    /**
-     * @brief transform global coordinate to local(car) coordinate system
-     * 
-     * @param[in] x: Global x coordinate
-     * @param[in] y: Global y coordinate
-     * @param[in] carPos: Car position
-     * @param[in] heading: Car heading angle
-     * @return Position2D: Transformed local car coordinate
-    */
-    Position2D worldToCar(float x, float y, const Position2D carPos, float heading);
-
-    /** 
-     * @brief rotate a vector counter-clockwise by yaw angle
-     * 
-     * @param[in] vec: Input vector
-     * @param[in] yaw: Yaw angle in radians
-     * @return Position2D: Rotated vector
-    */
-    Position2D rotateCCW(const Position2D& vec, float yaw);
+    VehicleModel vehicleModel{VehicleModel::Kinematic};
+    int actionRepeat{1};                    // physics substeps per step
+    std::size_t maxEpisodeSteps{0};         // truncation limit in steps, 0 = none
+    std::size_t episodeStep{0};             // steps since the last reset
+    StepResult lastResult{};                // outcome of the last step
+    RangeSensor rangeSensor;                // lidar, off by default
+    std::vector<float> ranges;              // lidar ranges of the current state
+    BevRasterizer bevRasterizer;            // bird's-eye-view image, off by default
+    std::vector<uint8_t> bev;               // image of the current state
+
+    // apply the action and evaluate the parking check, shared by step() and stepInto()
+    void advance(const Action& action, float simDt, StepResult& result) noexcept;
+
+    // refresh carTransform from vehicleState (one sin/cos pair)
+    void updateCarTransform() noexcept;
+
+    // refresh the lidar ranges and the bird's-eye-view image from carTransform
+    void updateSensors() noexcept {
+        if (rangeSensor.enabled()) rangeSensor.scan(lot, carTransform, ranges.data());
+        if (bevRasterizer.enabled()) bevRasterizer.render(lot, carTransform, slotTransform, bev.data());
+    }
 
     /** 
      * @brief calculate the relative coordinate system of the car from the parking lot corners to the center of the car
@@ -123,22 +212,20 @@ private:
      * local axes: +y forward, +x right
      * There are three main steps:
      * 1: Define the corners in the parking slot frame
-     * 2: Rotate/translate them into the world frame
-     * 3: Transform them into the car frame
+     * 2: Rotate/translate them into the world frame (slot.applyN)
+     * 3: Transform them into the car frame (car.applyInverseN)
      * 
-     * @param[in] carPos: Car position
-     * @param[in] carYaw: Car yaw angle
-     * @param[in] parkingPos: Parking lot position
-     * @param[in] parkingYaw: Parking lot yaw angle
+     * @param[in] car: Car frame -> world transform
+     * @param[in] slot: Parking slot frame -> world transform
      * 
      * @return std::array<Position2D, 4>: The relative coordinate system of the car 
      * 
     */
-    std::array<Position2D, 4> calculateRelCorners(const Position2D& carPos, float carYaw, const Position2D& parkingPos, float parkingYaw);
+    std::array<Position2D, 4> calculateRelCorners(const Transform2D& car, const Transform2D& slot) const noexcept;
 
     // parking check functions
-    bool isParked(const Position2D& carPos, float carYaw, const Position2D& parkingPos, float parkingYaw);
-    bool isParkedAtCenter(const Position2D& carPos, const float carYaw, const Position2D& parkingPos, const float& parkingYaw);
+    bool isParked(const Position2D& carPos, float carYaw, const Transform2D& slot) const noexcept;
+    bool isParkedAtCenter(const Transform2D& car, const Transform2D& slot) const noexcept;
  
 };
 #endif
@@ -9,6 +9,27 @@ constexpr float PARK_LONG_TOL = 1.5f;   // ±1.5 m along slot axis on X axis
 constexpr float PARK_LAT_TOL  = 1.f;    // ±1.0 m sideways on Y axis
 constexpr float PARK_YAW_TOL  = 10.0f * (PI / 180.0f); // 10 deg in rad
 
+// Spawn ranges used by reset() (in world frame, meters)
+constexpr float SLOT_SPAWN_X_MIN = -15.0f;
+constexpr float SLOT_SPAWN_X_MAX =  15.0f;
+constexpr float SLOT_SPAWN_Y_MIN = -10.0f;
+constexpr float SLOT_SPAWN_Y_MAX =  10.0f;
+constexpr float CAR_SPAWN_MARGIN =   5.0f;  // car spawns within ±5 m of the slot center
+constexpr int SPAWN_DRAW_COUNT = 5;         // uniform draws per reset: slot x, slot y, slot yaw, car x, car y
 
+// Reward subtracted when the car body touches an obstacle of the lot (the episode terminates)
+constexpr float COLLISION_PENALTY = 1.0f;
 
-#endif
\ No newline at end of file
+// Lot bounds (in world frame, meters): an episode terminates when the car center leaves them.
+// The lot is the area shown by the default window (800 x 600 px at 20 px/m).
+constexpr float LOT_X_MIN = -20.0f;
+constexpr float LOT_X_MAX =  20.0f;
+constexpr float LOT_Y_MIN = -15.0f;
+constexpr float LOT_Y_MAX =  15.0f;
+static_assert(SLOT_SPAWN_X_MIN - CAR_SPAWN_MARGIN >= LOT_X_MIN && SLOT_SPAWN_X_MAX + CAR_SPAWN_MARGIN <= LOT_X_MAX &&
+              SLOT_SPAWN_Y_MIN - CAR_SPAWN_MARGIN >= LOT_Y_MIN && SLOT_SPAWN_Y_MAX + CAR_SPAWN_MARGIN <= LOT_Y_MAX,
+              "cars must spawn inside the lot");
+
+
+
+#endif
@@ -0,0 +1,198 @@
+#include "VecParkingEnv.h"
+
+#include "../utilities/FastMath.h"
+
+
+// constructor
+// ------------------------------------------------------------------------
+VecParkingEnv::VecParkingEnv(std::size_t numEnvs, Randomizer* randomizer, float simDt)
+    : numEnvs(numEnvs), simDt(simDt), randomizer(randomizer),
+      x(numEnvs, 0.0f), y(numEnvs, 0.0f), psi(numEnvs, 0.0f), v(numEnvs, 0.0f), delta(numEnvs, 0.0f),
+      vy(numEnvs, 0.0f), yawRate(numEnvs, 0.0f),
+      slotX(numEnvs, 0.0f), slotY(numEnvs, 0.0f), slotYaw(numEnvs, 0.0f),
+      slotCos(numEnvs, 1.0f), slotSin(numEnvs, 0.0f), targetSlot(numEnvs, -1), episodeIndex(numEnvs, 0),
+      episodeStep(numEnvs, 0), finalObs(numEnvs), terminatedScratch(numEnvs, 0), truncatedScratch(numEnvs, 0),
+      contact(numEnvs, 0), collided(numEnvs, 0) {};
+
+// step all environments by one time step
+// ------------------------------------------------------------------------
+void VecParkingEnv::step(const Action* actions, Observation* out, float* rewards, uint8_t* terminated, uint8_t* truncated) {
+    const VehicleStateSoA state{x.data(), y.data(), psi.data(), v.data(), delta.data(), numEnvs, vy.data(), yawRate.data()};
+    std::fill(rewards, rewards + numEnvs, 0.0f);
+    std::fill(terminated, terminated + numEnvs, uint8_t{0});
+    std::fill(collided.begin(), collided.end(), uint8_t{0});
+
+    for (int k = 0; k < actionRepeat; ++k) {
+        // apply the actions to all vehicles at once (kinematic: SIMD path selected at runtime)
+        if (vehicleModel == VehicleModel::Dynamic) bicycleModel.dynamicActBatch(actions, state, simDt);
+        else bicycleModel.kinematicActBatch(actions, state, simDt);
+
+        // collisions of all cars against the lot in one batch
+        if (lot) lot->collideBatch(x.data(), y.data(), psi.data(), numEnvs, contact.data());
+
+        // reward and termination, a terminated env keeps its observation from this substep
+        for (std::size_t i = 0; i < numEnvs; ++i) {
+            if (terminated[i]) continue;
+            const bool parked = isCarInSlot(x[i], y[i], psi[i], slotTransform(i));
+            const bool hit = lot && contact[i];
+            if (!parked && !hit && inLot(i)) continue;
+            rewards[i] += (parked ? 1.0f : 0.0f) - (hit ? COLLISION_PENALTY : 0.0f);
+            terminated[i] = 1;
+            collided[i] = hit ? 1 : 0;
+            observeEnv(i, out[i]);
+        }
+    }
+
+    for (std::size_t i = 0; i < numEnvs; ++i) {
+        if (terminated[i]) {
+            // undo the substeps the batch ran after the env terminated
+            const VehicleState& last = out[i].vehicleState;
+            x[i] = last.pos.x;
+            y[i] = last.pos.y;
+            psi[i] = last.psi;
+            v[i] = last.velocity;
+            delta[i] = last.delta;
+            vy[i] = last.vy;
+            yawRate[i] = last.yawRate;
+        } else {
+            observeEnv(i, out[i]);
+        }
+
+        ++episodeStep[i];
+        truncated[i] = (!terminated[i] && maxEpisodeSteps != 0 && episodeStep[i] >= maxEpisodeSteps) ? 1 : 0;
+
+        // re-randomize only the finished envs, without a round trip through the caller
+        if (autoReset && (terminated[i] || truncated[i])) {
+            finalObs[i] = out[i];
+            resetEnv(i);
+            observeEnv(i, out[i]);
+        }
+    }
+
+    // lidar of every env in one pass
+    if (rangeSensor.enabled()) rangeSensor.scanBatch(lot, x.data(), y.data(), psi.data(), numEnvs, ranges.data());
+    renderBev(0, numEnvs);
+}
+
+// step all environments, one done flag per env
+// ------------------------------------------------------------------------
+void VecParkingEnv::step(const Action* actions, Observation* out, float* rewards, uint8_t* dones) {
+    step(actions, out, rewards, terminatedScratch.data(), truncatedScratch.data());
+    for (std::size_t i = 0; i < numEnvs; ++i) {
+        dones[i] = terminatedScratch[i] | truncatedScratch[i];
+    }
+}
+
+// reset all environments
+// ------------------------------------------------------------------------
+void VecParkingEnv::reset() {
+    for (std::size_t i = 0; i < numEnvs; ++i) {
+        resetEnv(i);
+    }
+}
+
+// reset a single environment, same distribution as ParkingEnv::reset
+// ------------------------------------------------------------------------
+void VecParkingEnv::resetEnv(std::size_t i) {
+    // one batched draw from this env's stream: slot x, slot y, slot yaw, car margin x, car margin y
+    randomizer->setStream(i, episodeIndex[i]++);
+    float u[SPAWN_DRAW_COUNT];
+    randomizer->fillUniform(u, SPAWN_DRAW_COUNT, 0.0f, 1.0f);
+
+    VehicleState start;
+    if (lot && lot->sampleStart(u, start, targetSlot[i])) {
+        // car on an aisle of the lot, target is the nearest free slot
+        const ParkingSlot& slot = lot->getSlots()[targetSlot[i]];
+        slotX[i] = slot.pose.t.x;
+        slotY[i] = slot.pose.t.y;
+        slotYaw[i] = slot.yaw;
+        slotCos[i] = slot.pose.c;
+        slotSin[i] = slot.pose.s;
+        x[i] = start.pos.x;
+        y[i] = start.pos.y;
+        psi[i] = start.psi;
+    } else {
+        // random positions and yaw for parking, yaw is either 0 or 90 degree
+        slotX[i] = SLOT_SPAWN_X_MIN + u[0] * (SLOT_SPAWN_X_MAX - SLOT_SPAWN_X_MIN);
+        slotY[i] = SLOT_SPAWN_Y_MIN + u[1] * (SLOT_SPAWN_Y_MAX - SLOT_SPAWN_Y_MIN);
+        slotYaw[i] = (u[2] < 0.5f) ? 0.0f : PI * 0.5f;
+        slotCos[i] = std::cos(slotYaw[i]);
+        slotSin[i] = std::sin(slotYaw[i]);
+        targetSlot[i] = -1;
+
+        // random positions for car around the parking lot
+        x[i] = slotX[i] + CAR_SPAWN_MARGIN * (2.0f * u[3] - 1.0f);
+        y[i] = slotY[i] + CAR_SPAWN_MARGIN * (2.0f * u[4] - 1.0f);
+        psi[i] = 0.0f;
+    }
+    v[i] = 0.0f;
+    delta[i] = 0.0f;
+    vy[i] = 0.0f;
+    yawRate[i] = 0.0f;
+    episodeStep[i] = 0;
+    if (rangeSensor.enabled()) rangeSensor.scanBatch(lot, &x[i], &y[i], &psi[i], 1, ranges.data() + i * rangeSensor.getBeams());
+    renderBev(i, i + 1);
+}
+
+// set up the lidar of all envs
+// ------------------------------------------------------------------------
+void VecParkingEnv::setRangeSensor(const RangeSensorConfig& config) {
+    rangeSensor.configure(config);
+    ranges.assign(numEnvs * static_cast<std::size_t>(rangeSensor.getBeams()), rangeSensor.getMaxRange());
+    if (rangeSensor.enabled()) rangeSensor.scanBatch(lot, x.data(), y.data(), psi.data(), numEnvs, ranges.data());
+}
+
+// set up the bird's-eye-view images of all envs
+// ------------------------------------------------------------------------
+void VecParkingEnv::setBevRaster(const BevConfig& config) {
+    bevRasterizer.configure(config);
+    bev.assign(numEnvs * bevRasterizer.imageSize(), 0);
+    renderBev(0, numEnvs);
+}
+
+// render the images of a range of envs, cos/sin of the headings as in scanBatch
+// ------------------------------------------------------------------------
+void VecParkingEnv::renderBev(std::size_t begin, std::size_t end) noexcept {
+    if (!bevRasterizer.enabled()) return;
+    const std::size_t size = bevRasterizer.imageSize();
+    for (std::size_t i = begin; i < end; ++i) {
+        Transform2D car{1.0f, 0.0f, {x[i], y[i]}};
+        fastSinCos(psi[i], car.s, car.c);
+        bevRasterizer.render(lot, car, slotTransform(i), bev.data() + i * size);
+    }
+}
+
+// write the current observation of every environment
+// ------------------------------------------------------------------------
+void VecParkingEnv::observe(Observation* out) const {
+    for (std::size_t i = 0; i < numEnvs; ++i) {
+        observeEnv(i, out[i]);
+    }
+}
+
+// return the vehicle state of env i
+// ------------------------------------------------------------------------
+VehicleState VecParkingEnv::getVehicleState(std::size_t i) const {
+    return VehicleState{{x[i], y[i]}, psi[i], v[i], delta[i], vy[i], yawRate[i]};
+}
+
+// slot corners relative to the car, same frames as ParkingEnv::calculateRelCorners
+// ------------------------------------------------------------------------
+void VecParkingEnv::observeEnv(std::size_t i, Observation& out) const {
+    const float halfLen = PARKING_LENGTH * 0.5f;
+    const float halfWid = PARKING_WIDTH  * 0.5f;
+
+    // corners in parking slot frame in CW order
+    const float cornerX[4] = { halfWid,  halfWid, -halfWid, -halfWid };
+    const float cornerY[4] = { halfLen, -halfLen, -halfLen,  halfLen };
+
+    const Transform2D slot = slotTransform(i);
+    const Transform2D car = Transform2D::fromPose({x[i], y[i]}, psi[i]);
+
+    for (int k = 0; k < 4; ++k) {
+        // slot frame -> world frame -> car frame
+        out.distCorners[k] = car.applyInverse(slot.apply(Position2D{cornerX[k], cornerY[k]}));
+    }
+
+    out.vehicleState = VehicleState{{x[i], y[i]}, psi[i], v[i], delta[i], vy[i], yawRate[i]};
+}
@@ -0,0 +1,183 @@
+#ifndef VECPARKINGENV_H
+#define VECPARKINGENV_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "ParkingEnv.h"
+#include "ParkingParams.h"
+#include "../core/Config.h"
+#include "../sensors/BevRasterizer.h"
+#include "../sensors/RangeSensor.h"
+#include "../utilities/Randomizer.h"
+#include "../utilities/Transform2D.h"
+#include "../vehicledynamics/VehicleTypes.h"
+#include "../vehicledynamics/BicycleModel.h"
+
+
+/**
+ * Vectorized Parking Env Class
+ * ---------------------------
+ * This class steps N independent parking environments in one call.
+ * Vehicle and slot states are kept in structure-of-arrays (SoA) form so that a batch step
+ * walks contiguous float arrays instead of N separate ParkingEnv objects.
+ *
+ * The dynamics (BicycleModel::kinematicActBatch or dynamicActBatch, the batched forms of kinematicAct
+ * and dynamicAct) and the parking check (isCarInSlot) are the same as in ParkingEnv, so env i of a VecParkingEnv behaves like a
+ * single ParkingEnv up to the polynomial trig error documented in FastMath.h.
+ * All buffers are allocated once in the constructor; step() and reset() do not allocate.
+ */
+class VecParkingEnv {
+public:
+    // constructor
+    // ------------------------------------------------------------------------
+    VecParkingEnv(std::size_t numEnvs, Randomizer* randomizer, float simDt = 0.01f);
+
+    /**
+     * @brief Step all environments by one time step.
+     *
+     * With an action repeat K (setActionRepeat) every env runs up to K physics substeps with its action,
+     * as ParkingEnv::stepInto: an env that terminates stops there (its state is restored to that
+     * substep after the batch), rewards are summed over the substeps and observations are written once.
+     * Termination and truncation follow ParkingEnv (parked, collided or left the lot / max episode steps).
+     * With a lot the collisions of all envs are checked in one ParkingLot::collideBatch call per substep,
+     * getCollided(i) tells whether env i terminated by a collision in the last step.
+     * With a range sensor (setRangeSensor) all envs are scanned once at the end (RangeSensor::scanBatch),
+     * getRanges() then matches out (after auto-reset: the first state of the new episode).
+     * Likewise the bird's-eye-view images (setBevRaster) are rendered into one numEnvs x C x H x W tensor (getBev).
+     *
+     * With auto-reset (setAutoReset) every finished env is reset inside this call: out[i] is then the
+     * first observation of the new episode and the last observation of the finished one is kept in
+     * getFinalObservation(i) until the next step.
+     *
+     * @param[in]  actions: numEnvs actions, one per environment (not modified, clamping is done internally)
+     * @param[out] out: numEnvs observations
+     * @param[out] rewards: numEnvs rewards (1 if parked, -COLLISION_PENALTY on a collision, 0 otherwise)
+     * @param[out] terminated: numEnvs flags (1 if the car parked, collided or left the lot)
+     * @param[out] truncated: numEnvs flags (1 if the episode reached the max episode steps)
+     * @return void
+     */
+    void step(const Action* actions, Observation* out, float* rewards, uint8_t* terminated, uint8_t* truncated);
+
+    // same as above with one flag per env: dones[i] = terminated[i] | truncated[i]
+    void step(const Action* actions, Observation* out, float* rewards, uint8_t* dones);
+
+    /**
+     * @brief Reset all environments to random initial states.
+     *
+     * @return void
+     */
+    void reset();
+
+    /**
+     * @brief Reset a single environment to a random initial state.
+     *
+     * Uses the Randomizer stream (i, episode index of env i) and the same draws as ParkingEnv::reset,
+     * so env i matches a ParkingEnv with setEnvIndex(i) and the same seed.
+     *
+     * @param[in] i: environment index
+     * @return void
+     */
+    void resetEnv(std::size_t i);
+
+    /**
+     * @brief Write the current observation of every environment into out.
+     *
+     * @param[out] out: numEnvs observations
+     * @return void
+     */
+    void observe(Observation* out) const;
+
+    // getter
+    std::size_t size() const noexcept { return numEnvs; }
+    float getSimDt() const noexcept { return simDt; }
+    VehicleState getVehicleState(std::size_t i) const;
+    Position2D getParkingPos(std::size_t i) const { return {slotX[i], slotY[i]}; }
+    float getParkingYaw(std::size_t i) const { return slotYaw[i]; }
+    uint64_t getEpisodeIndex(std::size_t i) const { return episodeIndex[i]; }
+    VehicleModel getVehicleModel() const noexcept { return vehicleModel; }
+    int getActionRepeat() const noexcept { return actionRepeat; }
+    std::size_t getMaxEpisodeSteps() const noexcept { return maxEpisodeSteps; }
+    std::size_t getEpisodeStep(std::size_t i) const { return episodeStep[i]; }
+    bool getAutoReset() const noexcept { return autoReset; }
+    const Observation& getFinalObservation(std::size_t i) const { return finalObs[i]; }
+    const Observation* getFinalObservations() const noexcept { return finalObs.data(); }  // numEnvs last observations, see step()
+    KinematicIntegrator getIntegrator() const noexcept { return bicycleModel.getIntegrator(); }
+    const ParkingLot* getLot() const noexcept { return lot; }
+    int getTargetSlot(std::size_t i) const { return targetSlot[i]; }
+    bool getCollided(std::size_t i) const { return collided[i] != 0; }
+    const RangeSensor& getRangeSensor() const noexcept { return rangeSensor; }
+    const float* getRanges() const noexcept { return ranges.data(); }  // numEnvs x beams lidar ranges [m], row i = env i
+    const float* getRanges(std::size_t i) const { return ranges.data() + i * static_cast<std::size_t>(rangeSensor.getBeams()); }
+    const BevRasterizer& getBevRasterizer() const noexcept { return bevRasterizer; }
+    const uint8_t* getBev() const noexcept { return bev.data(); }  // numEnvs x C x H x W images, image i = env i
+    const uint8_t* getBev(std::size_t i) const { return bev.data() + i * bevRasterizer.imageSize(); }
+
+    // setter
+    void setSimDt(float dt) { simDt = dt; }
+    void setVehicleModel(VehicleModel model) noexcept { vehicleModel = model; }
+    void setActionRepeat(int repeat) noexcept { actionRepeat = std::max(repeat, 1); }  // physics substeps per step
+    void setMaxEpisodeSteps(std::size_t steps) noexcept { maxEpisodeSteps = steps; }  // 0 = no time limit
+    void setAutoReset(bool enabled) noexcept { autoReset = enabled; }
+    void setIntegrator(KinematicIntegrator mode) noexcept { bicycleModel.setIntegrator(mode); }  // use Arc for simDt >= 0.05
+    void setLot(const ParkingLot* newLot) noexcept { lot = newLot; }  // shared, read-only lot, nullptr = single slot; applies from the next reset
+    void setRangeSensor(const RangeSensorConfig& config);  // lidar against the lot obstacles, beams = 0 turns it off
+    void setBevRaster(const BevConfig& config);            // bird's-eye-view images, width or height = 0 turns them off
+
+private:
+    std::size_t numEnvs{0};
+    float simDt{0.01f};
+
+    Randomizer* randomizer{nullptr};
+    BicycleModel bicycleModel{CAR_LENGTH};
+    VehicleModel vehicleModel{VehicleModel::Kinematic};
+    int actionRepeat{1};
+    std::size_t maxEpisodeSteps{0};
+    bool autoReset{false};
+    const ParkingLot* lot{nullptr};  // multi-slot world, not owned
+
+    // vehicle states (SoA), vy and yawRate are only advanced by the dynamic model
+    std::vector<float> x, y, psi, v, delta, vy, yawRate;
+
+    // parking slots (SoA), cos/sin of the slot yaw are cached at reset
+    std::vector<float> slotX, slotY, slotYaw, slotCos, slotSin;
+    std::vector<int> targetSlot;  // slot index in lot, -1 without a lot
+
+    // random sub-stream of the next reset of each env
+    std::vector<uint64_t> episodeIndex;
+
+    // steps since the last reset of each env
+    std::vector<std::size_t> episodeStep;
+
+    // last observation of the episodes finished (and auto-reset) in the last step
+    std::vector<Observation> finalObs;
+
+    // scratch flags for the dones overload of step()
+    std::vector<uint8_t> terminatedScratch, truncatedScratch;
+
+    // collision flags: of the current substep (ParkingLot::collideBatch) and of the last step
+    std::vector<uint8_t> contact, collided;
+
+    // lidar and its ranges, numEnvs x beams
+    RangeSensor rangeSensor;
+    std::vector<float> ranges;
+
+    // bird's-eye-view rasterizer and its images, numEnvs x imageSize()
+    BevRasterizer bevRasterizer;
+    std::vector<uint8_t> bev;
+
+    // render the images of envs [begin, end)
+    void renderBev(std::size_t begin, std::size_t end) noexcept;
+
+    // write observation i into out
+    void observeEnv(std::size_t i, Observation& out) const;
+
+    // slot frame -> world of env i from the cached cos/sin
+    Transform2D slotTransform(std::size_t i) const { return Transform2D{slotCos[i], slotSin[i], {slotX[i], slotY[i]}}; }
+
+    // lot bounds check of env i's car
+    bool inLot(std::size_t i) const { return lot ? lot->contains(x[i], y[i]) : isCarInLot(x[i], y[i]); }
+};
+#endif
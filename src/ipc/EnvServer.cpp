@@ -0,0 +1,161 @@
+#include "EnvServer.h"
+
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "../utilities/Logger.h"
+
+
+// the slabs hold Observation / Action arrays as rows of floats
+static_assert(sizeof(Observation) % sizeof(float) == 0 && alignof(Observation) == alignof(float), "Observation must be a row of floats");
+static_assert(sizeof(Action) == 2 * sizeof(float), "Action must be {acceleration, steeringAngle}");
+static_assert(offsetof(CarEnvShmHeader, request) == 128 && sizeof(CarEnvShmHeader) == 256, "doorbells must sit on their own cache lines");
+
+namespace {
+    constexpr int SERVE_POLL_MS = 100;   // stop() latency while idle
+
+    std::size_t alignUp(std::size_t v) { return (v + 63) & ~std::size_t{63}; }
+}
+
+
+// constructor
+// ------------------------------------------------------------------------
+EnvServer::EnvServer(const EnvServerConfig& newConfig)
+    : config(newConfig), env(newConfig.numEnvs, &randomizer, newConfig.simDt) {
+    if (config.seed != 0) randomizer.seed(config.seed);
+    env.setActionRepeat(config.actionRepeat);
+    env.setMaxEpisodeSteps(config.maxEpisodeSteps);
+    env.setVehicleModel(config.vehicleModel);
+    env.setIntegrator(config.integrator);
+    env.setAutoReset(true);
+
+    // optional multi-slot lot, its occupancy is drawn from the same seed (as CarSimulatorHeadless)
+    if (config.lotAisles > 0) {
+        LotLayout layout;
+        layout.aisles = static_cast<int>(config.lotAisles);
+        layout.slotsPerRow = static_cast<int>(config.lotSlotsPerRow);
+        layout.occupancy = config.lotOccupancy;
+        lot = ParkingLot::generate(layout, randomizer.getSeed());
+        env.setLot(&lot);
+    }
+}
+
+// destructor: unmap and remove the segment
+// ------------------------------------------------------------------------
+EnvServer::~EnvServer() {
+    if (!header) return;
+    munmap(header, segmentSize);
+    shm_unlink(config.name.c_str());
+}
+
+// create the segment and reset the envs
+// ------------------------------------------------------------------------
+bool EnvServer::open() {
+    const std::size_t n = config.numEnvs;
+    const std::size_t obsOffset = alignUp(sizeof(CarEnvShmHeader));
+    const std::size_t actionOffset = alignUp(obsOffset + n * sizeof(Observation));
+    const std::size_t finalObsOffset = alignUp(actionOffset + n * sizeof(Action));
+    const std::size_t rewardOffset = alignUp(finalObsOffset + n * sizeof(Observation));
+    const std::size_t terminatedOffset = alignUp(rewardOffset + n * sizeof(float));
+    const std::size_t truncatedOffset = alignUp(terminatedOffset + n);
+    segmentSize = alignUp(truncatedOffset + n);
+
+    // a segment left by a crashed server would hold stale sequence numbers
+    shm_unlink(config.name.c_str());
+    const int fd = shm_open(config.name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0) {
+        CAR_LOG_ERROR("shm_open(%s) failed: %s", config.name.c_str(), std::strerror(errno));
+        return false;
+    }
+    if (ftruncate(fd, static_cast<off_t>(segmentSize)) != 0) {
+        CAR_LOG_ERROR("ftruncate(%s, %zu) failed: %s", config.name.c_str(), segmentSize, std::strerror(errno));
+        close(fd);
+        shm_unlink(config.name.c_str());
+        return false;
+    }
+    void* base = mmap(nullptr, segmentSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED) {
+        CAR_LOG_ERROR("mmap(%s) failed: %s", config.name.c_str(), std::strerror(errno));
+        shm_unlink(config.name.c_str());
+        return false;
+    }
+
+    // ftruncate zero-fills: sequence numbers, waiters and slabs start at 0
+    header = static_cast<CarEnvShmHeader*>(base);
+    char* bytes = static_cast<char*>(base);
+    header->version = CAR_ENV_SHM_VERSION;
+    header->numEnvs = static_cast<uint32_t>(n);
+    header->obsSize = static_cast<uint32_t>(sizeof(Observation) / sizeof(float));
+    header->actionSize = static_cast<uint32_t>(sizeof(Action) / sizeof(float));
+    header->serverPid = static_cast<int32_t>(getpid());
+    header->totalSize = segmentSize;
+    header->obsOffset = obsOffset;
+    header->actionOffset = actionOffset;
+    header->finalObsOffset = finalObsOffset;
+    header->rewardOffset = rewardOffset;
+    header->terminatedOffset = terminatedOffset;
+    header->truncatedOffset = truncatedOffset;
+
+    obs = reinterpret_cast<Observation*>(bytes + obsOffset);
+    actions = reinterpret_cast<const Action*>(bytes + actionOffset);
+    finalObs = reinterpret_cast<Observation*>(bytes + finalObsOffset);
+    rewards = reinterpret_cast<float*>(bytes + rewardOffset);
+    terminated = reinterpret_cast<uint8_t*>(bytes + terminatedOffset);
+    truncated = reinterpret_cast<uint8_t*>(bytes + truncatedOffset);
+
+    runCommand(CAR_ENV_CMD_RESET);
+    __atomic_store_n(&header->magic, CAR_ENV_SHM_MAGIC, __ATOMIC_RELEASE);
+    CAR_LOG_INFO("car_env_server: %zu envs on %s (%zu bytes)", n, config.name.c_str(), segmentSize);
+    return true;
+}
+
+// answer commands until shutdown or stop()
+// ------------------------------------------------------------------------
+void EnvServer::serve() {
+    if (!header) return;
+    // continue after the last answered command, a client may have rung before serve() started
+    uint32_t seq = __atomic_load_n(&header->response.seq, __ATOMIC_ACQUIRE);
+    while (!stopRequested.load(std::memory_order_relaxed)) {
+        // any new request.seq, not only seq + 1: after a client timeout the next command comes with seq + 2,
+        // the answer carries the seq seen so the client waiting for its latest command gets it
+        if (car_env_doorbell_wait_change(&header->request, &seq, config.spin, SERVE_POLL_MS, 0) != CAR_ENV_OK) continue;
+        const uint32_t command = __atomic_load_n(&header->request.command, __ATOMIC_RELAXED);
+        runCommand(command);
+        ++commandCount;
+        car_env_doorbell_ring(&header->response, seq);
+        if (command == CAR_ENV_CMD_SHUTDOWN) break;
+    }
+}
+
+// run one command on the slabs
+// ------------------------------------------------------------------------
+void EnvServer::runCommand(uint32_t command) {
+    switch (command) {
+    case CAR_ENV_CMD_STEP:
+        env.step(actions, obs, rewards, terminated, truncated);
+        // with auto-reset obs already holds the next episode, keep the last state of the finished ones
+        for (std::size_t i = 0; i < config.numEnvs; ++i) {
+            if (terminated[i] | truncated[i]) finalObs[i] = env.getFinalObservation(i);
+        }
+        break;
+    case CAR_ENV_CMD_RESET:
+        env.reset();
+        env.observe(obs);
+        std::memset(rewards, 0, config.numEnvs * sizeof(float));
+        std::memset(terminated, 0, config.numEnvs);
+        std::memset(truncated, 0, config.numEnvs);
+        break;
+    case CAR_ENV_CMD_PING:
+    case CAR_ENV_CMD_SHUTDOWN:
+        break;
+    default:
+        CAR_LOG_WARN("car_env_server: unknown command %u", command);
+        break;
+    }
+}
@@ -0,0 +1,95 @@
+#ifndef ENVSERVER_H
+#define ENVSERVER_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "car_env_client.h"
+#include "../envs/VecParkingEnv.h"
+#include "../utilities/Randomizer.h"
+#include "../vehicledynamics/BicycleModel.h"
+#include "../world/ParkingLot.h"
+
+
+// settings of car_env_server
+struct EnvServerConfig {
+    std::string name{"/car_env"};           // shm_open name of the segment
+    std::size_t numEnvs{64};                // envs in the batch
+    uint64_t seed{0};                       // global RNG seed, 0 = random seed from std::random_device
+    float simDt{0.01f};                     // fixed simulation step [s]
+    int actionRepeat{1};                    // physics substeps per step
+    std::size_t maxEpisodeSteps{2000};      // truncation limit in steps, 0 = none
+    VehicleModel vehicleModel{VehicleModel::Kinematic};
+    KinematicIntegrator integrator{KinematicIntegrator::Euler};
+    std::size_t lotAisles{0};               // generated parking lot, 0 = single slot in empty space
+    std::size_t lotSlotsPerRow{10};
+    float lotOccupancy{0.5f};
+    int spin{20000};                        // spin iterations on the request doorbell before sleeping
+};
+
+/**
+ * Env Server Class
+ * ---------------------------
+ * Hosts a VecParkingEnv (auto-reset on) behind the shared-memory protocol of car_env_client.h so that
+ * a trainer in another process can step it; a crash of either process does not take the other down.
+ *
+ * The env reads its actions from and writes its observations, rewards and flags into the segment
+ * directly (Observation / Action are plain rows of floats), so a step copies nothing besides the final
+ * observations of the envs that finished. serve() answers one client command at a time until
+ * CAR_ENV_CMD_SHUTDOWN or stop(); the segment is unlinked by the destructor.
+ */
+class EnvServer {
+public:
+    explicit EnvServer(const EnvServerConfig& config);
+    ~EnvServer();
+
+    EnvServer(const EnvServer&) = delete;
+    EnvServer& operator=(const EnvServer&) = delete;
+
+    /** Create the segment and reset the envs
+     * ----------------------------------------------------------------------------
+     * A stale segment of the same name (e.g. left by a crashed server) is replaced.
+     *
+     * @return bool: false if the segment cannot be created (logged)
+     */
+    bool open();
+
+    /** Answer commands until shutdown or stop()
+     * ----------------------------------------------------------------------------
+     * @return void
+     */
+    void serve();
+
+    // make serve() return within ~100 ms, callable from another thread or a signal handler
+    void stop() noexcept { stopRequested.store(true, std::memory_order_relaxed); }
+
+    // getter
+    const EnvServerConfig& getConfig() const noexcept { return config; }
+    std::size_t getCommandCount() const noexcept { return commandCount; }
+
+private:
+    EnvServerConfig config;
+    Randomizer randomizer;
+    ParkingLot lot;
+    VecParkingEnv env;
+
+    CarEnvShmHeader* header{nullptr};       // mapped segment
+    std::size_t segmentSize{0};
+    std::atomic<bool> stopRequested{false};
+    std::size_t commandCount{0};
+
+    // slabs inside the segment
+    Observation* obs{nullptr};
+    Observation* finalObs{nullptr};
+    const Action* actions{nullptr};
+    float* rewards{nullptr};
+    uint8_t* terminated{nullptr};
+    uint8_t* truncated{nullptr};
+
+    // run one command on the slabs
+    void runCommand(uint32_t command);
+};
+
+#endif
@@ -0,0 +1,192 @@
+/* C client of car_env_server and the futex doorbell shared with the server, see car_env_client.h */
+#define _GNU_SOURCE
+#include "car_env_client.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <signal.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define CAR_ENV_CPU_RELAX() _mm_pause()
+#else
+#define CAR_ENV_CPU_RELAX() ((void)0)
+#endif
+
+#define CAR_ENV_DEFAULT_SPIN 20000
+#define CAR_ENV_ALIVE_CHECK_MS 100
+
+struct CarEnvClient {
+    CarEnvShmHeader* header;
+    size_t size;
+    uint32_t seq;       /* last request sequence number */
+    int spin;
+};
+
+
+/* ---- doorbell ---- */
+
+static long futexWait(uint32_t* word, uint32_t expected, const struct timespec* timeout) {
+    /* shared (not FUTEX_PRIVATE_FLAG): the word lives in memory mapped by two processes */
+    return syscall(SYS_futex, word, FUTEX_WAIT, expected, timeout, NULL, 0);
+}
+
+static long futexWake(uint32_t* word) {
+    return syscall(SYS_futex, word, FUTEX_WAKE, 1, NULL, NULL, 0);
+}
+
+static int64_t nowMs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+/* on a single CPU the other side cannot make progress while we spin */
+static int spinUseful(void) {
+    static int cpus = 0;
+    if (cpus == 0) cpus = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    return cpus > 1;
+}
+
+void car_env_doorbell_ring(CarEnvDoorbell* bell, uint32_t value) {
+    /* seq_cst store / load pair with the waiter's waiters store / seq load: one of them sees the other */
+    __atomic_store_n(&bell->seq, value, __ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&bell->waiters, __ATOMIC_SEQ_CST) != 0) futexWake(&bell->seq);
+}
+
+/* wait until bell->seq == *value (exact) or bell->seq != *value (!exact), *value = the seq seen */
+static int waitSeq(CarEnvDoorbell* bell, uint32_t* value, int exact, int spin, int timeoutMs, int32_t alivePid) {
+    if (!spinUseful()) spin = 0;
+    for (int i = 0; i < spin; ++i) {
+        const uint32_t seen = __atomic_load_n(&bell->seq, __ATOMIC_ACQUIRE);
+        if ((seen == *value) == (exact != 0)) {
+            *value = seen;
+            return CAR_ENV_OK;
+        }
+        CAR_ENV_CPU_RELAX();
+    }
+
+    const int64_t deadline = (timeoutMs < 0) ? -1 : nowMs() + timeoutMs;
+    int status = CAR_ENV_OK;
+    __atomic_store_n(&bell->waiters, 1u, __ATOMIC_SEQ_CST);
+    for (;;) {
+        const uint32_t seen = __atomic_load_n(&bell->seq, __ATOMIC_SEQ_CST);
+        if ((seen == *value) == (exact != 0)) {
+            *value = seen;
+            break;
+        }
+
+        int64_t sliceMs = CAR_ENV_ALIVE_CHECK_MS;
+        if (deadline >= 0) {
+            const int64_t left = deadline - nowMs();
+            if (left <= 0) {
+                status = CAR_ENV_ERR_TIMEOUT;
+                break;
+            }
+            if (left < sliceMs) sliceMs = left;
+        }
+        const struct timespec slice = {(time_t)(sliceMs / 1000), (long)(sliceMs % 1000) * 1000000L};
+        /* returns at once if seq != seen, wakes on a ring, or times out after the slice */
+        if (futexWait(&bell->seq, seen, &slice) != 0 && errno == ETIMEDOUT && alivePid > 0) {
+            if (kill(alivePid, 0) != 0 && errno == ESRCH) {
+                status = CAR_ENV_ERR_SERVER_GONE;
+                break;
+            }
+        }
+    }
+    __atomic_store_n(&bell->waiters, 0u, __ATOMIC_SEQ_CST);
+    return status;
+}
+
+int car_env_doorbell_wait(CarEnvDoorbell* bell, uint32_t value, int spin, int timeoutMs, int32_t alivePid) {
+    return waitSeq(bell, &value, 1, spin, timeoutMs, alivePid);
+}
+
+int car_env_doorbell_wait_change(CarEnvDoorbell* bell, uint32_t* seq, int spin, int timeoutMs, int32_t alivePid) {
+    return waitSeq(bell, seq, 0, spin, timeoutMs, alivePid);
+}
+
+
+/* ---- client ---- */
+
+CarEnvClient* car_env_connect(const char* name, int timeoutMs) {
+    const int64_t deadline = nowMs() + (timeoutMs < 0 ? 0 : timeoutMs);
+    for (;;) {
+        /* the server sets the size first and the magic last */
+        const int fd = shm_open(name, O_RDWR, 0);
+        if (fd >= 0) {
+            struct stat st;
+            if (fstat(fd, &st) == 0 && (size_t)st.st_size >= sizeof(CarEnvShmHeader)) {
+                void* base = mmap(NULL, (size_t)st.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+                close(fd);
+                if (base == MAP_FAILED) return NULL;
+
+                CarEnvShmHeader* header = (CarEnvShmHeader*)base;
+                if (__atomic_load_n(&header->magic, __ATOMIC_ACQUIRE) == CAR_ENV_SHM_MAGIC) {
+                    if (header->version != CAR_ENV_SHM_VERSION || header->totalSize != (uint64_t)st.st_size) {
+                        munmap(base, (size_t)st.st_size);
+                        return NULL;
+                    }
+                    CarEnvClient* client = (CarEnvClient*)malloc(sizeof(CarEnvClient));
+                    if (!client) {
+                        munmap(base, (size_t)st.st_size);
+                        return NULL;
+                    }
+                    client->header = header;
+                    client->size = (size_t)st.st_size;
+                    client->seq = __atomic_load_n(&header->request.seq, __ATOMIC_ACQUIRE);
+                    client->spin = CAR_ENV_DEFAULT_SPIN;
+                    return client;
+                }
+                munmap(base, (size_t)st.st_size);
+            } else {
+                close(fd);
+            }
+        }
+        if (nowMs() >= deadline) return NULL;
+        usleep(10000);
+    }
+}
+
+void car_env_disconnect(CarEnvClient* client) {
+    if (!client) return;
+    munmap(client->header, client->size);
+    free(client);
+}
+
+void car_env_set_spin(CarEnvClient* client, int spin) {
+    client->spin = spin < 0 ? 0 : spin;
+}
+
+static int runCommand(CarEnvClient* client, uint32_t command, int timeoutMs) {
+    CarEnvShmHeader* h = client->header;
+    const uint32_t seq = ++client->seq;
+    __atomic_store_n(&h->request.command, command, __ATOMIC_RELAXED);
+    car_env_doorbell_ring(&h->request, seq);
+    return car_env_doorbell_wait(&h->response, seq, client->spin, timeoutMs, h->serverPid);
+}
+
+int car_env_step(CarEnvClient* client, int timeoutMs) { return runCommand(client, CAR_ENV_CMD_STEP, timeoutMs); }
+int car_env_reset(CarEnvClient* client, int timeoutMs) { return runCommand(client, CAR_ENV_CMD_RESET, timeoutMs); }
+int car_env_ping(CarEnvClient* client, int timeoutMs) { return runCommand(client, CAR_ENV_CMD_PING, timeoutMs); }
+int car_env_shutdown(CarEnvClient* client, int timeoutMs) { return runCommand(client, CAR_ENV_CMD_SHUTDOWN, timeoutMs); }
+
+uint32_t car_env_num_envs(const CarEnvClient* client) { return client->header->numEnvs; }
+uint32_t car_env_obs_size(const CarEnvClient* client) { return client->header->obsSize; }
+uint32_t car_env_action_size(const CarEnvClient* client) { return client->header->actionSize; }
+
+#define CAR_ENV_SLAB(client, offset, type) ((type)((char*)(client)->header + (client)->header->offset))
+
+float* car_env_actions(CarEnvClient* client) { return CAR_ENV_SLAB(client, actionOffset, float*); }
+const float* car_env_obs(const CarEnvClient* client) { return CAR_ENV_SLAB(client, obsOffset, const float*); }
+const float* car_env_final_obs(const CarEnvClient* client) { return CAR_ENV_SLAB(client, finalObsOffset, const float*); }
+const float* car_env_rewards(const CarEnvClient* client) { return CAR_ENV_SLAB(client, rewardOffset, const float*); }
+const uint8_t* car_env_terminated(const CarEnvClient* client) { return CAR_ENV_SLAB(client, terminatedOffset, const uint8_t*); }
+const uint8_t* car_env_truncated(const CarEnvClient* client) { return CAR_ENV_SLAB(client, truncatedOffset, const uint8_t*); }
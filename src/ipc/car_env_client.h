@@ -0,0 +1,123 @@
+#ifndef CAR_ENV_CLIENT_H
+#define CAR_ENV_CLIENT_H
+
+/*
+ * Shared-memory protocol of car_env_server and its C client (Linux).
+ *
+ * The server creates one POSIX shared-memory segment (shm_open name, e.g. "/car_env") holding a
+ * CarEnvShmHeader followed by the slabs of a batch of envs: observations (numEnvs x obsSize floats),
+ * actions (numEnvs x actionSize floats), final observations, rewards (numEnvs floats) and the terminated /
+ * truncated flags (numEnvs bytes). The env writes and reads the slabs in place, so a step copies nothing
+ * across the process boundary.
+ *
+ * A step is a doorbell pair: the client writes the actions, then the command and request.seq + 1;
+ * the server runs the command and publishes the request.seq it saw in response.seq (after a client timeout
+ * the next request skips a number, the server answers the latest one). Each side spins a while on
+ * the other's sequence word and then sleeps on it with a futex; waiters announces a sleeping side so the
+ * other only pays the FUTEX_WAKE system call when needed. One client per segment.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CAR_ENV_SHM_MAGIC   0x43524E56u  /* "CRNV", set last by the server once the segment is ready */
+#define CAR_ENV_SHM_VERSION 1u
+
+/* commands, CarEnvShmHeader::command */
+enum {
+    CAR_ENV_CMD_NONE = 0,
+    CAR_ENV_CMD_STEP = 1,       /* step every env with the actions slab (auto-reset of finished envs) */
+    CAR_ENV_CMD_RESET = 2,      /* reset every env, obs holds the first observations */
+    CAR_ENV_CMD_PING = 3,       /* round trip without work, measures the signaling latency */
+    CAR_ENV_CMD_SHUTDOWN = 4    /* the server answers and exits */
+};
+
+/* status codes of the client calls */
+enum {
+    CAR_ENV_OK = 0,
+    CAR_ENV_ERR_TIMEOUT = -1,   /* no answer within the timeout */
+    CAR_ENV_ERR_SERVER_GONE = -2  /* the server process exited */
+};
+
+/* one sequence word and its sleeper flag on a cache line of its own */
+typedef struct CarEnvDoorbell {
+    uint32_t seq;
+    uint32_t waiters;
+    uint32_t command;           /* request doorbell only */
+    uint8_t pad[52];
+} CarEnvDoorbell;
+
+typedef struct CarEnvShmHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t numEnvs;
+    uint32_t obsSize;           /* floats per observation row */
+    uint32_t actionSize;        /* floats per action row: acceleration, steering angle */
+    int32_t serverPid;
+    uint64_t totalSize;         /* segment size [bytes] */
+    uint64_t obsOffset;         /* slab offsets from the segment start, 64-byte aligned */
+    uint64_t actionOffset;
+    uint64_t finalObsOffset;    /* last observation of the envs that finished in the last step */
+    uint64_t rewardOffset;
+    uint64_t terminatedOffset;
+    uint64_t truncatedOffset;
+    uint8_t pad[48];            /* the doorbells start at byte 128 */
+    CarEnvDoorbell request;     /* client -> server */
+    CarEnvDoorbell response;    /* server -> client */
+} CarEnvShmHeader;
+
+/* ---- doorbell, shared by the client and the server ---- */
+
+/* publish value in bell->seq (after every slab write) and wake a sleeping waiter */
+void car_env_doorbell_ring(CarEnvDoorbell* bell, uint32_t value);
+
+/*
+ * wait until bell->seq == value: spin up to spin iterations (skipped on a single CPU), then futex sleep
+ * timeoutMs < 0 waits forever; alivePid > 0 is checked every 100 ms while sleeping
+ * returns CAR_ENV_OK, CAR_ENV_ERR_TIMEOUT or CAR_ENV_ERR_SERVER_GONE
+ */
+int car_env_doorbell_wait(CarEnvDoorbell* bell, uint32_t value, int spin, int timeoutMs, int32_t alivePid);
+
+/*
+ * wait until bell->seq != *seq and store the new value in *seq; same spin, timeout and status as above
+ * (the server side: a client that timed out and sent its next command skips a sequence number)
+ */
+int car_env_doorbell_wait_change(CarEnvDoorbell* bell, uint32_t* seq, int spin, int timeoutMs, int32_t alivePid);
+
+/* ---- client ---- */
+
+typedef struct CarEnvClient CarEnvClient;
+
+/* map the segment of a running server, waits up to timeoutMs for it to appear; NULL on failure */
+CarEnvClient* car_env_connect(const char* name, int timeoutMs);
+void car_env_disconnect(CarEnvClient* client);
+
+/* spin iterations before sleeping on an answer (default 20000, 0 = sleep at once) */
+void car_env_set_spin(CarEnvClient* client, int spin);
+
+/* run a command and wait for its answer; returns a CAR_ENV_* status */
+int car_env_step(CarEnvClient* client, int timeoutMs);
+int car_env_reset(CarEnvClient* client, int timeoutMs);
+int car_env_ping(CarEnvClient* client, int timeoutMs);
+int car_env_shutdown(CarEnvClient* client, int timeoutMs);
+
+/* slab views, valid until car_env_disconnect */
+uint32_t car_env_num_envs(const CarEnvClient* client);
+uint32_t car_env_obs_size(const CarEnvClient* client);
+uint32_t car_env_action_size(const CarEnvClient* client);
+float* car_env_actions(CarEnvClient* client);
+const float* car_env_obs(const CarEnvClient* client);
+const float* car_env_final_obs(const CarEnvClient* client);
+const float* car_env_rewards(const CarEnvClient* client);
+const uint8_t* car_env_terminated(const CarEnvClient* client);
+const uint8_t* car_env_truncated(const CarEnvClient* client);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
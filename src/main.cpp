@@ -1,15 +1,35 @@
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+
 #include "core/Config.h"
 #include "Window.h"
 #include "simulator/Simulator.h"
 
 
-int main() {
+int main(int argc, char** argv) {
+    // optional replay of an episode log: --replay <file> [--episode k] [--step n]
+    std::string replayPath;
+    std::size_t replayEpisode = 0;
+    double replayStep = 0.0;
+    for (int i = 1; i < argc; ++i) {
+        if (i + 1 < argc && std::strcmp(argv[i], "--replay") == 0) replayPath = argv[++i];
+        else if (i + 1 < argc && std::strcmp(argv[i], "--episode") == 0) replayEpisode = std::strtoull(argv[++i], nullptr, 10);
+        else if (i + 1 < argc && std::strcmp(argv[i], "--step") == 0) replayStep = std::strtod(argv[++i], nullptr);
+        else {
+            std::cerr << "usage: " << argv[0] << " [--replay <file.carlog> [--episode k] [--step n]]" << std::endl;
+            return -1;
+        }
+    }
+
     // Create window + OpenGL context
     Window window(SCR_WIDTH, SCR_HEIGHT, "Car Simulator");
     if (!window.isValid()) return -1;
 
     // Create simulator after OpenGL is ready
     Simulator sim(window.get());
+    if (!replayPath.empty() && !sim.openReplay(replayPath, replayEpisode, replayStep)) return -1;
     
     // Init simulator
     if (!sim.init()) return -1;
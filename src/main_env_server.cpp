@@ -0,0 +1,92 @@
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+#include "ipc/EnvServer.h"
+#include "simulator/HeadlessConfig.h"
+#include "utilities/Logger.h"
+
+
+namespace {
+    EnvServer* activeServer = nullptr;
+
+    void onSignal(int) {
+        if (activeServer) activeServer->stop();
+    }
+
+    void printUsage(const char* argv0) {
+        std::cerr << "usage: " << argv0 << " [--name /shm_name] [--envs N] [--action-repeat K] [--spin N] [--config <file>] [--max-steps N] [--sim-dt s] [--seed N] [--log-level level] [--vehicle-model kinematic|dynamic] [--integrator euler|arc] [--lot-aisles N] [--lot-slots-per-row N] [--lot-occupancy p]" << std::endl;
+    }
+
+    bool parseCount(const std::string& value, long long minValue, long long& out) {
+        char* end = nullptr;
+        out = std::strtoll(value.c_str(), &end, 10);
+        return end && *end == '\0' && !value.empty() && out >= minValue;
+    }
+}
+
+
+// Hosts a batch of parking envs for a trainer in another process (shared memory, see ipc/car_env_client.h).
+int main(int argc, char** argv) {
+    EnvServerConfig serverConfig;
+    HeadlessConfig config;   // the env settings share the keys of CarSimulatorHeadless
+
+    for (int i = 1; i < argc; ++i) {
+        if (i + 1 >= argc || std::strncmp(argv[i], "--", 2) != 0) {
+            printUsage(argv[0]);
+            return 1;
+        }
+        const std::string flag = argv[i] + 2;
+        const std::string value = argv[++i];
+
+        bool ok = false;
+        long long count = 0;
+        if (flag == "name") {
+            serverConfig.name = value;
+            ok = value.size() > 1 && value[0] == '/';
+        } else if (flag == "envs") {
+            ok = parseCount(value, 1, count);
+            serverConfig.numEnvs = static_cast<std::size_t>(count);
+        } else if (flag == "action-repeat") {
+            ok = parseCount(value, 1, count);
+            serverConfig.actionRepeat = static_cast<int>(count);
+        } else if (flag == "spin") {
+            ok = parseCount(value, 0, count);
+            serverConfig.spin = static_cast<int>(count);
+        } else if (flag == "config") {
+            ok = loadHeadlessConfig(value, config);
+        } else {
+            std::string key = flag;
+            for (auto& ch : key) if (ch == '-') ch = '_';
+            ok = applyHeadlessSetting(key, value, config);
+        }
+        if (!ok) {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    Logger::instance().setLevel(config.logLevel);
+    serverConfig.seed = config.seed;
+    serverConfig.simDt = static_cast<float>(config.simDt);
+    serverConfig.maxEpisodeSteps = config.maxStepsPerEpisode;
+    serverConfig.vehicleModel = config.vehicleModel;
+    serverConfig.integrator = config.integrator;
+    serverConfig.lotAisles = config.lotAisles;
+    serverConfig.lotSlotsPerRow = config.lotSlotsPerRow;
+    serverConfig.lotOccupancy = static_cast<float>(config.lotOccupancy);
+
+    EnvServer server(serverConfig);
+    if (!server.open()) return 1;
+
+    activeServer = &server;
+    std::signal(SIGINT, onSignal);
+    std::signal(SIGTERM, onSignal);
+    server.serve();
+    activeServer = nullptr;
+
+    std::cout << "commands: " << server.getCommandCount() << std::endl;
+    return 0;
+}
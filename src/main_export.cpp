@@ -0,0 +1,150 @@
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "core/Config.h"
+#include "OffscreenContext.h"
+#include "recording/FrameEncoder.h"
+#include "renderers/FrameReadback.h"
+#include "renderers/SceneRenderer.h"
+#include "simulator/ReplayPlayer.h"
+
+
+namespace {
+    void printUsage(const char* argv0) {
+        std::cerr << "usage: " << argv0 << " --replay <file.carlog> --out <file.rgba | frame_%06d.png> [--format raw|png] [--episode k | --episode all] [--size WxH] [--fps N] [--speed x] [--readback pbo|sync] [--log-level level]" << std::endl;
+    }
+}
+
+
+// Headless video export: renders episodes of an episode log offscreen (EGL) and encodes the frames.
+int main(int argc, char** argv) {
+    std::string replayPath, outPath, episodeArg = "0";
+    FrameFormat format = FrameFormat::Raw;
+    int width = static_cast<int>(SCR_WIDTH), height = static_cast<int>(SCR_HEIGHT);
+    double fps = 30.0, speed = 1.0;
+    bool pboReadback = true;
+
+    for (int i = 1; i < argc; ++i) {
+        if (i + 1 >= argc || std::strncmp(argv[i], "--", 2) != 0) {
+            printUsage(argv[0]);
+            return 1;
+        }
+        const std::string flag = argv[i] + 2;
+        const std::string value = argv[++i];
+
+        bool ok = true;
+        if (flag == "replay") replayPath = value;
+        else if (flag == "out") outPath = value;
+        else if (flag == "episode") episodeArg = value;
+        else if (flag == "format") {
+            ok = value == "raw" || value == "png";
+            format = value == "png" ? FrameFormat::Png : FrameFormat::Raw;
+        }
+        else if (flag == "size") ok = std::sscanf(value.c_str(), "%dx%d", &width, &height) == 2 && width > 0 && height > 0;
+        else if (flag == "fps") ok = (fps = std::strtod(value.c_str(), nullptr)) > 0.0;
+        else if (flag == "speed") ok = (speed = std::strtod(value.c_str(), nullptr)) > 0.0;
+        else if (flag == "readback") {
+            ok = value == "pbo" || value == "sync";
+            pboReadback = value == "pbo";
+        }
+        else if (flag == "log-level") {
+            LogLevel level;
+            ok = parseLogLevel(value, level);
+            if (ok) Logger::instance().setLevel(level);
+        }
+        else ok = false;
+        if (!ok) {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+    if (replayPath.empty() || outPath.empty()) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    // Create the OpenGL context before any GL resource
+    OffscreenContext context;
+    if (!context.isValid()) return -1;
+
+    ReplayPlayer replay;
+    if (!replay.open(replayPath)) return -1;
+    std::size_t firstEpisode = 0, lastEpisode = replay.getEpisodeCount();
+    if (episodeArg != "all") {
+        firstEpisode = std::strtoull(episodeArg.c_str(), nullptr, 10);
+        lastEpisode = firstEpisode + 1;
+        if (firstEpisode >= replay.getEpisodeCount()) {
+            CAR_LOG_ERROR("Replay %s has no episode %zu (%zu episodes)", replayPath.c_str(), firstEpisode, replay.getEpisodeCount());
+            return -1;
+        }
+    }
+
+    SceneRenderer scene(width, height, replay.getTrajectory().capacity());
+    scene.setLot(replay.hasLot() ? &replay.getLot() : nullptr);
+    FrameReadback target(width, height);
+    if (!target.isComplete()) return -1;
+
+    FrameEncoderConfig encoderConfig;
+    encoderConfig.path = outPath;
+    encoderConfig.format = format;
+    encoderConfig.width = width;
+    encoderConfig.height = height;
+    FrameEncoder encoder;
+    if (!encoder.open(encoderConfig)) return -1;
+
+    // frame f shows the cursor f * stepsPerFrame. With PBOs frame n + 1 renders while frame n is read back;
+    // the synchronous read waits for each frame, which can be faster with a CPU renderer on few cores
+    const auto start = std::chrono::steady_clock::now();
+    const double stepsPerFrame = speed / (fps * replay.getStepDt());
+    uint64_t frames = 0;
+    for (std::size_t k = firstEpisode; k < lastEpisode; ++k) {
+        replay.selectEpisode(k);
+        const EpisodeLogEpisode& episode = replay.getEpisode();
+        scene.setSlot({episode.slotX, episode.slotY}, episode.slotYaw);
+
+        const std::size_t episodeFrames = static_cast<std::size_t>(std::floor(replay.getNumSteps() / stepsPerFrame)) + 1;
+        for (std::size_t f = 0; f < episodeFrames; ++f, ++frames) {
+            replay.seek(static_cast<double>(f) * stepsPerFrame);
+            target.bind();
+            scene.draw(replay.getPrevState(), replay.getCurState(), replay.getAlpha(), replay.getTrajectory());
+
+            if (!pboReadback) {
+                std::vector<uint8_t> frame = encoder.acquire();
+                target.readNow(frame.data());
+                encoder.submit(std::move(frame));
+                continue;
+            }
+            if (!target.hasPendingFrame()) {
+                target.capture(nullptr);
+                continue;
+            }
+            std::vector<uint8_t> frame = encoder.acquire();
+            target.capture(frame.data());
+            encoder.submit(std::move(frame));
+        }
+    }
+    if (target.hasPendingFrame()) {
+        std::vector<uint8_t> frame = encoder.acquire();
+        target.finish(frame.data());
+        encoder.submit(std::move(frame));
+    }
+    const bool ok = encoder.close();
+
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "frames          : " << encoder.getFramesWritten() << " / " << frames << "\n";
+    std::cout << "size            : " << width << "x" << height << " @ " << fps << " fps\n";
+    std::cout << "wall time [s]   : " << seconds << "\n";
+    std::cout << "export [fps]    : " << (seconds > 0.0 ? static_cast<double>(frames) / seconds : 0.0) << "\n";
+    if (format == FrameFormat::Raw) {
+        std::cout << "play with       : ffplay -f rawvideo -pixel_format rgba -video_size " << width << "x" << height
+                  << " -framerate " << fps << " " << outPath << "\n";
+    }
+    return ok ? 0 : -1;
+}
@@ -0,0 +1,132 @@
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+#include "recording/EpisodeLogWriter.h"
+#include "simulator/HeadlessConfig.h"
+#include "simulator/SimulationCore.h"
+#include "utilities/Randomizer.h"
+#include "vehicledynamics/BicycleModel.h"
+#include "world/ParkingLot.h"
+
+
+namespace {
+    void printUsage(const char* argv0) {
+        std::cerr << "usage: " << argv0 << " [--config <file>] [--episodes N] [--max-steps N] [--sim-dt s] [--record-trajectory 0|1] [--seed N] [--log-level level] [--vehicle-model kinematic|dynamic] [--integrator euler|arc] [--lot-aisles N] [--lot-slots-per-row N] [--lot-occupancy p] [--record-log <file>]" << std::endl;
+    }
+}
+
+
+// Window-free entry point: runs N episodes as fast as possible with a random policy.
+int main(int argc, char** argv) {
+    HeadlessConfig config;
+
+    // command line: --config first loads a file, later flags override it
+    for (int i = 1; i < argc; ++i) {
+        if (i + 1 >= argc || std::strncmp(argv[i], "--", 2) != 0) {
+            printUsage(argv[0]);
+            return 1;
+        }
+        const std::string flag = argv[i] + 2;
+        const std::string value = argv[++i];
+
+        bool ok = false;
+        if (flag == "config") {
+            ok = loadHeadlessConfig(value, config);
+        } else {
+            std::string key = flag;
+            for (auto& ch : key) if (ch == '-') ch = '_';
+            ok = applyHeadlessSetting(key, value, config);
+        }
+        if (!ok) {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    Logger::instance().setLevel(config.logLevel);
+
+    // the env resets from the streams (seed, 0, episode); the policy uses stream (seed, 1, 0)
+    Randomizer envRandomizer;
+    if (config.seed != 0) envRandomizer.seed(config.seed);
+    Randomizer policyRandomizer(envRandomizer.getSeed());
+    policyRandomizer.setStream(1, 0);
+    SimulationCore core(&envRandomizer, config.simDt);
+    core.setRecordTrajectory(config.recordTrajectory);
+    core.setVehicleModel(config.vehicleModel);
+    core.setIntegrator(config.integrator);
+    core.setMaxEpisodeSteps(config.maxStepsPerEpisode);
+
+    // optional multi-slot lot, its occupancy is drawn from the same seed
+    ParkingLot lot;
+    if (config.lotAisles > 0) {
+        LotLayout layout;
+        layout.aisles = static_cast<int>(config.lotAisles);
+        layout.slotsPerRow = static_cast<int>(config.lotSlotsPerRow);
+        layout.occupancy = static_cast<float>(config.lotOccupancy);
+        lot = ParkingLot::generate(layout, envRandomizer.getSeed());
+        core.setLot(&lot);
+        std::cout << "lot: " << lot.getSlots().size() << " slots, " << lot.getFreeSlotCount() << " free, "
+                  << lot.getObstacles().size() << " obstacles" << std::endl;
+    }
+
+    // optional binary episode log, written by a background thread
+    EpisodeLogWriter episodeLog;
+    if (!config.recordLog.empty()) {
+        EpisodeLogInfo info;
+        info.simDt = static_cast<float>(config.simDt);
+        info.seed = envRandomizer.getSeed();
+        info.vehicleModel = config.vehicleModel;
+        info.integrator = config.integrator;
+        if (!episodeLog.open(config.recordLog, info, config.lotAisles > 0 ? &lot : nullptr)) return 1;
+    }
+
+    const BicycleModelLimits limits;
+    std::size_t totalSteps = 0, successes = 0, leftLot = 0, collisions = 0;
+
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t episode = 0; episode < config.episodes; ++episode) {
+        core.reset();
+        if (episodeLog.isOpen()) episodeLog.beginEpisode(0, core.getEnv());
+
+        for (std::size_t t = 0; t < config.maxStepsPerEpisode; ++t) {
+            // random continuous action within the model limits
+            Action action;
+            action.acceleration = policyRandomizer.randFloat(-limits.a_max, limits.a_max);
+            action.steeringAngle = policyRandomizer.randFloat(-limits.delta_max, limits.delta_max);
+
+            core.stepOnce(action);
+            ++totalSteps;
+
+            // the episode terminates when the car parks, collides or leaves the lot
+            const StepResult& result = core.getLastResult();
+            if (episodeLog.isOpen()) {
+                // log the applied action (clamped to the model limits), as RolloutRunner records it
+                Action applied;
+                applied.steeringAngle = std::clamp(action.steeringAngle, -limits.delta_max, limits.delta_max);
+                applied.acceleration = std::clamp(action.acceleration, -limits.a_max, limits.a_max);
+                episodeLog.recordStep(0, core.getCurState(), applied, result);
+            }
+            if (result.terminated) {
+                if (result.collided) ++collisions;
+                else if (result.reward > 0.0f) ++successes;
+                else ++leftLot;
+                break;
+            }
+        }
+        if (episodeLog.isOpen()) episodeLog.endEpisode(0);
+    }
+    if (episodeLog.isOpen() && !episodeLog.close()) return 1;
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "episodes: " << config.episodes
+              << ", steps: " << totalSteps
+              << ", parked: " << successes
+              << ", left lot: " << leftLot
+              << ", collisions: " << collisions
+              << ", time: " << seconds << " s"
+              << ", steps/s: " << (seconds > 0.0 ? totalSteps / seconds : 0.0) << std::endl;
+    return 0;
+}
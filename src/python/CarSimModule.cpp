@@ -0,0 +1,347 @@
+// Python bindings of the batched parking env (CPython C API + NumPy C API), built with -DCAR_BUILD_PYTHON=ON.
+//
+//   import car_sim
+//   env = car_sim.VecParkingEnv(1024, seed=1, lot_aisles=4)
+//   env.reset()
+//   for _ in range(steps):
+//       env.actions[:] = policy(env.obs)     # write into the C++ action buffer
+//       env.step()                           # one call for the whole batch, GIL released
+//       learn(env.obs, env.rewards, env.terminated, env.truncated)
+//
+// obs, rewards, terminated, truncated, final_obs, ranges and bev are read-only NumPy views over buffers
+// owned by the env, refreshed in place by step() and reset(); actions is a writable view. The buffers are
+// allocated once in the constructor, so the views stay valid (and keep the env alive) as long as they exist.
+
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+#define NPY_NO_DEPRECATED_API NPY_1_7_API_VERSION
+#include <numpy/arrayobject.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "envs/ParkingEnv.h"
+#include "envs/VecParkingEnv.h"
+#include "sensors/BevRasterizer.h"
+#include "sensors/RangeSensor.h"
+#include "utilities/Randomizer.h"
+#include "vehicledynamics/BicycleModel.h"
+#include "vehicledynamics/VehicleTypes.h"
+#include "world/ParkingLot.h"
+
+
+// the views read Observation / Action arrays as rows of floats
+constexpr std::size_t OBS_SIZE = sizeof(Observation) / sizeof(float);
+constexpr std::size_t ACTION_SIZE = sizeof(Action) / sizeof(float);
+static_assert(std::is_standard_layout<Observation>::value && OBS_SIZE * sizeof(float) == sizeof(Observation),
+              "Observation must be a plain row of floats");
+static_assert(std::is_standard_layout<Action>::value && ACTION_SIZE == 2, "Action must be {acceleration, steeringAngle}");
+
+
+namespace {
+    /**
+     * Python-side owner of a VecParkingEnv: its random generator, optional lot and the step buffers.
+     * Not copyable (the env keeps pointers to the randomizer and the lot).
+     */
+    class PyVecParkingEnv {
+    public:
+        PyVecParkingEnv(std::size_t numEnvs, uint64_t seed, float simDt, int actionRepeat, std::size_t maxEpisodeSteps,
+                        bool autoReset, const std::string& vehicleModel, const std::string& integrator,
+                        int lotAisles, int lotSlotsPerRow, float lotOccupancy,
+                        int lidarBeams, float lidarRange, float lidarFov, int bevSize, float bevResolution)
+            : env(numEnvs, &randomizer, simDt), obs(numEnvs), actions(numEnvs), rewards(numEnvs, 0.0f),
+              terminated(numEnvs, 0), truncated(numEnvs, 0) {
+            if (seed != 0) randomizer.seed(seed);
+            env.setActionRepeat(actionRepeat);
+            env.setMaxEpisodeSteps(maxEpisodeSteps);
+            env.setAutoReset(autoReset);
+            env.setVehicleModel(vehicleModel == "dynamic" ? VehicleModel::Dynamic : VehicleModel::Kinematic);
+            env.setIntegrator(integrator == "arc" ? KinematicIntegrator::Arc : KinematicIntegrator::Euler);
+
+            // optional multi-slot lot, its occupancy is drawn from the same seed (as CarSimulatorHeadless)
+            if (lotAisles > 0) {
+                LotLayout layout;
+                layout.aisles = lotAisles;
+                layout.slotsPerRow = lotSlotsPerRow;
+                layout.occupancy = lotOccupancy;
+                lot = ParkingLot::generate(layout, randomizer.getSeed());
+                env.setLot(&lot);
+            }
+            env.setRangeSensor(RangeSensorConfig{lidarBeams, lidarRange, lidarFov, {}});
+            env.setBevRaster(BevConfig{bevSize, bevSize, bevResolution});
+            reset();
+        }
+
+        PyVecParkingEnv(const PyVecParkingEnv&) = delete;
+        PyVecParkingEnv& operator=(const PyVecParkingEnv&) = delete;
+
+        // reset every env and write the first observations
+        void reset() {
+            env.reset();
+            env.observe(obs.data());
+            std::fill(rewards.begin(), rewards.end(), 0.0f);
+            std::fill(terminated.begin(), terminated.end(), uint8_t{0});
+            std::fill(truncated.begin(), truncated.end(), uint8_t{0});
+        }
+
+        // step every env with the actions buffer
+        void step() { env.step(actions.data(), obs.data(), rewards.data(), terminated.data(), truncated.data()); }
+
+        std::size_t size() const noexcept { return env.size(); }
+        const VecParkingEnv& getEnv() const noexcept { return env; }
+
+        Observation* obsData() noexcept { return obs.data(); }
+        Action* actionData() noexcept { return actions.data(); }
+        float* rewardData() noexcept { return rewards.data(); }
+        uint8_t* terminatedData() noexcept { return terminated.data(); }
+        uint8_t* truncatedData() noexcept { return truncated.data(); }
+
+    private:
+        Randomizer randomizer;   // declared before env, which keeps a pointer to it
+        ParkingLot lot;
+        VecParkingEnv env;
+        std::vector<Observation> obs;
+        std::vector<Action> actions;
+        std::vector<float> rewards;
+        std::vector<uint8_t> terminated, truncated;
+    };
+
+    // the Python object: a pointer to the owner, nullptr until __init__ succeeded
+    struct PyEnvObject {
+        PyObject_HEAD
+        PyVecParkingEnv* env;
+    };
+
+    // owner of a car_sim.VecParkingEnv, raises RuntimeError if __init__ did not run
+    PyVecParkingEnv* envOf(PyObject* self) {
+        PyVecParkingEnv* env = reinterpret_cast<PyEnvObject*>(self)->env;
+        if (!env) PyErr_SetString(PyExc_RuntimeError, "car_sim.VecParkingEnv is not initialized");
+        return env;
+    }
+
+    // NumPy array over memory owned by self, no copy; the array holds a reference to self
+    PyObject* makeView(PyObject* self, int typenum, int ndim, npy_intp* shape, npy_intp* strides, const void* data, bool writeable) {
+        const int flags = writeable ? NPY_ARRAY_CARRAY : NPY_ARRAY_CARRAY_RO;
+        PyObject* view = PyArray_New(&PyArray_Type, ndim, shape, typenum, strides, const_cast<void*>(data), 0, flags, nullptr);
+        if (!view) return nullptr;
+        Py_INCREF(self);
+        if (PyArray_SetBaseObject(reinterpret_cast<PyArrayObject*>(view), self) != 0) {   // steals the reference
+            Py_DECREF(view);
+            return nullptr;
+        }
+        return view;
+    }
+
+    // rows x cols floats, one row per env
+    PyObject* floatRows(PyObject* self, const void* data, std::size_t rows, std::size_t cols, bool writeable) {
+        npy_intp shape[2] = {static_cast<npy_intp>(rows), static_cast<npy_intp>(cols)};
+        npy_intp strides[2] = {static_cast<npy_intp>(cols * sizeof(float)), static_cast<npy_intp>(sizeof(float))};
+        return makeView(self, NPY_FLOAT32, 2, shape, strides, data, writeable);
+    }
+
+    // one flag byte per env as bool
+    PyObject* flags(PyObject* self, const uint8_t* data, std::size_t n) {
+        npy_intp shape[1] = {static_cast<npy_intp>(n)};
+        npy_intp strides[1] = {1};
+        return makeView(self, NPY_BOOL, 1, shape, strides, data, false);
+    }
+
+
+    // type slots and methods
+    // ------------------------------------------------------------------------
+    void envDealloc(PyObject* self) {
+        delete reinterpret_cast<PyEnvObject*>(self)->env;
+        Py_TYPE(self)->tp_free(self);
+    }
+
+    int envInit(PyObject* self, PyObject* args, PyObject* kwargs) {
+        static const char* keywords[] = {"num_envs", "seed", "sim_dt", "action_repeat", "max_episode_steps", "auto_reset",
+                                         "vehicle_model", "integrator", "lot_aisles", "lot_slots_per_row", "lot_occupancy",
+                                         "lidar_beams", "lidar_range", "lidar_fov", "bev_size", "bev_resolution", nullptr};
+        Py_ssize_t numEnvs = 0, maxEpisodeSteps = 0;
+        unsigned long long seed = 0;
+        float simDt = 0.01f, lotOccupancy = 0.5f, lidarRange = 10.0f, lidarFov = 2.0f * PI, bevResolution = 0.1f;
+        int actionRepeat = 1, autoReset = 1, lotAisles = 0, lotSlotsPerRow = 10, lidarBeams = 0, bevSize = 0;
+        const char* vehicleModel = "kinematic";
+        const char* integrator = "euler";
+        if (!PyArg_ParseTupleAndKeywords(args, kwargs, "n|Kfinpssiififfif", const_cast<char**>(keywords),
+                                         &numEnvs, &seed, &simDt, &actionRepeat, &maxEpisodeSteps, &autoReset,
+                                         &vehicleModel, &integrator, &lotAisles, &lotSlotsPerRow, &lotOccupancy,
+                                         &lidarBeams, &lidarRange, &lidarFov, &bevSize, &bevResolution)) {
+            return -1;
+        }
+        if (numEnvs <= 0 || maxEpisodeSteps < 0) {
+            PyErr_SetString(PyExc_ValueError, "num_envs must be positive and max_episode_steps non-negative");
+            return -1;
+        }
+
+        PyEnvObject* object = reinterpret_cast<PyEnvObject*>(self);
+        if (object->env) {
+            // views of the current buffers may exist, they must not outlive a re-initialization
+            PyErr_SetString(PyExc_RuntimeError, "car_sim.VecParkingEnv is already initialized");
+            return -1;
+        }
+        try {
+            object->env = new PyVecParkingEnv(static_cast<std::size_t>(numEnvs), seed, simDt, actionRepeat,
+                                              static_cast<std::size_t>(maxEpisodeSteps), autoReset != 0, vehicleModel,
+                                              integrator, lotAisles, lotSlotsPerRow, lotOccupancy, lidarBeams, lidarRange,
+                                              lidarFov, bevSize, bevResolution);
+        } catch (const std::exception& e) {
+            PyErr_SetString(PyExc_RuntimeError, e.what());
+            return -1;
+        }
+        return 0;
+    }
+
+    PyObject* envReset(PyObject* self, PyObject*) {
+        PyVecParkingEnv* env = envOf(self);
+        if (!env) return nullptr;
+        Py_BEGIN_ALLOW_THREADS
+        env->reset();
+        Py_END_ALLOW_THREADS
+        Py_RETURN_NONE;
+    }
+
+    PyObject* envStep(PyObject* self, PyObject*) {
+        PyVecParkingEnv* env = envOf(self);
+        if (!env) return nullptr;
+        Py_BEGIN_ALLOW_THREADS
+        env->step();
+        Py_END_ALLOW_THREADS
+        Py_RETURN_NONE;
+    }
+
+    Py_ssize_t envLength(PyObject* self) {
+        PyVecParkingEnv* env = envOf(self);
+        return env ? static_cast<Py_ssize_t>(env->size()) : -1;
+    }
+
+
+    // properties
+    // ------------------------------------------------------------------------
+    PyObject* getNumEnvs(PyObject* self, void*) {
+        PyVecParkingEnv* env = envOf(self);
+        return env ? PyLong_FromSize_t(env->size()) : nullptr;
+    }
+
+    PyObject* getObs(PyObject* self, void*) {
+        PyVecParkingEnv* env = envOf(self);
+        return env ? floatRows(self, env->obsData(), env->size(), OBS_SIZE, false) : nullptr;
+    }
+
+    PyObject* getFinalObs(PyObject* self, void*) {
+        PyVecParkingEnv* env = envOf(self);
+        return env ? floatRows(self, env->getEnv().getFinalObservations(), env->size(), OBS_SIZE, false) : nullptr;
+    }
+
+    PyObject* getActions(PyObject* self, void*) {
+        PyVecParkingEnv* env = envOf(self);
+        return env ? floatRows(self, env->actionData(), env->size(), ACTION_SIZE, true) : nullptr;
+    }
+
+    PyObject* getRewards(PyObject* self, void*) {
+        PyVecParkingEnv* env = envOf(self);
+        if (!env) return nullptr;
+        npy_intp shape[1] = {static_cast<npy_intp>(env->size())};
+        npy_intp strides[1] = {static_cast<npy_intp>(sizeof(float))};
+        return makeView(self, NPY_FLOAT32, 1, shape, strides, env->rewardData(), false);
+    }
+
+    PyObject* getTerminated(PyObject* self, void*) {
+        PyVecParkingEnv* env = envOf(self);
+        return env ? flags(self, env->terminatedData(), env->size()) : nullptr;
+    }
+
+    PyObject* getTruncated(PyObject* self, void*) {
+        PyVecParkingEnv* env = envOf(self);
+        return env ? flags(self, env->truncatedData(), env->size()) : nullptr;
+    }
+
+    PyObject* getRanges(PyObject* self, void*) {
+        PyVecParkingEnv* env = envOf(self);
+        if (!env) return nullptr;
+        const VecParkingEnv& vec = env->getEnv();
+        return floatRows(self, vec.getRanges(), vec.size(), static_cast<std::size_t>(vec.getRangeSensor().getBeams()), false);
+    }
+
+    PyObject* getBev(PyObject* self, void*) {
+        PyVecParkingEnv* env = envOf(self);
+        if (!env) return nullptr;
+        const VecParkingEnv& vec = env->getEnv();
+        const BevConfig& config = vec.getBevRasterizer().getConfig();
+        const npy_intp c = BEV_CHANNELS, h = config.height, w = config.width;
+        npy_intp shape[4] = {static_cast<npy_intp>(vec.size()), c, h, w};
+        npy_intp strides[4] = {c * h * w, h * w, w, 1};
+        return makeView(self, NPY_UINT8, 4, shape, strides, vec.getBev(), false);
+    }
+
+
+    PyMethodDef envMethods[] = {
+        {"reset", envReset, METH_NOARGS, "Reset every env, obs holds the first observations"},
+        {"step", envStep, METH_NOARGS,
+         "Step every env with the actions buffer; obs, rewards, terminated, truncated (and ranges, bev) are refreshed in place"},
+        {nullptr, nullptr, 0, nullptr}
+    };
+
+    PyGetSetDef envProperties[] = {
+        {"num_envs", getNumEnvs, nullptr, "number of envs", nullptr},
+        {"obs", getObs, nullptr, "(num_envs, OBS_SIZE) float32, read-only; with auto-reset the first observation of the new episode", nullptr},
+        {"final_obs", getFinalObs, nullptr, "(num_envs, OBS_SIZE) float32, read-only; last observation of the envs that finished in the last step", nullptr},
+        {"actions", getActions, nullptr, "(num_envs, ACTION_SIZE) float32, writable; read by step(), clamped internally", nullptr},
+        {"rewards", getRewards, nullptr, "(num_envs,) float32, read-only", nullptr},
+        {"terminated", getTerminated, nullptr, "(num_envs,) bool, read-only; parked, collided or left the lot", nullptr},
+        {"truncated", getTruncated, nullptr, "(num_envs,) bool, read-only; reached max_episode_steps", nullptr},
+        {"ranges", getRanges, nullptr, "(num_envs, lidar_beams) float32 lidar ranges [m], read-only", nullptr},
+        {"bev", getBev, nullptr, "(num_envs, BEV_CHANNELS, bev_size, bev_size) uint8 bird's-eye-view images, read-only", nullptr},
+        {nullptr, nullptr, nullptr, nullptr, nullptr}
+    };
+
+    PySequenceMethods envSequence = {};
+    PyTypeObject envType = {PyVarObject_HEAD_INIT(nullptr, 0)};
+
+    PyModuleDef carSimModule = {PyModuleDef_HEAD_INIT, "car_sim",
+                                "Batched parking environments of car_core with zero-copy NumPy buffers", -1,
+                                nullptr, nullptr, nullptr, nullptr, nullptr};
+}
+
+
+PyMODINIT_FUNC PyInit_car_sim() {
+    import_array();
+
+    envSequence.sq_length = envLength;
+    envType.tp_name = "car_sim.VecParkingEnv";
+    envType.tp_basicsize = sizeof(PyEnvObject);
+    envType.tp_flags = Py_TPFLAGS_DEFAULT;
+    envType.tp_doc =
+        "VecParkingEnv(num_envs, seed=0, sim_dt=0.01, action_repeat=1, max_episode_steps=0, auto_reset=True, "
+        "vehicle_model='kinematic', integrator='euler', lot_aisles=0, lot_slots_per_row=10, lot_occupancy=0.5, "
+        "lidar_beams=0, lidar_range=10.0, lidar_fov=2*pi, bev_size=0, bev_resolution=0.1)\n\n"
+        "N parking envs stepped in one call. Observation row: slot corners in the car frame (x1, y1, ..., x4, y4), "
+        "x, y, psi, velocity, delta, vy, yaw rate. Action row: acceleration, steering angle. "
+        "seed 0 draws a random seed; lot_aisles 0 = single random slot; lidar_beams / bev_size 0 = sensor off";
+    envType.tp_new = PyType_GenericNew;
+    envType.tp_init = envInit;
+    envType.tp_dealloc = envDealloc;
+    envType.tp_methods = envMethods;
+    envType.tp_getset = envProperties;
+    envType.tp_as_sequence = &envSequence;
+    if (PyType_Ready(&envType) < 0) return nullptr;
+
+    PyObject* module = PyModule_Create(&carSimModule);
+    if (!module) return nullptr;
+    Py_INCREF(&envType);
+    if (PyModule_AddObject(module, "VecParkingEnv", reinterpret_cast<PyObject*>(&envType)) < 0
+        || PyModule_AddIntConstant(module, "OBS_SIZE", static_cast<long>(OBS_SIZE)) < 0
+        || PyModule_AddIntConstant(module, "ACTION_SIZE", static_cast<long>(ACTION_SIZE)) < 0
+        || PyModule_AddIntConstant(module, "BEV_CHANNELS", static_cast<long>(BEV_CHANNELS)) < 0) {
+        Py_DECREF(&envType);
+        Py_DECREF(module);
+        return nullptr;
+    }
+    return module;
+}
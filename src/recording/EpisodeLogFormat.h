@@ -0,0 +1,121 @@
+#ifndef EPISODELOGFORMAT_H
+#define EPISODELOGFORMAT_H
+
+#include <cstdint>
+
+#include "../envs/ParkingEnv.h"
+#include "../vehicledynamics/VehicleTypes.h"
+
+
+/*
+ * Binary episode log (.carlog), little-endian, every section 16-byte aligned so a mapped file can be
+ * read through these structs in place:
+ *
+ *   EpisodeLogHeader                                   file offset 0
+ *   EpisodeLogWorld, slotCount x EpisodeLogSlot, obstacleCount x EpisodeLogObstacle
+ *   per finished episode: EpisodeLogEpisode, numSteps x EpisodeLogStep (contiguous)
+ *   episodeCount x EpisodeLogIndexEntry               at indexOffset, written by close()
+ *
+ * Episodes of different envs are interleaved in the order they finished, the steps of one episode are
+ * contiguous. A file whose writer did not close it has indexOffset 0; the reader then rebuilds the index
+ * by walking the episode headers and drops a truncated last episode.
+ */
+
+constexpr uint64_t EPISODE_LOG_MAGIC = 0x31474F4C52414301ull;   // "\x01CARLOG1"
+constexpr uint32_t EPISODE_LOG_VERSION = 1;
+constexpr uint32_t EPISODE_LOG_EPISODE_TAG = 0x45504953u;       // marks the start of an EpisodeLogEpisode
+
+// EpisodeLogStep::flags
+enum EpisodeLogFlags : uint32_t {
+    EPISODE_LOG_TERMINATED = 1u << 0,
+    EPISODE_LOG_TRUNCATED = 1u << 1,
+    EPISODE_LOG_COLLIDED = 1u << 2,
+    EPISODE_LOG_PARKED = 1u << 3,   // terminated with a positive reward
+};
+
+// file header, 64 bytes
+struct EpisodeLogHeader {
+    uint64_t magic;
+    uint32_t version;
+    uint32_t headerSize;            // sizeof(EpisodeLogHeader), sizes let a reader reject a foreign layout
+    uint32_t episodeSize;           // sizeof(EpisodeLogEpisode)
+    uint32_t stepSize;              // sizeof(EpisodeLogStep)
+    float simDt;                    // physics step [s]
+    int32_t actionRepeat;           // physics substeps per recorded step
+    uint64_t seed;                  // global seed of the recorded run
+    uint32_t numEnvs;
+    uint8_t vehicleModel;           // VehicleModel
+    uint8_t integrator;             // KinematicIntegrator
+    uint16_t reserved;
+    uint64_t indexOffset;           // 0 until close()
+    uint64_t episodeCount;          // entries of the index
+};
+
+// world description, 32 bytes, followed by the slots and the obstacles
+struct EpisodeLogWorld {
+    uint32_t slotCount;             // 0 = single slot per episode in empty space
+    uint32_t obstacleCount;
+    float minX, minY, maxX, maxY;   // lot bounds
+    float cellSize;                 // grid cell size the lot was built with
+    uint32_t reserved;
+};
+
+struct EpisodeLogSlot {
+    float x, y, yaw;
+    uint32_t occupied;
+};
+
+struct EpisodeLogObstacle {
+    float x, y, c, s;               // box frame -> world (Transform2D, stored as is to rebuild the lot bit for bit)
+    float halfLength, halfWidth;
+    uint32_t kind;                  // ObstacleKind
+    uint32_t reserved;
+};
+
+// episode header, 80 bytes, followed by numSteps EpisodeLogStep
+struct EpisodeLogEpisode {
+    uint32_t tag;                   // EPISODE_LOG_EPISODE_TAG
+    uint32_t envId;
+    uint64_t episodeIndex;          // random sub-stream the env reset from
+    uint32_t numSteps;
+    uint32_t flags;                 // flags of the last step
+    float totalReward;
+    int32_t targetSlot;             // index into the world slots, -1 without a lot
+    float slotX, slotY, slotYaw;    // target slot pose
+    VehicleState start;             // state after reset
+    uint32_t reserved[2];
+};
+
+// one env step, 48 bytes
+struct EpisodeLogStep {
+    VehicleState state;             // state after the step
+    Action action;                  // action of the step
+    float reward;
+    uint32_t flags;                 // EpisodeLogFlags
+    uint32_t step;                  // index within the episode
+};
+
+// seek index entry, 16 bytes
+struct EpisodeLogIndexEntry {
+    uint64_t offset;                // file offset of the EpisodeLogEpisode
+    uint32_t envId;
+    uint32_t numSteps;
+};
+
+static_assert(sizeof(EpisodeLogHeader) == 64, "EpisodeLogHeader layout");
+static_assert(sizeof(EpisodeLogWorld) == 32 && sizeof(EpisodeLogSlot) == 16 && sizeof(EpisodeLogObstacle) == 32, "EpisodeLogWorld layout");
+static_assert(sizeof(EpisodeLogEpisode) == 80, "EpisodeLogEpisode layout");
+static_assert(sizeof(EpisodeLogStep) == 48, "EpisodeLogStep layout");
+static_assert(sizeof(EpisodeLogIndexEntry) == 16, "EpisodeLogIndexEntry layout");
+
+// EpisodeLogFlags of a step result
+inline uint32_t episodeLogFlags(const StepResult& result) noexcept {
+    uint32_t flags = 0;
+    if (result.terminated) flags |= EPISODE_LOG_TERMINATED;
+    if (result.truncated) flags |= EPISODE_LOG_TRUNCATED;
+    if (result.collided) flags |= EPISODE_LOG_COLLIDED;
+    if (result.terminated && !result.collided && result.reward > 0.0f) flags |= EPISODE_LOG_PARKED;
+    return flags;
+}
+
+#endif
@@ -0,0 +1,189 @@
+#include "EpisodeLogReader.h"
+
+#include <cerrno>
+#include <cstring>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "../utilities/Logger.h"
+
+
+// destructor
+// ------------------------------------------------------------------------
+EpisodeLogReader::~EpisodeLogReader() {
+    close();
+}
+
+// map the file and check the header
+// ------------------------------------------------------------------------
+bool EpisodeLogReader::open(const std::string& path) {
+    close();
+    if (!map(path)) return false;
+
+    const EpisodeLogHeader& header = getHeader();
+    const std::size_t worldEnd = sizeof(EpisodeLogHeader) + sizeof(EpisodeLogWorld);
+    if (size < worldEnd || header.magic != EPISODE_LOG_MAGIC || header.version != EPISODE_LOG_VERSION ||
+        header.headerSize != sizeof(EpisodeLogHeader) || header.episodeSize != sizeof(EpisodeLogEpisode) ||
+        header.stepSize != sizeof(EpisodeLogStep)) {
+        CAR_LOG_ERROR("EpisodeLogReader: %s is not an episode log of version %u", path.c_str(), EPISODE_LOG_VERSION);
+        close();
+        return false;
+    }
+    world = reinterpret_cast<const EpisodeLogWorld*>(data + sizeof(EpisodeLogHeader));
+    if (worldEnd + world->slotCount * sizeof(EpisodeLogSlot) + world->obstacleCount * sizeof(EpisodeLogObstacle) > size) {
+        CAR_LOG_ERROR("EpisodeLogReader: %s: world section is cut off", path.c_str());
+        close();
+        return false;
+    }
+    if (!loadIndex()) {
+        CAR_LOG_ERROR("EpisodeLogReader: %s: invalid seek index", path.c_str());
+        close();
+        return false;
+    }
+    return true;
+}
+
+// use the stored index, or rebuild it from the episode headers
+// ------------------------------------------------------------------------
+bool EpisodeLogReader::loadIndex() {
+    const EpisodeLogHeader& header = getHeader();
+    const uint64_t first = sizeof(EpisodeLogHeader) + sizeof(EpisodeLogWorld) +
+                           world->slotCount * sizeof(EpisodeLogSlot) + world->obstacleCount * sizeof(EpisodeLogObstacle);
+    stepCount = 0;
+
+    if (header.indexOffset != 0) {
+        if (header.indexOffset < first || header.indexOffset + header.episodeCount * sizeof(EpisodeLogIndexEntry) > size) return false;
+        index = reinterpret_cast<const EpisodeLogIndexEntry*>(data + header.indexOffset);
+        episodeCount = static_cast<std::size_t>(header.episodeCount);
+        for (std::size_t k = 0; k < episodeCount; ++k) {
+            const uint64_t end = index[k].offset + sizeof(EpisodeLogEpisode) + uint64_t{index[k].numSteps} * sizeof(EpisodeLogStep);
+            if (index[k].offset < first || end > header.indexOffset || getEpisode(k).tag != EPISODE_LOG_EPISODE_TAG) return false;
+            stepCount += index[k].numSteps;
+        }
+        return true;
+    }
+
+    // not closed: walk the episodes up to the first incomplete one
+    recovered = true;
+    rebuiltIndex.clear();
+    uint64_t offset = first;
+    while (offset + sizeof(EpisodeLogEpisode) <= size) {
+        const EpisodeLogEpisode& e = *reinterpret_cast<const EpisodeLogEpisode*>(data + offset);
+        const uint64_t end = offset + sizeof(EpisodeLogEpisode) + uint64_t{e.numSteps} * sizeof(EpisodeLogStep);
+        if (e.tag != EPISODE_LOG_EPISODE_TAG || end > size) break;
+        rebuiltIndex.push_back(EpisodeLogIndexEntry{offset, e.envId, e.numSteps});
+        stepCount += e.numSteps;
+        offset = end;
+    }
+    index = rebuiltIndex.data();
+    episodeCount = rebuiltIndex.size();
+    CAR_LOG_WARN("EpisodeLogReader: log was not closed, recovered %zu episodes", episodeCount);
+    return true;
+}
+
+// rebuild the recorded lot
+// ------------------------------------------------------------------------
+bool EpisodeLogReader::buildLot(ParkingLot& lot) const {
+    if (!world || world->slotCount == 0) return false;
+    lot = ParkingLot{};
+    const EpisodeLogSlot* slots = getSlots();
+    for (uint32_t i = 0; i < world->slotCount; ++i) {
+        lot.addSlot({slots[i].x, slots[i].y}, slots[i].yaw, slots[i].occupied != 0);
+    }
+    const EpisodeLogObstacle* obstacles = getObstacles();
+    for (uint32_t i = 0; i < world->obstacleCount; ++i) {
+        const EpisodeLogObstacle& o = obstacles[i];
+        lot.addObstacle(Obstacle{Transform2D{o.c, o.s, {o.x, o.y}}, {o.halfLength, o.halfWidth}, static_cast<ObstacleKind>(o.kind)});
+    }
+    lot.build(AABB2D{world->minX, world->minY, world->maxX, world->maxY}, world->cellSize);
+    return true;
+}
+
+#ifdef _WIN32
+// map the whole file read-only
+// ------------------------------------------------------------------------
+bool EpisodeLogReader::map(const std::string& path) {
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    LARGE_INTEGER fileSize{};
+    if (file == INVALID_HANDLE_VALUE || !GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) {
+        CAR_LOG_ERROR("EpisodeLogReader: cannot open %s", path.c_str());
+        if (file != INVALID_HANDLE_VALUE) CloseHandle(file);
+        return false;
+    }
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    const void* view = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (!view) {
+        CAR_LOG_ERROR("EpisodeLogReader: cannot map %s", path.c_str());
+        if (mapping) CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+    fileHandle = file;
+    mappingHandle = mapping;
+    data = static_cast<const unsigned char*>(view);
+    size = static_cast<std::size_t>(fileSize.QuadPart);
+    return true;
+}
+
+// unmap
+// ------------------------------------------------------------------------
+void EpisodeLogReader::close() {
+    if (data) UnmapViewOfFile(data);
+    if (mappingHandle) CloseHandle(mappingHandle);
+    if (fileHandle) CloseHandle(fileHandle);
+    data = nullptr;
+    mappingHandle = fileHandle = nullptr;
+    size = 0;
+    world = nullptr;
+    index = nullptr;
+    rebuiltIndex.clear();
+    episodeCount = 0;
+    stepCount = 0;
+    recovered = false;
+}
+#else
+// map the whole file read-only
+// ------------------------------------------------------------------------
+bool EpisodeLogReader::map(const std::string& path) {
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    struct stat st{};
+    if (fd < 0 || fstat(fd, &st) != 0 || st.st_size == 0) {
+        CAR_LOG_ERROR("EpisodeLogReader: cannot open %s: %s", path.c_str(), fd < 0 ? std::strerror(errno) : "empty file");
+        if (fd >= 0) ::close(fd);
+        return false;
+    }
+    void* view = mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (view == MAP_FAILED) {
+        CAR_LOG_ERROR("EpisodeLogReader: cannot map %s: %s", path.c_str(), std::strerror(errno));
+        return false;
+    }
+    madvise(view, static_cast<std::size_t>(st.st_size), MADV_SEQUENTIAL);  // episodes are mostly read front to back
+    data = static_cast<const unsigned char*>(view);
+    size = static_cast<std::size_t>(st.st_size);
+    return true;
+}
+
+// unmap
+// ------------------------------------------------------------------------
+void EpisodeLogReader::close() {
+    if (data) munmap(const_cast<unsigned char*>(data), size);
+    data = nullptr;
+    size = 0;
+    world = nullptr;
+    index = nullptr;
+    rebuiltIndex.clear();
+    episodeCount = 0;
+    stepCount = 0;
+    recovered = false;
+}
+#endif
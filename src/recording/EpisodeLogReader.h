@@ -0,0 +1,77 @@
+#ifndef EPISODELOGREADER_H
+#define EPISODELOGREADER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "EpisodeLogFormat.h"
+#include "../world/ParkingLot.h"
+
+
+/**
+ * Episode Log Reader Class
+ * ---------------------------
+ * Maps an episode log (EpisodeLogFormat.h) read-only and hands out pointers into the mapping, so reading
+ * a million steps is one pass over the page cache without parsing or copies. Episodes are looked up
+ * through the seek index written by EpisodeLogWriter::close(); for a file that was not closed (crashed
+ * recorder) the index is rebuilt from the episode headers and a truncated last episode is dropped.
+ */
+class EpisodeLogReader {
+public:
+    EpisodeLogReader() = default;
+    ~EpisodeLogReader();
+
+    EpisodeLogReader(const EpisodeLogReader&) = delete;
+    EpisodeLogReader& operator=(const EpisodeLogReader&) = delete;
+
+    /** Map a log file and load its index
+     * ----------------------------------------------------------------------------
+     * @param[in] path: log file
+     * @return bool: false if the file cannot be mapped or is not a log of this version (logged)
+     */
+    bool open(const std::string& path);
+
+    // unmap the file, pointers handed out before become invalid
+    void close();
+
+    /** Rebuild the recorded lot
+     * ----------------------------------------------------------------------------
+     * @param[out] lot: lot with the recorded slots, obstacles, bounds and cell size
+     * @return bool: false if the run had no lot (single slot per episode)
+     */
+    bool buildLot(ParkingLot& lot) const;
+
+    // getter, valid while open
+    bool isOpen() const noexcept { return data != nullptr; }
+    bool isRecovered() const noexcept { return recovered; }     // the index was rebuilt (file not closed)
+    const EpisodeLogHeader& getHeader() const noexcept { return *reinterpret_cast<const EpisodeLogHeader*>(data); }
+    const EpisodeLogWorld& getWorld() const noexcept { return *world; }
+    const EpisodeLogSlot* getSlots() const noexcept { return reinterpret_cast<const EpisodeLogSlot*>(world + 1); }
+    const EpisodeLogObstacle* getObstacles() const noexcept { return reinterpret_cast<const EpisodeLogObstacle*>(getSlots() + world->slotCount); }
+    std::size_t getEpisodeCount() const noexcept { return episodeCount; }
+    uint64_t getStepCount() const noexcept { return stepCount; }
+    const EpisodeLogIndexEntry& getIndexEntry(std::size_t k) const noexcept { return index[k]; }
+    const EpisodeLogEpisode& getEpisode(std::size_t k) const noexcept { return *reinterpret_cast<const EpisodeLogEpisode*>(data + index[k].offset); }
+    const EpisodeLogStep* getSteps(std::size_t k) const noexcept { return reinterpret_cast<const EpisodeLogStep*>(data + index[k].offset + sizeof(EpisodeLogEpisode)); }
+
+private:
+    const unsigned char* data{nullptr};     // mapped file
+    std::size_t size{0};
+    const EpisodeLogWorld* world{nullptr};
+    const EpisodeLogIndexEntry* index{nullptr};     // in the mapping, or rebuiltIndex
+    std::vector<EpisodeLogIndexEntry> rebuiltIndex;
+    std::size_t episodeCount{0};
+    uint64_t stepCount{0};
+    bool recovered{false};
+
+#ifdef _WIN32
+    void* fileHandle{nullptr};
+    void* mappingHandle{nullptr};
+#endif
+
+    bool map(const std::string& path);
+    bool loadIndex();
+};
+#endif
@@ -0,0 +1,219 @@
+#include "EpisodeLogWriter.h"
+
+#include <cerrno>
+#include <cstring>
+
+#include "../utilities/Logger.h"
+
+
+namespace {
+    bool writeAll(std::FILE* file, const void* data, std::size_t size) {
+        return size == 0 || std::fwrite(data, 1, size, file) == size;
+    }
+
+    template <typename T>
+    void appendBytes(std::vector<char>& out, const T* data, std::size_t count) {
+        const char* bytes = reinterpret_cast<const char*>(data);
+        out.insert(out.end(), bytes, bytes + count * sizeof(T));
+    }
+}
+
+
+// constructor
+// ------------------------------------------------------------------------
+EpisodeLogWriter::EpisodeLogWriter(std::size_t blockSize) : blockSize(blockSize) {}
+
+// destructor
+// ------------------------------------------------------------------------
+EpisodeLogWriter::~EpisodeLogWriter() {
+    close();
+}
+
+// create the file and start the flush thread
+// ------------------------------------------------------------------------
+bool EpisodeLogWriter::open(const std::string& path, const EpisodeLogInfo& info, const ParkingLot* lot) {
+    close();
+    file = std::fopen(path.c_str(), "wb");
+    if (!file) {
+        CAR_LOG_ERROR("EpisodeLogWriter: cannot create %s: %s", path.c_str(), std::strerror(errno));
+        return false;
+    }
+
+    header = EpisodeLogHeader{};
+    header.magic = EPISODE_LOG_MAGIC;
+    header.version = EPISODE_LOG_VERSION;
+    header.headerSize = sizeof(EpisodeLogHeader);
+    header.episodeSize = sizeof(EpisodeLogEpisode);
+    header.stepSize = sizeof(EpisodeLogStep);
+    header.simDt = info.simDt;
+    header.actionRepeat = info.actionRepeat;
+    header.seed = info.seed;
+    header.numEnvs = info.numEnvs;
+    header.vehicleModel = static_cast<uint8_t>(info.vehicleModel);
+    header.integrator = static_cast<uint8_t>(info.integrator);
+
+    // header and world go through the first block, so the flush thread is the only writer
+    std::vector<char> first;
+    first.reserve(blockSize);
+    appendBytes(first, &header, 1);
+
+    EpisodeLogWorld world{};
+    std::vector<EpisodeLogSlot> slots;
+    std::vector<EpisodeLogObstacle> obstacles;
+    if (lot && !lot->getSlots().empty()) {
+        const AABB2D& bounds = lot->getBounds();
+        world.minX = bounds.minX;
+        world.minY = bounds.minY;
+        world.maxX = bounds.maxX;
+        world.maxY = bounds.maxY;
+        world.cellSize = lot->getSlotGrid().getCellSize();
+        for (const ParkingSlot& s : lot->getSlots()) {
+            slots.push_back(EpisodeLogSlot{s.pose.t.x, s.pose.t.y, s.yaw, s.occupied ? 1u : 0u});
+        }
+        for (const Obstacle& o : lot->getObstacles()) {
+            obstacles.push_back(EpisodeLogObstacle{o.pose.t.x, o.pose.t.y, o.pose.c, o.pose.s,
+                                                   o.halfExtents.x, o.halfExtents.y, static_cast<uint32_t>(o.kind), 0u});
+        }
+        world.slotCount = static_cast<uint32_t>(slots.size());
+        world.obstacleCount = static_cast<uint32_t>(obstacles.size());
+    }
+    appendBytes(first, &world, 1);
+    appendBytes(first, slots.data(), slots.size());
+    appendBytes(first, obstacles.data(), obstacles.size());
+
+    staging.assign(info.numEnvs, Staging{});
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        fileOffset = first.size();
+        block = std::move(first);
+        fullBlocks.clear();
+        index.clear();
+        stepCount = 0;
+        closing = false;
+    }
+    writeFailed.store(false);
+    flushThread = std::thread(&EpisodeLogWriter::flushLoop, this);
+    return true;
+}
+
+// start an episode
+// ------------------------------------------------------------------------
+void EpisodeLogWriter::beginEpisode(uint32_t envId, const ParkingEnv& env) {
+    Staging& s = staging[envId];
+    EpisodeLogEpisode& e = s.episode;
+    e = EpisodeLogEpisode{};
+    e.tag = EPISODE_LOG_EPISODE_TAG;
+    e.envId = envId;
+    e.episodeIndex = env.getEpisodeIndex() - 1;     // reset() moved on to the next sub-stream
+    e.targetSlot = env.getTargetSlot();
+    e.slotX = env.getParkingPos().x;
+    e.slotY = env.getParkingPos().y;
+    e.slotYaw = env.getParkingYaw();
+    e.start = env.getVehicleState();
+    s.steps.clear();
+    s.active = true;
+}
+
+// append one step
+// ------------------------------------------------------------------------
+void EpisodeLogWriter::recordStep(uint32_t envId, const VehicleState& state, const Action& action, const StepResult& result) {
+    Staging& s = staging[envId];
+    if (!s.active) return;
+    const uint32_t flags = episodeLogFlags(result);
+    s.steps.push_back(EpisodeLogStep{state, action, result.reward, flags, static_cast<uint32_t>(s.steps.size())});
+    s.episode.totalReward += result.reward;
+    s.episode.flags = flags;
+}
+
+// move a finished episode into the current block
+// ------------------------------------------------------------------------
+void EpisodeLogWriter::endEpisode(uint32_t envId) {
+    Staging& s = staging[envId];
+    if (!s.active) return;
+    s.active = false;
+    s.episode.numSteps = static_cast<uint32_t>(s.steps.size());
+    const std::size_t bytes = sizeof(EpisodeLogEpisode) + s.steps.size() * sizeof(EpisodeLogStep);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!block.empty() && block.size() + bytes > blockSize) submitBlock();
+    appendBytes(block, &s.episode, 1);
+    appendBytes(block, s.steps.data(), s.steps.size());
+    index.push_back(EpisodeLogIndexEntry{fileOffset, envId, s.episode.numSteps});
+    fileOffset += bytes;
+    stepCount += s.steps.size();
+}
+
+// write the rest and the index
+// ------------------------------------------------------------------------
+bool EpisodeLogWriter::close() {
+    if (!file) return true;
+    for (uint32_t envId = 0; envId < staging.size(); ++envId) endEpisode(envId);
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!block.empty()) submitBlock();
+        closing = true;
+    }
+    flushCv.notify_one();
+    flushThread.join();
+
+    // index at the end, then the header again with its position
+    bool ok = !writeFailed.load();
+    header.indexOffset = fileOffset;
+    header.episodeCount = index.size();
+    ok = ok && writeAll(file, index.data(), index.size() * sizeof(EpisodeLogIndexEntry));
+    ok = ok && std::fseek(file, 0, SEEK_SET) == 0 && writeAll(file, &header, sizeof(header));
+    ok = (std::fclose(file) == 0) && ok;
+    file = nullptr;
+    if (!ok) CAR_LOG_ERROR("EpisodeLogWriter: writing the log failed");
+    return ok;
+}
+
+// episodes ended so far
+// ------------------------------------------------------------------------
+uint64_t EpisodeLogWriter::getEpisodeCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return index.size();
+}
+
+// steps of the episodes ended so far
+// ------------------------------------------------------------------------
+uint64_t EpisodeLogWriter::getStepCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return stepCount;
+}
+
+// hand the current block to the flush thread, continue in a recycled one
+// ------------------------------------------------------------------------
+void EpisodeLogWriter::submitBlock() {
+    fullBlocks.push_back(std::move(block));
+    if (freeBlocks.empty()) {
+        block = std::vector<char>();
+        block.reserve(blockSize);
+    } else {
+        block = std::move(freeBlocks.back());
+        freeBlocks.pop_back();
+    }
+    flushCv.notify_one();
+}
+
+// write full blocks in order until close()
+// ------------------------------------------------------------------------
+void EpisodeLogWriter::flushLoop() {
+    std::unique_lock<std::mutex> lock(mutex);
+    for (;;) {
+        flushCv.wait(lock, [this] { return closing || !fullBlocks.empty(); });
+        if (fullBlocks.empty()) return;     // closing and drained
+
+        std::vector<char> data = std::move(fullBlocks.front());
+        fullBlocks.pop_front();
+        lock.unlock();
+        if (!writeFailed.load(std::memory_order_relaxed) && !writeAll(file, data.data(), data.size())) {
+            CAR_LOG_ERROR("EpisodeLogWriter: write failed: %s", std::strerror(errno));
+            writeFailed.store(true);
+        }
+        data.clear();
+        lock.lock();
+        freeBlocks.push_back(std::move(data));
+    }
+}
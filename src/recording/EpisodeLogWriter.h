@@ -0,0 +1,125 @@
+#ifndef EPISODELOGWRITER_H
+#define EPISODELOGWRITER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "EpisodeLogFormat.h"
+#include "../envs/ParkingEnv.h"
+#include "../vehicledynamics/BicycleModel.h"
+#include "../world/ParkingLot.h"
+
+
+// run settings stored in the log header
+struct EpisodeLogInfo {
+    uint32_t numEnvs{1};            // env ids are 0 .. numEnvs - 1
+    float simDt{0.01f};
+    int actionRepeat{1};
+    uint64_t seed{0};
+    VehicleModel vehicleModel{VehicleModel::Kinematic};
+    KinematicIntegrator integrator{KinematicIntegrator::Euler};
+};
+
+/**
+ * Episode Log Writer Class
+ * ---------------------------
+ * Records episodes into the binary format of EpisodeLogFormat.h. The stepping threads only copy:
+ * recordStep() appends a 48-byte record to the env's staging buffer, endEpisode() moves the finished
+ * episode into the current block, and full blocks are written to disk by a background flush thread.
+ * Blocks are recycled and the staging buffers keep their capacity, so after the first episodes
+ * recording allocates nothing and never waits for the disk.
+ *
+ * beginEpisode / recordStep of different env ids may run concurrently (one thread per env at a time,
+ * as with RolloutRunner shards); endEpisode takes a short lock.
+ */
+class EpisodeLogWriter {
+public:
+    // constructor, blockSize = bytes handed to the flush thread at once
+    // ------------------------------------------------------------------------
+    explicit EpisodeLogWriter(std::size_t blockSize = std::size_t{1} << 20);
+
+    // destructor, close()s the file
+    // ------------------------------------------------------------------------
+    ~EpisodeLogWriter();
+
+    EpisodeLogWriter(const EpisodeLogWriter&) = delete;
+    EpisodeLogWriter& operator=(const EpisodeLogWriter&) = delete;
+
+    /** Create the file, write the header and the world, start the flush thread
+     * ----------------------------------------------------------------------------
+     * @param[in] path: output file, truncated
+     * @param[in] info: run settings
+     * @param[in] lot: lot of the envs, nullptr = single slot in empty space
+     * @return bool: false if the file cannot be created (logged)
+     */
+    bool open(const std::string& path, const EpisodeLogInfo& info, const ParkingLot* lot);
+
+    /** Start an episode of env envId right after env.reset()
+     * ----------------------------------------------------------------------------
+     * An episode of envId that was not ended is dropped.
+     *
+     * @param[in] envId: env id < numEnvs
+     * @param[in] env: the reset env (start state, target slot, episode index)
+     * @return void
+     */
+    void beginEpisode(uint32_t envId, const ParkingEnv& env);
+
+    // append one step of env envId: state after the step, applied action, step result
+    void recordStep(uint32_t envId, const VehicleState& state, const Action& action, const StepResult& result);
+
+    /** Finish the episode of env envId and queue it for writing
+     * ----------------------------------------------------------------------------
+     * @param[in] envId: env id < numEnvs
+     * @return void
+     */
+    void endEpisode(uint32_t envId);
+
+    /** End the open episodes, write the pending blocks and the seek index
+     * ----------------------------------------------------------------------------
+     * @return bool: false if a write failed (logged)
+     */
+    bool close();
+
+    // getter
+    bool isOpen() const noexcept { return file != nullptr; }
+    uint64_t getEpisodeCount() const;
+    uint64_t getStepCount() const;
+
+private:
+    struct Staging {
+        EpisodeLogEpisode episode{};
+        std::vector<EpisodeLogStep> steps;
+        bool active{false};
+    };
+
+    std::size_t blockSize;
+    std::FILE* file{nullptr};
+    EpisodeLogHeader header{};
+    std::vector<Staging> staging;           // per env
+
+    // guarded by mutex
+    mutable std::mutex mutex;
+    std::condition_variable flushCv;
+    std::vector<char> block;                // block being filled
+    std::deque<std::vector<char>> fullBlocks;
+    std::vector<std::vector<char>> freeBlocks;
+    std::vector<EpisodeLogIndexEntry> index;
+    uint64_t fileOffset{0};                 // file offset of the next episode
+    uint64_t stepCount{0};
+    bool closing{false};
+
+    std::thread flushThread;
+    std::atomic<bool> writeFailed{false};
+
+    void flushLoop();
+    void submitBlock();     // caller holds mutex
+};
+#endif
@@ -0,0 +1,228 @@
+#include "FrameEncoder.h"
+
+#include <cerrno>
+#include <cstring>
+#include <string>
+
+#ifdef CAR_HAVE_PNG
+#include <png.h>
+#endif
+
+#include "../utilities/Logger.h"
+
+
+namespace {
+    // widest zero padding of a PNG frame number (uint64_t has 20 digits)
+    constexpr int MAX_NUMBER_WIDTH = 20;
+
+    // split a PNG path pattern at its one integer conversion %d / %i / %u, optionally zero-padded to a width
+    // ("frame_%06d.png" -> "frame_", 6, ".png"); %% is a literal %, any other conversion is rejected. A width
+    // without the 0 flag (%6d) is rejected too: printf pads it with spaces, the file names are zero-padded
+    bool parseFramePattern(const std::string& pattern, std::string& prefix, std::string& suffix, int& width) {
+        prefix.clear();
+        suffix.clear();
+        width = 0;
+        bool found = false;
+        for (std::size_t i = 0; i < pattern.size(); ++i) {
+            std::string& out = found ? suffix : prefix;
+            if (pattern[i] != '%') {
+                out += pattern[i];
+                continue;
+            }
+            if (i + 1 < pattern.size() && pattern[i + 1] == '%') {
+                out += '%';
+                ++i;
+                continue;
+            }
+            if (found) return false;
+
+            std::size_t j = i + 1;
+            const bool zeroFlag = j < pattern.size() && pattern[j] == '0';
+            if (zeroFlag) ++j;
+            int digits = 0;
+            for (; j < pattern.size() && pattern[j] >= '0' && pattern[j] <= '9'; ++j) {
+                digits = digits * 10 + (pattern[j] - '0');
+                if (digits > MAX_NUMBER_WIDTH) return false;
+            }
+            if (j == pattern.size() || (pattern[j] != 'd' && pattern[j] != 'i' && pattern[j] != 'u')) return false;
+            if (digits > 0 && !zeroFlag) return false;
+            width = digits;
+            found = true;
+            i = j;
+        }
+        return found;
+    }
+}
+
+
+// destructor
+// ------------------------------------------------------------------------
+FrameEncoder::~FrameEncoder() {
+    close();
+}
+
+// PNG support
+// ------------------------------------------------------------------------
+bool FrameEncoder::hasPng() noexcept {
+#ifdef CAR_HAVE_PNG
+    return true;
+#else
+    return false;
+#endif
+}
+
+// open the output and start the encoder thread
+// ------------------------------------------------------------------------
+bool FrameEncoder::open(const FrameEncoderConfig& newConfig) {
+    close();
+    if (newConfig.width <= 0 || newConfig.height <= 0) {
+        CAR_LOG_ERROR("FrameEncoder: invalid frame size %dx%d", newConfig.width, newConfig.height);
+        return false;
+    }
+    if (newConfig.format == FrameFormat::Png && !hasPng()) {
+        CAR_LOG_ERROR("FrameEncoder: PNG output needs libpng, rebuild with libpng or use raw output");
+        return false;
+    }
+    if (newConfig.format == FrameFormat::Png && !parseFramePattern(newConfig.path, pngPrefix, pngSuffix, pngNumberWidth)) {
+        CAR_LOG_ERROR("FrameEncoder: PNG path %s needs exactly one frame number conversion %%d or zero-padded %%0Nd (no space-padded %%Nd) and no other %% conversion",
+                      newConfig.path.c_str());
+        return false;
+    }
+    if (newConfig.format == FrameFormat::Raw) {
+        file = std::fopen(newConfig.path.c_str(), "wb");
+        if (!file) {
+            CAR_LOG_ERROR("FrameEncoder: cannot create %s: %s", newConfig.path.c_str(), std::strerror(errno));
+            return false;
+        }
+    }
+
+    config = newConfig;
+    if (config.maxQueued == 0) config.maxQueued = 1;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        queued.clear();
+        inFlight = 0;
+        closing = false;
+    }
+    framesWritten.store(0);
+    writeFailed.store(false);
+    running = true;
+    encodeThread = std::thread(&FrameEncoder::encodeLoop, this);
+    return true;
+}
+
+// buffer for the next frame
+// ------------------------------------------------------------------------
+std::vector<uint8_t> FrameEncoder::acquire() {
+    std::unique_lock<std::mutex> lock(mutex);
+    freeCv.wait(lock, [this] { return inFlight < config.maxQueued; });
+    ++inFlight;
+    std::vector<uint8_t> frame;
+    if (!freeFrames.empty()) {
+        frame = std::move(freeFrames.back());
+        freeFrames.pop_back();
+    }
+    lock.unlock();
+    frame.resize(getFrameBytes());
+    return frame;
+}
+
+// queue a frame
+// ------------------------------------------------------------------------
+void FrameEncoder::submit(std::vector<uint8_t>&& frame) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        queued.push_back(std::move(frame));
+    }
+    encodeCv.notify_one();
+}
+
+// drain the queue and stop
+// ------------------------------------------------------------------------
+bool FrameEncoder::close() {
+    if (!running) return true;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        closing = true;
+    }
+    encodeCv.notify_one();
+    encodeThread.join();
+    running = false;
+
+    bool ok = !writeFailed.load();
+    if (file) {
+        ok = (std::fclose(file) == 0) && ok;
+        file = nullptr;
+    }
+    if (!ok) CAR_LOG_ERROR("FrameEncoder: writing %s failed", config.path.c_str());
+    return ok;
+}
+
+// encode queued frames in order until close()
+// ------------------------------------------------------------------------
+void FrameEncoder::encodeLoop() {
+    std::vector<uint8_t> rowScratch;
+    uint64_t number = 0;
+    std::unique_lock<std::mutex> lock(mutex);
+    for (;;) {
+        encodeCv.wait(lock, [this] { return closing || !queued.empty(); });
+        if (queued.empty()) return;     // closing and drained
+
+        std::vector<uint8_t> frame = std::move(queued.front());
+        queued.pop_front();
+        lock.unlock();
+        if (!writeFailed.load(std::memory_order_relaxed)) {
+            if (encode(frame, number, rowScratch)) framesWritten.fetch_add(1, std::memory_order_relaxed);
+            else writeFailed.store(true);
+        }
+        ++number;
+        lock.lock();
+        freeFrames.push_back(std::move(frame));
+        --inFlight;
+        freeCv.notify_one();
+    }
+}
+
+// write one frame, top row first
+// ------------------------------------------------------------------------
+bool FrameEncoder::encode(const std::vector<uint8_t>& frame, uint64_t number, std::vector<uint8_t>& rowScratch) {
+    const std::size_t stride = static_cast<std::size_t>(config.width) * 4;
+    if (config.format == FrameFormat::Raw) {
+        // rows in reverse order, gathered so the file sees one write per frame
+        rowScratch.resize(frame.size());
+        for (int y = 0; y < config.height; ++y) {
+            std::memcpy(rowScratch.data() + static_cast<std::size_t>(y) * stride,
+                        frame.data() + static_cast<std::size_t>(config.height - 1 - y) * stride, stride);
+        }
+        if (std::fwrite(rowScratch.data(), 1, rowScratch.size(), file) != rowScratch.size()) {
+            CAR_LOG_ERROR("FrameEncoder: write failed: %s", std::strerror(errno));
+            return false;
+        }
+        return true;
+    }
+
+#ifdef CAR_HAVE_PNG
+    // the user pattern is never a format string, only the validated prefix / suffix around the number
+    char digits[MAX_NUMBER_WIDTH + 1];
+    std::snprintf(digits, sizeof(digits), "%0*llu", pngNumberWidth, static_cast<unsigned long long>(number));
+    const std::string path = pngPrefix + digits + pngSuffix;
+    png_image image;
+    std::memset(&image, 0, sizeof(image));
+    image.version = PNG_IMAGE_VERSION;
+    image.width = static_cast<png_uint_32>(config.width);
+    image.height = static_cast<png_uint_32>(config.height);
+    image.format = PNG_FORMAT_RGBA;
+#ifdef PNG_IMAGE_FLAG_FAST
+    image.flags = PNG_IMAGE_FLAG_FAST;      // speed over file size, frames are usually re-encoded to video
+#endif
+    // a negative row stride makes libpng read the bottom-up rows top row first
+    if (!png_image_write_to_file(&image, path.c_str(), 0, frame.data(), -static_cast<png_int_32>(stride), nullptr)) {
+        CAR_LOG_ERROR("FrameEncoder: cannot write %s: %s", path.c_str(), image.message);
+        return false;
+    }
+    return true;
+#else
+    (void)number;
+    return false;
+#endif
+}
@@ -0,0 +1,105 @@
+#ifndef FRAMEENCODER_H
+#define FRAMEENCODER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+// output of FrameEncoder
+enum class FrameFormat : uint8_t {
+    Raw,    // one file of RGBA frames, top row first (ffmpeg -f rawvideo -pix_fmt rgba -s WxH -i file)
+    Png     // one PNG per frame, path holds one %d / %0Nd for the frame number, %% for a literal % (needs libpng)
+};
+
+struct FrameEncoderConfig {
+    std::string path;                   // raw: output file, png: e.g. "frames/frame_%06d.png"
+    FrameFormat format{FrameFormat::Raw};
+    int width{0};
+    int height{0};
+    std::size_t maxQueued{8};           // frames in flight before acquire() waits for the encoder
+};
+
+/**
+ * Frame Encoder Class
+ * ---------------------------
+ * Writes rendered frames on a background thread, so encoding overlaps rendering. Frames are RGBA8
+ * with the bottom row first, as glReadPixels returns them; the encoder flips them to top row first.
+ *
+ * The render thread takes a buffer with acquire(), fills it and hands it over with submit(). Buffers
+ * are recycled; at most maxQueued frames are in flight, so a slow encoder throttles the renderer
+ * instead of growing the queue.
+ */
+class FrameEncoder {
+public:
+    FrameEncoder() = default;
+
+    // destructor, close()s the output
+    // ------------------------------------------------------------------------
+    ~FrameEncoder();
+
+    FrameEncoder(const FrameEncoder&) = delete;
+    FrameEncoder& operator=(const FrameEncoder&) = delete;
+
+    /** Open the output and start the encoder thread
+     * ----------------------------------------------------------------------------
+     * @param[in] config: output path, format and frame size
+     * @return bool: false if the output cannot be created, the format is not available or the PNG path
+     *         pattern is invalid (logged)
+     */
+    bool open(const FrameEncoderConfig& config);
+
+    /** Buffer of getFrameBytes() bytes for the next frame, waits while maxQueued frames are in flight
+     * ----------------------------------------------------------------------------
+     * @return std::vector<uint8_t>: recycled buffer, its content is undefined
+     */
+    std::vector<uint8_t> acquire();
+
+    // queue a filled buffer of acquire() as the next frame
+    void submit(std::vector<uint8_t>&& frame);
+
+    /** Encode the queued frames and stop the encoder thread
+     * ----------------------------------------------------------------------------
+     * @return bool: false if a write failed (logged)
+     */
+    bool close();
+
+    // getter
+    bool isOpen() const noexcept { return running; }
+    std::size_t getFrameBytes() const noexcept { return static_cast<std::size_t>(config.width) * config.height * 4; }
+    uint64_t getFramesWritten() const noexcept { return framesWritten.load(std::memory_order_relaxed); }
+
+    // PNG output is compiled in (libpng found)
+    static bool hasPng() noexcept;
+
+private:
+    FrameEncoderConfig config;
+    std::FILE* file{nullptr};           // raw output
+    std::string pngPrefix, pngSuffix;   // png: path around the frame number
+    int pngNumberWidth{0};              // png: zero padding of the frame number
+    bool running{false};
+
+    // guarded by mutex
+    std::mutex mutex;
+    std::condition_variable encodeCv;   // frames queued or closing
+    std::condition_variable freeCv;     // a buffer came back
+    std::deque<std::vector<uint8_t>> queued;
+    std::vector<std::vector<uint8_t>> freeFrames;
+    std::size_t inFlight{0};            // acquired and not yet encoded
+    bool closing{false};
+
+    std::thread encodeThread;
+    std::atomic<uint64_t> framesWritten{0};
+    std::atomic<bool> writeFailed{false};
+
+    void encodeLoop();
+    bool encode(const std::vector<uint8_t>& frame, uint64_t number, std::vector<uint8_t>& rowScratch);
+};
+#endif
@@ -0,0 +1,92 @@
+#include "FrameReadback.h"
+
+#include <cstring>
+
+#include "../utilities/Logger.h"
+
+
+// constructor
+// ------------------------------------------------------------------------
+FrameReadback::FrameReadback(int width, int height) : width(width), height(height) {
+    glGenFramebuffers(1, &fbo);
+    glGenRenderbuffers(1, &colorRbo);
+    glBindRenderbuffer(GL_RENDERBUFFER, colorRbo);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, colorRbo);
+    complete = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+    if (!complete) CAR_LOG_ERROR("FrameReadback: framebuffer %dx%d is incomplete", width, height);
+
+    // two pack buffers of one frame each, read by the CPU
+    glGenBuffers(2, pbos);
+    for (unsigned int pbo : pbos) {
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, pbo);
+        glBufferData(GL_PIXEL_PACK_BUFFER, static_cast<GLsizeiptr>(getFrameBytes()), nullptr, GL_STREAM_READ);
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    glPixelStorei(GL_PACK_ALIGNMENT, 4);
+}
+
+// destructor
+// ------------------------------------------------------------------------
+FrameReadback::~FrameReadback() {
+    glDeleteBuffers(2, pbos);
+    glDeleteRenderbuffers(1, &colorRbo);
+    glDeleteFramebuffers(1, &fbo);
+}
+
+// render target
+// ------------------------------------------------------------------------
+void FrameReadback::bind() const {
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+    glViewport(0, 0, width, height);
+}
+
+// start reading this frame, copy out the previous one
+// ------------------------------------------------------------------------
+bool FrameReadback::capture(uint8_t* out) {
+    const int index = next;
+    next ^= 1;
+
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, fbo);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, pbos[index]);
+    glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);   // into the PBO, no wait
+    pending[index] = true;
+
+    // the other PBO holds the previous frame, by now (usually) copied on the GPU side
+    const bool copied = copyOut(next, out);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    return copied;
+}
+
+// the last frame still in a PBO
+// ------------------------------------------------------------------------
+bool FrameReadback::finish(uint8_t* out) {
+    const bool copied = copyOut(next ^ 1, out);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    return copied;
+}
+
+// synchronous baseline
+// ------------------------------------------------------------------------
+void FrameReadback::readNow(uint8_t* out) const {
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, fbo);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, out);
+}
+
+// map a pending PBO and copy it out
+// ------------------------------------------------------------------------
+bool FrameReadback::copyOut(int index, uint8_t* out) {
+    if (!pending[index]) return false;
+    pending[index] = false;
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, pbos[index]);
+    const void* pixels = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, static_cast<GLsizeiptr>(getFrameBytes()), GL_MAP_READ_BIT);
+    if (!pixels) {
+        CAR_LOG_ERROR("FrameReadback: mapping the pixel buffer failed (0x%x)", glGetError());
+        return false;
+    }
+    std::memcpy(out, pixels, getFrameBytes());
+    glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    return true;
+}
@@ -0,0 +1,72 @@
+#ifndef FRAMEREADBACK_H
+#define FRAMEREADBACK_H
+
+#include <glad/glad.h>
+
+#include <cstddef>
+#include <cstdint>
+
+
+/**
+ * Frame Readback Class
+ * ---------------------------
+ * Offscreen render target (FBO with an RGBA8 color renderbuffer) and asynchronous readback through
+ * two pixel buffer objects.
+ *
+ * capture() starts the copy of the frame just drawn into one PBO (glReadPixels into a bound
+ * GL_PIXEL_PACK_BUFFER returns without waiting) and maps the other PBO, which holds the frame of the
+ * previous call. So frame n is read while frame n + 1 is rendered, and the map rarely waits. Pixels
+ * are RGBA8, bottom row first.
+ */
+class FrameReadback {
+public:
+    // constructor creates the FBO and the two PBOs (needs a current GL context)
+    // ------------------------------------------------------------------------
+    FrameReadback(int width, int height);
+
+    // destructor
+    // ------------------------------------------------------------------------
+    ~FrameReadback();
+
+    FrameReadback(const FrameReadback&) = delete;
+    FrameReadback& operator=(const FrameReadback&) = delete;
+
+    // bind the FBO as draw and read target and set the viewport to the frame size
+    void bind() const;
+
+    /** Queue the readback of the frame just drawn, copy out the previous frame
+     * ----------------------------------------------------------------------------
+     * @param[out] out: getFrameBytes() bytes, receives the frame of the previous capture()
+     *                  (may be nullptr if hasPendingFrame() is false)
+     * @return bool: false on the first call (no previous frame), out is untouched
+     */
+    bool capture(uint8_t* out);
+
+    /** Copy out the frame of the last capture()
+     * ----------------------------------------------------------------------------
+     * @param[out] out: getFrameBytes() bytes
+     * @return bool: false if no frame is pending
+     */
+    bool finish(uint8_t* out);
+
+    // synchronous glReadPixels into client memory, waits for the frame (baseline of the benchmark)
+    void readNow(uint8_t* out) const;
+
+    // getter
+    bool isComplete() const noexcept { return complete; }
+    bool hasPendingFrame() const noexcept { return pending[next ^ 1]; }   // capture() / finish() will copy out a frame
+    int getWidth() const noexcept { return width; }
+    int getHeight() const noexcept { return height; }
+    std::size_t getFrameBytes() const noexcept { return static_cast<std::size_t>(width) * height * 4; }
+
+private:
+    int width{0}, height{0};
+    unsigned int fbo{0}, colorRbo{0};
+    unsigned int pbos[2]{0, 0};
+    int next{0};                // PBO of the next capture()
+    bool pending[2]{false, false};
+    bool complete{false};
+
+    bool copyOut(int index, uint8_t* out);
+};
+#endif
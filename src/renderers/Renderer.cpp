@@ -1,5 +1,7 @@
 #include "Renderer.h"
 
+#include <cstddef>
+
 
 // constructor
 // ------------------------------------------------------------------------
@@ -7,7 +9,10 @@ Renderer::Renderer(float ppm, int fbW, int fbH) : ppm(ppm), fbW(fbW), fbH(fbH) {
 
 // destructor
 // ------------------------------------------------------------------------
-// default destructor is used. 
+Renderer::~Renderer() {
+    if (instanceVBO) glDeleteBuffers(1, &instanceVBO);
+    if (instanceVAO) glDeleteVertexArrays(1, &instanceVAO);
+}
 
 // draw
 // ------------------------------------------------------------------------
@@ -33,6 +38,68 @@ void Renderer::draw(const Entity& e) const {
     
 };
 
+// create the instancing VAO/VBO
+// ------------------------------------------------------------------------
+void Renderer::initInstancing(const Loader& quad) {
+    glGenVertexArrays(1, &instanceVAO);
+    glGenBuffers(1, &instanceVBO);
+
+    glBindVertexArray(instanceVAO);
+
+    // per-vertex: reuse the quad positions and indices
+    glBindBuffer(GL_ARRAY_BUFFER, quad.getVBO());
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
+    glEnableVertexAttribArray(0);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, quad.getEBO());
+
+    // per-instance: offset, scale, yaw, color
+    glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+    const GLsizei stride = sizeof(RectInstance);
+    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, stride, (void*)offsetof(RectInstance, offset));
+    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, stride, (void*)offsetof(RectInstance, scale));
+    glVertexAttribPointer(3, 1, GL_FLOAT, GL_FALSE, stride, (void*)offsetof(RectInstance, yaw));
+    glVertexAttribPointer(4, 4, GL_FLOAT, GL_FALSE, stride, (void*)offsetof(RectInstance, color));
+    for (unsigned int loc = 1; loc <= 4; ++loc) {
+        glEnableVertexAttribArray(loc);
+        glVertexAttribDivisor(loc, 1);
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindVertexArray(0);  // keep the EBO bound to the VAO, unbind the VAO only
+}
+
+// queue an entity for the next flush
+// ------------------------------------------------------------------------
+void Renderer::submit(const Entity& e) {
+    const Position2D ndcPos = metersToNDC(e.getPosX(), e.getPosY());
+    const Position2D ndcSize = rectSizeToNDC(e.getWidth(), e.getLength());
+    const auto& c = e.getColor();
+    instances.push_back(RectInstance{{ndcPos.x, ndcPos.y}, {ndcSize.x, ndcSize.y}, e.getYaw(), {c[0], c[1], c[2], c[3]}});
+}
+
+// draw all queued entities in one call
+// ------------------------------------------------------------------------
+void Renderer::flush(const InstancedRectShader& shader) {
+    if (instances.empty()) return;
+
+    glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+    if (instances.size() > instanceCapacity) {
+        // grow geometrically so long sessions do not reallocate every frame
+        instanceCapacity = std::max(instances.size(), instanceCapacity * 2);
+    }
+    // orphan the previous storage so the driver does not stall on the last frame's draw
+    glBufferData(GL_ARRAY_BUFFER, instanceCapacity * sizeof(RectInstance), nullptr, GL_STREAM_DRAW);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, instances.size() * sizeof(RectInstance), instances.data());
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    shader.use();
+    glBindVertexArray(instanceVAO);
+    glDrawElementsInstanced(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0, static_cast<GLsizei>(instances.size()));
+    glBindVertexArray(0);
+
+    instances.clear();
+}
+
 // converts a point (the object center in meters) into an NDC position for uOffset
 // ------------------------------------------------------------------------
 Position2D Renderer::metersToNDC(float x_m, float y_m) const {
@@ -2,10 +2,12 @@
 #define RENDERER_H
 
 #include <algorithm>
+#include <vector>
 
 #include "../vehicledynamics/VehicleTypes.h"
 #include "../entities/Entity.h"
 #include "../shaders/RectShader.h"
+#include "../shaders/InstancedRectShader.h"
 #include "../Loader.h"
 
 
@@ -16,6 +18,15 @@ class RectShader;
 struct Position2D;
 
 
+// per-instance data of the instanced rectangle path, matches instancedRectShader.vert locations 1-4
+struct RectInstance {
+    float offset[2];  // NDC center
+    float scale[2];   // NDC full size
+    float yaw;        // CCW rotation [rad]
+    float color[4];   // r, g, b, a
+};
+
+
 class Renderer {
 public: 
     
@@ -23,9 +34,12 @@ public:
     // ------------------------------------------------------------------------
     Renderer(float ppm, int fbW, int fbH);
 
-    // destructor
+    // destructor deletes the instancing buffers if they were created
     // ------------------------------------------------------------------------
-    // default destructor is used. 
+    ~Renderer();
+
+    Renderer(const Renderer&) = delete;
+    Renderer& operator=(const Renderer&) = delete;
 
     /** draw
      * ------------------------------------------------------------------------
@@ -35,6 +49,37 @@ public:
     */
     void draw(const Entity& e) const;
 
+    /** Create the instancing VAO/VBO on top of the shared quad mesh
+     * ------------------------------------------------------------------------
+     * Must be called once after the OpenGL context is ready, before submit()/flush().
+     * @param[in] quad: shared unit quad mesh (its VBO and EBO are reused)
+     * @return void
+    */
+    void initInstancing(const Loader& quad);
+
+    /** Queue an entity for the next flush()
+     * ------------------------------------------------------------------------
+     * Converts meters to NDC on the CPU and appends one RectInstance.
+     * @param[in] e: entity to draw
+     * @return void
+    */
+    void submit(const Entity& e);
+
+    /** Draw all queued entities with a single glDrawElementsInstanced
+     * ------------------------------------------------------------------------
+     * The instance data is streamed into the instance VBO once per call (buffer orphaning),
+     * then the queue is cleared. Entities are drawn in submission order.
+     * @param[in] shader: instanced rectangle shader
+     * @return void
+    */
+    void flush(const InstancedRectShader& shader);
+
+    // number of instances queued since the last flush()
+    std::size_t getQueuedCount() const noexcept { return instances.size(); }
+
+    // scale from meters to NDC (x, y), used by shaders that transform points on the GPU
+    Position2D getMetersToNdcScale() const noexcept { return {2.0f * ppm / fbW, 2.0f * ppm / fbH}; }
+
 private:
     // converts a point (the object center in meters) into an NDC position for uOffset
     // ------------------------------------------------------------------------
@@ -46,5 +91,10 @@ private:
 
     float ppm{20.f};
     int fbW{0}, fbH{0};
+
+    // instancing
+    unsigned int instanceVAO{0}, instanceVBO{0};
+    std::size_t instanceCapacity{0};      // instance VBO size in instances
+    std::vector<RectInstance> instances;  // CPU staging, capacity is kept between frames
 };
 #endif
\ No newline at end of file
@@ -0,0 +1,156 @@
+#include "SceneRenderer.h"
+
+#include "../utilities/MathUtils.h"
+
+
+namespace {
+    // Unit quad in NDC-space centered at origin
+    float QUAD_VERTICES[] = {
+        0.5f,  0.5f, 0.0f,
+        0.5f, -0.5f, 0.0f,
+       -0.5f, -0.5f, 0.0f,
+       -0.5f,  0.5f, 0.0f
+    };
+
+    unsigned int QUAD_INDICES[] = {
+        0, 1, 3,
+        1, 2, 3
+    };
+
+    constexpr std::size_t QUAD_VERTEX_COUNT = sizeof(QUAD_VERTICES) / sizeof(float);
+    constexpr std::size_t QUAD_INDEX_COUNT  = sizeof(QUAD_INDICES)  / sizeof(unsigned int);
+}
+
+
+// constructor: shaders, quad mesh, renderers and the fixed entities
+// ------------------------------------------------------------------------
+SceneRenderer::SceneRenderer(int fbW, int fbH, std::size_t trajectoryCapacity, const VehicleParams& params)
+    : vehicleParams(params) {
+    // build and compile our shader program
+    // ------------------------------------
+    rectShader = std::make_unique<RectShader>();
+    instancedRectShader = std::make_unique<InstancedRectShader>();
+
+    // set up vertex data (and buffer(s)) and configure vertex attributes
+    quad = std::make_unique<Loader>(QUAD_VERTICES, QUAD_VERTEX_COUNT, QUAD_INDICES,  QUAD_INDEX_COUNT);
+
+    // renderer
+    renderer = std::make_unique<Renderer>(PPM, fbW, fbH);
+    renderer->initInstancing(*quad);
+
+    // trajectory polyline, the VBO has the same capacity as the drawn ring buffer
+    trajectoryShader = std::make_unique<TrajectoryShader>();
+    trajectoryRenderer = std::make_unique<TrajectoryRenderer>(trajectoryCapacity);
+
+    // wheels
+    vehicleParams.finalize();
+
+    // wheel anchors in car-local frame
+    anchors = {{
+        {+vehicleParams.Lf, +vehicleParams.track*0.5f},
+        {+vehicleParams.Lf, -vehicleParams.track*0.5f},
+        {-vehicleParams.Lr, -vehicleParams.track*0.5f},
+        {-vehicleParams.Lr, +vehicleParams.track*0.5f}
+    }};
+
+    // entities
+    carEntity = Entity(quad.get(), rectShader.get());
+    carEntity.setColor({0.15f, 0.65f, 0.15f, 1.0f});
+    carEntity.setWidth(CAR_LENGTH);
+    carEntity.setLength(CAR_WIDTH);
+
+    parkingEntity = Entity(quad.get(), rectShader.get());
+    parkingEntity.setColor({1.0f, 0.0f, 0.0f, 1.0f});
+    parkingEntity.setWidth(PARKING_LENGTH);
+    parkingEntity.setLength(PARKING_WIDTH);
+
+    wheelFL = Entity(quad.get(), rectShader.get()), wheelFR = Entity(quad.get(), rectShader.get());
+    wheelRL = Entity(quad.get(), rectShader.get()), wheelRR = Entity(quad.get(), rectShader.get());
+
+    const float wheelWidth = vehicleParams.wheel.width;
+    const float wheelLength = vehicleParams.wheel.length;
+    for (Entity* wheel : {&wheelFL, &wheelFR, &wheelRL, &wheelRR}) {
+        wheel->setColor({0.4f, 0.4f, 0.4f, 1.0f});
+        wheel->setWidth(wheelLength);
+        wheel->setLength(wheelWidth);
+    }
+}
+
+// target slot
+// ------------------------------------------------------------------------
+void SceneRenderer::setSlot(const Position2D& pos, float yaw) {
+    parkingEntity.setPos(pos);
+    parkingEntity.setYaw(yaw);
+}
+
+// parked cars and curbs
+// ------------------------------------------------------------------------
+void SceneRenderer::setLot(const ParkingLot* lot) {
+    obstacleEntities.clear();
+    if (!lot) return;
+    for (const Obstacle& o : lot->getObstacles()) {
+        Entity entity(quad.get(), rectShader.get());
+        entity.setColor(o.kind == ObstacleKind::ParkedCar ? std::array<float, 4>{0.35f, 0.45f, 0.6f, 1.0f}
+                                                           : std::array<float, 4>{0.5f, 0.5f, 0.5f, 1.0f});
+        entity.setYaw(o.pose.yaw());
+        entity.setWidth(2.0f * o.halfExtents.x);
+        entity.setLength(2.0f * o.halfExtents.y);
+        entity.setPos(o.pose.t);
+        obstacleEntities.push_back(entity);
+    }
+}
+
+void SceneRenderer::placeWheel(Entity& wheel, float ax, float ay, bool front,
+                      const Transform2D& car, const float& yawDraw, const float& steer) {
+
+    // car-local anchor to world position
+    wheel.setPos(car.apply({ax, ay}));
+
+    if (front) {
+        wheel.setYaw(yawDraw + steer);
+    } else {
+        wheel.setYaw(yawDraw);
+    }
+};
+
+// draw all entities including interpolation
+// ------------------------------------------------------------------------
+void SceneRenderer::draw(const VehicleState& prevState, const VehicleState& curState, float alpha, const TrajectoryBuffer& trajectory) {
+    // interpolate for smooth rendering
+    const Position2D posDraw = interp(prevState.pos, curState.pos, alpha);
+    const float yawDraw = lerpAngle(prevState.psi, curState.psi, alpha);
+    const float deltaDraw = prevState.delta + (curState.delta - prevState.delta) * alpha;
+
+    // set pos and yaw to draw the car
+    carEntity.setPos(posDraw);
+    carEntity.setYaw(yawDraw);
+
+    // render
+    // ------
+    glClearColor(0.2f, 0.3f, 0.3f, 1.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+
+    // queue entities, everything is drawn by one instanced call in flush()
+    for (const Entity& obstacle : obstacleEntities) renderer->submit(obstacle);
+    renderer->submit(parkingEntity);
+    renderer->submit(carEntity);
+
+    // one sin/cos pair for all four wheels
+    const Transform2D carDraw = Transform2D::fromPose(posDraw, yawDraw);
+    placeWheel(wheelFL, anchors[0][0], anchors[0][1], true, carDraw, yawDraw, deltaDraw);
+    placeWheel(wheelFR, anchors[1][0], anchors[1][1], true, carDraw, yawDraw, deltaDraw);
+    placeWheel(wheelRR, anchors[2][0], anchors[2][1], false, carDraw, yawDraw, 0.0f);
+    placeWheel(wheelRL, anchors[3][0], anchors[3][1], false, carDraw, yawDraw, 0.0f);
+
+    renderer->submit(wheelFL);
+    renderer->submit(wheelFR);
+    renderer->submit(wheelRR);
+    renderer->submit(wheelRL);
+
+    renderer->flush(*instancedRectShader);
+
+    // trajectory: upload only the points recorded since the last frame, then one line strip
+    const Position2D metersToNdc = renderer->getMetersToNdcScale();
+    trajectoryRenderer->sync(trajectory);
+    trajectoryRenderer->draw(*trajectoryShader, metersToNdc.x, metersToNdc.y, {0.9f, 0.9f, 0.2f, 1.0f});
+}
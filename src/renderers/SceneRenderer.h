@@ -0,0 +1,98 @@
+#ifndef SCENERENDERER_H
+#define SCENERENDERER_H
+
+#include <glad/glad.h>
+
+#include <array>
+#include <memory>
+#include <vector>
+
+#include "../core/Config.h"
+#include "../shaders/RectShader.h"
+#include "../shaders/InstancedRectShader.h"
+#include "../shaders/TrajectoryShader.h"
+#include "../Loader.h"
+#include "../entities/Entity.h"
+#include "Renderer.h"
+#include "TrajectoryRenderer.h"
+#include "../simulator/TrajectoryBuffer.h"
+#include "../vehicledynamics/VehicleTypes.h"
+#include "../utilities/Transform2D.h"
+#include "../world/ParkingLot.h"
+
+
+/**
+ * Scene Renderer Class
+ * ---------------------------
+ * The parking scene of the simulator: car, wheels, target slot, lot obstacles and the driven path,
+ * drawn with Renderer (one instanced call) and TrajectoryRenderer. It only needs a current OpenGL
+ * context, so the GLFW front end (Simulator) and the offscreen video export draw the same frames.
+ */
+class SceneRenderer {
+public:
+    /** Create the shaders, the quad mesh and the renderers (needs a current GL context)
+     * ----------------------------------------------------------------------------
+     * @param[in] fbW, fbH: framebuffer size [px]
+     * @param[in] trajectoryCapacity: capacity of the TrajectoryBuffers passed to draw()
+     * @param[in] vehicleParams: wheel anchors and sizes
+     */
+    SceneRenderer(int fbW, int fbH, std::size_t trajectoryCapacity, const VehicleParams& vehicleParams = VehicleParams{});
+
+    SceneRenderer(const SceneRenderer&) = delete;
+    SceneRenderer& operator=(const SceneRenderer&) = delete;
+
+    // target slot pose
+    void setSlot(const Position2D& pos, float yaw);
+
+    // parked cars and curbs of a lot, nullptr = none
+    void setLot(const ParkingLot* lot);
+
+    /** Draw one frame into the bound framebuffer
+     * ----------------------------------------------------------------------------
+     * 1. Interpolate position, yaw and steering between prev and cur with alpha
+     * 2. Submit obstacles, slot, car and wheels and render them with one instanced draw call
+     * 3. Upload the trajectory points recorded since the last frame and draw them as a line strip
+     *
+     * @param[in] prev, cur: vehicle states around the frame time
+     * @param[in] alpha: interpolation factor in [0, 1]
+     * @param[in] trajectory: driven path, capacity as given to the constructor
+     * @return void
+     */
+    void draw(const VehicleState& prev, const VehicleState& cur, float alpha, const TrajectoryBuffer& trajectory);
+
+private:
+    VehicleParams vehicleParams;
+
+    // Renderer
+    std::unique_ptr<RectShader> rectShader;
+    std::unique_ptr<InstancedRectShader> instancedRectShader;
+    std::unique_ptr<Loader> quad;
+    std::unique_ptr<Renderer> renderer;
+    std::unique_ptr<TrajectoryShader> trajectoryShader;
+    std::unique_ptr<TrajectoryRenderer> trajectoryRenderer;
+
+    // Scene entities
+    Entity carEntity = Entity(quad.get(), rectShader.get());
+    Entity parkingEntity = Entity(quad.get(), rectShader.get());
+    Entity wheelFL = Entity(quad.get(), rectShader.get());
+    Entity wheelFR = Entity(quad.get(), rectShader.get());
+    Entity wheelRL = Entity(quad.get(), rectShader.get());
+    Entity wheelRR = Entity(quad.get(), rectShader.get());
+    std::array<std::array<float, 2>, 4> anchors;
+    std::vector<Entity> obstacleEntities;
+
+    void placeWheel(Entity& wheel, float ax, float ay, bool front,
+                    const Transform2D& car, const float& yawDraw, const float& steer);
+
+    // Linear interpolation for positions
+    inline float lerp(float a, float b, float t) { return a + (b - a) * t; }
+
+    // Interpolate Position2D (positions); for headings, use lerpAngle on psi
+    inline Position2D interp(const Position2D& prev, const Position2D& curr, float alpha) {
+        return Position2D{
+            lerp(prev.x, curr.x, alpha),
+            lerp(prev.y, curr.y, alpha)
+        };
+    }
+};
+#endif
@@ -0,0 +1,88 @@
+#include "TrajectoryRenderer.h"
+
+
+// constructor
+// ------------------------------------------------------------------------
+TrajectoryRenderer::TrajectoryRenderer(std::size_t capacity) : capacity(capacity) {
+    glGenVertexArrays(1, &vao);
+    glGenBuffers(1, &vbo);
+
+    glBindVertexArray(vao);
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+
+    // capacity ring slots + 1 mirror of slot 0, allocated once
+    glBufferData(GL_ARRAY_BUFFER, (capacity + 1) * sizeof(TrajectoryPoint), nullptr, GL_DYNAMIC_DRAW);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(TrajectoryPoint), (void*)0);
+    glEnableVertexAttribArray(0);
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindVertexArray(0);
+}
+
+// destructor
+// ------------------------------------------------------------------------
+TrajectoryRenderer::~TrajectoryRenderer() {
+    glDeleteBuffers(1, &vbo);
+    glDeleteVertexArrays(1, &vao);
+}
+
+// upload the points pushed since the last sync
+// ------------------------------------------------------------------------
+void TrajectoryRenderer::sync(const TrajectoryBuffer& trajectory) {
+    const uint64_t total = trajectory.getTotalPushed();
+    const uint64_t newPoints = total - syncedTotal;
+
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    if (newPoints >= capacity) {
+        uploadSlots(trajectory, 0, capacity);
+    } else if (newPoints > 0) {
+        // the new points are the slots just before head, possibly wrapping around
+        const std::size_t n = static_cast<std::size_t>(newPoints);
+        const std::size_t head = trajectory.getHead();
+        const std::size_t first = (head >= n) ? head - n : head + capacity - n;
+        if (first + n <= capacity) {
+            uploadSlots(trajectory, first, n);
+        } else {
+            uploadSlots(trajectory, first, capacity - first);
+            uploadSlots(trajectory, 0, n - (capacity - first));
+        }
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    syncedTotal = total;
+    syncedHead = trajectory.getHead();
+    syncedCount = trajectory.size();
+}
+
+// copy ring slots [first, first + count) into the VBO (bound by the caller)
+// ------------------------------------------------------------------------
+void TrajectoryRenderer::uploadSlots(const TrajectoryBuffer& trajectory, std::size_t first, std::size_t count) {
+    if (count == 0) return;
+    glBufferSubData(GL_ARRAY_BUFFER, first * sizeof(TrajectoryPoint), count * sizeof(TrajectoryPoint), trajectory.data() + first);
+
+    // keep the mirror slot in sync with slot 0
+    if (first == 0) {
+        glBufferSubData(GL_ARRAY_BUFFER, capacity * sizeof(TrajectoryPoint), sizeof(TrajectoryPoint), trajectory.data());
+    }
+}
+
+// draw the synced trajectory
+// ------------------------------------------------------------------------
+void TrajectoryRenderer::draw(const TrajectoryShader& shader, float metersToNdcX, float metersToNdcY, const std::array<float, 4>& color) const {
+    if (syncedCount < 2) return;
+
+    shader.use();
+    shader.setMetersToNdc(metersToNdcX, metersToNdcY);
+    shader.setColor(color[0], color[1], color[2], color[3]);
+
+    glBindVertexArray(vao);
+    if (syncedCount < capacity || syncedHead == 0) {
+        // not wrapped: oldest point is in slot 0
+        glDrawArrays(GL_LINE_STRIP, 0, static_cast<GLsizei>(syncedCount));
+    } else {
+        // wrapped: [oldest .. mirror of slot 0] then [slot 0 .. newest]
+        glDrawArrays(GL_LINE_STRIP, static_cast<GLint>(syncedHead), static_cast<GLsizei>(capacity - syncedHead + 1));
+        glDrawArrays(GL_LINE_STRIP, 0, static_cast<GLsizei>(syncedHead));
+    }
+    glBindVertexArray(0);
+}
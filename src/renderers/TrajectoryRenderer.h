@@ -0,0 +1,63 @@
+#ifndef TRAJECTORYRENDERER_H
+#define TRAJECTORYRENDERER_H
+
+#include <glad/glad.h>
+
+#include <array>
+#include <cstdint>
+
+#include "../shaders/TrajectoryShader.h"
+#include "../simulator/TrajectoryBuffer.h"
+
+
+/**
+ * Trajectory Renderer Class
+ * ---------------------------
+ * Draws a TrajectoryBuffer as a line strip.
+ *
+ * The VBO mirrors the ring storage slot by slot plus one extra slot holding a copy of slot 0, so
+ * a wrapped ring is drawn as two strips [oldest .. capacity] and [0 .. newest] without a gap.
+ * sync() uploads only the slots written since the previous sync with glBufferSubData, so the
+ * upload cost per frame depends on the new points, not on the trajectory length.
+ */
+class TrajectoryRenderer {
+public:
+    // constructor creates a VBO for capacity + 1 points (needs a current GL context)
+    // ------------------------------------------------------------------------
+    explicit TrajectoryRenderer(std::size_t capacity);
+
+    // destructor
+    // ------------------------------------------------------------------------
+    ~TrajectoryRenderer();
+
+    TrajectoryRenderer(const TrajectoryRenderer&) = delete;
+    TrajectoryRenderer& operator=(const TrajectoryRenderer&) = delete;
+
+    /** Upload the points pushed since the last sync
+     * ------------------------------------------------------------------------
+     * @param[in] trajectory: ring buffer with the same capacity as this renderer
+     * @return void
+    */
+    void sync(const TrajectoryBuffer& trajectory);
+
+    /** Draw the synced trajectory as a line strip
+     * ------------------------------------------------------------------------
+     * @param[in] shader: trajectory shader
+     * @param[in] metersToNdcX, metersToNdcY: scale from meters to NDC (see Renderer::getMetersToNdcScale)
+     * @param[in] color: line color r, g, b, a
+     * @return void
+    */
+    void draw(const TrajectoryShader& shader, float metersToNdcX, float metersToNdcY, const std::array<float, 4>& color) const;
+
+private:
+    unsigned int vao{0}, vbo{0};
+    std::size_t capacity{0};
+
+    // ring state at the last sync
+    uint64_t syncedTotal{0};
+    std::size_t syncedHead{0};
+    std::size_t syncedCount{0};
+
+    void uploadSlots(const TrajectoryBuffer& trajectory, std::size_t first, std::size_t count);
+};
+#endif
@@ -0,0 +1,183 @@
+#include "AsyncEnvPool.h"
+
+#include <algorithm>
+
+#include "../utilities/Logger.h"
+
+
+// constructor
+// ------------------------------------------------------------------------
+AsyncEnvPool::AsyncEnvPool(const AsyncEnvPoolConfig& newConfig) : config(newConfig) {
+    const std::size_t n = config.numEnvs;
+    config.maxChunk = std::max<std::size_t>(1, config.maxChunk);
+
+    // one RNG per env: envs are stepped by any worker in any order
+    randomizers.reserve(n);
+    envs.reserve(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        randomizers.push_back(std::make_unique<Randomizer>(config.seed));
+        envs.push_back(std::make_unique<ParkingEnv>(randomizers.back().get()));
+        ParkingEnv& env = *envs.back();
+        env.setEnvIndex(i);
+        env.setActionRepeat(config.actionRepeat);
+        env.setMaxEpisodeSteps(config.maxEpisodeSteps);
+        env.setLot(config.lot);
+    }
+    actions.resize(n);
+    inFlight.assign(n, 0);
+    requests.resize(std::max<std::size_t>(n, 1));
+    results.resize(std::max<std::size_t>(n, 1));
+
+    std::size_t numThreads = config.numThreads;
+    if (numThreads == 0) numThreads = std::max(1u, std::thread::hardware_concurrency());
+    workers.reserve(numThreads);
+    for (std::size_t t = 0; t < numThreads; ++t) workers.emplace_back(&AsyncEnvPool::workerLoop, this);
+}
+
+// destructor
+// ------------------------------------------------------------------------
+AsyncEnvPool::~AsyncEnvPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    requestCv.notify_all();
+    for (auto& worker : workers) worker.join();
+}
+
+// queue a reset of every env
+// ------------------------------------------------------------------------
+bool AsyncEnvPool::asyncReset() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (std::find(inFlight.begin(), inFlight.end(), uint8_t{1}) != inFlight.end()) {
+            CAR_LOG_WARN("AsyncEnvPool::asyncReset: %zu requests still in flight", pending);
+            return false;
+        }
+        for (std::size_t i = 0; i < config.numEnvs; ++i) {
+            inFlight[i] = 1;
+            pushRequest(static_cast<uint32_t>(i), true);
+        }
+        pending += config.numEnvs;
+    }
+    requestCv.notify_all();
+    return true;
+}
+
+// queue one step per env
+// ------------------------------------------------------------------------
+bool AsyncEnvPool::sendActions(const uint32_t* ids, const Action* newActions, std::size_t count) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (std::size_t k = 0; k < count; ++k) {
+            const uint32_t id = ids[k];
+            if (id < config.numEnvs && !inFlight[id]) {
+                inFlight[id] = 1;
+                continue;
+            }
+            // undo the marks of this call, nothing is queued
+            for (std::size_t j = 0; j < k; ++j) inFlight[ids[j]] = 0;
+            CAR_LOG_WARN("AsyncEnvPool::sendActions: env %u is out of range or already in flight", id);
+            return false;
+        }
+        for (std::size_t k = 0; k < count; ++k) {
+            actions[ids[k]] = newActions[k];
+            pushRequest(ids[k], false);
+        }
+        pending += count;
+    }
+    if (count > 1) requestCv.notify_all();
+    else if (count == 1) requestCv.notify_one();
+    return true;
+}
+
+// wait for the first batchSize results
+// ------------------------------------------------------------------------
+std::size_t AsyncEnvPool::recvResults(std::size_t batchSize, AsyncEnvResult* out) {
+    std::unique_lock<std::mutex> lock(mutex);
+    const std::size_t wanted = std::min(batchSize, pending);
+    resultCv.wait(lock, [&] { return resultCount >= wanted; });
+
+    const std::size_t capacity = results.size();
+    for (std::size_t k = 0; k < wanted; ++k) {
+        out[k] = results[resultHead];
+        inFlight[out[k].envId] = 0;
+        resultHead = (resultHead + 1) % capacity;
+    }
+    resultCount -= wanted;
+    pending -= wanted;
+    return wanted;
+}
+
+// requests not yet received
+// ------------------------------------------------------------------------
+std::size_t AsyncEnvPool::getPending() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return pending;
+}
+
+// append to the request ring, caller holds the mutex
+// ------------------------------------------------------------------------
+void AsyncEnvPool::pushRequest(uint32_t envId, bool reset) {
+    requests[(requestHead + requestCount) % requests.size()] = Request{envId, reset};
+    ++requestCount;
+}
+
+// take a chunk of requests, run them unlocked, publish the results
+// ------------------------------------------------------------------------
+void AsyncEnvPool::workerLoop() {
+    std::vector<Request> chunk(config.maxChunk);
+    std::vector<AsyncEnvResult> done(config.maxChunk);
+
+    std::unique_lock<std::mutex> lock(mutex);
+    for (;;) {
+        requestCv.wait(lock, [this] { return stopping || requestCount > 0; });
+        if (stopping) return;
+
+        // a fair share of the queue, so that a burst of requests spreads over the workers
+        const std::size_t share = (requestCount + workers.size() - 1) / workers.size();
+        const std::size_t take = std::min(config.maxChunk, share);
+        for (std::size_t k = 0; k < take; ++k) {
+            chunk[k] = requests[requestHead];
+            requestHead = (requestHead + 1) % requests.size();
+        }
+        requestCount -= take;
+        lock.unlock();
+
+        for (std::size_t k = 0; k < take; ++k) runRequest(chunk[k], done[k]);
+
+        lock.lock();
+        const std::size_t capacity = results.size();
+        for (std::size_t k = 0; k < take; ++k) {
+            results[(resultHead + resultCount) % capacity] = done[k];
+            ++resultCount;
+        }
+        resultCv.notify_one();
+    }
+}
+
+// step or reset one env, auto-reset after the last step of an episode
+// ------------------------------------------------------------------------
+void AsyncEnvPool::runRequest(const Request& request, AsyncEnvResult& result) {
+    ParkingEnv& env = *envs[request.envId];
+    result.envId = request.envId;
+    if (request.reset) {
+        env.reset();
+        env.observe(result.obs);
+        result.reward = 0.0f;
+        result.terminated = false;
+        result.truncated = false;
+        return;
+    }
+
+    StepResult step;
+    env.stepInto(actions[request.envId], config.simDt, result.obs, step);
+    result.reward = step.reward;
+    result.terminated = step.terminated;
+    result.truncated = step.truncated;
+    if (step.done) {
+        result.finalObs = result.obs;
+        env.reset();
+        env.observe(result.obs);
+    }
+}
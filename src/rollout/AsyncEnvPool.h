@@ -0,0 +1,132 @@
+#ifndef ASYNCENVPOOL_H
+#define ASYNCENVPOOL_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "../envs/ParkingEnv.h"
+#include "../utilities/Randomizer.h"
+#include "../vehicledynamics/VehicleTypes.h"
+#include "../world/ParkingLot.h"
+
+
+struct AsyncEnvPoolConfig {
+    std::size_t numEnvs{256};
+    std::size_t numThreads{0};      // 0 = std::thread::hardware_concurrency()
+    std::size_t maxChunk{16};       // envs a worker takes per lock, amortizes the queue lock over cheap steps
+    float simDt{0.01f};
+    int actionRepeat{1};            // physics substeps of simDt per env step (ParkingEnv::setActionRepeat)
+    std::size_t maxEpisodeSteps{0}; // episode truncation in env steps, 0 = none (ParkingEnv::setMaxEpisodeSteps)
+    uint64_t seed{0};               // global seed, env i resets from the random stream (seed, i, episode)
+    const ParkingLot* lot{nullptr}; // shared, read-only lot, nullptr = single slot per env
+};
+
+// result of one env step (or reset) handed out by recvResults()
+struct AsyncEnvResult {
+    uint32_t envId{0};
+    float reward{0.0f};
+    bool terminated{false};     // the env was reset after this step, obs is the first state of the next episode
+    bool truncated{false};      // max episode steps reached, the env was reset after this step
+    Observation obs;            // observation after the step (after the auto-reset if the episode ended)
+    Observation finalObs;       // last observation of the finished episode, valid if terminated || truncated
+};
+
+/**
+ * Async Env Pool Class
+ * ---------------------------
+ * EnvPool-style asynchronous stepping of ParkingEnv instances: sendActions() queues actions for some
+ * envs and returns at once, worker threads step them in the background, and recvResults() hands out
+ * the results of whichever envs finished first. A learner that sends batch k + 1 while it runs the
+ * policy on batch k keeps the workers busy, and an env that is slow to step (reset, many obstacles
+ * to check) only delays its own result instead of the whole batch.
+ *
+ * Finished episodes are reset by the worker right after the step (auto-reset). Each env has its own
+ * Randomizer, so an env's trajectory for a given seed and action sequence does not depend on which
+ * thread steps it or on the order in which results come back.
+ *
+ * Every env holds at most one request at a time: send an env again only after its result has been
+ * received. The queues are preallocated for numEnvs entries and guarded by one mutex; workers take up to
+ * maxChunk envs per lock and publish their results in one lock.
+ */
+class AsyncEnvPool {
+public:
+    // constructor, starts the worker threads
+    // ------------------------------------------------------------------------
+    explicit AsyncEnvPool(const AsyncEnvPoolConfig& config);
+
+    // destructor, drops queued requests and joins the workers
+    // ------------------------------------------------------------------------
+    ~AsyncEnvPool();
+
+    AsyncEnvPool(const AsyncEnvPool&) = delete;
+    AsyncEnvPool& operator=(const AsyncEnvPool&) = delete;
+
+    /** Queue a reset of every env
+     * ----------------------------------------------------------------------------
+     * Each reset produces one result (reward 0, no flags) with the first observation.
+     *
+     * @return bool: false (nothing queued) if some env still has a request in flight
+     */
+    bool asyncReset();
+
+    /** Queue one step for each of count envs and return without waiting
+     * ----------------------------------------------------------------------------
+     * @param[in] ids: env ids in [0, numEnvs), each at most once
+     * @param[in] actions: action of env ids[k] at actions[k]
+     * @param[in] count: number of envs
+     * @return bool: false (nothing queued, logged) if an id is out of range or already in flight
+     */
+    bool sendActions(const uint32_t* ids, const Action* actions, std::size_t count);
+
+    /** Wait for the results of batchSize envs, the first that finished
+     * ----------------------------------------------------------------------------
+     * batchSize is clamped to the number of requests not yet received, so the call never waits for
+     * envs that were not sent.
+     *
+     * @param[in] batchSize: number of results wanted
+     * @param[out] out: at least batchSize results
+     * @return std::size_t: number of results written
+     */
+    std::size_t recvResults(std::size_t batchSize, AsyncEnvResult* out);
+
+    // getter
+    std::size_t getNumEnvs() const noexcept { return config.numEnvs; }
+    std::size_t getNumThreads() const noexcept { return workers.size(); }
+    std::size_t getPending() const;         // requests sent and not yet received
+    const ParkingEnv& getEnv(std::size_t i) const { return *envs[i]; }   // only while env i is not in flight
+
+private:
+    struct Request {
+        uint32_t envId;
+        bool reset;
+    };
+
+    AsyncEnvPoolConfig config;
+    std::vector<std::unique_ptr<Randomizer>> randomizers;
+    std::vector<std::unique_ptr<ParkingEnv>> envs;
+    std::vector<Action> actions;            // pending action per env, written before its request is queued
+    std::vector<uint8_t> inFlight;          // 1 from send until recv, guarded by mutex
+
+    // fixed-capacity rings, an env is in at most one of them at a time
+    std::vector<Request> requests;
+    std::size_t requestHead{0}, requestCount{0};
+    std::vector<AsyncEnvResult> results;
+    std::size_t resultHead{0}, resultCount{0};
+    std::size_t pending{0};                 // requests queued or running or with an unreceived result
+
+    mutable std::mutex mutex;
+    std::condition_variable requestCv;
+    std::condition_variable resultCv;
+    bool stopping{false};
+    std::vector<std::thread> workers;
+
+    void workerLoop();
+    void pushRequest(uint32_t envId, bool reset);
+    void runRequest(const Request& request, AsyncEnvResult& result);
+};
+#endif
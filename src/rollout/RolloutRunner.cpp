@@ -0,0 +1,135 @@
+#include "RolloutRunner.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+
+
+// constructor
+// ------------------------------------------------------------------------
+RolloutRunner::RolloutRunner(const RolloutConfig& config) : config(config), pool(config.numThreads) {
+    const std::size_t shardSize = std::max<std::size_t>(1, config.shardSize);
+    const std::size_t numShards = (config.numEnvs + shardSize - 1) / shardSize;
+
+    shards.resize(numShards);
+    for (std::size_t s = 0; s < numShards; ++s) {
+        Shard& shard = shards[s];
+        shard.firstEnv = s * shardSize;
+        const std::size_t count = std::min(shardSize, config.numEnvs - shard.firstEnv);
+
+        // one RNG per shard: a shard is only ever stepped by one thread at a time,
+        // each env switches to its own stream on reset so results do not depend on scheduling
+        shard.randomizer = std::make_unique<Randomizer>(config.seed);
+        shard.envs.reserve(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            shard.envs.emplace_back(shard.randomizer.get());
+            shard.envs.back().setEnvIndex(shard.firstEnv + i);
+            shard.envs.back().setActionRepeat(config.actionRepeat);
+            shard.envs.back().setMaxEpisodeSteps(config.maxEpisodeSteps);
+        }
+        shard.obs.resize(count);
+        shard.actions.resize(count);
+        shard.transitions.resize(count * config.stepsPerRun);
+    }
+
+    workerStats.resize(pool.size());
+}
+
+// reset all environments
+// ------------------------------------------------------------------------
+void RolloutRunner::reset() {
+    pool.parallelFor(shards.size(), [this](std::size_t s, std::size_t) {
+        Shard& shard = shards[s];
+        for (std::size_t i = 0; i < shard.envs.size(); ++i) {
+            shard.envs[i].reset();
+            shard.envs[i].observe(shard.obs[i]);
+        }
+    });
+}
+
+// step every shard for stepsPerRun steps
+// ------------------------------------------------------------------------
+void RolloutRunner::run(const RolloutPolicy& policy) {
+    std::vector<uint64_t> stolenBefore(pool.size());
+    for (std::size_t w = 0; w < pool.size(); ++w) {
+        stolenBefore[w] = pool.getStolenCount(w);
+        workerStats[w] = WorkerStats{};
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    pool.parallelFor(shards.size(), [&](std::size_t s, std::size_t worker) {
+        runShard(shards[s], policy, workerStats[worker]);
+    });
+    lastRunSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    for (std::size_t w = 0; w < pool.size(); ++w) {
+        workerStats[w].stolenShards = pool.getStolenCount(w) - stolenBefore[w];
+    }
+}
+
+// step one shard, executed by a single worker
+// ------------------------------------------------------------------------
+void RolloutRunner::runShard(Shard& shard, const RolloutPolicy& policy, WorkerStats& stats) {
+    const auto start = std::chrono::steady_clock::now();
+    const std::size_t count = shard.envs.size();
+    const BicycleModelLimits limits;
+
+    for (std::size_t t = 0; t < config.stepsPerRun; ++t) {
+        policy(shard.firstEnv, shard.obs.data(), shard.actions.data(), count);
+
+        Transition* row = shard.transitions.data() + t * count;
+        for (std::size_t i = 0; i < count; ++i) {
+            Transition& tr = row[i];
+            StepResult result;
+            tr.obs = shard.obs[i];
+            tr.action.steeringAngle = std::clamp(shard.actions[i].steeringAngle, -limits.delta_max, limits.delta_max);
+            tr.action.acceleration = std::clamp(shard.actions[i].acceleration, -limits.a_max, limits.a_max);
+            shard.envs[i].stepInto(tr.action, config.simDt, tr.nextObs, result);
+            tr.reward = result.reward;
+            tr.terminated = result.terminated;
+            tr.truncated = result.truncated;
+
+            // finished episodes restart right away, the next step starts from the new episode
+            if (result.done) {
+                shard.envs[i].reset();
+                shard.envs[i].observe(shard.obs[i]);
+            } else {
+                shard.obs[i] = tr.nextObs;
+            }
+            tr.envIndex = static_cast<uint32_t>(shard.firstEnv + i);
+            tr.step = static_cast<uint32_t>(t);
+        }
+    }
+
+    stats.steps += count * config.stepsPerRun;
+    stats.shards += 1;
+    stats.busySeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// transition of env envIndex at step of the last run
+// ------------------------------------------------------------------------
+const Transition& RolloutRunner::getTransition(std::size_t envIndex, std::size_t step) const {
+    const std::size_t shardSize = std::max<std::size_t>(1, config.shardSize);
+    const Shard& shard = shards[envIndex / shardSize];
+    return shard.transitions[step * shard.envs.size() + (envIndex - shard.firstEnv)];
+}
+
+// print per-thread and total throughput
+// ------------------------------------------------------------------------
+void RolloutRunner::printStats(std::ostream& os) const {
+    uint64_t totalSteps = 0;
+    os << "worker      steps     shards   stolen    busy[s]     steps/s\n";
+    for (std::size_t w = 0; w < workerStats.size(); ++w) {
+        const WorkerStats& s = workerStats[w];
+        totalSteps += s.steps;
+        os << std::setw(6) << w
+           << std::setw(11) << s.steps
+           << std::setw(11) << s.shards
+           << std::setw(9) << s.stolenShards
+           << std::setw(11) << std::fixed << std::setprecision(3) << s.busySeconds
+           << std::setw(12) << std::setprecision(0) << s.stepsPerSecond() << "\n";
+    }
+    const double total = lastRunSeconds > 0.0 ? totalSteps / lastRunSeconds : 0.0;
+    os << "total " << totalSteps << " steps in " << std::setprecision(3) << lastRunSeconds
+       << " s, " << std::setprecision(0) << total << " steps/s on " << workerStats.size() << " threads\n";
+}
@@ -0,0 +1,119 @@
+#ifndef ROLLOUTRUNNER_H
+#define ROLLOUTRUNNER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <ostream>
+#include <vector>
+
+#include "../envs/ParkingEnv.h"
+#include "../utilities/Randomizer.h"
+#include "../utilities/WorkStealingPool.h"
+#include "../vehicledynamics/VehicleTypes.h"
+
+
+// one environment step
+struct Transition {
+    Observation obs;          // observation before the step
+    Action action;            // applied action (the policy's action clamped to the model limits)
+    float reward{0.0f};
+    Observation nextObs;      // observation after the step (the last one of the episode if it ended)
+    bool terminated{false};   // the car parked, collided or left the lot, the env was reset after this step
+    bool truncated{false};    // max episode steps reached, the env was reset after this step
+    uint32_t envIndex{0};
+    uint32_t step{0};
+};
+
+/**
+ * @brief Policy callback, fills actions[0..count) from obs[0..count).
+ *
+ * Called once per shard and step with the shard's envs [firstEnv, firstEnv + count).
+ * It is called concurrently from several worker threads for different shards, so it must be
+ * thread-safe (e.g. only read shared policy weights).
+ */
+using RolloutPolicy = std::function<void(std::size_t firstEnv, const Observation* obs, Action* actions, std::size_t count)>;
+
+struct RolloutConfig {
+    std::size_t numEnvs{1024};
+    std::size_t shardSize{64};      // envs per shard, the unit of work stealing
+    std::size_t stepsPerRun{100};   // K steps per env in one run()
+    std::size_t numThreads{0};      // 0 = std::thread::hardware_concurrency()
+    float simDt{0.01f};
+    int actionRepeat{1};            // physics substeps of simDt per env step (ParkingEnv::setActionRepeat)
+    std::size_t maxEpisodeSteps{0}; // episode truncation in env steps, 0 = none (ParkingEnv::setMaxEpisodeSteps)
+    uint64_t seed{0};               // global seed, env i resets from the random stream (seed, i, episode)
+};
+
+// throughput of one worker thread during the last run()
+struct WorkerStats {
+    uint64_t steps{0};            // env steps executed
+    uint64_t shards{0};           // shards executed
+    uint64_t stolenShards{0};     // shards taken from other workers
+    double busySeconds{0.0};      // time spent stepping shards
+
+    double stepsPerSecond() const { return busySeconds > 0.0 ? steps / busySeconds : 0.0; }
+};
+
+/**
+ * Rollout Runner Class
+ * ---------------------------
+ * This class shards a batch of ParkingEnv instances across a WorkStealingPool.
+ * run() steps every shard for K steps with the policy callback and records every transition.
+ *
+ * Transitions are written into a buffer preallocated per shard ([step][env in shard]), so the
+ * stepping threads never allocate and a shard writes to the same memory whichever thread runs it.
+ */
+class RolloutRunner {
+public:
+    // constructor
+    // ------------------------------------------------------------------------
+    explicit RolloutRunner(const RolloutConfig& config);
+
+    /**
+     * @brief Reset all environments.
+     *
+     * @return void
+     */
+    void reset();
+
+    /**
+     * @brief Step every environment for stepsPerRun steps.
+     *
+     * @param[in] policy: policy callback
+     * @return void
+     */
+    void run(const RolloutPolicy& policy);
+
+    // transition of env envIndex at step (0 <= step < stepsPerRun) of the last run()
+    const Transition& getTransition(std::size_t envIndex, std::size_t step) const;
+
+    // getter
+    std::size_t getNumEnvs() const noexcept { return config.numEnvs; }
+    std::size_t getNumThreads() const noexcept { return pool.size(); }
+    const std::vector<WorkerStats>& getWorkerStats() const noexcept { return workerStats; }
+    double getLastRunSeconds() const noexcept { return lastRunSeconds; }
+
+    // print per-thread and total throughput of the last run()
+    void printStats(std::ostream& os) const;
+
+private:
+    struct Shard {
+        std::size_t firstEnv{0};
+        std::unique_ptr<Randomizer> randomizer;
+        std::vector<ParkingEnv> envs;
+        std::vector<Observation> obs;
+        std::vector<Action> actions;
+        std::vector<Transition> transitions;
+    };
+
+    RolloutConfig config;
+    WorkStealingPool pool;
+    std::vector<Shard> shards;
+    std::vector<WorkerStats> workerStats;
+    double lastRunSeconds{0.0};
+
+    void runShard(Shard& shard, const RolloutPolicy& policy, WorkerStats& stats);
+};
+#endif
@@ -0,0 +1,184 @@
+#include "BevRasterizer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "../core/Config.h"
+#include "../utilities/Logger.h"
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define CAR_BEV_RASTERIZER_SSE2 1
+#endif
+
+
+namespace {
+    constexpr uint8_t BEV_ON = 255;
+
+    // ceil of a value already clamped to >= 0, without the std::ceil library call
+    inline int ceilNonNeg(float v) noexcept {
+        const int t = static_cast<int>(v);
+        return t + (static_cast<float>(t) < v);
+    }
+
+    // 1 / v with |v| kept >= 1e-12, so axis-aligned rectangles need no special case (see rayBoxDistance)
+    inline float safeInverse(float v) noexcept {
+        return 1.0f / (std::fabs(v) < 1e-12f ? std::copysign(1e-12f, v) : v);
+    }
+
+#ifdef CAR_BEV_RASTERIZER_SSE2
+    // loadu(PREFIX_MASK + 16 - k) has the first k bytes set
+    alignas(16) constexpr uint8_t PREFIX_MASK[32] = {
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
+
+    inline __m128i prefixMask(int k) noexcept {
+        k = std::clamp(k, 0, 16);
+        return _mm_loadu_si128(reinterpret_cast<const __m128i*>(PREFIX_MASK + 16 - k));
+    }
+#endif
+
+    // set the columns [c0, c1) of a row, 0 <= c0, c1 <= width
+    inline void fillSpan(uint8_t* row, int c0, int c1, int width) noexcept {
+        if (c0 >= c1) return;
+#ifdef CAR_BEV_RASTERIZER_SSE2
+        // 16-byte chunks around the span, only the span bytes of the mask are set
+        for (int c = c0 & ~15; c < c1; c += 16) {
+            if (c + 16 > width) {
+                // a chunk would pass the row end (and possibly the buffer end)
+                std::memset(row + std::max(c, c0), BEV_ON, static_cast<std::size_t>(c1 - std::max(c, c0)));
+                break;
+            }
+            const __m128i mask = _mm_andnot_si128(prefixMask(c0 - c), prefixMask(c1 - c));
+            __m128i* p = reinterpret_cast<__m128i*>(row + c);
+            _mm_storeu_si128(p, _mm_or_si128(_mm_loadu_si128(p), mask));
+        }
+#else
+        (void)width;
+        std::memset(row + c0, BEV_ON, static_cast<std::size_t>(c1 - c0));
+#endif
+    }
+}
+
+
+// set the image size
+// ------------------------------------------------------------------------
+void BevRasterizer::configure(const BevConfig& newConfig) {
+    config = newConfig;
+    if (config.width > BEV_MAX_SIZE || config.height > BEV_MAX_SIZE) CAR_LOG_WARN("BEV image size clamped to %d", BEV_MAX_SIZE);
+    config.width = std::clamp(config.width, 0, BEV_MAX_SIZE);
+    config.height = std::clamp(config.height, 0, BEV_MAX_SIZE);
+    if (!(config.resolution > 0.0f)) {
+        CAR_LOG_WARN("BEV resolution must be positive, using 0.1 m");
+        config.resolution = 0.1f;
+    }
+    invResolution = 1.0f / config.resolution;
+    viewRadius = 0.5f * config.resolution * std::sqrt(static_cast<float>(config.width * config.width + config.height * config.height));
+}
+
+// fill an oriented rectangle into one layer
+// ------------------------------------------------------------------------
+void BevRasterizer::fillRect(const Transform2D& rect, const Position2D& half, uint8_t* layer) const noexcept {
+    const int width = config.width, height = config.height;
+    const float ir = invResolution;
+
+    // rectangle in pixel coordinates: u = column (car -y), v = row (car -x), pixel (r, c) centered at (c + 0.5, r + 0.5)
+    const float cu = 0.5f * width - rect.t.y * ir;
+    const float cv = 0.5f * height - rect.t.x * ir;
+    const float hx = half.x * ir, hy = half.y * ir;
+    // pixel directions of the rectangle axes: x -> (-s, -c), y -> (-c, s)
+    const float av = -rect.c, bv = rect.s;
+    const float ia = safeInverse(-rect.s), ib = safeInverse(-rect.c);
+
+    // rows whose center lies within the vertical extent
+    const float extent = std::fabs(rect.c) * hx + std::fabs(rect.s) * hy;
+    const int r0 = ceilNonNeg(std::clamp(cv - extent - 0.5f, 0.0f, static_cast<float>(height)));
+    const int r1 = ceilNonNeg(std::clamp(cv + extent - 0.5f, 0.0f, static_cast<float>(height)));  // exclusive
+    if (r0 >= r1) return;
+
+    // the row at offset dv from the center is covered where |du * (-s) + dv * av| <= hx and |du * (-c) + dv * bv| <= hy
+#ifdef CAR_BEV_RASTERIZER_SSE2
+    const __m128 vcu = _mm_set1_ps(cu - 0.5f);
+    const __m128 vhx = _mm_set1_ps(hx), vhy = _mm_set1_ps(hy);
+    const __m128 vav = _mm_set1_ps(av), vbv = _mm_set1_ps(bv);
+    const __m128 via = _mm_set1_ps(ia), vib = _mm_set1_ps(ib);
+    const __m128 zero = _mm_setzero_ps(), wmax = _mm_set1_ps(static_cast<float>(width));
+    const __m128 step = _mm_set1_ps(4.0f);
+    __m128 dv = _mm_add_ps(_mm_set1_ps(r0 + 0.5f - cv), _mm_set_ps(3.0f, 2.0f, 1.0f, 0.0f));
+    alignas(16) int32_t first[4], last[4];
+
+    for (int r = r0; r < r1; r += 4) {
+        // column spans of 4 rows, both slabs
+        const __m128 ka = _mm_mul_ps(dv, vav), kb = _mm_mul_ps(dv, vbv);
+        const __m128 a0 = _mm_mul_ps(_mm_sub_ps(_mm_sub_ps(zero, vhx), ka), via);
+        const __m128 a1 = _mm_mul_ps(_mm_sub_ps(vhx, ka), via);
+        const __m128 b0 = _mm_mul_ps(_mm_sub_ps(_mm_sub_ps(zero, vhy), kb), vib);
+        const __m128 b1 = _mm_mul_ps(_mm_sub_ps(vhy, kb), vib);
+        const __m128 lo = _mm_add_ps(_mm_max_ps(_mm_min_ps(a0, a1), _mm_min_ps(b0, b1)), vcu);
+        const __m128 hi = _mm_add_ps(_mm_min_ps(_mm_max_ps(a0, a1), _mm_max_ps(b0, b1)), vcu);
+
+        // first / one past the last column with its center inside: ceil(lo - 0.5), ceil(hi - 0.5)
+        const __m128 cl = _mm_min_ps(_mm_max_ps(lo, zero), wmax);
+        const __m128 ch = _mm_min_ps(_mm_max_ps(hi, zero), wmax);
+        const __m128i tl = _mm_cvttps_epi32(cl), th = _mm_cvttps_epi32(ch);
+        // truncation of a value >= 0 rounds down, add 1 where it lost a fraction (the compare mask is -1)
+        _mm_store_si128(reinterpret_cast<__m128i*>(first), _mm_sub_epi32(tl, _mm_castps_si128(_mm_cmplt_ps(_mm_cvtepi32_ps(tl), cl))));
+        _mm_store_si128(reinterpret_cast<__m128i*>(last), _mm_sub_epi32(th, _mm_castps_si128(_mm_cmplt_ps(_mm_cvtepi32_ps(th), ch))));
+
+        const int rows = std::min(4, r1 - r);
+        for (int j = 0; j < rows; ++j) fillSpan(layer + static_cast<std::size_t>(r + j) * width, first[j], last[j], width);
+        dv = _mm_add_ps(dv, step);
+    }
+#else
+    for (int r = r0; r < r1; ++r) {
+        const float dv = r + 0.5f - cv;
+        const float ka = dv * av, kb = dv * bv;
+        const float a0 = (-hx - ka) * ia, a1 = (hx - ka) * ia;
+        const float b0 = (-hy - kb) * ib, b1 = (hy - kb) * ib;
+        const float lo = std::max(std::min(a0, a1), std::min(b0, b1)) + cu - 0.5f;
+        const float hi = std::min(std::max(a0, a1), std::max(b0, b1)) + cu - 0.5f;
+        const int c0 = ceilNonNeg(std::clamp(lo, 0.0f, static_cast<float>(width)));
+        const int c1 = ceilNonNeg(std::clamp(hi, 0.0f, static_cast<float>(width)));
+        fillSpan(layer + static_cast<std::size_t>(r) * width, c0, c1, width);
+    }
+#endif
+}
+
+// render the image of one car
+// ------------------------------------------------------------------------
+void BevRasterizer::render(const ParkingLot* lot, const Transform2D& car, const Transform2D& target, uint8_t* out) const noexcept {
+    if (!enabled()) return;
+    const std::size_t layer = layerSize();
+    std::memset(out, 0, imageSize());
+    uint8_t* obstacles = out + static_cast<int>(BevChannel::Obstacles) * layer;
+    uint8_t* slots = out + static_cast<int>(BevChannel::Slots) * layer;
+    const Transform2D carInv = car.inverse();
+    const Position2D slotHalf{PARKING_LENGTH * 0.5f, PARKING_WIDTH * 0.5f};
+
+    if (lot) {
+        // obstacles stored in the cells around the view, rejected by their bounding circle first
+        const AABB2D view{car.t.x - viewRadius, car.t.y - viewRadius, car.t.x + viewRadius, car.t.y + viewRadius};
+        const OrientedBoxSoA boxes = lot->getCellBoxes();
+        lot->queryCellBoxes(view, [&](std::size_t k) {
+            const float dx = boxes.x[k] - car.t.x, dy = boxes.y[k] - car.t.y;
+            const float reach = viewRadius + boxes.r[k];
+            if (dx * dx + dy * dy > reach * reach) return;
+            const Transform2D box = carInv.compose(Transform2D{boxes.c[k], boxes.s[k], {boxes.x[k], boxes.y[k]}});
+            fillRect(box, {boxes.hx[k], boxes.hy[k]}, obstacles);
+        });
+
+        // the slot grid holds slot centers, widen the view by a slot half diagonal
+        const float pad = std::sqrt(slotHalf.x * slotHalf.x + slotHalf.y * slotHalf.y);
+        const AABB2D slotView{view.minX - pad, view.minY - pad, view.maxX + pad, view.maxY + pad};
+        const std::vector<ParkingSlot>& lotSlots = lot->getSlots();
+        lot->getSlotGrid().query(slotView, [&](uint32_t i) {
+            fillRect(carInv.compose(lotSlots[i].pose), slotHalf, slots);
+        });
+    }
+
+    const Transform2D targetRel = carInv.compose(target);
+    if (!lot) fillRect(targetRel, slotHalf, slots);
+    fillRect(targetRel, slotHalf, out + static_cast<int>(BevChannel::Target) * layer);
+    fillRect(Transform2D{}, {CAR_LENGTH * 0.5f, CAR_WIDTH * 0.5f}, out + static_cast<int>(BevChannel::Ego) * layer);
+}
@@ -0,0 +1,86 @@
+#ifndef BEVRASTERIZER_H
+#define BEVRASTERIZER_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "../utilities/Transform2D.h"
+#include "../vehicledynamics/VehicleTypes.h"
+#include "../world/ParkingLot.h"
+
+
+// layers of a bird's-eye-view image, each height x width bytes, 255 = occupied
+enum class BevChannel : int {
+    Obstacles = 0,   // parked cars, curbs
+    Slots = 1,       // every slot of the lot (the single slot without a lot)
+    Target = 2,      // target slot
+    Ego = 3          // car footprint
+};
+constexpr int BEV_CHANNELS = 4;
+
+// upper limit of BevConfig::width / height
+constexpr int BEV_MAX_SIZE = 1024;
+
+// bird's-eye-view settings
+struct BevConfig {
+    int width{0};                 // pixels across the car (car y axis), 0 = no image
+    int height{0};                // pixels along the car (car x axis)
+    float resolution{0.1f};       // [m] per pixel
+};
+
+/**
+ * BEV Rasterizer Class
+ * ---------------------------
+ * CPU rasterizer of a car-centred, car-aligned occupancy image for convolutional policies.
+ * It draws the same oriented rectangles as the GL Renderer (slots PARKING_LENGTH x PARKING_WIDTH,
+ * the car CAR_LENGTH x CAR_WIDTH) plus the lot obstacles, one layer per BevChannel, into
+ * BEV_CHANNELS x height x width bytes (channel-major, so a batch is an N x C x H x W tensor).
+ *
+ * Row 0 is in front of the car, column 0 on its left; a pixel is occupied when its center lies inside
+ * a rectangle (the GL rasterization rule). Rectangles are filled by scanlines: the span of 4 rows is
+ * computed at once from the two slab constraints of the rectangle (SSE2), the spans are written with
+ * 16-byte masked stores. Only the obstacles (ParkingLot::queryCellBoxes) and slots (slot grid) around
+ * the view are visited.
+ *
+ * render() is const and does not allocate, so one rasterizer can be shared by envs on several threads.
+ */
+class BevRasterizer {
+public:
+    BevRasterizer() = default;
+    explicit BevRasterizer(const BevConfig& config) { configure(config); }
+
+    // set the image size, width and height are clamped to [0, BEV_MAX_SIZE]
+    void configure(const BevConfig& newConfig);
+
+    /** Render the image of one car
+     * ----------------------------------------------------------------------------
+     * @param[in] lot: slots and obstacles, nullptr = only the target slot
+     * @param[in] car: car frame -> world
+     * @param[in] target: target slot frame -> world
+     * @param[out] out: imageSize() bytes
+     * @return void
+     */
+    void render(const ParkingLot* lot, const Transform2D& car, const Transform2D& target, uint8_t* out) const noexcept;
+
+    /** Fill an oriented rectangle into one layer
+     * ----------------------------------------------------------------------------
+     * @param[in] rect: rectangle frame -> car frame
+     * @param[in] half: half extents along the rectangle x / y axes [m]
+     * @param[out] layer: height x width bytes, covered pixels are set to 255
+     * @return void
+     */
+    void fillRect(const Transform2D& rect, const Position2D& half, uint8_t* layer) const noexcept;
+
+    // getter
+    const BevConfig& getConfig() const noexcept { return config; }
+    std::size_t layerSize() const noexcept { return static_cast<std::size_t>(config.width) * config.height; }
+    std::size_t imageSize() const noexcept { return BEV_CHANNELS * layerSize(); }
+    bool enabled() const noexcept { return config.width > 0 && config.height > 0; }
+
+private:
+    BevConfig config{};
+    float invResolution{10.0f};
+    float viewRadius{0.0f};        // half diagonal of the view [m]
+};
+
+#endif
@@ -0,0 +1,341 @@
+#include "RangeSensor.h"
+
+#include <algorithm>
+
+#include "RangeSensorKernels.h"
+#include "../utilities/CpuFeatures.h"
+#include "../utilities/FastMath.h"
+#include "../utilities/Logger.h"
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define CAR_RANGE_SENSOR_SSE2 1
+#endif
+
+
+namespace {
+    // added to the half angle of a sector, covers the fastAtan2 error [rad]
+    constexpr float BEAM_ANGLE_PAD = 1e-3f;
+
+    // axis-aligned boxes collected before a pass of the aligned box kernel over all beams
+    constexpr int ALIGNED_BOX_BATCH = 64;
+
+    // beams [k0, k1] against one box, best[k] = min(best[k], distance to the box)
+    // dirX, dirY and best are 16-byte aligned and padded to a multiple of 4
+    void castBeams(const Position2D& origin, const float* dirX, const float* dirY, float* best, int k0, int k1,
+                   const Transform2D& box, const Position2D& half) noexcept {
+#ifdef CAR_RANGE_SENSOR_SSE2
+        // ray origin in the box frame, slab offsets per axis
+        const Position2D p = box.applyInverse(origin);
+        const __m128 bc = _mm_set1_ps(box.c), bs = _mm_set1_ps(box.s);
+        const __m128 x0 = _mm_set1_ps(-half.x - p.x), x1 = _mm_set1_ps(half.x - p.x);
+        const __m128 y0 = _mm_set1_ps(-half.y - p.y), y1 = _mm_set1_ps(half.y - p.y);
+        const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+        const __m128 signMask = _mm_set1_ps(-0.0f);
+        const __m128 tiny = _mm_set1_ps(1e-12f);
+        const __m128 two = _mm_set1_ps(2.0f);
+        const __m128 zero = _mm_setzero_ps();
+
+        for (int k = k0 & ~3; k <= k1; k += 4) {
+            const __m128 dx = _mm_load_ps(dirX + k), dy = _mm_load_ps(dirY + k);
+
+            // beam directions in the box frame, kept away from 0 (see rayBoxDistance)
+            __m128 vx = _mm_add_ps(_mm_mul_ps(dx, bc), _mm_mul_ps(dy, bs));
+            __m128 vy = _mm_sub_ps(_mm_mul_ps(dy, bc), _mm_mul_ps(dx, bs));
+            vx = _mm_or_ps(_mm_max_ps(_mm_and_ps(vx, absMask), tiny), _mm_and_ps(vx, signMask));
+            vy = _mm_or_ps(_mm_max_ps(_mm_and_ps(vy, absMask), tiny), _mm_and_ps(vy, signMask));
+
+            // 1 / v: rcp estimate and one Newton step (~2e-7 relative error), cheaper than 4 divisions
+            __m128 ix = _mm_rcp_ps(vx), iy = _mm_rcp_ps(vy);
+            ix = _mm_mul_ps(ix, _mm_sub_ps(two, _mm_mul_ps(vx, ix)));
+            iy = _mm_mul_ps(iy, _mm_sub_ps(two, _mm_mul_ps(vy, iy)));
+
+            // slab entry / exit
+            const __m128 tx0 = _mm_mul_ps(x0, ix), tx1 = _mm_mul_ps(x1, ix);
+            const __m128 ty0 = _mm_mul_ps(y0, iy), ty1 = _mm_mul_ps(y1, iy);
+            const __m128 tNear = _mm_max_ps(_mm_min_ps(tx0, tx1), _mm_min_ps(ty0, ty1));
+            const __m128 tFar = _mm_min_ps(_mm_max_ps(tx0, tx1), _mm_max_ps(ty0, ty1));
+            const __m128 hit = _mm_and_ps(_mm_cmple_ps(tNear, tFar), _mm_cmpge_ps(tFar, zero));
+
+            const __m128 b = _mm_load_ps(best + k);
+            const __m128 d = _mm_or_ps(_mm_and_ps(hit, _mm_max_ps(tNear, zero)), _mm_andnot_ps(hit, b));
+            _mm_store_ps(best + k, _mm_min_ps(b, d));
+        }
+#else
+        for (int k = k0; k <= k1; ++k) {
+            best[k] = std::min(best[k], rayBoxDistance(origin, dirX[k], dirY[k], box, half));
+        }
+#endif
+    }
+
+    // beams [k0, count) against m axis-aligned boxes, see RangeSensorKernels.h
+    // invX, invY and best are 16-byte aligned, k0 and count are multiples of 4
+    void castAlignedBoxes(const float* invX, const float* invY, float* best, int k0, int count, const float* boxes, int m) noexcept {
+#ifdef CAR_RANGE_SENSOR_SSE2
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 miss = _mm_set1_ps(std::numeric_limits<float>::infinity());
+        for (int k = k0; k < count; k += 4) {
+            const __m128 ix = _mm_load_ps(invX + k), iy = _mm_load_ps(invY + k);
+            __m128 b = _mm_load_ps(best + k);
+            for (int j = 0; j < m; ++j) {
+                const float* box = boxes + 4 * j;
+                const __m128 tx0 = _mm_mul_ps(_mm_set1_ps(box[0]), ix), ty0 = _mm_mul_ps(_mm_set1_ps(box[1]), iy);
+                const __m128 tx1 = _mm_mul_ps(_mm_set1_ps(box[2]), ix), ty1 = _mm_mul_ps(_mm_set1_ps(box[3]), iy);
+                const __m128 tNear = _mm_max_ps(_mm_max_ps(_mm_min_ps(tx0, tx1), _mm_min_ps(ty0, ty1)), zero);
+                const __m128 tFar = _mm_min_ps(_mm_max_ps(tx0, tx1), _mm_max_ps(ty0, ty1));
+                const __m128 hit = _mm_cmple_ps(tNear, tFar);
+                b = _mm_min_ps(b, _mm_or_ps(_mm_and_ps(hit, tNear), _mm_andnot_ps(hit, miss)));
+            }
+            _mm_store_ps(best + k, b);
+        }
+#else
+        for (int k = k0; k < count; ++k) {
+            for (int j = 0; j < m; ++j) {
+                const float* box = boxes + 4 * j;
+                const float tx0 = box[0] * invX[k], ty0 = box[1] * invY[k];
+                const float tx1 = box[2] * invX[k], ty1 = box[3] * invY[k];
+                const float tNear = std::max({std::min(tx0, tx1), std::min(ty0, ty1), 0.0f});
+                const float tFar = std::min(std::max(tx0, tx1), std::max(ty0, ty1));
+                if (tNear <= tFar) best[k] = std::min(best[k], tNear);
+            }
+        }
+#endif
+    }
+
+    // atan2(y[j], x[j]) of 4 points, fastAtan2 lane by lane (the octant is restored with masks)
+    void atan2x4(const float* y, const float* x, float* angle) noexcept {
+#ifdef CAR_RANGE_SENSOR_SSE2
+        const __m128 vx = _mm_load_ps(x), vy = _mm_load_ps(y);
+        const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+        const __m128 ax = _mm_and_ps(vx, absMask), ay = _mm_and_ps(vy, absMask);
+        const __m128 a = _mm_div_ps(_mm_min_ps(ax, ay), _mm_max_ps(_mm_max_ps(ax, ay), _mm_set1_ps(1e-30f)));
+        const __m128 z = _mm_mul_ps(a, a);
+        __m128 t = _mm_add_ps(_mm_set1_ps(FAST_ATAN_C7), _mm_mul_ps(z, _mm_set1_ps(FAST_ATAN_C9)));
+        t = _mm_add_ps(_mm_set1_ps(FAST_ATAN_C5), _mm_mul_ps(z, t));
+        t = _mm_add_ps(_mm_set1_ps(FAST_ATAN_C3), _mm_mul_ps(z, t));
+        t = _mm_mul_ps(a, _mm_add_ps(_mm_set1_ps(FAST_ATAN_C1), _mm_mul_ps(z, t)));
+
+        const __m128 swap = _mm_cmpgt_ps(ay, ax);
+        t = _mm_or_ps(_mm_and_ps(swap, _mm_sub_ps(_mm_set1_ps(0.5f * FAST_PI), t)), _mm_andnot_ps(swap, t));
+        const __m128 back = _mm_cmplt_ps(vx, _mm_setzero_ps());
+        t = _mm_or_ps(_mm_and_ps(back, _mm_sub_ps(_mm_set1_ps(FAST_PI), t)), _mm_andnot_ps(back, t));
+        _mm_store_ps(angle, _mm_or_ps(t, _mm_and_ps(vy, _mm_set1_ps(-0.0f))));
+#else
+        for (int j = 0; j < 4; ++j) angle[j] = fastAtan2(y[j], x[j]);
+#endif
+    }
+
+    // sectors of 4 bounding circles: center (x, y) in the sensor frame, radius r, d > sqrt(2) r
+    // phi = direction of the center (fastAtan2), spread = r / sqrt(d^2 - r^2) >= half angle asin(r / d)
+    void boundingSectors(const float* x, const float* y, const float* r, float* phi, float* spread) noexcept {
+#ifdef CAR_RANGE_SENSOR_SSE2
+        const __m128 vx = _mm_load_ps(x), vy = _mm_load_ps(y), vr = _mm_load_ps(r);
+        const __m128 d2 = _mm_add_ps(_mm_mul_ps(vx, vx), _mm_mul_ps(vy, vy));
+        _mm_store_ps(spread, _mm_div_ps(vr, _mm_sqrt_ps(_mm_sub_ps(d2, _mm_mul_ps(vr, vr)))));
+#else
+        for (int j = 0; j < 4; ++j) spread[j] = r[j] / std::sqrt(x[j] * x[j] + y[j] * y[j] - r[j] * r[j]);
+#endif
+        atan2x4(y, x, phi);
+    }
+}
+
+// set the beams
+// ------------------------------------------------------------------------
+void RangeSensor::configure(const RangeSensorConfig& newConfig) {
+    config = newConfig;
+    if (config.beams > RANGE_SENSOR_MAX_BEAMS) CAR_LOG_WARN("Range sensor beams clamped to %d", RANGE_SENSOR_MAX_BEAMS);
+    config.beams = std::clamp(config.beams, 0, RANGE_SENSOR_MAX_BEAMS);
+
+    const int n = config.beams;
+    const bool fullCircle = config.fov >= 2.0f * PI;
+    const float fov = fullCircle ? 2.0f * PI : std::max(config.fov, 0.0f);
+    if (n <= 1) {
+        // a single beam points forward
+        angleStart = 0.0f;
+        angleStep = 0.0f;
+    } else {
+        angleStart = -0.5f * fov;
+        angleStep = fullCircle ? fov / n : fov / (n - 1);
+    }
+    period = (angleStep > 0.0f) ? 2.0f * PI / angleStep : 0.0f;
+    avx2 = cpuFeatures().avx2;
+
+    const std::size_t padded = (static_cast<std::size_t>(n) + 3) & ~std::size_t{3};
+    beamC.assign(padded, 1.0f);
+    beamS.assign(padded, 0.0f);
+    for (int k = 0; k < n; ++k) {
+        beamC[k] = std::cos(beamAngle(k));
+        beamS[k] = std::sin(beamAngle(k));
+    }
+}
+
+// ranges of all beams for one car pose
+// ------------------------------------------------------------------------
+void RangeSensor::scan(const ParkingLot* lot, const Transform2D& car, float* ranges) const noexcept {
+    const int n = config.beams;
+    if (n <= 0) return;
+
+    // beam directions in world frame
+    const Transform2D sensor = car.compose(config.mount);
+    const int padded = static_cast<int>(beamC.size());
+    alignas(16) float dirX[RANGE_SENSOR_MAX_BEAMS];
+    alignas(16) float dirY[RANGE_SENSOR_MAX_BEAMS];
+    alignas(16) float best[RANGE_SENSOR_MAX_BEAMS];
+    for (int k = 0; k < padded; ++k) {
+        dirX[k] = sensor.c * beamC[k] - sensor.s * beamS[k];
+        dirY[k] = sensor.s * beamC[k] + sensor.c * beamS[k];
+        best[k] = config.maxRange;
+    }
+
+    if (lot) {
+        const float reach = config.maxRange;
+
+        // beams with an angle in [phi - lo, phi + hi] (sensor frame), the sector may wrap around behind the car;
+        // a single beam (or fov 0) has no sectors, every box is cast against all beams
+        const float invStep = (n > 1 && angleStep > 0.0f) ? 1.0f / angleStep : 0.0f;
+        const float lastBeam = static_cast<float>(n - 1);
+        auto castRange = [&](float a, float b, const Transform2D& box, const Position2D& half) {
+            a = std::max(a, 0.0f);
+            b = std::min(b, lastBeam);
+            if (a > b) return;
+            int first = static_cast<int>(a);
+            first += (static_cast<float>(first) < a) ? 1 : 0;
+            const int last = static_cast<int>(b);
+            if (first <= last) castBeams(sensor.t, dirX, dirY, best, first, last, box, half);
+        };
+        auto castSector = [&](float phi, float lo, float hi, const Transform2D& box, const Position2D& half) {
+            const float k0 = (phi - lo - BEAM_ANGLE_PAD - angleStart) * invStep;
+            const float k1 = (phi + hi + BEAM_ANGLE_PAD - angleStart) * invStep;
+            castRange(k0, k1, box, half);
+            if (k0 < 0.0f) castRange(k0 + period, k1 + period, box, half);
+            if (k1 > lastBeam) castRange(k0 - period, k1 - period, box, half);
+        };
+
+        // small boxes wait here until their sectors can be computed 4 at a time
+        alignas(16) float pendX[4] = {1.0f, 1.0f, 1.0f, 1.0f}, pendY[4] = {}, pendR[4] = {};
+        Transform2D pendBox[4];
+        Position2D pendHalf[4];
+        int pending = 0;
+        auto flush = [&] {
+            alignas(16) float phi[4], spread[4];
+            boundingSectors(pendX, pendY, pendR, phi, spread);
+            for (int j = 0; j < pending; ++j) castSector(phi[j], spread[j], spread[j], pendBox[j], pendHalf[j]);
+            pending = 0;
+        };
+
+        // oriented box with bounding circle radius r
+        auto castBox = [&](const Transform2D& box, const Position2D& half, float r) {
+            const float ox = box.t.x - sensor.t.x;
+            const float oy = box.t.y - sensor.t.y;
+            const float d2 = ox * ox + oy * oy;
+            if (d2 > (reach + r) * (reach + r)) return;  // out of range
+
+            if (invStep == 0.0f) {
+                castBeams(sensor.t, dirX, dirY, best, 0, n - 1, box, half);
+                return;
+            }
+
+            if (d2 > 2.0f * r * r) {
+                // small box: the sector of its bounding circle (< 90 deg)
+                pendX[pending] = ox * sensor.c + oy * sensor.s;
+                pendY[pending] = -ox * sensor.s + oy * sensor.c;
+                pendR[pending] = r;
+                pendBox[pending] = box;
+                pendHalf[pending] = half;
+                if (++pending == 4) flush();
+                return;
+            }
+
+            // large or close box (long curbs): clip it to the square within reach of the sensor (box frame)
+            const Position2D p = box.applyInverse(sensor.t);
+            const float minX = std::max(-half.x, p.x - reach), maxX = std::min(half.x, p.x + reach);
+            const float minY = std::max(-half.y, p.y - reach), maxY = std::min(half.y, p.y + reach);
+            if (minX > maxX || minY > maxY) return;
+            if (p.x >= minX && p.x <= maxX && p.y >= minY && p.y <= maxY) {
+                castBeams(sensor.t, dirX, dirY, best, 0, n - 1, box, half);  // sensor inside the box
+                return;
+            }
+
+            // sector spanned by the corners of the clipped box around the direction to its center (< 180 deg),
+            // corner angles relative to that direction from cross and dot products, 4 lanes at once
+            const Transform2D rel = sensor.inverse().compose(box);  // box frame -> sensor frame
+            const Position2D center = rel.apply({0.5f * (minX + maxX), 0.5f * (minY + maxY)});
+            const float phi = fastAtan2(center.y, center.x);
+            alignas(16) float cross[4], dot[4], a[4];
+            const Position2D corners[4] = {{minX, minY}, {maxX, minY}, {maxX, maxY}, {minX, maxY}};
+            for (int j = 0; j < 4; ++j) {
+                const Position2D q = rel.apply(corners[j]);
+                cross[j] = center.x * q.y - center.y * q.x;
+                dot[j] = center.x * q.x + center.y * q.y;
+            }
+            atan2x4(cross, dot, a);
+            const float lo = std::max({0.0f, -a[0], -a[1], -a[2], -a[3]});
+            const float hi = std::max({0.0f, a[0], a[1], a[2], a[3]});
+            castSector(phi, lo, hi, box, half);
+        };
+
+        if (reach <= lot->getSensorReach()) {
+            // candidate list of the sensor grid cell: axis-aligned obstacles (all of a generated lot) are
+            // tested against every beam by the aligned box kernel, without sectors; rotated ones go through castBox
+            alignas(32) float invX[RANGE_SENSOR_MAX_BEAMS];
+            alignas(32) float invY[RANGE_SENSOR_MAX_BEAMS];
+            auto nonZero = [](float v) { return std::fabs(v) < 1e-12f ? std::copysign(1e-12f, v) : v; };
+            for (int k = 0; k < padded; ++k) {
+                invX[k] = 1.0f / nonZero(dirX[k]);
+                invY[k] = 1.0f / nonZero(dirY[k]);
+            }
+            alignas(16) float aligned[4 * ALIGNED_BOX_BATCH];
+            int m = 0;
+            auto castAligned = [&] {
+                int k0 = 0;
+#if defined(CAR_HAVE_X86_SIMD)
+                if (avx2) k0 = castAlignedBoxesAVX2(invX, invY, best, padded, aligned, m);
+#endif
+                castAlignedBoxes(invX, invY, best, k0, padded, aligned, m);
+                m = 0;
+            };
+
+            const SensorCandidates candidates = lot->sensorCandidates(sensor.t);
+            const std::vector<Obstacle>& obstacles = lot->getObstacles();
+            const std::vector<AABB2D>& bounds = lot->getObstacleBoxes();
+            for (std::size_t k = 0; k < candidates.count; ++k) {
+                const uint32_t i = candidates.index[k];
+                if (!lot->isAxisAligned(i)) {
+                    const Obstacle& o = obstacles[i];
+                    castBox(o.pose, o.halfExtents, std::sqrt(o.halfExtents.x * o.halfExtents.x + o.halfExtents.y * o.halfExtents.y));
+                    continue;
+                }
+                const AABB2D& b = bounds[i];
+                float* box = aligned + 4 * m;
+                box[0] = b.minX - sensor.t.x;
+                box[1] = b.minY - sensor.t.y;
+                box[2] = b.maxX - sensor.t.x;
+                box[3] = b.maxY - sensor.t.y;
+                if (++m == ALIGNED_BOX_BATCH) castAligned();
+            }
+            if (m > 0) castAligned();
+        } else {
+            // beams longer than the sensor grid reach: walk the obstacle grid cells around the sensor
+            const AABB2D area{sensor.t.x - reach, sensor.t.y - reach, sensor.t.x + reach, sensor.t.y + reach};
+            const OrientedBoxSoA boxes = lot->getCellBoxes();
+            lot->queryCellBoxes(area, [&](std::size_t i) {
+                castBox(Transform2D{boxes.c[i], boxes.s[i], {boxes.x[i], boxes.y[i]}}, {boxes.hx[i], boxes.hy[i]}, boxes.r[i]);
+            });
+        }
+        if (pending > 0) flush();
+    }
+
+    std::copy(best, best + n, ranges);
+}
+
+// scans of n cars
+// ------------------------------------------------------------------------
+void RangeSensor::scanBatch(const ParkingLot* lot, const float* x, const float* y, const float* psi, std::size_t n, float* ranges) const noexcept {
+    const std::size_t beams = static_cast<std::size_t>(config.beams);
+    if (beams == 0) return;
+    for (std::size_t i = 0; i < n; ++i) {
+        Transform2D car{1.0f, 0.0f, {x[i], y[i]}};
+        fastSinCos(psi[i], car.s, car.c);
+        scan(lot, car, ranges + i * beams);
+    }
+}
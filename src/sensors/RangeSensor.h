@@ -0,0 +1,119 @@
+#ifndef RANGESENSOR_H
+#define RANGESENSOR_H
+
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+#include "../utilities/MathUtils.h"
+#include "../utilities/Transform2D.h"
+#include "../vehicledynamics/VehicleTypes.h"
+#include "../world/ParkingLot.h"
+
+
+// upper limit of RangeSensorConfig::beams (scan() keeps its scratch on the stack)
+constexpr int RANGE_SENSOR_MAX_BEAMS = 1024;
+
+// planar lidar settings
+struct RangeSensorConfig {
+    int beams{0};                 // number of beams, 0 = no sensor
+    float maxRange{10.0f};        // [m], reported by beams that hit nothing
+    float fov{2.0f * PI};         // angular span [rad], >= 2*PI is a full circle
+    Transform2D mount{};          // sensor frame -> car frame, x forward
+};
+
+/**
+ * @brief Distance along a ray to an oriented box (slab test in the box frame).
+ *
+ * Scalar reference of the SSE2 kernel in RangeSensor.cpp. Direction components closer to 0 than
+ * 1e-12 are replaced by ±1e-12, so rays parallel to a box face need no special case.
+ *
+ * @param o     Ray origin in world frame.
+ * @param dx,dy Unit ray direction in world frame.
+ * @param box   Box frame -> world frame.
+ * @param half  Half extents along the box x / y axes [m].
+ *
+ * @return distance to the first hit, 0 if o is inside the box, +inf if the ray misses.
+ */
+inline float rayBoxDistance(const Position2D& o, float dx, float dy, const Transform2D& box, const Position2D& half) noexcept {
+    const Position2D p = box.applyInverse(o);
+    auto nonZero = [](float v) { return std::fabs(v) < 1e-12f ? std::copysign(1e-12f, v) : v; };
+    const float vx = nonZero(dx * box.c + dy * box.s);
+    const float vy = nonZero(-dx * box.s + dy * box.c);
+
+    const float tx1 = (-half.x - p.x) / vx, tx2 = (half.x - p.x) / vx;
+    const float ty1 = (-half.y - p.y) / vy, ty2 = (half.y - p.y) / vy;
+    const float tNear = std::fmax(std::fmin(tx1, tx2), std::fmin(ty1, ty2));
+    const float tFar = std::fmin(std::fmax(tx1, tx2), std::fmax(ty1, ty2));
+    if (tNear > tFar || tFar < 0.0f) return std::numeric_limits<float>::infinity();
+    return std::fmax(tNear, 0.0f);
+}
+
+/**
+ * Range Sensor Class
+ * ---------------------------
+ * Simulated 2D lidar: beams spread evenly over the field of view from a pose mounted on the car,
+ * cast against the obstacle boxes of a ParkingLot (parked cars, curbs). Free slots are painted lines,
+ * not obstacles, so beams pass over them. Without a lot every beam reports maxRange.
+ *
+ * A scan reads the candidate list of the sensor's cell in the lot's sensor grid (ParkingLot::
+ * sensorCandidates). Axis-aligned obstacles, which are all obstacles of a generated lot, are tested
+ * against every beam by a slab test on world-frame bounds (8 beams per instruction with AVX2, else 4
+ * with SSE2), with no per-box sector setup or branches. Rotated obstacles are first rejected by
+ * distance, then the beams inside the angle their bounding circle subtends (fastAtan2, a little
+ * padding) are tested 4 at a time by the SSE2 slab test in the box frame. When maxRange exceeds the
+ * lot's sensor reach, every obstacle in the obstacle grid cells within maxRange takes the rotated path.
+ *
+ * Beam k points at -fov/2 + k * step in the sensor frame, step = fov / beams for a full circle
+ * (beam beams/2 points forward) and fov / (beams - 1) otherwise (first and last beam on the edges).
+ * scan() is const and does not allocate, so one sensor can be shared by envs on several threads.
+ */
+class RangeSensor {
+public:
+    RangeSensor() = default;
+    explicit RangeSensor(const RangeSensorConfig& config) { configure(config); }
+
+    // set the beams, beams is clamped to [0, RANGE_SENSOR_MAX_BEAMS]
+    void configure(const RangeSensorConfig& newConfig);
+
+    /** Ranges of all beams for one car pose
+     * ----------------------------------------------------------------------------
+     * @param[in] lot: obstacles, nullptr = none
+     * @param[in] car: car frame -> world
+     * @param[out] ranges: getBeams() distances [m], maxRange if a beam hits nothing
+     * @return void
+     */
+    void scan(const ParkingLot* lot, const Transform2D& car, float* ranges) const noexcept;
+
+    /** scan() for n cars in SoA form
+     * ----------------------------------------------------------------------------
+     * cos/sin of the headings come from the FastMath.h polynomials, as in ParkingLot::collideBatch.
+     *
+     * @param[in] lot: obstacles, nullptr = none
+     * @param[in] x, y, psi: n car poses
+     * @param[in] n: number of cars
+     * @param[out] ranges: n x getBeams() distances, row i belongs to car i
+     * @return void
+     */
+    void scanBatch(const ParkingLot* lot, const float* x, const float* y, const float* psi, std::size_t n, float* ranges) const noexcept;
+
+    // angle of beam k in the sensor frame [rad]
+    float beamAngle(int k) const noexcept { return angleStart + k * angleStep; }
+
+    // getter
+    const RangeSensorConfig& getConfig() const noexcept { return config; }
+    int getBeams() const noexcept { return config.beams; }
+    float getMaxRange() const noexcept { return config.maxRange; }
+    bool enabled() const noexcept { return config.beams > 0; }
+
+private:
+    RangeSensorConfig config{};
+    float angleStart{0.0f};         // angle of beam 0 [rad]
+    float angleStep{0.0f};          // angle between neighbouring beams [rad]
+    float period{0.0f};             // 2*PI in beam index units
+    std::vector<float> beamC, beamS;  // beam directions in the sensor frame, padded to a multiple of 4
+    bool avx2{false};               // cpuFeatures().avx2, selects the aligned box kernel
+};
+
+#endif
@@ -0,0 +1,30 @@
+#include "RangeSensorKernels.h"
+
+#include <immintrin.h>
+
+#include <limits>
+
+
+// AVX2 kernel of the RangeSensor aligned box test, 8 beams per iteration; every box is applied to
+// the beams while their best distances stay in a register. Mirrors castAlignedBoxes (RangeSensor.cpp).
+int castAlignedBoxesAVX2(const float* invX, const float* invY, float* best, int count, const float* boxes, int m) {
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 miss = _mm256_set1_ps(std::numeric_limits<float>::infinity());
+    int k = 0;
+    for (; k + 8 <= count; k += 8) {
+        const __m256 ix = _mm256_loadu_ps(invX + k), iy = _mm256_loadu_ps(invY + k);
+        __m256 b = _mm256_loadu_ps(best + k);
+        for (int j = 0; j < m; ++j) {
+            const float* box = boxes + 4 * j;
+            const __m256 tx0 = _mm256_mul_ps(_mm256_broadcast_ss(box + 0), ix);
+            const __m256 ty0 = _mm256_mul_ps(_mm256_broadcast_ss(box + 1), iy);
+            const __m256 tx1 = _mm256_mul_ps(_mm256_broadcast_ss(box + 2), ix);
+            const __m256 ty1 = _mm256_mul_ps(_mm256_broadcast_ss(box + 3), iy);
+            const __m256 tNear = _mm256_max_ps(_mm256_max_ps(_mm256_min_ps(tx0, tx1), _mm256_min_ps(ty0, ty1)), zero);
+            const __m256 tFar = _mm256_min_ps(_mm256_max_ps(tx0, tx1), _mm256_max_ps(ty0, ty1));
+            b = _mm256_min_ps(b, _mm256_blendv_ps(miss, tNear, _mm256_cmp_ps(tNear, tFar, _CMP_LE_OQ)));
+        }
+        _mm256_storeu_ps(best + k, b);
+    }
+    return k;
+}
@@ -0,0 +1,22 @@
+#ifndef RANGESENSORKERNELS_H
+#define RANGESENSORKERNELS_H
+
+
+/**
+ * Beam kernels of RangeSensor::scan
+ * ---------------------------
+ * Like BicycleModelKernels.h: a kernel compiled with wider instruction set flags lives in its own
+ * translation unit (see CMakeLists.txt) and is only called after cpuFeatures() reports support.
+ *
+ * The aligned box kernels test all beams of a scan against axis-aligned boxes, the slab test of
+ * rayBoxDistance without the rotation into the box frame:
+ *   invX, invY: 1 / beam direction in world frame, components kept away from 0 (±1e-12)
+ *   boxes:      m boxes as {minX, minY, maxX, maxY} relative to the ray origin (AABB2D layout)
+ *   best:       best[k] = min(best[k], distance to box j) for every box j the beam hits
+ */
+#if defined(CAR_HAVE_X86_SIMD)
+// beams [0, count) in blocks of 8, returns the number of beams processed
+int castAlignedBoxesAVX2(const float* invX, const float* invY, float* best, int count, const float* boxes, int m);
+#endif
+
+#endif
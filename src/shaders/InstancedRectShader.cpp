@@ -0,0 +1,9 @@
+#include "InstancedRectShader.h"
+
+
+ShaderPaths INSTANCED_RECT_SHADER_PATHS = {"./src/shaders/instancedRectShader.vert", "./src/shaders/instancedRectShader.frag"};
+
+
+// constructor generates the shader on the fly
+// ------------------------------------------------------------------------
+InstancedRectShader::InstancedRectShader() : ShaderProgram(INSTANCED_RECT_SHADER_PATHS) {}
@@ -0,0 +1,21 @@
+#ifndef INSTANCEDRECTSHADER_H
+#define INSTANCEDRECTSHADER_H
+
+#include "ShaderProgram.h"
+
+
+extern ShaderPaths INSTANCED_RECT_SHADER_PATHS;
+
+
+// RectShader variant that reads offset/scale/yaw/color as per-instance vertex attributes
+// (locations 1-4) instead of uniforms, so many rectangles are drawn with one glDrawElementsInstanced.
+class InstancedRectShader : public ShaderProgram {
+public:
+    // constructor generates the shader on the fly
+    // ------------------------------------------------------------------------
+    InstancedRectShader();
+
+    // Not changing behavior; inherit the base use()
+    using ShaderProgram::use;
+};
+#endif
@@ -11,7 +11,7 @@ ShaderProgram::ShaderProgram(ShaderPaths paths) {
 // ------------------------------------------------------------------------
 ShaderProgram::~ShaderProgram() { 
     glDeleteProgram(ID);
-    std::cout << "ShaderProgram destructed, shader program deleted." << std::endl;
+    CAR_LOG_DEBUG("ShaderProgram destructed, shader program deleted.");
 };
 
 // activate the shader
@@ -48,13 +48,13 @@ void ShaderProgram::checkCompileErrors(unsigned int shader, const std::string ty
         glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
         if (!success) {
             glGetShaderInfoLog(shader, 1024, NULL, infoLog);
-            std::cout << "ERROR::SHADER_COMPILATION_ERROR of type: " << type << "\n" << infoLog << "\n -- --------------------------------------------------- -- " << std::endl;
+            CAR_LOG_ERROR("Shader compilation error of type: %s\n%s", type.c_str(), infoLog);
         }
     } else {
         glGetProgramiv(shader, GL_LINK_STATUS, &success);
         if (!success) {
             glGetProgramInfoLog(shader, 1024, NULL, infoLog);
-            std::cout << "ERROR::PROGRAM_LINKING_ERROR of type: " << type << "\n" << infoLog << "\n -- --------------------------------------------------- -- " << std::endl;
+            CAR_LOG_ERROR("Program linking error of type: %s\n%s", type.c_str(), infoLog);
         }
     }
 };
@@ -65,7 +65,7 @@ int ShaderProgram::loadShaderSource(unsigned int shaderObj, const std::string pa
     // Open the file
     std::ifstream ifs(path);
     if (!ifs) {
-        std::cout << "error" << std::endl;
+        CAR_LOG_ERROR("Failed to open shader source: %s", path.c_str());
         return -1;
     }
 
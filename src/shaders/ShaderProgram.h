@@ -6,7 +6,7 @@
 #include <string>
 #include <fstream>
 #include <sstream>
-#include <iostream>
+#include "../utilities/Logger.h"
 
 
 // paths for vertex and fragment shaders
@@ -0,0 +1,24 @@
+#include "TrajectoryShader.h"
+
+
+ShaderPaths TRAJECTORY_SHADER_PATHS = {"./src/shaders/trajectoryShader.vert", "./src/shaders/trajectoryShader.frag"};
+
+
+// constructor generates the shader on the fly
+// ------------------------------------------------------------------------
+TrajectoryShader::TrajectoryShader() : ShaderProgram(TRAJECTORY_SHADER_PATHS) {
+    uMetersToNdcLoc_ = glGetUniformLocation(ID, "uMetersToNdc");
+    uColorLoc_ = glGetUniformLocation(ID, "uColor");
+}
+
+// set meters -> NDC scale
+// ------------------------------------------------------------------------
+void TrajectoryShader::setMetersToNdc(float sx, float sy) const {
+    if (uMetersToNdcLoc_ != -1) glUniform2f(uMetersToNdcLoc_, sx, sy);
+}
+
+// set color
+// ------------------------------------------------------------------------
+void TrajectoryShader::setColor(float r, float g, float b, float a) const {
+    if (uColorLoc_ != -1) glUniform4f(uColorLoc_, r, g, b, a);
+}
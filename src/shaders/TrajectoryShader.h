@@ -0,0 +1,29 @@
+#ifndef TRAJECTORYSHADER_H
+#define TRAJECTORYSHADER_H
+
+#include "ShaderProgram.h"
+
+
+extern ShaderPaths TRAJECTORY_SHADER_PATHS;
+
+
+// line shader for trajectory points stored in meters (uMetersToNdc/uColor)
+class TrajectoryShader : public ShaderProgram {
+
+private:
+    int uMetersToNdcLoc_ = -1;
+    int uColorLoc_ = -1;
+
+public:
+    // constructor generates the shader on the fly
+    // ------------------------------------------------------------------------
+    TrajectoryShader();
+
+    // setter
+    // ------------------------------------------------------------------------
+    void setMetersToNdc(float sx, float sy) const;
+    void setColor(float r, float g, float b, float a) const;
+    // Not changing behavior; inherit the base use()
+    using ShaderProgram::use;
+};
+#endif
@@ -0,0 +1,23 @@
+#version 330 core
+layout (location = 0) in vec3 aPos;
+// per-instance attributes (glVertexAttribDivisor = 1)
+layout (location = 1) in vec2 aOffset;
+layout (location = 2) in vec2 aScale;
+layout (location = 3) in float aYaw;
+layout (location = 4) in vec4 aColor;
+out vec4 vColor;
+void main() {
+   // same transform as rectShader.vert: scale -> rotate (CCW) -> translate
+   vec2 p = aPos.xy * aScale;
+
+   float c = cos(aYaw);
+   float s = sin(aYaw);
+   mat2 R = mat2(c, s,
+                  -s, c);
+   p = R * p;
+
+   p += aOffset;
+
+   vColor = aColor;
+   gl_Position = vec4(p, 0.0, 1.0);
+}
@@ -0,0 +1,7 @@
+#version 330 core
+uniform vec4 uColor;
+out vec4 FragColor;
+void main()
+{
+    FragColor = uColor;
+}
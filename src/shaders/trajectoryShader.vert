@@ -0,0 +1,7 @@
+#version 330 core
+layout (location = 0) in vec3 aPoint;  // x, y [m], t [s]
+uniform vec2 uMetersToNdc;
+void main() {
+   // points are stored in meters, only scaling is needed (the world origin is the screen center)
+   gl_Position = vec4(aPoint.xy * uMetersToNdc, 0.0, 1.0);
+}
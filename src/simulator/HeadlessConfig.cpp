@@ -0,0 +1,96 @@
+#include "HeadlessConfig.h"
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+
+
+namespace {
+    std::string trim(const std::string& s) {
+        const auto begin = s.find_first_not_of(" \t\r");
+        if (begin == std::string::npos) return "";
+        const auto end = s.find_last_not_of(" \t\r");
+        return s.substr(begin, end - begin + 1);
+    }
+
+    bool parseSize(const std::string& value, std::size_t& out) {
+        if (value.empty() || value[0] == '-') return false;
+        char* end = nullptr;
+        const unsigned long long v = std::strtoull(value.c_str(), &end, 10);
+        if (*end != '\0') return false;
+        out = static_cast<std::size_t>(v);
+        return true;
+    }
+
+    bool parseDouble(const std::string& value, double& out) {
+        if (value.empty()) return false;
+        char* end = nullptr;
+        out = std::strtod(value.c_str(), &end);
+        return *end == '\0';
+    }
+}
+
+// apply one setting
+// ------------------------------------------------------------------------
+bool applyHeadlessSetting(const std::string& key, const std::string& value, HeadlessConfig& config) {
+    if (key == "episodes") return parseSize(value, config.episodes);
+    if (key == "max_steps") return parseSize(value, config.maxStepsPerEpisode);
+    if (key == "sim_dt") return parseDouble(value, config.simDt) && config.simDt > 0.0;
+    if (key == "seed") {
+        std::size_t seed = 0;
+        if (!parseSize(value, seed)) return false;
+        config.seed = seed;
+        return true;
+    }
+    if (key == "log_level") return parseLogLevel(value, config.logLevel);
+    if (key == "vehicle_model") {
+        if (value == "kinematic") config.vehicleModel = VehicleModel::Kinematic;
+        else if (value == "dynamic") config.vehicleModel = VehicleModel::Dynamic;
+        else return false;
+        return true;
+    }
+    if (key == "integrator") {
+        if (value == "euler") config.integrator = KinematicIntegrator::Euler;
+        else if (value == "arc") config.integrator = KinematicIntegrator::Arc;
+        else return false;
+        return true;
+    }
+    if (key == "lot_aisles") return parseSize(value, config.lotAisles);
+    if (key == "lot_slots_per_row") return parseSize(value, config.lotSlotsPerRow) && config.lotSlotsPerRow > 0;
+    if (key == "lot_occupancy") return parseDouble(value, config.lotOccupancy) && config.lotOccupancy >= 0.0 && config.lotOccupancy <= 1.0;
+    if (key == "record_trajectory") {
+        if (value != "0" && value != "1") return false;
+        config.recordTrajectory = (value == "1");
+        return true;
+    }
+    if (key == "record_log") {
+        config.recordLog = value;
+        return !value.empty();
+    }
+    return false;
+}
+
+// load settings from a "key = value" file
+// ------------------------------------------------------------------------
+bool loadHeadlessConfig(const std::string& path, HeadlessConfig& config) {
+    std::ifstream ifs(path);
+    if (!ifs) {
+        std::cerr << "Failed to open config file: " << path << std::endl;
+        return false;
+    }
+
+    std::string line;
+    int lineNo = 0;
+    while (std::getline(ifs, line)) {
+        ++lineNo;
+        line = trim(line.substr(0, line.find('#')));
+        if (line.empty()) continue;
+
+        const auto eq = line.find('=');
+        if (eq == std::string::npos || !applyHeadlessSetting(trim(line.substr(0, eq)), trim(line.substr(eq + 1)), config)) {
+            std::cerr << path << ":" << lineNo << ": invalid setting '" << line << "'" << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,49 @@
+#ifndef HEADLESSCONFIG_H
+#define HEADLESSCONFIG_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "../utilities/Logger.h"
+#include "../vehicledynamics/BicycleModel.h"
+
+
+// settings of the headless executable (CarSimulatorHeadless)
+struct HeadlessConfig {
+    std::size_t episodes{100};              // number of episodes to run
+    std::size_t maxStepsPerEpisode{2000};   // an episode ends after this many steps if not parked
+    double simDt{0.01};                     // fixed simulation step [s]
+    bool recordTrajectory{false};           // record trajectory points in SimulationCore
+    uint64_t seed{0};                       // global RNG seed, 0 = random seed from std::random_device
+    LogLevel logLevel{LogLevel::Info};      // runtime log level
+    VehicleModel vehicleModel{VehicleModel::Kinematic};  // bicycle model used by the env
+    KinematicIntegrator integrator{KinematicIntegrator::Euler};  // kinematic step integration
+    std::size_t lotAisles{0};               // generated parking lot (ParkingLot::generate), 0 = single slot in empty space
+    std::size_t lotSlotsPerRow{10};         // slots per row of the generated lot
+    double lotOccupancy{0.5};               // probability that a slot of the generated lot holds a parked car
+    std::string recordLog;                  // binary episode log (EpisodeLogWriter) to write, empty = none
+};
+
+/** Apply one setting
+ * ----------------------------------------------------------------------------
+ * Keys: episodes, max_steps, sim_dt, record_trajectory (0/1), seed, log_level (trace/debug/info/warn/error/off),
+ * vehicle_model (kinematic/dynamic), integrator (euler/arc), lot_aisles, lot_slots_per_row, lot_occupancy ([0, 1]),
+ * record_log (output path)
+ *
+ * @param[in] key: setting name
+ * @param[in] value: setting value as text
+ * @param[out] config: config to update
+ * @return bool: false if the key is unknown or the value cannot be parsed
+ */
+bool applyHeadlessSetting(const std::string& key, const std::string& value, HeadlessConfig& config);
+
+/** Load settings from a "key = value" file, '#' starts a comment
+ * ----------------------------------------------------------------------------
+ * @param[in] path: config file path
+ * @param[out] config: config to update
+ * @return bool: false if the file cannot be read or contains an invalid line
+ */
+bool loadHeadlessConfig(const std::string& path, HeadlessConfig& config);
+
+#endif
@@ -0,0 +1,129 @@
+#include "ReplayPlayer.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "../utilities/Logger.h"
+
+
+// constructor
+// ------------------------------------------------------------------------
+ReplayPlayer::ReplayPlayer(std::size_t trajectoryCapacity) : trajectory(trajectoryCapacity) {}
+
+// map a log and select its first episode
+// ------------------------------------------------------------------------
+bool ReplayPlayer::open(const std::string& path) {
+    episode = nullptr;
+    if (!reader.open(path)) return false;
+    if (reader.getEpisodeCount() == 0) {
+        CAR_LOG_ERROR("ReplayPlayer: %s holds no episode", path.c_str());
+        reader.close();
+        return false;
+    }
+    const EpisodeLogHeader& header = reader.getHeader();
+    stepDt = static_cast<double>(header.simDt) * std::max(header.actionRepeat, 1);
+    lotLoaded = reader.buildLot(lot);
+    CAR_LOG_INFO("Replay %s: %zu episodes, %llu steps%s", path.c_str(), reader.getEpisodeCount(),
+                 static_cast<unsigned long long>(reader.getStepCount()), lotLoaded ? ", with lot" : "");
+    return selectEpisode(0);
+}
+
+// unmap the log
+// ------------------------------------------------------------------------
+void ReplayPlayer::close() {
+    reader.close();
+    episode = nullptr;
+    steps = nullptr;
+    numSteps = 0;
+    cursor = 0.0;
+    trajectory.clear();
+    pathSteps = 0;
+}
+
+// select an episode and start playing it
+// ------------------------------------------------------------------------
+bool ReplayPlayer::selectEpisode(std::size_t k) {
+    if (!reader.isOpen() || k >= reader.getEpisodeCount()) return false;
+    episodeIndex = k;
+    episode = &reader.getEpisode(k);
+    steps = reader.getSteps(k);
+    numSteps = episode->numSteps;
+
+    cursor = 0.0;
+    paused = false;
+    trajectory.clear();
+    pathSteps = 0;
+    update();
+    return true;
+}
+
+// advance the cursor by recorded time
+// ------------------------------------------------------------------------
+void ReplayPlayer::advance(double frameDt) {
+    if (!episode || paused) return;
+    cursor += frameDt * speed / stepDt;
+    if ((speed > 0.0 && cursor >= static_cast<double>(numSteps)) || (speed < 0.0 && cursor <= 0.0)) paused = true;
+    seek(cursor);
+}
+
+// jump to a step
+// ------------------------------------------------------------------------
+void ReplayPlayer::seek(double step) {
+    if (!episode) return;
+    cursor = std::clamp(step, 0.0, static_cast<double>(numSteps));
+    update();
+}
+
+// move by whole steps
+// ------------------------------------------------------------------------
+void ReplayPlayer::stepFrames(int n) {
+    paused = true;
+    seek(std::floor(cursor) + n);
+}
+
+// pause / resume
+// ------------------------------------------------------------------------
+void ReplayPlayer::setPaused(bool newPaused) {
+    paused = newPaused;
+    if (paused || !episode) return;
+    if (speed > 0.0 && cursor >= static_cast<double>(numSteps)) seek(0.0);
+    else if (speed < 0.0 && cursor <= 0.0) seek(static_cast<double>(numSteps));
+}
+
+// playback speed
+// ------------------------------------------------------------------------
+void ReplayPlayer::setSpeed(double newSpeed) {
+    const double magnitude = std::clamp(std::fabs(newSpeed), 1.0 / 64.0, 64.0);
+    speed = newSpeed < 0.0 ? -magnitude : magnitude;
+}
+
+// interpolation view and path at the cursor
+// ------------------------------------------------------------------------
+void ReplayPlayer::update() {
+    if (numSteps == 0) {
+        prevIndex = curIndex = 0;
+        alpha = 0.0f;
+    } else {
+        prevIndex = std::min(static_cast<std::size_t>(cursor), numSteps - 1);
+        curIndex = prevIndex + 1;
+        alpha = static_cast<float>(cursor - static_cast<double>(prevIndex));
+    }
+
+    // the path covers the states up to the cursor. A state adds at most one point, so a backward seek or a
+    // long jump rebuilds it from the last capacity() states only and never scans the whole episode.
+    const std::size_t until = getStep() + 1;
+    const std::size_t window = trajectory.capacity();
+    if (until < pathSteps || until - pathSteps > window) {
+        trajectory.clear();
+        pathSteps = until > window ? until - window : 0;
+    }
+    for (; pathSteps < until; ++pathSteps) {
+        const Position2D& pos = stateAt(pathSteps).pos;
+        if (!trajectory.empty()) {
+            const float dx = pos.x - trajectory.back().x;
+            const float dy = pos.y - trajectory.back().y;
+            if (dx * dx + dy * dy <= minSegLen * minSegLen) continue;
+        }
+        trajectory.push(TrajectoryPoint{pos.x, pos.y, static_cast<float>(static_cast<double>(pathSteps) * stepDt)});
+    }
+}
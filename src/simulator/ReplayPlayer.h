@@ -0,0 +1,125 @@
+#ifndef REPLAYPLAYER_H
+#define REPLAYPLAYER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "TrajectoryBuffer.h"
+#include "../recording/EpisodeLogReader.h"
+#include "../vehicledynamics/VehicleTypes.h"
+#include "../world/ParkingLot.h"
+
+
+/**
+ * Replay Player Class
+ * ---------------------------
+ * Plays back one episode of an episode log (EpisodeLogWriter) for the Simulator's replay mode. It is
+ * window-free like SimulationCore and exposes the same prev/cur/alpha view, so the front end draws a
+ * replayed car exactly like a simulated one.
+ *
+ * The log is memory mapped (EpisodeLogReader): opening an episode reads its header only, and a frame
+ * reads the two records around the cursor, so the cost of a seek does not depend on the episode length
+ * and a long episode is never loaded into RAM. The cursor is a fractional step in [0, numSteps]:
+ * 0 is the state after reset, i the state after step i. The trajectory buffer holds the path up to the
+ * cursor; it is extended while playing forward and rebuilt from the last capacity() states after a
+ * backward seek or a long jump.
+ */
+class ReplayPlayer {
+public:
+    // constructor, trajectoryCapacity as SimulationCore's so both can feed one TrajectoryRenderer
+    // ------------------------------------------------------------------------
+    explicit ReplayPlayer(std::size_t trajectoryCapacity = 65536);
+
+    /** Map a log and select its first episode
+     * ----------------------------------------------------------------------------
+     * @param[in] path: episode log file
+     * @return bool: false if the file is not a readable log or holds no episode (logged)
+     */
+    bool open(const std::string& path);
+
+    // unmap the log
+    void close();
+
+    /** Select episode k of the log, the cursor goes to its start and playback runs
+     * ----------------------------------------------------------------------------
+     * @param[in] k: episode in [0, getEpisodeCount())
+     * @return bool: false if k is out of range
+     */
+    bool selectEpisode(std::size_t k);
+
+    /** Move the cursor by frameDt of recorded time times the speed
+     * ----------------------------------------------------------------------------
+     * Playback pauses at either end of the episode.
+     *
+     * @param[in] frameDt: elapsed wall time since the last call [s]
+     * @return void
+     */
+    void advance(double frameDt);
+
+    // jump to a (fractional) step, clamped to [0, numSteps]
+    void seek(double step);
+
+    // pause and move by n whole steps (negative = backwards)
+    void stepFrames(int n);
+
+    // resume at the start (end when reversed) if the cursor is at the end the playback runs to
+    void setPaused(bool paused);
+
+    // playback speed, recorded seconds per wall second; negative plays backwards, clamped to +-[1/64, 64]
+    void setSpeed(double speed);
+
+    // getter
+    bool isOpen() const noexcept { return reader.isOpen(); }
+    const EpisodeLogReader& getReader() const noexcept { return reader; }
+    std::size_t getEpisodeCount() const noexcept { return reader.getEpisodeCount(); }
+    std::size_t getEpisodeIndex() const noexcept { return episodeIndex; }
+    const EpisodeLogEpisode& getEpisode() const noexcept { return *episode; }
+    std::size_t getNumSteps() const noexcept { return numSteps; }
+    double getCursor() const noexcept { return cursor; }
+    std::size_t getStep() const noexcept { return static_cast<std::size_t>(cursor); }
+    double getSpeed() const noexcept { return speed; }
+    bool isPaused() const noexcept { return paused; }
+    double getStepDt() const noexcept { return stepDt; }
+    bool hasLot() const noexcept { return lotLoaded; }
+    const ParkingLot& getLot() const noexcept { return lot; }
+    const TrajectoryBuffer& getTrajectory() const noexcept { return trajectory; }
+
+    // state after step i (0 = after reset), i <= numSteps
+    const VehicleState& stateAt(std::size_t i) const noexcept { return i == 0 ? episode->start : steps[i - 1].state; }
+    // record of the step that led to the current state, nullptr at step 0
+    const EpisodeLogStep* getCurrentRecord() const noexcept { return getStep() == 0 ? nullptr : &steps[getStep() - 1]; }
+
+    // interpolation view around the cursor, as SimulationCore
+    const VehicleState& getPrevState() const noexcept { return stateAt(prevIndex); }
+    const VehicleState& getCurState() const noexcept { return stateAt(curIndex); }
+    float getAlpha() const noexcept { return alpha; }
+
+private:
+    EpisodeLogReader reader;
+    ParkingLot lot;
+    bool lotLoaded{false};
+    double stepDt{0.01};                    // recorded time per step [s]
+
+    // selected episode, pointers into the mapping
+    std::size_t episodeIndex{0};
+    const EpisodeLogEpisode* episode{nullptr};
+    const EpisodeLogStep* steps{nullptr};
+    std::size_t numSteps{0};
+
+    // playback
+    double cursor{0.0};
+    double speed{1.0};
+    bool paused{false};
+    std::size_t prevIndex{0}, curIndex{0};
+    float alpha{0.0f};
+
+    // path up to the cursor
+    TrajectoryBuffer trajectory;
+    std::size_t pathSteps{0};               // states [0, pathSteps) were considered for the path
+    static constexpr float minSegLen = 0.01f;  // 1 cm, as SimulationCore
+
+    // refresh the interpolation view and the path after a cursor change
+    void update();
+};
+#endif
@@ -0,0 +1,65 @@
+#include "SimulationCore.h"
+
+#include <cmath>
+
+
+// constructor
+// ------------------------------------------------------------------------
+SimulationCore::SimulationCore(Randomizer* randomizer, double simDt, std::size_t trajectoryCapacity)
+    : env(randomizer), simDt(simDt), trajectory(trajectoryCapacity) {};
+
+// reset the environment and the loop state
+// ------------------------------------------------------------------------
+void SimulationCore::reset() {
+    env.reset();
+
+    prevState = env.getVehicleState();
+    curState = env.getVehicleState();
+
+    accumulator = 0.0;
+    stepCount = 0;
+
+    trajectory.clear();
+    recordPoint(curState.pos);
+}
+
+// accumulate real time and run fixed steps
+// ------------------------------------------------------------------------
+int SimulationCore::advance(double frameDt, Action& action, double maxSteps) {
+    accumulator += frameDt;
+
+    // clamp accumulator to avoid spiral of death after stalls
+    const double maxAccum = simDt * maxSteps;
+    if (accumulator > maxAccum) accumulator = maxAccum;
+
+    int steps = 0;
+    while (accumulator >= simDt && !env.getLastResult().done) {
+        stepOnce(action);
+        accumulator -= simDt;
+        ++steps;
+    }
+    return steps;
+}
+
+// run one fixed step
+// ------------------------------------------------------------------------
+void SimulationCore::stepOnce(Action& action) {
+    prevState = curState;
+
+    env.step(action, static_cast<float>(simDt));
+    curState = env.getVehicleState();
+    ++stepCount;
+
+    if (recordTrajectory) recordPoint(curState.pos);
+}
+
+// record a trajectory point if the car moved far enough
+// ------------------------------------------------------------------------
+void SimulationCore::recordPoint(const Position2D& pos) {
+    if (!trajectory.empty()) {
+        const float dx = pos.x - trajectory.back().x;
+        const float dy = pos.y - trajectory.back().y;
+        if (std::sqrt(dx * dx + dy * dy) <= minSegLen) return;
+    }
+    trajectory.push(TrajectoryPoint{pos.x, pos.y, static_cast<float>(stepCount * simDt)});
+}
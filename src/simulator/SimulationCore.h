@@ -0,0 +1,89 @@
+#ifndef SIMULATIONCORE_H
+#define SIMULATIONCORE_H
+
+#include <cstddef>
+#include <vector>
+
+#include "../envs/ParkingEnv.h"
+#include "TrajectoryBuffer.h"
+#include "../utilities/Randomizer.h"
+#include "../vehicledynamics/VehicleTypes.h"
+
+
+/**
+ * Simulation Core Class
+ * ---------------------------
+ * This class is the window-free part of the simulator: the fixed-step loop, env stepping and
+ * trajectory recording. It has no OpenGL/GLFW dependency and lives in car_core, so it can be driven
+ * by the GLFW front end (Simulator), by the headless executable or by any other program.
+ */
+class SimulationCore {
+public:
+    // constructor
+    // ------------------------------------------------------------------------
+    SimulationCore(Randomizer* randomizer, double simDt = 0.01, std::size_t trajectoryCapacity = 65536);
+
+    /**
+     * @brief Reset the environment, the interpolation snapshots, the accumulator and the trajectory.
+     *
+     * @return void
+     */
+    void reset();
+
+    /**
+     * @brief Add real elapsed time and run as many fixed steps as it covers.
+     *
+     * The accumulator is clamped to maxSteps * simDt first to avoid a spiral of death after stalls.
+     * Stepping stops early when the episode ends (getLastResult().done), the caller resets.
+     *
+     * @param[in] frameDt: elapsed wall time since the last call [s]
+     * @param[in] action: action applied during the steps (clamped in place by the env)
+     * @param[in] maxSteps: accumulator clamp in steps
+     * @return int: number of fixed steps executed
+     */
+    int advance(double frameDt, Action& action, double maxSteps = 5.0);
+
+    /**
+     * @brief Run exactly one fixed step, independent of the accumulator.
+     *
+     * @param[in] action: action applied during the step (clamped in place by the env)
+     * @return void
+     */
+    void stepOnce(Action& action);
+
+    // getter
+    const ParkingEnv& getEnv() const noexcept { return env; }
+    double getSimDt() const noexcept { return simDt; }
+    float getAlpha() const noexcept { return static_cast<float>(accumulator / simDt); }
+    const VehicleState& getPrevState() const noexcept { return prevState; }
+    const VehicleState& getCurState() const noexcept { return curState; }
+    const TrajectoryBuffer& getTrajectory() const noexcept { return trajectory; }
+    std::size_t getStepCount() const noexcept { return stepCount; }
+    const StepResult& getLastResult() const noexcept { return env.getLastResult(); }
+
+    // setter
+    void setRecordTrajectory(bool enabled) { recordTrajectory = enabled; }
+    void setVehicleModel(VehicleModel model) noexcept { env.setVehicleModel(model); }
+    void setIntegrator(KinematicIntegrator mode) noexcept { env.setIntegrator(mode); }
+    void setMaxEpisodeSteps(std::size_t steps) noexcept { env.setMaxEpisodeSteps(steps); }
+    void setLot(const ParkingLot* lot) noexcept { env.setLot(lot); }  // applies from the next reset
+
+private:
+    ParkingEnv env;
+    const double simDt{0.01};
+    double accumulator{0.0};
+    std::size_t stepCount{0};
+
+    // previous and current state for interpolation
+    VehicleState prevState{};
+    VehicleState curState{};
+
+    // trajectory: a point is recorded whenever the car moved more than minSegLen,
+    // the oldest points are overwritten once the ring buffer is full
+    bool recordTrajectory{true};
+    TrajectoryBuffer trajectory;
+    static constexpr float minSegLen = 0.01f;  // 1 cm
+
+    void recordPoint(const Position2D& pos);
+};
+#endif
@@ -1,36 +1,32 @@
 
 #include "Simulator.h"
 
-
-namespace {
-    // Unit quad in NDC-space centered at origin
-    float QUAD_VERTICES[] = {
-        0.5f,  0.5f, 0.0f,
-        0.5f, -0.5f, 0.0f,
-       -0.5f, -0.5f, 0.0f,
-       -0.5f,  0.5f, 0.0f
-    };
-
-    unsigned int QUAD_INDICES[] = {
-        0, 1, 3,
-        1, 2, 3
-    };
-
-    constexpr std::size_t QUAD_VERTEX_COUNT = sizeof(QUAD_VERTICES) / sizeof(float);
-    constexpr std::size_t QUAD_INDEX_COUNT  = sizeof(QUAD_INDICES)  / sizeof(unsigned int);
-}
+#include <cstdio>
 
 
 // constructor
-Simulator::Simulator(GLFWwindow* window) : window(window), randomizer(), env(&randomizer) {};
+Simulator::Simulator(GLFWwindow* window)
+    : window(window), randomizer(), core(&randomizer), replay(core.getTrajectory().capacity()) {};
+
+// replay mode: play an episode log instead of stepping the env
+// ------------------------------------------------------------------------
+bool Simulator::openReplay(const std::string& path, std::size_t episode, double step) {
+    if (!replay.open(path)) return false;
+    if (!replay.selectEpisode(episode)) {
+        CAR_LOG_ERROR("Replay %s has no episode %zu (%zu episodes)", path.c_str(), episode, replay.getEpisodeCount());
+        return false;
+    }
+    replay.seek(step);
+    return true;
+}
 
 bool Simulator::init() {
     initRenderer();
-    std::cout << "Init Render done" << std::endl;
+    CAR_LOG_INFO("Init Render done");
     initSimulationState();
-    std::cout << "Init Simulation State done" << std::endl;
+    CAR_LOG_INFO("Init Simulation State done");
     initEntities();
-    std::cout << "Init Entity done" << std::endl;
+    CAR_LOG_INFO("Init Entity done");
     return true;
 }
 
@@ -40,121 +36,54 @@ void Simulator::initRenderer() {
     glViewport(0, 0, fbW, fbH);
     // (optional) also trigger your callback once to keep all logic in one place:
     framebuffer_size_callback(window, fbW, fbH);
-    // build and compile our shader program
-    // ------------------------------------
-    
-    rectShader = std::make_unique<RectShader>();
-    
-    // set up vertex data (and buffer(s)) and configure vertex attributes
-    quad = std::make_unique<Loader>(QUAD_VERTICES, QUAD_VERTEX_COUNT, QUAD_INDICES,  QUAD_INDEX_COUNT);
-
-    // renderer
-    renderer = std::make_unique<Renderer>(PPM, fbW, fbH);
+
+    // shaders, quad mesh, renderers and entities; the path VBO has the same capacity as the core's ring buffer
+    scene = std::make_unique<SceneRenderer>(fbW, fbH, core.getTrajectory().capacity());
 }
 
-// initialize simulation state: env, vehicle params
+// initialize simulation state: env, timing
 // ------------------------------------------------------------------------
 void Simulator::initSimulationState() {
-    // reset the environment
-    env.reset();
-    
-    // wheels
-    vehicleParams.finalize();
-
-    // wheel anchors in car-local frame
-    anchors = {{
-        {+vehicleParams.Lf, +vehicleParams.track*0.5f}, 
-        {+vehicleParams.Lf, -vehicleParams.track*0.5f},
-        {-vehicleParams.Lr, -vehicleParams.track*0.5f}, 
-        {-vehicleParams.Lr, +vehicleParams.track*0.5f}
-    }};
-
-    // previous and current state for interpolation
-    prevState = env.getVehicleState().pos;
-    prevPsi = env.getVehicleState().psi;
-    prevDelta = env.getVehicleState().delta;
-    curState = env.getVehicleState().pos;
-    curPsi = env.getVehicleState().psi;
-    curDelta = env.getVehicleState().delta;
+    // reset the environment, interpolation snapshots and trajectory
+    core.reset();
 
     // timing
     lastTime = glfwGetTime();
-    accumulator = 0.0;
 }
 
-// initialize entities: car, parking lot, wheels and trajectory
+// initialize entities: parking slot, recorded lot in replay mode
 // ------------------------------------------------------------------------
 void Simulator::initEntities() {   
-    // entities
-    const VehicleState vehicleState = env.getVehicleState();
-    carEntity = Entity(quad.get(), rectShader.get());
-    carEntity.setColor({0.15f, 0.65f, 0.15f, 1.0f});
-    carEntity.setYaw(vehicleState.psi);
-    carEntity.setWidth(CAR_LENGTH);
-    carEntity.setLength(CAR_WIDTH);
-    carEntity.setPos(vehicleState.pos);
-
-    const Position2D parkingPos = env.getParkingPos();
-    const float parkingYaw = env.getParkingYaw();
-    parkingEntity = Entity(quad.get(), rectShader.get());
-    parkingEntity.setColor({1.0f, 0.0f, 0.0f, 1.0f});
-    parkingEntity.setYaw(parkingYaw);
-    parkingEntity.setWidth(PARKING_LENGTH);
-    parkingEntity.setLength(PARKING_WIDTH);
-    parkingEntity.setPos(parkingPos);
-
-    wheelFL = Entity(quad.get(), rectShader.get()), wheelFR = Entity(quad.get(), rectShader.get());
-    wheelRL = Entity(quad.get(), rectShader.get()), wheelRR = Entity(quad.get(), rectShader.get());
-
-    const float wheelWidth = vehicleParams.wheel.width;
-    const float wheelLength = vehicleParams.wheel.length;
-    for (Entity* wheel : {&wheelFL, &wheelFR, &wheelRL, &wheelRR}) {
-        wheel->setColor({0.4f, 0.4f, 0.4f, 1.0f});
-        wheel->setWidth(wheelLength);
-        wheel->setLength(wheelWidth);
+    if (replay.isOpen()) {
+        placeReplaySlot();
+        scene->setLot(replay.hasLot() ? &replay.getLot() : nullptr);
+        return;
     }
-    
-    // trajectory line
-    trajectoryEntities.clear();
-    trajectoryEntities.reserve(2000);
+    placeEnvSlot();
 }
 
-void Simulator::placeWheel(Entity& wheel, float ax, float ay, bool front, 
-                      const Position2D& pos, const float& yawDraw, const float& steer) {
-    
-    const float c = cosf(yawDraw), s = sinf(yawDraw);
-
-    // car-local anchor to world position
-    const float wx = pos.x + (c*ax - s*ay);
-    const float wy = pos.y + (s*ax + c*ay);
-
-    wheel.setPos({wx, wy});
-
-    if (front) {
-        wheel.setYaw(yawDraw + steer);
-    } else {
-        wheel.setYaw(yawDraw);
-    }
-};
-
 void Simulator::run() {
     // render loop
     // -----------
     while (!glfwWindowShouldClose(window)) {      
         // timing
         double now = glfwGetTime();
-        double frameDt = now - lastTime;
+        const double frameDt = now - lastTime;
         lastTime = now;
-        accumulator += frameDt;
 
-        // input
-        // -----
-        processInput(window, action);
-    
-        clampAccumulator(accumulator, simDt);
-        
-        // fixed-step simulation
-        tick();
+        if (replay.isOpen()) {
+            // recorded states instead of env steps
+            processReplayInput(window);
+            replay.advance(frameDt);
+            updateReplayTitle();
+        } else {
+            // input
+            // -----
+            processInput(window, action);
+
+            // fixed-step simulation
+            tick(frameDt);
+        }
 
         // draw including interpolation factor
         draw();
@@ -169,92 +98,34 @@ void Simulator::run() {
 
 // step the simulation with fixed time step
 // ------------------------------------------------------------------------
-void Simulator::tick() {
-    while (accumulator >= simDt) {
-        // set the privious Position2D
-        prevState = curState;
-        prevPsi = curPsi;
-        prevDelta = curDelta;
-        
-        // update Position2D
-        const float dt = static_cast<float>(simDt);
-        Observation obs = env.step(action, dt);
-
-        // set the current Position2D
-        curState = obs.vehicleState.pos;
-        curPsi = obs.vehicleState.psi;
-        curDelta  = obs.vehicleState.delta;
-
-        // TODO: keepOnScreenMeters does not work well. Fix it later.
-        keepOnScreenMeters(obs.vehicleState.pos, carEntity.getWidth(), carEntity.getLength(),fbW, fbH, PPM);
-        accumulator -= simDt;
+void Simulator::tick(double frameDt) {
+    // the accumulator is clamped inside SimulationCore to avoid spiral of death after stalls
+    core.advance(frameDt, action);
+
+    // the episode ends when the car parks, collides or leaves the lot (the visible area), then a new one starts
+    const StepResult& result = core.getLastResult();
+    if (result.done) {
+        CAR_LOG_INFO("Episode finished after %zu steps: %s", core.getStepCount(),
+                     result.truncated ? "time limit" : (result.collided ? "collision" : (result.reward > 0.0f ? "parked" : "left the lot")));
+        core.reset();
+        placeEnvSlot();
     }
 }
 
+// the slot the env scores parking against, a reset may pick a new one
+// ------------------------------------------------------------------------
+void Simulator::placeEnvSlot() {
+    scene->setSlot(core.getEnv().getParkingPos(), core.getEnv().getParkingYaw());
+}
+
 // draw all entities including interpolation
 // ------------------------------------------------------------------------
 void Simulator::draw() {
-    // interpolate for smooth rendering
-    float alpha = static_cast<float>(accumulator / simDt);
-    const Position2D posDraw = interp(prevState, curState, alpha);
-    const float yawDraw = lerpAngle(prevPsi, curPsi, alpha);
-    const float deltaDraw = prevDelta + (curDelta - prevDelta) * alpha;
-
-    // set pos and yaw to draw the car
-    carEntity.setPos(posDraw);
-    carEntity.setYaw(yawDraw);
-
-    // trajectory
-    // calculate the distance between two points
-    float dx = curState.x - prevState.x;
-    float dy = curState.y - prevState.y;
-    float len = std::sqrt(dx*dx + dy*dy);
-    
-    // ignore small movement
-    const float minSegLen = 0.01f;   // 1 cm
-    if (len > minSegLen) {
-        // center of the segment
-        Position2D center{
-            0.5f * (prevState.x + curState.x),
-            0.5f * (prevState.y + curState.y)
-        };
-
-    // yaw of the segment
-    float segYaw = std::atan2(dy, dx);
-
-    Entity seg(quad.get(), rectShader.get());
-    seg.setPos(center);
-    seg.setWidth(0.05f);
-    seg.setLength(len);
-    seg.setYaw(segYaw);
-    seg.setColor({0.9f, 0.9f, 0.2f, 1.0f});
-
-    trajectoryEntities.push_back(seg);
-
-    };
-
-    // render
-    // ------
-    glClearColor(0.2f, 0.3f, 0.3f, 1.0f);
-    glClear(GL_COLOR_BUFFER_BIT);
-
-    // draw entities
-    renderer->draw(parkingEntity);
-    renderer->draw(carEntity);
-
-    placeWheel(wheelFL, anchors[0][0], anchors[0][1], true, posDraw, yawDraw, deltaDraw);
-    placeWheel(wheelFR, anchors[1][0], anchors[1][1], true, posDraw, yawDraw, deltaDraw);
-    placeWheel(wheelRR, anchors[2][0], anchors[2][1], false, posDraw, yawDraw, 0.0f);
-    placeWheel(wheelRL, anchors[3][0], anchors[3][1], false, posDraw, yawDraw, 0.0f);
-        
-    renderer->draw(wheelFL);
-    renderer->draw(wheelFR);
-    renderer->draw(wheelRR);
-    renderer->draw(wheelRL);
-
-    // draw trajectory
-    for (auto& seg : trajectoryEntities) {
-        renderer->draw(seg);
+    // interpolate for smooth rendering, between recorded states in replay mode
+    if (replay.isOpen()) {
+        scene->draw(replay.getPrevState(), replay.getCurState(), replay.getAlpha(), replay.getTrajectory());
+    } else {
+        scene->draw(core.getPrevState(), core.getCurState(), core.getAlpha(), core.getTrajectory());
     }
 }
 
@@ -279,6 +150,70 @@ void Simulator::processInput(GLFWwindow *window, Action& action) {
     if (glfwGetKey(window, GLFW_KEY_DOWN)  == GLFW_PRESS) action.acceleration = -iAcceleration;
 }
 
+// replay keys: playback, seek and episode selection
+// ------------------------------------------------------------------------
+void Simulator::processReplayInput(GLFWwindow* window) {
+    if (glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS)
+        glfwSetWindowShouldClose(window, true);
+
+    const double steps = static_cast<double>(replay.getNumSteps());
+    if (keyPressed(window, GLFW_KEY_SPACE)) replay.setPaused(!replay.isPaused());
+    if (keyPressed(window, GLFW_KEY_RIGHT)) replay.stepFrames(+1);
+    if (keyPressed(window, GLFW_KEY_LEFT)) replay.stepFrames(-1);
+    if (keyPressed(window, GLFW_KEY_PAGE_UP)) replay.stepFrames(+100);
+    if (keyPressed(window, GLFW_KEY_PAGE_DOWN)) replay.stepFrames(-100);
+    if (keyPressed(window, GLFW_KEY_UP)) replay.setSpeed(replay.getSpeed() * 2.0);
+    if (keyPressed(window, GLFW_KEY_DOWN)) replay.setSpeed(replay.getSpeed() * 0.5);
+    if (keyPressed(window, GLFW_KEY_R)) replay.setSpeed(-replay.getSpeed());
+    if (keyPressed(window, GLFW_KEY_HOME)) replay.seek(0.0);
+    if (keyPressed(window, GLFW_KEY_END)) replay.seek(steps);
+    for (int digit = 0; digit <= 9; ++digit) {
+        if (keyPressed(window, GLFW_KEY_0 + digit)) replay.seek(std::floor(steps * digit / 10.0));
+    }
+
+    std::size_t episode = replay.getEpisodeIndex();
+    if (keyPressed(window, GLFW_KEY_N) && episode + 1 < replay.getEpisodeCount()) ++episode;
+    if (keyPressed(window, GLFW_KEY_P) && episode > 0) --episode;
+    if (episode != replay.getEpisodeIndex()) {
+        replay.selectEpisode(episode);
+        placeReplaySlot();
+    }
+}
+
+// key edge detection for the replay toggles
+// ------------------------------------------------------------------------
+bool Simulator::keyPressed(GLFWwindow* window, int key) {
+    const bool down = glfwGetKey(window, key) == GLFW_PRESS;
+    const bool pressed = down && !keyWasDown[key];
+    keyWasDown[key] = down;
+    return pressed;
+}
+
+// target slot of the shown episode
+// ------------------------------------------------------------------------
+void Simulator::placeReplaySlot() {
+    const EpisodeLogEpisode& episode = replay.getEpisode();
+    scene->setSlot({episode.slotX, episode.slotY}, episode.slotYaw);
+}
+
+// replay status in the window title, set only when it changes
+// ------------------------------------------------------------------------
+void Simulator::updateReplayTitle() {
+    const EpisodeLogEpisode& episode = replay.getEpisode();
+    const EpisodeLogStep* record = replay.getCurrentRecord();
+    const uint32_t flags = record ? record->flags : 0u;
+    const char* outcome = (flags & EPISODE_LOG_PARKED) ? " parked" : (flags & EPISODE_LOG_COLLIDED) ? " collision"
+                        : (flags & EPISODE_LOG_TRUNCATED) ? " time limit" : (flags & EPISODE_LOG_TERMINATED) ? " left the lot" : "";
+
+    char title[256];
+    std::snprintf(title, sizeof(title), "Car Simulator replay - episode %zu/%zu (env %u) step %zu/%zu x%g%s%s",
+                  replay.getEpisodeIndex() + 1, replay.getEpisodeCount(), episode.envId, replay.getStep(),
+                  replay.getNumSteps(), replay.getSpeed(), replay.isPaused() ? " paused" : "", outcome);
+    if (windowTitle == title) return;
+    windowTitle = title;
+    glfwSetWindowTitle(window, title);
+}
+
 // glfw: whenever the window size changed (by OS or user resize) this callback function executes
 // ---------------------------------------------------------------------------------------------
 void Simulator::framebuffer_size_callback(GLFWwindow* window, int width, int height) {
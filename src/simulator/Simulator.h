@@ -3,17 +3,18 @@
 
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
+#include <array>
 #include <memory>
+#include <string>
 
 #include "../core/Config.h"
-#include "../shaders/RectShader.h"
-#include "../Loader.h"
-#include "../entities/Entity.h"
-#include "../renderers/Renderer.h"
+#include "../renderers/SceneRenderer.h"
 #include "../vehicledynamics/BicycleModel.h"
 #include "../vehicledynamics/VehicleTypes.h"
 #include "../utilities/Randomizer.h"
 #include "../envs/ParkingEnv.h"
+#include "ReplayPlayer.h"
+#include "SimulationCore.h"
 
 
 // forward declarations at global scope
@@ -21,9 +22,16 @@ struct Observation;
 
 
 /**
- * Parking Env Class
+ * Simulator Class
  * ---------------------------
- * This class compose the simulations in this project.  
+ * This class is the GLFW/OpenGL front end of the simulations in this project.
+ * Keyboard input, timing and rendering live here; the fixed-step loop, env stepping and trajectory
+ * recording are done by SimulationCore, which has no window dependency.
+ *
+ * In replay mode (openReplay) the car, wheels, slot and lot are driven by the recorded states of an
+ * episode log through ReplayPlayer instead of env steps:
+ * Space pause, Left/Right step -/+1, PageDown/PageUp step -/+100, Up/Down speed x2 / /2, R reverse,
+ * Home/End and 0-9 seek to 0 %, 100 %, 0-90 %, N/P next / previous episode.
  */
 class Simulator {
 
@@ -32,6 +40,15 @@ public:
     Simulator(GLFWwindow* window);
 
     // necessary simulation attributes and methods
+    /** Switch to replay mode, call before init()
+     * ----------------------------------------------------------------------------
+     * @param[in] path: episode log (EpisodeLogWriter, e.g. CarSimulatorHeadless --record-log)
+     * @param[in] episode: episode of the log to show first
+     * @param[in] step: step of that episode to start at
+     * @return bool: false if the log cannot be opened or has no such episode (logged)
+     */
+    bool openReplay(const std::string& path, std::size_t episode = 0, double step = 0.0);
+
     // Init simulator
     bool init();
 
@@ -45,63 +62,46 @@ private:
     int fbW = 0, fbH = 0;
 
     // Core systems
-    VehicleParams vehicleParams;
     Randomizer randomizer;
-    ParkingEnv env;
+    SimulationCore core;
+    ReplayPlayer replay;
     Action action;
 
-    // Renderer
-    std::unique_ptr<RectShader> rectShader;
-    std::unique_ptr<Loader> quad;
-    std::unique_ptr<Renderer> renderer;
-
-    // Scene entities
-    Entity carEntity = Entity(quad.get(), rectShader.get());
-    Entity parkingEntity = Entity(quad.get(), rectShader.get());
-    Entity wheelFL = Entity(quad.get(), rectShader.get());
-    Entity wheelFR = Entity(quad.get(), rectShader.get());
-    Entity wheelRL = Entity(quad.get(), rectShader.get());
-    Entity wheelRR = Entity(quad.get(), rectShader.get());
-    std::vector<Entity> trajectoryEntities;
-    std::array<std::array<float, 2>, 4> anchors;
-
-    // Simulation
-    const double simDt{0.01};
-    double accumulator{0.0};
+    // Renderer: car, wheels, slot, lot and path (shared with the offscreen export)
+    std::unique_ptr<SceneRenderer> scene;
+
+    // Timing
     double lastTime{0.0};
-    Position2D prevState{};
-    Position2D curState{};
-    float prevPsi{0.0f};
-    float curPsi{0.0f};
-    float prevDelta{0.0f};
-    float curDelta{0.0f};
 
-    void initRenderer();         // Loader + RectShader + Renderer
-    void initSimulationState();  // simDt, accumulator, VehicleParams, BicycleModel, VehicleState
-    void initEntities();         // car / parking / wheels / trajectory
+    // replay input and status
+    std::array<bool, GLFW_KEY_LAST + 1> keyWasDown{};
+    std::string windowTitle;
 
-    void placeWheel(Entity& wheel, float ax, float ay, bool front,
-                    const Position2D& pos, const float& yawDraw, const float& steer);
+    void initRenderer();         // SceneRenderer: shaders, quad, Renderer, TrajectoryRenderer, entities
+    void initSimulationState();  // SimulationCore reset, timing
+    void initEntities();         // parking slot, lot of a replayed log
 
     /** 
      * @brief Advance the simulation by fixed time step
      * This function advances the simulation by a fixed time
      * 
      * one frame: input → env steps → update Entities → render.
+     * When the episode ends (the car parked or left the lot, i.e. the visible area) a new one is started
+     * and the scene shows its target slot.
      * 
+     * @param[in] frameDt: elapsed wall time since the last frame [s]
      * @return void
     */ 
-    void tick();
+    void tick(double frameDt);
+
+    // target slot of the env's current episode
+    void placeEnvSlot();
+
     /** 
      * @brief Draw all entities including interpolation factor
      * 
-     * This function draws all entites with interpolation for smooth rendering and Renderer class. 
-     * 
-     * 1. Calculate interpolation factor alpha from accumulator and simDt
-     * 2. Interpolate position, yaw, delta using alpha
-     * 3. Set interpolated pos and yaw to car entity
-     * 4. Update and store trajectory line segments
-     * 5. Render all entities
+     * Hands the prev/cur states, the interpolation factor alpha and the trajectory of SimulationCore
+     * (ReplayPlayer in replay mode) to SceneRenderer::draw.
      * 
      * @return void 
      */
@@ -111,37 +111,14 @@ private:
     // process all input: query GLFW whether relevant keys are pressed/released this frame and react accordingly
     void processInput(GLFWwindow *window, Action& action);
 
+    // replay mode: playback keys, target slot of the shown episode, status in the window title
+    void processReplayInput(GLFWwindow* window);
+    bool keyPressed(GLFWwindow* window, int key);   // true on the frame the key goes down
+    void placeReplaySlot();
+    void updateReplayTitle();
+
     // glfw: whenever the window size changed (by OS or user resize) this callback function executes
     // ---------------------------------------------------------------------------------------------
     static void framebuffer_size_callback(GLFWwindow* window, int width, int height);
-
-    // Clamp accumulator to avoid spiral of death after stalls
-    inline void clampAccumulator(double& accum, const double simDt, double maxSteps = 5.0) {
-        const double MAX_ACCUM = simDt * maxSteps;
-        if (accum > MAX_ACCUM) accum = MAX_ACCUM;
-    }
-
-    // Linear interpolation for positions
-    inline float lerp(float a, float b, float t) { return a + (b - a) * t; }
-
-    // Interpolate Position2D (positions); for headings, use lerpAngle on psi
-    inline Position2D interp(const Position2D& prev, const Position2D& curr, float alpha) {
-        return Position2D{
-            lerp(prev.x, curr.x, alpha),
-            lerp(prev.y, curr.y, alpha)
-        };
-    }
-
-    // keep the entire rectangle visible on screen.
-    // ------------------------------------------------------------------------
-    inline void keepOnScreenMeters(Position2D& s, float width_m, float length_m, int fbW, int fbH, float ppm) {
-        const float worldHalfW = (fbW / ppm) * 0.5f;
-        const float worldHalfH = (fbH / ppm) * 0.5f;
-        const float marginX = width_m * 0.5f;
-        const float marginY = length_m * 0.5f;
-        s.x = std::clamp(s.x, -worldHalfW + marginX, worldHalfW - marginX);
-        s.y = std::clamp(s.y, -worldHalfH + marginY, worldHalfH - marginY);
-    };
-    
 };
 #endif
@@ -0,0 +1,39 @@
+#include "TrajectoryBuffer.h"
+
+#include <algorithm>
+
+
+// constructor
+// ------------------------------------------------------------------------
+TrajectoryBuffer::TrajectoryBuffer(std::size_t capacity) : storage(std::max<std::size_t>(1, capacity)) {};
+
+// append a point
+// ------------------------------------------------------------------------
+void TrajectoryBuffer::push(const TrajectoryPoint& p) {
+    storage[head] = p;
+    head = (head + 1 == storage.size()) ? 0 : head + 1;
+    if (count < storage.size()) ++count;
+    ++totalPushed;
+}
+
+// drop all points
+// ------------------------------------------------------------------------
+void TrajectoryBuffer::clear() {
+    head = 0;
+    count = 0;
+}
+
+// i-th point from the oldest
+// ------------------------------------------------------------------------
+const TrajectoryPoint& TrajectoryBuffer::operator[](std::size_t i) const {
+    const std::size_t oldest = (count < storage.size()) ? 0 : head;
+    std::size_t slot = oldest + i;
+    if (slot >= storage.size()) slot -= storage.size();
+    return storage[slot];
+}
+
+// newest point
+// ------------------------------------------------------------------------
+const TrajectoryPoint& TrajectoryBuffer::back() const {
+    return storage[(head == 0) ? storage.size() - 1 : head - 1];
+}
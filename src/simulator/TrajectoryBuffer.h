@@ -0,0 +1,57 @@
+#ifndef TRAJECTORYBUFFER_H
+#define TRAJECTORYBUFFER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+
+// one recorded trajectory point
+struct TrajectoryPoint {
+    float x{0.0f};  // [m]
+    float y{0.0f};  // [m]
+    float t{0.0f};  // simulation time [s]
+};
+
+/**
+ * Trajectory Buffer Class
+ * ---------------------------
+ * Fixed-capacity ring buffer of trajectory points. Once full, the oldest point is overwritten,
+ * so memory stays flat over arbitrarily long sessions.
+ *
+ * The raw storage is exposed (data(), getHead()) so that a GPU buffer can mirror it slot by slot
+ * and only upload the slots written since the last sync (see getTotalPushed()).
+ */
+class TrajectoryBuffer {
+public:
+    // constructor allocates the whole storage once
+    // ------------------------------------------------------------------------
+    explicit TrajectoryBuffer(std::size_t capacity = 65536);
+
+    // append a point, overwriting the oldest one when full
+    void push(const TrajectoryPoint& p);
+
+    // drop all points (the storage and the push counter are kept)
+    void clear();
+
+    // i-th point from the oldest (0) to the newest (size() - 1)
+    const TrajectoryPoint& operator[](std::size_t i) const;
+
+    // newest point, only valid if !empty()
+    const TrajectoryPoint& back() const;
+
+    // getter
+    bool empty() const noexcept { return count == 0; }
+    std::size_t size() const noexcept { return count; }
+    std::size_t capacity() const noexcept { return storage.size(); }
+    std::size_t getHead() const noexcept { return head; }             // storage slot of the next push
+    uint64_t getTotalPushed() const noexcept { return totalPushed; }   // pushes since construction
+    const TrajectoryPoint* data() const noexcept { return storage.data(); }
+
+private:
+    std::vector<TrajectoryPoint> storage;
+    std::size_t head{0};
+    std::size_t count{0};
+    uint64_t totalPushed{0};
+};
+#endif
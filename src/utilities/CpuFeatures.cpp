@@ -0,0 +1,50 @@
+#include "CpuFeatures.h"
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#include <immintrin.h>
+#endif
+
+
+namespace {
+
+    CpuFeatures detectCpuFeatures() {
+        CpuFeatures f;
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+        int info[4] = {0, 0, 0, 0};
+        __cpuid(info, 0);
+        const int maxLeaf = info[0];
+
+        __cpuid(info, 1);
+        f.sse41 = (info[2] & (1 << 19)) != 0;
+        const bool fma = (info[2] & (1 << 12)) != 0;
+        const bool osxsave = (info[2] & (1 << 27)) != 0;
+        const bool avx = (info[2] & (1 << 28)) != 0;
+
+        // the OS must save XMM and YMM state for AVX code to be usable
+        const bool ymmSaved = osxsave && ((_xgetbv(0) & 0x6) == 0x6);
+
+        bool avx2 = false;
+        if (maxLeaf >= 7) {
+            __cpuidex(info, 7, 0);
+            avx2 = (info[1] & (1 << 5)) != 0;
+        }
+        f.avx2 = avx && avx2 && fma && ymmSaved;
+
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+        __builtin_cpu_init();
+        f.sse41 = __builtin_cpu_supports("sse4.1");
+        f.avx2 = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#endif
+
+        return f;
+    }
+}
+
+// return the cached features
+// ------------------------------------------------------------------------
+const CpuFeatures& cpuFeatures() {
+    static const CpuFeatures features = detectCpuFeatures();
+    return features;
+}
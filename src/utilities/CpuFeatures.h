@@ -0,0 +1,21 @@
+#ifndef CPUFEATURES_H
+#define CPUFEATURES_H
+
+
+/** CPU features
+ * ---------------------------
+ * Runtime detection of the x86 SIMD extensions used by the batch kernels.
+ * The result is computed once and cached. On non-x86 targets every flag is false.
+*/
+struct CpuFeatures {
+    bool sse41{false};
+    bool avx2{false};  // AVX2 + FMA, and the OS saves the YMM registers
+};
+
+/** Return the features of the CPU the process runs on
+ * ----------------------------------------------------------------------------
+ * @return const CpuFeatures&
+ */
+const CpuFeatures& cpuFeatures();
+
+#endif
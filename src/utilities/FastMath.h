@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cmath>
+
+/**
+ * Polynomial sin/cos/tan approximations
+ * ---------------------------
+ * Scalar reference of the polynomials used by the SIMD kernels in BicycleModelSSE41.cpp and
+ * BicycleModelAVX2.cpp. The kernels evaluate exactly the same operations lane by lane, so the
+ * scalar batch path and the SIMD paths agree up to FMA rounding.
+ *
+ * sin/cos: the argument is reduced to r in [-PI/4, PI/4] by a 3-part Cody-Waite subtraction of
+ * q * PI/2 (q = nearest integer of x * 2/PI), then Cephes minimax polynomials are evaluated and
+ * the quadrant q mod 4 selects/negates the results.
+ * Measured max abs error vs double precision sin/cos: 9.3e-8 for |x| <= 1000 (about 1 ulp at 1.0).
+ *
+ * tan: Cephes minimax polynomial on [-PI/4, PI/4] without range reduction. It is only valid for
+ * steering angles, which BicycleModel clamps to ±delta_max = ±PI/4.
+ * Measured max relative error vs double precision tan on [-PI/4, PI/4]: 9.0e-8.
+ *
+ * atan2: Abramowitz & Stegun 4.4.49 polynomial of atan on [0, 1] applied to min(|x|, |y|) / max(|x|, |y|),
+ * then the octant is restored. Max abs error 1e-5 rad; only used where a coarse angle is enough
+ * (RangeSensor beam culling).
+ */
+
+// Cody-Waite split of PI/2 (FAST_PIO2_1 + FAST_PIO2_2 + FAST_PIO2_3 ≈ PI/2)
+inline constexpr float FAST_TWO_OVER_PI = 0.636619772367581343f;
+inline constexpr float FAST_PIO2_1 = 1.5703125f;
+inline constexpr float FAST_PIO2_2 = 4.837512969970703125e-4f;
+inline constexpr float FAST_PIO2_3 = 7.54978995489188216e-8f;
+
+// sin coefficients on [-PI/4, PI/4]
+inline constexpr float FAST_SIN_C1 = -1.6666654611e-1f;
+inline constexpr float FAST_SIN_C2 =  8.3321608736e-3f;
+inline constexpr float FAST_SIN_C3 = -1.9515295891e-4f;
+
+// cos coefficients on [-PI/4, PI/4]
+inline constexpr float FAST_COS_C1 =  4.166664568298827e-2f;
+inline constexpr float FAST_COS_C2 = -1.388731625493765e-3f;
+inline constexpr float FAST_COS_C3 =  2.443315711809948e-5f;
+
+// tan coefficients on [-PI/4, PI/4]
+inline constexpr float FAST_TAN_C1 = 3.33331568548e-1f;
+inline constexpr float FAST_TAN_C2 = 1.33387994085e-1f;
+inline constexpr float FAST_TAN_C3 = 5.34112807005e-2f;
+inline constexpr float FAST_TAN_C4 = 2.44301354525e-2f;
+inline constexpr float FAST_TAN_C5 = 3.11992232697e-3f;
+inline constexpr float FAST_TAN_C6 = 9.38540185543e-3f;
+
+// atan coefficients on [0, 1]
+inline constexpr float FAST_ATAN_C1 =  0.9998660f;
+inline constexpr float FAST_ATAN_C3 = -0.3302995f;
+inline constexpr float FAST_ATAN_C5 =  0.1801410f;
+inline constexpr float FAST_ATAN_C7 = -0.0851330f;
+inline constexpr float FAST_ATAN_C9 =  0.0208351f;
+inline constexpr float FAST_PI = 3.14159265358979f;
+
+// compute sin(x) and cos(x) at once
+inline void fastSinCos(float x, float& s, float& c) {
+    const float q = std::nearbyint(x * FAST_TWO_OVER_PI);
+    const float r = ((x - q * FAST_PIO2_1) - q * FAST_PIO2_2) - q * FAST_PIO2_3;
+    const float z = r * r;
+
+    const float sr = r + r * z * (FAST_SIN_C1 + z * (FAST_SIN_C2 + z * FAST_SIN_C3));
+    const float cr = 1.0f - 0.5f * z + z * z * (FAST_COS_C1 + z * (FAST_COS_C2 + z * FAST_COS_C3));
+
+    // quadrant selection
+    const int quadrant = static_cast<int>(q) & 3;
+    const bool swap = (quadrant & 1) != 0;
+    const float sv = swap ? cr : sr;
+    const float cv = swap ? sr : cr;
+    s = (quadrant & 2) ? -sv : sv;
+    c = (quadrant == 1 || quadrant == 2) ? -cv : cv;
+}
+
+// tan(x) for |x| <= PI/4
+inline float fastTanQuarterPi(float x) {
+    const float z = x * x;
+    const float p = ((((FAST_TAN_C6 * z + FAST_TAN_C5) * z + FAST_TAN_C4) * z + FAST_TAN_C3) * z + FAST_TAN_C2) * z + FAST_TAN_C1;
+    return x + x * z * p;
+}
+
+// atan2(y, x) in [-PI, PI], 0 for (0, 0)
+inline float fastAtan2(float y, float x) {
+    const float ax = std::fabs(x), ay = std::fabs(y);
+    const float mx = ax > ay ? ax : ay;
+    const float mn = ax > ay ? ay : ax;
+    const float a = mx > 0.0f ? mn / mx : 0.0f;
+    const float z = a * a;
+
+    float r = a * (FAST_ATAN_C1 + z * (FAST_ATAN_C3 + z * (FAST_ATAN_C5 + z * (FAST_ATAN_C7 + z * FAST_ATAN_C9))));
+    if (ay > ax) r = 0.5f * FAST_PI - r;
+    if (x < 0.0f) r = FAST_PI - r;
+    return (y < 0.0f) ? -r : r;
+}
@@ -0,0 +1,157 @@
+#include "Logger.h"
+
+#include <cstdarg>
+
+
+namespace {
+    constexpr uint64_t RING_MASK = Logger::RING_CAPACITY - 1;
+    static_assert((Logger::RING_CAPACITY & RING_MASK) == 0, "RING_CAPACITY must be a power of two");
+
+    const char* levelName(LogLevel level) {
+        switch (level) {
+        case LogLevel::Trace: return "TRACE";
+        case LogLevel::Debug: return "DEBUG";
+        case LogLevel::Info:  return "INFO ";
+        case LogLevel::Warn:  return "WARN ";
+        case LogLevel::Error: return "ERROR";
+        default:              return "     ";
+        }
+    }
+
+    // file name without directories
+    const char* baseName(const char* path) {
+        const char* base = path;
+        for (const char* p = path; *p; ++p) {
+            if (*p == '/' || *p == '\\') base = p + 1;
+        }
+        return base;
+    }
+
+    // small sequential id per thread, easier to read than std::thread::id
+    uint32_t threadIndex() {
+        static std::atomic<uint32_t> nextIndex{0};
+        thread_local const uint32_t index = nextIndex.fetch_add(1, std::memory_order_relaxed);
+        return index;
+    }
+}
+
+// process-wide logger
+// ------------------------------------------------------------------------
+Logger& Logger::instance() {
+    static Logger logger;
+    return logger;
+}
+
+// constructor starts the sink thread
+// ------------------------------------------------------------------------
+Logger::Logger() : start(std::chrono::steady_clock::now()), ring(new Record[RING_CAPACITY]) {
+    for (uint64_t i = 0; i < RING_CAPACITY; ++i) {
+        ring[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    sinkThread = std::thread(&Logger::sinkLoop, this);
+}
+
+// destructor drains the ring and joins the sink thread
+// ------------------------------------------------------------------------
+Logger::~Logger() {
+    stopping.store(true, std::memory_order_release);
+    if (sinkThread.joinable()) sinkThread.join();
+}
+
+// format and enqueue a message
+// ------------------------------------------------------------------------
+bool Logger::log(LogLevel level, const char* file, int line, const char* fmt, ...) {
+    // claim a slot (Vyukov bounded queue), give up instead of waiting when the ring is full
+    uint64_t pos = enqueuePos.load(std::memory_order_relaxed);
+    Record* record = nullptr;
+    for (;;) {
+        record = &ring[pos & RING_MASK];
+        const uint64_t seq = record->sequence.load(std::memory_order_acquire);
+        const int64_t diff = static_cast<int64_t>(seq) - static_cast<int64_t>(pos);
+        if (diff == 0) {
+            if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+        } else if (diff < 0) {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        } else {
+            pos = enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+
+    // the slot is owned by this thread until the sequence is published
+    record->level = level;
+    record->file = file;
+    record->line = line;
+    record->thread = threadIndex();
+    record->seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    va_list args;
+    va_start(args, fmt);
+    std::vsnprintf(record->message, MESSAGE_SIZE, fmt, args);
+    va_end(args);
+
+    record->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+// wait until every message enqueued so far has been written
+// ------------------------------------------------------------------------
+void Logger::flush() {
+    const uint64_t target = enqueuePos.load(std::memory_order_acquire);
+    while (dequeuePos.load(std::memory_order_acquire) < target) {
+        std::this_thread::yield();
+    }
+    std::fflush(output.load(std::memory_order_relaxed));
+}
+
+// redirect the sink
+// ------------------------------------------------------------------------
+void Logger::setOutput(std::FILE* out) {
+    flush();
+    output.store(out, std::memory_order_relaxed);
+}
+
+// sink thread: write records until stopped, then drain
+// ------------------------------------------------------------------------
+void Logger::sinkLoop() {
+    while (!stopping.load(std::memory_order_acquire)) {
+        if (!writeOne()) {
+            std::fflush(output.load(std::memory_order_relaxed));
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+    while (writeOne()) {}
+    std::fflush(output.load(std::memory_order_relaxed));
+}
+
+// write the next record if there is one
+// ------------------------------------------------------------------------
+bool Logger::writeOne() {
+    const uint64_t pos = dequeuePos.load(std::memory_order_relaxed);
+    Record& record = ring[pos & RING_MASK];
+    if (record.sequence.load(std::memory_order_acquire) != pos + 1) return false;
+
+    std::fprintf(output.load(std::memory_order_relaxed), "%12.6f %s [%s:%d] (t%u) %s\n",
+                 record.seconds, levelName(record.level), baseName(record.file), record.line, record.thread, record.message);
+
+    // hand the slot back to the producers, one lap later
+    record.sequence.store(pos + RING_CAPACITY, std::memory_order_release);
+    dequeuePos.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+// parse a level name
+// ------------------------------------------------------------------------
+bool parseLogLevel(const std::string& name, LogLevel& level) {
+    static const struct { const char* name; LogLevel level; } LEVELS[] = {
+        {"trace", LogLevel::Trace}, {"debug", LogLevel::Debug}, {"info", LogLevel::Info},
+        {"warn", LogLevel::Warn}, {"error", LogLevel::Error}, {"off", LogLevel::Off},
+    };
+    for (const auto& entry : LEVELS) {
+        if (name == entry.name) {
+            level = entry.level;
+            return true;
+        }
+    }
+    return false;
+}
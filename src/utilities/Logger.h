@@ -0,0 +1,145 @@
+#ifndef LOGGER_H
+#define LOGGER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <thread>
+
+
+// log levels, a message is emitted if its level >= the compile-time and runtime levels
+enum class LogLevel : int {
+    Trace = 0,
+    Debug = 1,
+    Info  = 2,
+    Warn  = 3,
+    Error = 4,
+    Off   = 5
+};
+
+// compile-time minimum level: calls below it are removed by the compiler (set by CMake, default Debug)
+#ifndef CAR_LOG_LEVEL
+#define CAR_LOG_LEVEL 1
+#endif
+
+/**
+ * Logger Class
+ * ---------------------------
+ * Leveled logger with an asynchronous sink.
+ *
+ * log() formats the message on the calling thread into a fixed-size record and pushes it into a
+ * bounded lock-free multi-producer/single-consumer ring (per-slot sequence numbers). A background
+ * sink thread pops the records and writes them as
+ *   <seconds since start> <LEVEL> [<file>:<line>] (t<thread>) <message>
+ * If the ring is full the record is dropped and counted, so the logging thread never waits.
+ *
+ * Disabled calls cost nothing: levels below CAR_LOG_LEVEL are compiled out by the CAR_LOG_* macros,
+ * and levels below the runtime level cost one relaxed atomic load.
+ */
+class Logger {
+public:
+    static constexpr std::size_t MESSAGE_SIZE = 512;   // bytes per message including '\0', longer messages are cut
+    static constexpr std::size_t RING_CAPACITY = 2048; // records, power of two
+
+    // process-wide logger, the sink thread starts on first use
+    static Logger& instance();
+
+    // destructor drains the ring and joins the sink thread
+    // ------------------------------------------------------------------------
+    ~Logger();
+
+    Logger(const Logger&) = delete;
+    Logger& operator=(const Logger&) = delete;
+
+    // runtime level check
+    bool isEnabled(LogLevel level) const noexcept {
+        return static_cast<int>(level) >= runtimeLevel.load(std::memory_order_relaxed);
+    }
+
+    /** Format and enqueue a message (printf-style), never blocks
+     * ----------------------------------------------------------------------------
+     * @param[in] level: message level
+     * @param[in] file: source file (__FILE__)
+     * @param[in] line: source line (__LINE__)
+     * @param[in] fmt: printf format
+     * @return bool: false if the message was dropped because the ring was full
+     */
+#if defined(__GNUC__) || defined(__clang__)
+    __attribute__((format(printf, 5, 6)))
+#endif
+    bool log(LogLevel level, const char* file, int line, const char* fmt, ...);
+
+    /** Wait until every message enqueued so far has been written
+     * ----------------------------------------------------------------------------
+     * @return void
+     */
+    void flush();
+
+    // setter
+    void setLevel(LogLevel level) noexcept { runtimeLevel.store(static_cast<int>(level), std::memory_order_relaxed); }
+    void setOutput(std::FILE* out);   // default stdout, flushes first
+
+    // getter
+    LogLevel getLevel() const noexcept { return static_cast<LogLevel>(runtimeLevel.load(std::memory_order_relaxed)); }
+    uint64_t getDroppedCount() const noexcept { return dropped.load(std::memory_order_relaxed); }
+
+private:
+    Logger();
+
+    struct Record {
+        std::atomic<uint64_t> sequence{0};
+        LogLevel level{LogLevel::Info};
+        int line{0};
+        const char* file{nullptr};
+        uint32_t thread{0};
+        double seconds{0.0};
+        char message[MESSAGE_SIZE];
+    };
+
+    std::atomic<int> runtimeLevel{static_cast<int>(LogLevel::Info)};
+    std::atomic<uint64_t> dropped{0};
+    std::chrono::steady_clock::time_point start;
+
+    // ring: producers claim slots with enqueuePos, the sink thread owns dequeuePos
+    std::unique_ptr<Record[]> ring;
+    alignas(64) std::atomic<uint64_t> enqueuePos{0};
+    alignas(64) std::atomic<uint64_t> dequeuePos{0};
+
+    std::atomic<std::FILE*> output{stdout};
+    std::atomic<bool> stopping{false};
+    std::thread sinkThread;
+
+    void sinkLoop();
+    bool writeOne();   // write the next record if there is one
+};
+
+/** Parse a level name (trace, debug, info, warn, error, off)
+ * ----------------------------------------------------------------------------
+ * @param[in] name: level name
+ * @param[out] level: parsed level
+ * @return bool: false if the name is unknown
+ */
+bool parseLogLevel(const std::string& name, LogLevel& level);
+
+
+// logging macros, e.g. CAR_LOG_INFO("reset env %zu", i);
+#define CAR_LOG(level, ...)                                                              \
+    do {                                                                                 \
+        if constexpr (static_cast<int>(level) >= CAR_LOG_LEVEL) {                        \
+            if (Logger::instance().isEnabled(level)) {                                   \
+                Logger::instance().log(level, __FILE__, __LINE__, __VA_ARGS__);          \
+            }                                                                            \
+        }                                                                                \
+    } while (0)
+
+#define CAR_LOG_TRACE(...) CAR_LOG(LogLevel::Trace, __VA_ARGS__)
+#define CAR_LOG_DEBUG(...) CAR_LOG(LogLevel::Debug, __VA_ARGS__)
+#define CAR_LOG_INFO(...)  CAR_LOG(LogLevel::Info,  __VA_ARGS__)
+#define CAR_LOG_WARN(...)  CAR_LOG(LogLevel::Warn,  __VA_ARGS__)
+#define CAR_LOG_ERROR(...) CAR_LOG(LogLevel::Error, __VA_ARGS__)
+
+#endif
@@ -1,19 +1,124 @@
 #include "Randomizer.h"
 
+
+namespace {
+    // Philox4x32 constants (Salmon et al., "Parallel Random Numbers: As Easy as 1, 2, 3")
+    constexpr uint32_t PHILOX_M0 = 0xD2511F53u;
+    constexpr uint32_t PHILOX_M1 = 0xCD9E8D57u;
+    constexpr uint32_t PHILOX_W0 = 0x9E3779B9u;
+    constexpr uint32_t PHILOX_W1 = 0xBB67AE85u;
+    constexpr int PHILOX_ROUNDS = 10;
+
+    // 24 random bits -> [0, 1)
+    inline float toUnitFloat(uint32_t u) {
+        return static_cast<float>(u >> 8) * (1.0f / 16777216.0f);
+    }
+
+    inline float toRange(uint32_t u, float lo, float span) {
+        return lo + toUnitFloat(u) * span;
+    }
+}
+
 // constructor
 // ------------------------------------------------------------------------
-Randomizer::Randomizer() {};
+Randomizer::Randomizer() {
+    std::random_device rd;
+    seed((static_cast<uint64_t>(rd()) << 32) | rd());
+}
+
+Randomizer::Randomizer(uint64_t globalSeed, RngMode mode) : mode(mode) {
+    seed(globalSeed);
+}
+
+// set the global seed and restart at stream (0, 0)
+// ------------------------------------------------------------------------
+void Randomizer::seed(uint64_t newSeed) {
+    globalSeed = newSeed;
+    key = {static_cast<uint32_t>(newSeed), static_cast<uint32_t>(newSeed >> 32)};
+    if (mode == RngMode::MT19937 && !mt) mt = std::make_unique<std::mt19937>();
+    setStream(0, 0);
+}
+
+// switch to the stream (globalSeed, streamIndex, subIndex)
+// ------------------------------------------------------------------------
+void Randomizer::setStream(uint64_t streamIndex, uint64_t subIndex) {
+    if (mode == RngMode::MT19937) {
+        std::seed_seq seq{static_cast<uint32_t>(globalSeed), static_cast<uint32_t>(globalSeed >> 32),
+                          static_cast<uint32_t>(streamIndex), static_cast<uint32_t>(subIndex)};
+        mt->seed(seq);
+        return;
+    }
+    counter = {0u, 0u, static_cast<uint32_t>(streamIndex), static_cast<uint32_t>(subIndex)};
+    blockPos = 4;
+}
+
+// next raw 32-bit draw
+// ------------------------------------------------------------------------
+uint32_t Randomizer::nextU32() {
+    if (mode == RngMode::MT19937) return static_cast<uint32_t>((*mt)());
+
+    if (blockPos == 4) {
+        block = philox4x32(counter, key);
+        if (++counter[0] == 0) ++counter[1];
+        blockPos = 0;
+    }
+    return block[blockPos++];
+}
 
 // return a random float number in [minVal, maxVal)
 // ------------------------------------------------------------------------
 float Randomizer::randFloat(float minVal, float maxVal) {
-    std::uniform_real_distribution<float> dist(minVal, maxVal);
-    return dist(g_rng);
+    return toRange(nextU32(), minVal, maxVal - minVal);
 }
 
-// return a random int number in [minVal, maxVal)
+// return a random int number in [minVal, maxVal], Lemire's multiply-shift with rejection
 // ------------------------------------------------------------------------
 int Randomizer::randInt(int minVal, int maxVal) {
-    std::uniform_int_distribution<int> dist(minVal, maxVal);
-    return dist(g_rng);
+    const uint64_t range = static_cast<uint64_t>(static_cast<int64_t>(maxVal) - minVal) + 1;
+    if (range > UINT32_MAX) return static_cast<int>(nextU32());  // full int range
+
+    const uint32_t r = static_cast<uint32_t>(range);
+    uint64_t m = static_cast<uint64_t>(nextU32()) * r;
+    if (static_cast<uint32_t>(m) < r) {
+        const uint32_t threshold = (0u - r) % r;
+        while (static_cast<uint32_t>(m) < threshold) {
+            m = static_cast<uint64_t>(nextU32()) * r;
+        }
+    }
+    return static_cast<int>(minVal + static_cast<int64_t>(m >> 32));
+}
+
+// fill out with n random floats in [lo, hi)
+// ------------------------------------------------------------------------
+void Randomizer::fillUniform(float* out, std::size_t n, float lo, float hi) {
+    const float span = hi - lo;
+    std::size_t i = 0;
+
+    if (mode == RngMode::Philox) {
+        // use up the current block first so the sequence matches randFloat calls
+        for (; i < n && blockPos < 4; ++i) out[i] = toRange(block[blockPos++], lo, span);
+
+        // whole blocks, no buffering
+        for (; i + 4 <= n; i += 4) {
+            const std::array<uint32_t, 4> words = philox4x32(counter, key);
+            if (++counter[0] == 0) ++counter[1];
+            for (int k = 0; k < 4; ++k) out[i + k] = toRange(words[k], lo, span);
+        }
+    }
+
+    for (; i < n; ++i) out[i] = toRange(nextU32(), lo, span);
+}
+
+// Philox4x32-10 block function
+// ------------------------------------------------------------------------
+std::array<uint32_t, 4> Randomizer::philox4x32(std::array<uint32_t, 4> c, std::array<uint32_t, 2> k) {
+    for (int round = 0; round < PHILOX_ROUNDS; ++round) {
+        const uint64_t p0 = static_cast<uint64_t>(PHILOX_M0) * c[0];
+        const uint64_t p1 = static_cast<uint64_t>(PHILOX_M1) * c[2];
+        c = {static_cast<uint32_t>(p1 >> 32) ^ c[1] ^ k[0], static_cast<uint32_t>(p1),
+             static_cast<uint32_t>(p0 >> 32) ^ c[3] ^ k[1], static_cast<uint32_t>(p0)};
+        k[0] += PHILOX_W0;
+        k[1] += PHILOX_W1;
+    }
+    return c;
 }
@@ -1,28 +1,67 @@
 #ifndef RANDOMIZER_H
 #define RANDOMIZER_H
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
 #include <random>
 
+
+// random number generator behind a Randomizer
+enum class RngMode {
+    Philox,   // counter-based Philox4x32-10, 40 bytes of state, streams are free to derive
+    MT19937   // std::mt19937 (5 KB of state), reseeded by setStream
+};
+
 /** Ranomizer class
  * ---------------------------
- * 
+ * Uniform float/int draws with an explicit seed.
+ *
+ * In Philox mode the n-th 32-bit draw of a stream is a pure function of
+ * (globalSeed, streamIndex, subIndex, n): the seed is the Philox key and the counter is
+ * (n / 4, streamIndex, subIndex). Environments call setStream(envIndex, episodeIndex) on reset,
+ * so a reset is bitwise reproducible no matter how envs share a Randomizer or how they are
+ * scheduled across threads. streamIndex and subIndex use their low 32 bits.
+ *
+ * In MT19937 mode setStream reseeds the mt19937 from (globalSeed, streamIndex, subIndex), which is
+ * reproducible too but costs a full state initialization.
 */
 class Randomizer {
 public:
 
-    // constructor
+    // constructor: random seed from std::random_device, Philox mode
     // ------------------------------------------------------------------------
     Randomizer();
 
-    /** Return a random float number
+    // constructor: explicit seed
+    // ------------------------------------------------------------------------
+    explicit Randomizer(uint64_t globalSeed, RngMode mode = RngMode::Philox);
+
+    /** Set the global seed and restart at stream (0, 0)
+     * ----------------------------------------------------------------------------
+     * @param[in] globalSeed: seed shared by all streams
+     * @return void
+     */
+    void seed(uint64_t globalSeed);
+
+    /** Switch to the stream derived from (globalSeed, streamIndex, subIndex), starting at its first draw
+     * ----------------------------------------------------------------------------
+     * @param[in] streamIndex: e.g. the environment index
+     * @param[in] subIndex: e.g. the episode index
+     * @return void
+     */
+    void setStream(uint64_t streamIndex, uint64_t subIndex);
+
+    /** Return a random float number in [minVal, maxVal)
      * ----------------------------------------------------------------------------
      * @param[in] minVal: Minimum value
      * @param[in] maxVal: Maximum value
-     * @return float 
+     * @return float
      */
     float randFloat(float minVal, float maxVal);
 
-    /** Return a random int number
+    /** Return a random int number in [minVal, maxVal] (unbiased)
      * ----------------------------------------------------------------------------
      * @param[in] minVal: Minimum value
      * @param[in] maxVal: Maximum value
@@ -30,8 +69,45 @@ public:
      */
     int randInt(int minVal, int maxVal);
 
+    /** Fill out with n random floats in [lo, hi)
+     * ----------------------------------------------------------------------------
+     * Produces exactly the values of n consecutive randFloat(lo, hi) calls. In Philox mode whole
+     * blocks of 4 draws are generated straight into out.
+     *
+     * @param[out] out: n floats
+     * @param[in] n: number of floats
+     * @param[in] lo: Minimum value
+     * @param[in] hi: Maximum value
+     * @return void
+     */
+    void fillUniform(float* out, std::size_t n, float lo, float hi);
+
+    // next raw 32-bit draw of the current stream
+    uint32_t nextU32();
+
+    // getter
+    uint64_t getSeed() const noexcept { return globalSeed; }
+    RngMode getMode() const noexcept { return mode; }
+
+    /** Philox4x32-10 block function
+     * ----------------------------------------------------------------------------
+     * @param[in] counter: 128-bit counter
+     * @param[in] key: 64-bit key
+     * @return std::array<uint32_t, 4>: 4 random words
+     */
+    static std::array<uint32_t, 4> philox4x32(std::array<uint32_t, 4> counter, std::array<uint32_t, 2> key);
+
 private:
-    // RNG – constructed once
-    std::mt19937 g_rng{ std::random_device{}() };
+    RngMode mode{RngMode::Philox};
+    uint64_t globalSeed{0};
+
+    // Philox state: counter[0..1] is the block index, counter[2..3] the stream
+    std::array<uint32_t, 2> key{};
+    std::array<uint32_t, 4> counter{};
+    std::array<uint32_t, 4> block{};
+    unsigned blockPos{4};  // next unused word of block, 4 = empty
+
+    // MT19937 state, only allocated in MT19937 mode
+    std::unique_ptr<std::mt19937> mt;
 };
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,84 @@
+#ifndef TRANSFORM2D_H
+#define TRANSFORM2D_H
+
+#include <cmath>
+#include <cstddef>
+
+#include "../vehicledynamics/VehicleTypes.h"
+
+
+/**
+ * Transform2D
+ * ---------------------------
+ * Rigid transform in the plane (SE(2)) from a local frame to its parent frame:
+ *   p_parent = R(yaw) * p_local + t
+ * cos/sin of the yaw are computed once in fromPose() and reused by every apply, so a pose that is
+ * used several times per step (slot corners, parking check, wheel placement) costs one sin/cos pair.
+ */
+struct Transform2D {
+    float c{1.0f};            // cos(yaw)
+    float s{0.0f};            // sin(yaw)
+    Position2D t{0.0f, 0.0f}; // origin of the local frame in the parent frame
+
+    // transform of a frame at pos with heading yaw
+    static Transform2D fromPose(const Position2D& pos, float yaw) noexcept {
+        return Transform2D{std::cos(yaw), std::sin(yaw), pos};
+    }
+
+    // rotate a vector from the local frame into the parent frame (no translation)
+    Position2D rotate(const Position2D& v) const noexcept {
+        return Position2D{c * v.x - s * v.y, s * v.x + c * v.y};
+    }
+
+    // local point -> parent frame
+    Position2D apply(const Position2D& p) const noexcept {
+        return Position2D{t.x + c * p.x - s * p.y, t.y + s * p.x + c * p.y};
+    }
+
+    // parent point -> local frame
+    Position2D applyInverse(const Position2D& p) const noexcept {
+        const float dx = p.x - t.x;
+        const float dy = p.y - t.y;
+        return Position2D{c * dx + s * dy, -s * dx + c * dy};
+    }
+
+    // transform from the parent frame to the local frame
+    Transform2D inverse() const noexcept {
+        return Transform2D{c, -s, Position2D{-(c * t.x + s * t.y), s * t.x - c * t.y}};
+    }
+
+    // this * other: maps the local frame of other into the parent frame of this
+    Transform2D compose(const Transform2D& other) const noexcept {
+        return Transform2D{c * other.c - s * other.s, s * other.c + c * other.s, apply(other.t)};
+    }
+
+    // heading of the local frame in the parent frame, (-PI, PI]
+    float yaw() const noexcept { return std::atan2(s, c); }
+
+    /** Apply the transform to n points
+     * ----------------------------------------------------------------------------
+     * @param[in] in: n points in the local frame
+     * @param[out] out: n points in the parent frame (may alias in)
+     * @param[in] n: number of points
+     * @return void
+     */
+    void applyN(const Position2D* in, Position2D* out, std::size_t n) const noexcept {
+        for (std::size_t i = 0; i < n; ++i) out[i] = apply(in[i]);
+    }
+
+    // same as above for points in SoA form, the loop vectorizes
+    void applyN(const float* inX, const float* inY, float* outX, float* outY, std::size_t n) const noexcept {
+        for (std::size_t i = 0; i < n; ++i) {
+            const float x = inX[i], y = inY[i];
+            outX[i] = t.x + c * x - s * y;
+            outY[i] = t.y + s * x + c * y;
+        }
+    }
+
+    // parent points -> local frame, n points
+    void applyInverseN(const Position2D* in, Position2D* out, std::size_t n) const noexcept {
+        for (std::size_t i = 0; i < n; ++i) out[i] = applyInverse(in[i]);
+    }
+};
+
+#endif
@@ -0,0 +1,107 @@
+#include "WorkStealingPool.h"
+
+#include <algorithm>
+
+
+// constructor
+// ------------------------------------------------------------------------
+WorkStealingPool::WorkStealingPool(std::size_t numThreads) {
+    if (numThreads == 0) {
+        numThreads = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+    }
+
+    queues.reserve(numThreads);
+    for (std::size_t i = 0; i < numThreads; ++i) {
+        queues.push_back(std::make_unique<WorkerQueue>());
+    }
+
+    workers.reserve(numThreads);
+    for (std::size_t i = 0; i < numThreads; ++i) {
+        workers.emplace_back(&WorkStealingPool::workerLoop, this, i);
+    }
+}
+
+// destructor
+// ------------------------------------------------------------------------
+WorkStealingPool::~WorkStealingPool() {
+    {
+        std::lock_guard<std::mutex> lock(jobMutex);
+        stopping = true;
+    }
+    jobCv.notify_all();
+    for (auto& t : workers) t.join();
+}
+
+// deal the tasks, wake the workers and wait for completion
+// ------------------------------------------------------------------------
+void WorkStealingPool::parallelFor(std::size_t numTasks, const TaskFn& fn) {
+    if (numTasks == 0) return;
+
+    // round-robin so every worker starts with a local share
+    for (std::size_t t = 0; t < numTasks; ++t) {
+        WorkerQueue& q = *queues[t % queues.size()];
+        std::lock_guard<std::mutex> lock(q.mutex);
+        q.tasks.push_back(t);
+    }
+
+    std::unique_lock<std::mutex> lock(jobMutex);
+    job = &fn;
+    activeWorkers = workers.size();
+    ++generation;
+    jobCv.notify_all();
+    doneCv.wait(lock, [this] { return activeWorkers == 0; });
+    job = nullptr;
+}
+
+// worker: wait for a job, drain own queue, then steal
+// ------------------------------------------------------------------------
+void WorkStealingPool::workerLoop(std::size_t index) {
+    uint64_t seenGeneration = 0;
+
+    for (;;) {
+        const TaskFn* fn = nullptr;
+        {
+            std::unique_lock<std::mutex> lock(jobMutex);
+            jobCv.wait(lock, [&] { return stopping || generation != seenGeneration; });
+            if (stopping) return;
+            seenGeneration = generation;
+            fn = job;
+        }
+
+        std::size_t task = 0;
+        while (popOwn(index, task) || steal(index, task)) {
+            (*fn)(task, index);
+        }
+
+        // all deques were empty when this worker looked; tasks are never re-queued, so it is done
+        std::lock_guard<std::mutex> lock(jobMutex);
+        if (--activeWorkers == 0) doneCv.notify_one();
+    }
+}
+
+// pop from the back of the own deque
+// ------------------------------------------------------------------------
+bool WorkStealingPool::popOwn(std::size_t index, std::size_t& task) {
+    WorkerQueue& q = *queues[index];
+    std::lock_guard<std::mutex> lock(q.mutex);
+    if (q.tasks.empty()) return false;
+    task = q.tasks.back();
+    q.tasks.pop_back();
+    return true;
+}
+
+// steal from the front of another worker's deque
+// ------------------------------------------------------------------------
+bool WorkStealingPool::steal(std::size_t index, std::size_t& task) {
+    const std::size_t n = queues.size();
+    for (std::size_t k = 1; k < n; ++k) {
+        WorkerQueue& victim = *queues[(index + k) % n];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (victim.tasks.empty()) continue;
+        task = victim.tasks.front();
+        victim.tasks.pop_front();
+        queues[index]->stolen.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+    return false;
+}
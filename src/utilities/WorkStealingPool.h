@@ -0,0 +1,78 @@
+#ifndef WORKSTEALINGPOOL_H
+#define WORKSTEALINGPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+/** Work-stealing thread pool
+ * ---------------------------
+ * Persistent worker threads that execute a batch of independent tasks.
+ * parallelFor() deals the tasks round-robin into one deque per worker. A worker pops from the back
+ * of its own deque and, once it is empty, steals from the front of the other workers' deques, so
+ * uneven task costs are balanced without a shared queue on the hot path.
+ *
+ * Tasks are expected to be coarse (e.g. "step one env shard for K steps"), so each deque is
+ * protected by a small mutex instead of a lock-free Chase-Lev deque.
+*/
+class WorkStealingPool {
+public:
+    using TaskFn = std::function<void(std::size_t task, std::size_t worker)>;
+
+    // constructor, numThreads = 0 uses std::thread::hardware_concurrency()
+    // ------------------------------------------------------------------------
+    explicit WorkStealingPool(std::size_t numThreads = 0);
+
+    // destructor joins all workers
+    // ------------------------------------------------------------------------
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    /** Run fn(task, worker) for every task in [0, numTasks) and wait until all are done
+     * ----------------------------------------------------------------------------
+     * @param[in] numTasks: number of tasks
+     * @param[in] fn: task body, worker is the index of the executing worker in [0, size())
+     * @return void
+     */
+    void parallelFor(std::size_t numTasks, const TaskFn& fn);
+
+    // getter
+    std::size_t size() const noexcept { return workers.size(); }
+
+    // number of tasks worker i has stolen from other workers since construction
+    uint64_t getStolenCount(std::size_t worker) const { return queues[worker]->stolen.load(std::memory_order_relaxed); }
+
+private:
+    struct alignas(64) WorkerQueue {
+        std::mutex mutex;
+        std::deque<std::size_t> tasks;
+        std::atomic<uint64_t> stolen{0};
+    };
+
+    std::vector<std::thread> workers;
+    std::vector<std::unique_ptr<WorkerQueue>> queues;
+
+    // job dispatch
+    std::mutex jobMutex;
+    std::condition_variable jobCv;
+    std::condition_variable doneCv;
+    const TaskFn* job{nullptr};
+    uint64_t generation{0};
+    std::size_t activeWorkers{0};
+    bool stopping{false};
+
+    void workerLoop(std::size_t index);
+    bool popOwn(std::size_t index, std::size_t& task);
+    bool steal(std::size_t index, std::size_t& task);
+};
+#endif
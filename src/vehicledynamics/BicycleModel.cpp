@@ -1,4 +1,7 @@
 #include "BicycleModel.h"
+#include "BicycleModelKernels.h"
+#include "../utilities/CpuFeatures.h"
+#include "../utilities/FastMath.h"
 
 
 // helper: normalize angle to (-pi, pi]
@@ -10,9 +13,17 @@ static inline float normalizeAngleRad(float a) {
     return a - PI;
 }
 
+// helper: cos(x) for |x| <= PI/4 (steering angles), no range reduction needed
+// ------------------------------------------------------------------------
+static inline float cosQuarterPi(float x) {
+    const float z = x * x;
+    return 1.0f - 0.5f * z + z * z * (FAST_COS_C1 + z * (FAST_COS_C2 + z * FAST_COS_C3));
+}
+
 // constructor
 // ------------------------------------------------------------------------
-BicycleModel::BicycleModel(float length): length(length) {};
+BicycleModel::BicycleModel(float length, const DynamicBicycleParams& dynamicParams)
+    : length(length), dynamicParams(dynamicParams) {};
 
 // Calculate the car movement using kinematic bicycle model
 // ------------------------------------------------------------------------
@@ -24,6 +35,27 @@ void BicycleModel::kinematicAct(Action& action, VehicleState& vehicleState, floa
     action.steeringAngle = std::clamp(action.steeringAngle, -limits.delta_max, limits.delta_max);
     action.acceleration = std::clamp(action.acceleration, -limits.a_max, limits.a_max);
 
+    static_cast<const BicycleModel&>(*this).kinematicAct(static_cast<const Action&>(action), vehicleState, dt);
+}
+
+// Calculate the car movement using kinematic bicycle model, the action is not modified
+// ------------------------------------------------------------------------
+void BicycleModel::kinematicAct(const Action& input, VehicleState& vehicleState, float dt) const noexcept {
+
+    const BicycleModelLimits limits;
+
+    if (integrator == KinematicIntegrator::Arc) {
+        const KinematicBatchParams p{dt, 1.0f / length, limits.delta_max, limits.a_max, limits.v_max};
+        VehicleStateSoA one{&vehicleState.pos.x, &vehicleState.pos.y, &vehicleState.psi, &vehicleState.velocity, &vehicleState.delta, 1};
+        kinematicArcBatchScalar(&input, one, 0, 1, p);
+        return;
+    }
+
+    // clamp action inputs
+    Action action;
+    action.steeringAngle = std::clamp(input.steeringAngle, -limits.delta_max, limits.delta_max);
+    action.acceleration = std::clamp(input.acceleration, -limits.a_max, limits.a_max);
+
     // update velocity with acceleration limits
     vehicleState.velocity += action.acceleration * dt;
 
@@ -58,9 +90,221 @@ void BicycleModel::kinematicAct(Action& action, VehicleState& vehicleState, floa
     // << " v: " << vehicleState.velocity << std::endl;
 }
 
-void BicycleModel::dynamicAct(Action action) {
-    // To be implemented later
+// Calculate the movement of many cars, best SIMD path for this CPU
+// ------------------------------------------------------------------------
+void BicycleModel::kinematicActBatch(const Action* actions, const VehicleStateSoA& state, float dt) const {
+    kinematicActBatch(actions, state, dt, activeSimdPath());
+}
+
+// Calculate the movement of many cars with an explicit SIMD path
+// ------------------------------------------------------------------------
+void BicycleModel::kinematicActBatch(const Action* actions, const VehicleStateSoA& state, float dt, SimdPath path) const {
+    const BicycleModelLimits limits;
+    const KinematicBatchParams p{dt, 1.0f / length, limits.delta_max, limits.a_max, limits.v_max};
+
+    if (integrator == KinematicIntegrator::Arc) {
+        kinematicArcBatchScalar(actions, state, 0, state.count, p);
+        return;
+    }
+
+    // the SIMD kernels handle full blocks, the scalar kernel handles the tail
+    std::size_t done = 0;
+#if defined(CAR_HAVE_X86_SIMD)
+    if (path == SimdPath::AVX2 && isSimdPathSupported(SimdPath::AVX2)) {
+        done = kinematicBatchAVX2(actions, state, p);
+    } else if (path != SimdPath::Scalar && isSimdPathSupported(SimdPath::SSE41)) {
+        done = kinematicBatchSSE41(actions, state, p);
+    }
+#else
+    (void)path;
+#endif
+    kinematicBatchScalar(actions, state, done, state.count, p);
+}
+
+// return the best SIMD path supported by this CPU
+// ------------------------------------------------------------------------
+SimdPath BicycleModel::activeSimdPath() {
+    if (isSimdPathSupported(SimdPath::AVX2)) return SimdPath::AVX2;
+    if (isSimdPathSupported(SimdPath::SSE41)) return SimdPath::SSE41;
+    return SimdPath::Scalar;
+}
+
+// return whether the given SIMD path can run here
+// ------------------------------------------------------------------------
+bool BicycleModel::isSimdPathSupported(SimdPath path) {
+    switch (path) {
+    case SimdPath::Scalar:
+        return true;
+#if defined(CAR_HAVE_X86_SIMD)
+    case SimdPath::SSE41:
+        return cpuFeatures().sse41;
+    case SimdPath::AVX2:
+        return cpuFeatures().avx2;
+#endif
+    default:
+        return false;
+    }
+}
+
+// scalar batch kernel, also processes the tail of the SIMD kernels
+// ------------------------------------------------------------------------
+void kinematicBatchScalar(const Action* actions, const VehicleStateSoA& state, std::size_t begin, std::size_t end, const KinematicBatchParams& p) {
+    const float TWO_PI = 2.0f * PI;
+    const float INV_TWO_PI = 1.0f / TWO_PI;
+
+    for (std::size_t i = begin; i < end; ++i) {
+        const float steer = std::clamp(actions[i].steeringAngle, -p.deltaMax, p.deltaMax);
+        const float accel = std::clamp(actions[i].acceleration, -p.aMax, p.aMax);
+
+        const float v = std::clamp(state.velocity[i] + accel * p.dt, -p.vMax, p.vMax);
+
+        float s, c;
+        fastSinCos(state.psi[i], s, c);
+        const float psiDot = v * fastTanQuarterPi(steer) * p.invLength;
+
+        state.x[i] += p.dt * v * c;
+        state.y[i] += p.dt * v * s;
+        const float psi = state.psi[i] + p.dt * psiDot;
+        state.psi[i] = psi - TWO_PI * std::nearbyint(psi * INV_TWO_PI);
+        state.velocity[i] = v;
+        state.delta[i] = steer;
+    }
+}
+
+// scalar batch kernel with exact arc integration
+// ------------------------------------------------------------------------
+void kinematicArcBatchScalar(const Action* actions, const VehicleStateSoA& state, std::size_t begin, std::size_t end, const KinematicBatchParams& p) {
+    const float TWO_PI = 2.0f * PI;
+    const float INV_TWO_PI = 1.0f / TWO_PI;
+    const float SERIES_LIMIT = 0.1f;  // |k s| below which sin(k s)/(k s) and (1 - cos(k s))/(k s) use their series
+
+    for (std::size_t i = begin; i < end; ++i) {
+        const float steer = std::clamp(actions[i].steeringAngle, -p.deltaMax, p.deltaMax);
+        const float accel = std::clamp(actions[i].acceleration, -p.aMax, p.aMax);
+
+        // distance travelled: constant acceleration until the velocity saturates at ts, then constant
+        const float v0 = std::clamp(state.velocity[i], -p.vMax, p.vMax);
+        const float vEnd = v0 + accel * p.dt;
+        const float v1 = std::clamp(vEnd, -p.vMax, p.vMax);
+        const float ts = (vEnd == v1) ? p.dt : (v1 - v0) / accel;
+        const float dist = ts * (v0 + 0.5f * accel * ts) + (p.dt - ts) * v1;
+
+        // heading change along the arc
+        const float dpsi = dist * fastTanQuarterPi(steer) * p.invLength;
+        float sd, cd;
+        fastSinCos(dpsi, sd, cd);
+        const float z = dpsi * dpsi;
+        const bool straight = std::fabs(dpsi) < SERIES_LIMIT;
+        const float sinc = straight ? 1.0f - z * (1.0f / 6.0f) + z * z * (1.0f / 120.0f) : sd / dpsi;
+        const float cosc = straight ? dpsi * (0.5f - z * (1.0f / 24.0f) + z * z * (1.0f / 720.0f)) : (1.0f - cd) / dpsi;
+
+        // chord in the car frame rotated into the world frame
+        float s, c;
+        fastSinCos(state.psi[i], s, c);
+        state.x[i] += dist * (c * sinc - s * cosc);
+        state.y[i] += dist * (s * sinc + c * cosc);
+        const float psi = state.psi[i] + dpsi;
+        state.psi[i] = psi - TWO_PI * std::nearbyint(psi * INV_TWO_PI);
+        state.velocity[i] = v1;
+        state.delta[i] = steer;
+    }
+}
+
+// Calculate the car movement using dynamic bicycle model
+// ------------------------------------------------------------------------
+void BicycleModel::dynamicAct(const Action& action, VehicleState& vehicleState, float dt) const noexcept {
+    VehicleStateSoA one{&vehicleState.pos.x, &vehicleState.pos.y, &vehicleState.psi, &vehicleState.velocity, &vehicleState.delta, 1,
+                        &vehicleState.vy, &vehicleState.yawRate};
+    dynamicBatchScalar(&action, one, 0, 1, makeDynamicBatchParams(dt));
+}
+
+// Calculate the movement of many cars using dynamic bicycle model, best SIMD path for this CPU
+// ------------------------------------------------------------------------
+void BicycleModel::dynamicActBatch(const Action* actions, const VehicleStateSoA& state, float dt) const noexcept {
+    dynamicActBatch(actions, state, dt, activeSimdPath());
+}
+
+// Calculate the movement of many cars using dynamic bicycle model with an explicit SIMD path
+// ------------------------------------------------------------------------
+void BicycleModel::dynamicActBatch(const Action* actions, const VehicleStateSoA& state, float dt, SimdPath path) const noexcept {
+    const DynamicBatchParams p = makeDynamicBatchParams(dt);
+
+    // the AVX2 kernel handles full blocks, the scalar kernel handles the tail
+    std::size_t done = 0;
+#if defined(CAR_HAVE_X86_SIMD)
+    if (path == SimdPath::AVX2 && isSimdPathSupported(SimdPath::AVX2)) done = dynamicBatchAVX2(actions, state, p);
+#else
+    (void)path;
+#endif
+    dynamicBatchScalar(actions, state, done, state.count, p);
+}
+
+// constants of the dynamic step
+// ------------------------------------------------------------------------
+DynamicBatchParams BicycleModel::makeDynamicBatchParams(float dt) const noexcept {
+    const BicycleModelLimits limits;
+    const DynamicBicycleParams& d = dynamicParams;
+    return DynamicBatchParams{dt, 0.5f * length, 0.5f * length, 1.0f / length, 1.0f / d.mass, 1.0f / d.yawInertia,
+                              d.corneringFront, d.corneringRear, d.blendSpeedLow, 1.0f / (d.blendSpeedHigh - d.blendSpeedLow),
+                              limits.delta_max, limits.a_max, limits.v_max};
+}
+
+// scalar dynamic batch kernel, also processes the tail of the AVX2 kernel
+// ------------------------------------------------------------------------
+void dynamicBatchScalar(const Action* actions, const VehicleStateSoA& state, std::size_t begin, std::size_t end, const DynamicBatchParams& p) {
+    const float TWO_PI = 2.0f * PI;
+    const float INV_TWO_PI = 1.0f / TWO_PI;
+    const float dt = p.dt, lf = p.lf, lr = p.lr;
+    const float minSpeed = 0.1f;  // slip angles use max(|vx|, minSpeed), only reached where the kinematic blend dominates
+
+    for (std::size_t i = begin; i < end; ++i) {
+        const float steer = std::clamp(actions[i].steeringAngle, -p.deltaMax, p.deltaMax);
+        const float accel = std::clamp(actions[i].acceleration, -p.aMax, p.aMax);
+        const float vy0 = state.vy[i], r0 = state.yawRate[i];
+
+        // 1. longitudinal velocity, explicit
+        const float vx = std::clamp(state.velocity[i] + dt * (accel + r0 * vy0), -p.vMax, p.vMax);
+
+        // 2. lateral velocity and yaw rate, backward Euler on the linear tire model at this vx
+        const float cd = cosQuarterPi(steer);
+        const float speed = std::max(std::fabs(vx), minSpeed);
+        const float invSpeed = 1.0f / speed;
+        const float steerDir = (vx < 0.0f) ? -steer : steer;
+        const float cf = p.corneringFront * cd;
+        const float cr = p.corneringRear;
+
+        const float a11 = -(cf + cr) * p.invMass * invSpeed;
+        const float a12 = (lr * cr - lf * cf) * p.invMass * invSpeed - vx;
+        const float a21 = (lr * cr - lf * cf) * p.invInertia * invSpeed;
+        const float a22 = -(lf * lf * cf + lr * lr * cr) * p.invInertia * invSpeed;
+        const float rhs1 = vy0 + dt * cf * steerDir * p.invMass;
+        const float rhs2 = r0 + dt * lf * cf * steerDir * p.invInertia;
+
+        const float m11 = 1.0f - dt * a11, m12 = -dt * a12;
+        const float m21 = -dt * a21, m22 = 1.0f - dt * a22;
+        const float invDet = 1.0f / (m11 * m22 - m12 * m21);
+        const float vyDyn = (rhs1 * m22 - m12 * rhs2) * invDet;
+        const float rDyn = (m11 * rhs2 - m21 * rhs1) * invDet;
+
+        // 3. blend towards kinematicAct at low speed (no side slip there)
+        const float rKin = vx * fastTanQuarterPi(steer) * p.invLength;
+        const float w = std::clamp((std::fabs(vx) - p.blendSpeedLow) * p.invBlendRange, 0.0f, 1.0f);
+        const float vy = w * vyDyn;
+        const float r = rKin + w * (rDyn - rKin);
 
+        // 4. pose with the new velocities
+        const float psiNew = state.psi[i] + dt * r;
+        const float psi = psiNew - TWO_PI * std::nearbyint(psiNew * INV_TWO_PI);
+        float s, c;
+        fastSinCos(psi, s, c);
+        state.x[i] += dt * (vx * c - vy * s);
+        state.y[i] += dt * (vx * s + vy * c);
+        state.psi[i] = psi;
+        state.velocity[i] = vx;
+        state.delta[i] = steer;
+        state.vy[i] = vy;
+        state.yawRate[i] = r;
+    }
 }
 
 // upadte the state of the car
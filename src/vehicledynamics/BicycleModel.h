@@ -9,6 +9,27 @@
 #include "VehicleTypes.h"
 #include "../utilities/MathUtils.h"
 
+struct DynamicBatchParams;   // BicycleModelKernels.h
+
+
+// instruction set used by kinematicActBatch and dynamicActBatch
+enum class SimdPath {
+    Scalar,
+    SSE41,
+    AVX2
+};
+
+// integration of kinematicAct / kinematicActBatch over one step
+enum class KinematicIntegrator {
+    Euler,  // explicit Euler with the updated velocity, accurate for small dt only
+    Arc     // exact for constant action: circular arc of the travelled distance, usable at dt = 0.05-0.1 s
+};
+
+// vehicle model used by the envs
+enum class VehicleModel {
+    Kinematic,
+    Dynamic
+};
 
 struct BicycleModelLimits {
     float delta_max{PI * 0.25f};     // PI/4 = 45 degrees = 0.785rad
@@ -17,16 +38,25 @@ struct BicycleModelLimits {
     float v_max{2.78f};              // 10 km/h ≈ 2.78 m/s
 };
 
+// parameters of the dynamic bicycle model (the axles are at ±length/2 from the center of gravity)
+struct DynamicBicycleParams {
+    float mass{1500.0f};             // kg
+    float yawInertia{2500.0f};       // kg m^2
+    float corneringFront{80000.0f};  // N/rad, linear tire
+    float corneringRear{80000.0f};   // N/rad, linear tire
+    float blendSpeedLow{0.5f};       // m/s, purely kinematic below
+    float blendSpeedHigh{1.5f};      // m/s, purely dynamic above
+};
+
 /**
  * Bicycle Model Class
  * ---------------------------
- * This class implements the kinematic bicycle model for vehicle dynamics. 
- * Dynamic bicycle model will be implemeted later.
+ * This class implements the kinematic and the dynamic bicycle model for vehicle dynamics. 
  */
 class BicycleModel {
 
 public:
-    BicycleModel(float length);
+    BicycleModel(float length, const DynamicBicycleParams& dynamicParams = DynamicBicycleParams{});
 
     /** Calculate the car movement using kinematic bicycle model
      * ----------------------------------------------------------------------------
@@ -38,12 +68,96 @@ public:
      * y_dot = v * sin(psi);
      * v_dot = acceleration;
      * psi_dot = v * tan(steeringAngle) / Length;
+     * The action is clamped to the limits in place.
+     *
+     * With KinematicIntegrator::Arc the step is integrated exactly for the (constant) action instead:
+     * curvature k = tan(steeringAngle) / Length is constant, so the car moves along a circular arc
+     * whose length s is the distance covered by v(t) = clamp(v + acceleration * t, -v_max, v_max):
+     *   psi' = psi + k * s
+     *   x'   = x + s * (cos(psi) * sin(k s) / (k s) - sin(psi) * (1 - cos(k s)) / (k s))
+     *   y'   = y + s * (sin(psi) * sin(k s) / (k s) + cos(psi) * (1 - cos(k s)) / (k s))
+     * with a series for small k * s (straight-line limit). This holds for reversing within the step too,
+     * since the path only depends on the signed distance. sin/cos are the FastMath.h polynomials.
      * @return void 
     */
     void kinematicAct(Action& action, VehicleState& vehicleState, float dt);
 
-    // Calculate the car movement using dynamic bicycle model
-    void dynamicAct(Action action);
+    // same as above, the action is not modified (clamping is done on a local copy)
+    void kinematicAct(const Action& action, VehicleState& vehicleState, float dt) const noexcept;
+
+    /** Calculate the movement of many cars using kinematic bicycle model
+     * ----------------------------------------------------------------------------
+     * Same equations, clamping and heading normalization as kinematicAct, applied to
+     * state.count vehicles stored in SoA form. The best SIMD path supported by the CPU is
+     * selected at runtime (see activeSimdPath()).
+     * sin/cos/tan are evaluated with the polynomials in FastMath.h, so the results differ from
+     * kinematicAct by the polynomial error (about 1e-7 abs per step) and the heading wrap
+     * (psi - 2*PI*round(psi / 2*PI) instead of fmod).
+     * With KinematicIntegrator::Arc the scalar arc loop is used on every path (no SIMD kernels).
+     *
+     * @param[in] actions: state.count actions (not modified, clamping is done internally)
+     * @param[in] state: SoA vehicle states to be updated
+     * @param[in] dt: discrete time step
+     * @return void
+    */
+    void kinematicActBatch(const Action* actions, const VehicleStateSoA& state, float dt) const;
+
+    // same as above with an explicit path, falls back to the best supported path below it
+    void kinematicActBatch(const Action* actions, const VehicleStateSoA& state, float dt, SimdPath path) const;
+
+    // return the best SIMD path supported by this CPU
+    static SimdPath activeSimdPath();
+
+    // return whether the given SIMD path is compiled in and supported by this CPU
+    static bool isSimdPathSupported(SimdPath path);
+
+    /** Calculate the car movement using dynamic bicycle model
+     * ----------------------------------------------------------------------------
+     * State at the center of gravity: longitudinal velocity vx (VehicleState::velocity), lateral
+     * velocity vy and yaw rate r in the car frame. Linear tires with slip angles
+     *   alpha_f = delta * sign(vx) - (vy + lf * r) / |vx|,  alpha_r = -(vy - lr * r) / |vx|
+     * give the lateral forces F = C * alpha, and
+     *   vy_dot = (Ff * cos(delta) + Fr) / m - vx * r
+     *   r_dot  = (lf * Ff * cos(delta) - lr * Fr) / Iz
+     *
+     * Semi-implicit step with a fixed cost: vx is updated explicitly (acceleration + r * vy, clamped
+     * to v_max), then the (vy, r) system, which is linear for a given vx, is solved with backward
+     * Euler (one 2x2 solve). It is stable for any dt, including the stiff low-speed range, where the
+     * tire time constant m * |vx| / (Cf + Cr) is far below simDt = 0.01.
+     * Below blendSpeedLow the (vy, r) update is replaced by the kinematicAct values r = vx * tan(delta) / L,
+     * vy = 0, so parking manoeuvres follow the kinematic model; between blendSpeedLow and blendSpeedHigh
+     * both are blended linearly.
+     * sin/cos/tan are the FastMath.h polynomials, as in the batch kernels.
+     *
+     * @param[in] action: Action structure containing acceleration and steering angle (clamped internally)
+     * @param[in] vehicleState: State structure to be updated
+     * @param[in] dt: discrete time step
+     * @return void
+    */
+    void dynamicAct(const Action& action, VehicleState& vehicleState, float dt) const noexcept;
+
+    /** Calculate the movement of many cars using dynamic bicycle model
+     * ----------------------------------------------------------------------------
+     * Same step as dynamicAct for state.count vehicles in SoA form; state.vy and state.yawRate must be set.
+     * With AVX2 (see activeSimdPath()) full blocks of 8 vehicles run in a SIMD kernel, the rest in the
+     * scalar loop; both evaluate the same expressions, so they differ only by rounding (about 1e-6 rel).
+     *
+     * @param[in] actions: state.count actions (not modified, clamping is done internally)
+     * @param[in] state: SoA vehicle states to be updated
+     * @param[in] dt: discrete time step
+     * @return void
+    */
+    void dynamicActBatch(const Action* actions, const VehicleStateSoA& state, float dt) const noexcept;
+
+    // same as above with an explicit path, SimdPath::SSE41 runs the scalar loop (no SSE4.1 dynamic kernel)
+    void dynamicActBatch(const Action* actions, const VehicleStateSoA& state, float dt, SimdPath path) const noexcept;
+
+    // getter
+    const DynamicBicycleParams& getDynamicParams() const noexcept { return dynamicParams; }
+    KinematicIntegrator getIntegrator() const noexcept { return integrator; }
+
+    // setter
+    void setIntegrator(KinematicIntegrator mode) noexcept { integrator = mode; }
 
     /** Update the state of the car
      * @param[in] vehicleState: VehicleState structure to be updated
@@ -58,6 +172,10 @@ public:
 
 private:
     float length{0.0f};
+    DynamicBicycleParams dynamicParams;
+    KinematicIntegrator integrator{KinematicIntegrator::Euler};
 
+    // constants of dynamicAct / dynamicActBatch for step dt
+    DynamicBatchParams makeDynamicBatchParams(float dt) const noexcept;
 };
 #endif
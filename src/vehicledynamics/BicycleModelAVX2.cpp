@@ -0,0 +1,198 @@
+#include "BicycleModelKernels.h"
+
+#include <immintrin.h>
+
+
+// AVX2 kernels of BicycleModel::kinematicActBatch and dynamicActBatch, 8 vehicles per iteration.
+// Mirror kinematicBatchScalar / dynamicBatchScalar and the polynomials of FastMath.h lane by lane.
+namespace {
+
+    inline __m256 clampPs(__m256 x, __m256 lo, __m256 hi) {
+        return _mm256_min_ps(_mm256_max_ps(x, lo), hi);
+    }
+
+    inline __m256 roundPs(__m256 x) {
+        return _mm256_round_ps(x, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    }
+
+    // sin(x) and cos(x), see fastSinCos
+    inline void sinCosPs(__m256 x, __m256& s, __m256& c) {
+        const __m256 q = roundPs(_mm256_mul_ps(x, _mm256_set1_ps(0.636619772367581343f)));
+        __m256 r = _mm256_sub_ps(x, _mm256_mul_ps(q, _mm256_set1_ps(1.5703125f)));
+        r = _mm256_sub_ps(r, _mm256_mul_ps(q, _mm256_set1_ps(4.837512969970703125e-4f)));
+        r = _mm256_sub_ps(r, _mm256_mul_ps(q, _mm256_set1_ps(7.54978995489188216e-8f)));
+        const __m256 z = _mm256_mul_ps(r, r);
+
+        __m256 ps = _mm256_add_ps(_mm256_set1_ps(8.3321608736e-3f), _mm256_mul_ps(z, _mm256_set1_ps(-1.9515295891e-4f)));
+        ps = _mm256_add_ps(_mm256_set1_ps(-1.6666654611e-1f), _mm256_mul_ps(z, ps));
+        const __m256 sr = _mm256_add_ps(r, _mm256_mul_ps(_mm256_mul_ps(r, z), ps));
+
+        __m256 pc = _mm256_add_ps(_mm256_set1_ps(-1.388731625493765e-3f), _mm256_mul_ps(z, _mm256_set1_ps(2.443315711809948e-5f)));
+        pc = _mm256_add_ps(_mm256_set1_ps(4.166664568298827e-2f), _mm256_mul_ps(z, pc));
+        const __m256 cr = _mm256_add_ps(_mm256_sub_ps(_mm256_set1_ps(1.0f), _mm256_mul_ps(_mm256_set1_ps(0.5f), z)), _mm256_mul_ps(_mm256_mul_ps(z, z), pc));
+
+        // quadrant selection
+        const __m256i qi = _mm256_cvtps_epi32(q);
+        const __m256 swap = _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(qi, _mm256_set1_epi32(1)), _mm256_set1_epi32(1)));
+        const __m256 sv = _mm256_blendv_ps(sr, cr, swap);
+        const __m256 cv = _mm256_blendv_ps(cr, sr, swap);
+        const __m256 signS = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(qi, _mm256_set1_epi32(2)), 30));
+        const __m256 signC = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(_mm256_add_epi32(qi, _mm256_set1_epi32(1)), _mm256_set1_epi32(2)), 30));
+        s = _mm256_xor_ps(sv, signS);
+        c = _mm256_xor_ps(cv, signC);
+    }
+
+    // tan(x) for |x| <= PI/4, see fastTanQuarterPi
+    inline __m256 tanQuarterPiPs(__m256 x) {
+        const __m256 z = _mm256_mul_ps(x, x);
+        __m256 p = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(9.38540185543e-3f), z), _mm256_set1_ps(3.11992232697e-3f));
+        p = _mm256_add_ps(_mm256_mul_ps(p, z), _mm256_set1_ps(2.44301354525e-2f));
+        p = _mm256_add_ps(_mm256_mul_ps(p, z), _mm256_set1_ps(5.34112807005e-2f));
+        p = _mm256_add_ps(_mm256_mul_ps(p, z), _mm256_set1_ps(1.33387994085e-1f));
+        p = _mm256_add_ps(_mm256_mul_ps(p, z), _mm256_set1_ps(3.33331568548e-1f));
+        return _mm256_add_ps(x, _mm256_mul_ps(_mm256_mul_ps(x, z), p));
+    }
+
+    // cos(x) for |x| <= PI/4, see cosQuarterPi in BicycleModel.cpp
+    inline __m256 cosQuarterPiPs(__m256 x) {
+        const __m256 z = _mm256_mul_ps(x, x);
+        __m256 p = _mm256_add_ps(_mm256_set1_ps(-1.388731625493765e-3f), _mm256_mul_ps(z, _mm256_set1_ps(2.443315711809948e-5f)));
+        p = _mm256_add_ps(_mm256_set1_ps(4.166664568298827e-2f), _mm256_mul_ps(z, p));
+        return _mm256_add_ps(_mm256_sub_ps(_mm256_set1_ps(1.0f), _mm256_mul_ps(_mm256_set1_ps(0.5f), z)), _mm256_mul_ps(_mm256_mul_ps(z, z), p));
+    }
+
+    inline __m256 absPs(__m256 x) {
+        return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), x);
+    }
+
+    // de-interleave 8 {acceleration, steeringAngle} pairs
+    // (the in-lane shuffle yields pairs in order 0,2,1,3, permute4x64 restores 0..7)
+    inline void loadActions(const float* a, __m256& accel, __m256& steer) {
+        const __m256 a0 = _mm256_loadu_ps(a);
+        const __m256 a1 = _mm256_loadu_ps(a + 8);
+        accel = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(_mm256_shuffle_ps(a0, a1, _MM_SHUFFLE(2, 0, 2, 0))), _MM_SHUFFLE(3, 1, 2, 0)));
+        steer = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(_mm256_shuffle_ps(a0, a1, _MM_SHUFFLE(3, 1, 3, 1))), _MM_SHUFFLE(3, 1, 2, 0)));
+    }
+}
+
+// process vehicles in blocks of 8
+// ------------------------------------------------------------------------
+std::size_t kinematicBatchAVX2(const Action* actions, const VehicleStateSoA& state, const KinematicBatchParams& p) {
+    const __m256 dt = _mm256_set1_ps(p.dt);
+    const __m256 invLength = _mm256_set1_ps(p.invLength);
+    const __m256 deltaMax = _mm256_set1_ps(p.deltaMax), deltaMin = _mm256_set1_ps(-p.deltaMax);
+    const __m256 aMax = _mm256_set1_ps(p.aMax), aMin = _mm256_set1_ps(-p.aMax);
+    const __m256 vMax = _mm256_set1_ps(p.vMax), vMin = _mm256_set1_ps(-p.vMax);
+    const __m256 twoPi = _mm256_set1_ps(6.28318530717958647f);
+    const __m256 invTwoPi = _mm256_set1_ps(1.0f / 6.28318530717958647f);
+
+    const float* a = reinterpret_cast<const float*>(actions);
+    const std::size_t blocks = state.count / 8;
+
+    for (std::size_t b = 0; b < blocks; ++b) {
+        const std::size_t i = b * 8;
+
+        __m256 accelRaw, steerRaw;
+        loadActions(a + 2 * i, accelRaw, steerRaw);
+        const __m256 accel = clampPs(accelRaw, aMin, aMax);
+        const __m256 steer = clampPs(steerRaw, deltaMin, deltaMax);
+
+        const __m256 v = clampPs(_mm256_add_ps(_mm256_loadu_ps(state.velocity + i), _mm256_mul_ps(accel, dt)), vMin, vMax);
+
+        __m256 s, c;
+        const __m256 psi0 = _mm256_loadu_ps(state.psi + i);
+        sinCosPs(psi0, s, c);
+        const __m256 psiDot = _mm256_mul_ps(_mm256_mul_ps(v, tanQuarterPiPs(steer)), invLength);
+
+        const __m256 dv = _mm256_mul_ps(dt, v);
+        _mm256_storeu_ps(state.x + i, _mm256_add_ps(_mm256_loadu_ps(state.x + i), _mm256_mul_ps(dv, c)));
+        _mm256_storeu_ps(state.y + i, _mm256_add_ps(_mm256_loadu_ps(state.y + i), _mm256_mul_ps(dv, s)));
+
+        const __m256 psi = _mm256_add_ps(psi0, _mm256_mul_ps(dt, psiDot));
+        _mm256_storeu_ps(state.psi + i, _mm256_sub_ps(psi, _mm256_mul_ps(twoPi, roundPs(_mm256_mul_ps(psi, invTwoPi)))));
+        _mm256_storeu_ps(state.velocity + i, v);
+        _mm256_storeu_ps(state.delta + i, steer);
+    }
+
+    return blocks * 8;
+}
+
+// dynamic step in blocks of 8
+// ------------------------------------------------------------------------
+std::size_t dynamicBatchAVX2(const Action* actions, const VehicleStateSoA& state, const DynamicBatchParams& p) {
+    const __m256 dt = _mm256_set1_ps(p.dt);
+    const __m256 one = _mm256_set1_ps(1.0f), zero = _mm256_setzero_ps();
+    const __m256 deltaMax = _mm256_set1_ps(p.deltaMax), deltaMin = _mm256_set1_ps(-p.deltaMax);
+    const __m256 aMax = _mm256_set1_ps(p.aMax), aMin = _mm256_set1_ps(-p.aMax);
+    const __m256 vMax = _mm256_set1_ps(p.vMax), vMin = _mm256_set1_ps(-p.vMax);
+    const __m256 twoPi = _mm256_set1_ps(6.28318530717958647f);
+    const __m256 invTwoPi = _mm256_set1_ps(1.0f / 6.28318530717958647f);
+    const __m256 minSpeed = _mm256_set1_ps(0.1f);
+    const __m256 lf = _mm256_set1_ps(p.lf), lr = _mm256_set1_ps(p.lr);
+    const __m256 lfSq = _mm256_set1_ps(p.lf * p.lf), lrSq = _mm256_set1_ps(p.lr * p.lr);
+    const __m256 invLength = _mm256_set1_ps(p.invLength);
+    const __m256 invMass = _mm256_set1_ps(p.invMass), invInertia = _mm256_set1_ps(p.invInertia);
+    const __m256 corneringFront = _mm256_set1_ps(p.corneringFront), cr = _mm256_set1_ps(p.corneringRear);
+    const __m256 blendSpeedLow = _mm256_set1_ps(p.blendSpeedLow), invBlendRange = _mm256_set1_ps(p.invBlendRange);
+
+    const float* a = reinterpret_cast<const float*>(actions);
+    const std::size_t blocks = state.count / 8;
+
+    for (std::size_t b = 0; b < blocks; ++b) {
+        const std::size_t i = b * 8;
+
+        __m256 accelRaw, steerRaw;
+        loadActions(a + 2 * i, accelRaw, steerRaw);
+        const __m256 accel = clampPs(accelRaw, aMin, aMax);
+        const __m256 steer = clampPs(steerRaw, deltaMin, deltaMax);
+        const __m256 vy0 = _mm256_loadu_ps(state.vy + i);
+        const __m256 r0 = _mm256_loadu_ps(state.yawRate + i);
+
+        // 1. longitudinal velocity, explicit
+        const __m256 vx = clampPs(_mm256_add_ps(_mm256_loadu_ps(state.velocity + i), _mm256_mul_ps(dt, _mm256_add_ps(accel, _mm256_mul_ps(r0, vy0)))), vMin, vMax);
+
+        // 2. lateral velocity and yaw rate, backward Euler on the linear tire model at this vx
+        const __m256 absVx = absPs(vx);
+        const __m256 invSpeed = _mm256_div_ps(one, _mm256_max_ps(absVx, minSpeed));
+        const __m256 steerDir = _mm256_blendv_ps(steer, _mm256_sub_ps(zero, steer), _mm256_cmp_ps(vx, zero, _CMP_LT_OQ));
+        const __m256 cf = _mm256_mul_ps(corneringFront, cosQuarterPiPs(steer));
+
+        const __m256 cross = _mm256_sub_ps(_mm256_mul_ps(lr, cr), _mm256_mul_ps(lf, cf));
+        const __m256 a11 = _mm256_mul_ps(_mm256_mul_ps(_mm256_sub_ps(zero, _mm256_add_ps(cf, cr)), invMass), invSpeed);
+        const __m256 a12 = _mm256_sub_ps(_mm256_mul_ps(_mm256_mul_ps(cross, invMass), invSpeed), vx);
+        const __m256 a21 = _mm256_mul_ps(_mm256_mul_ps(cross, invInertia), invSpeed);
+        const __m256 a22 = _mm256_mul_ps(_mm256_mul_ps(_mm256_sub_ps(zero, _mm256_add_ps(_mm256_mul_ps(lfSq, cf), _mm256_mul_ps(lrSq, cr))), invInertia), invSpeed);
+        const __m256 force = _mm256_mul_ps(_mm256_mul_ps(dt, cf), steerDir);
+        const __m256 rhs1 = _mm256_add_ps(vy0, _mm256_mul_ps(force, invMass));
+        const __m256 rhs2 = _mm256_add_ps(r0, _mm256_mul_ps(_mm256_mul_ps(force, lf), invInertia));
+
+        const __m256 m11 = _mm256_sub_ps(one, _mm256_mul_ps(dt, a11)), m12 = _mm256_sub_ps(zero, _mm256_mul_ps(dt, a12));
+        const __m256 m21 = _mm256_sub_ps(zero, _mm256_mul_ps(dt, a21)), m22 = _mm256_sub_ps(one, _mm256_mul_ps(dt, a22));
+        const __m256 invDet = _mm256_div_ps(one, _mm256_sub_ps(_mm256_mul_ps(m11, m22), _mm256_mul_ps(m12, m21)));
+        const __m256 vyDyn = _mm256_mul_ps(_mm256_sub_ps(_mm256_mul_ps(rhs1, m22), _mm256_mul_ps(m12, rhs2)), invDet);
+        const __m256 rDyn = _mm256_mul_ps(_mm256_sub_ps(_mm256_mul_ps(m11, rhs2), _mm256_mul_ps(m21, rhs1)), invDet);
+
+        // 3. blend towards the kinematic model at low speed
+        const __m256 rKin = _mm256_mul_ps(_mm256_mul_ps(vx, tanQuarterPiPs(steer)), invLength);
+        const __m256 w = clampPs(_mm256_mul_ps(_mm256_sub_ps(absVx, blendSpeedLow), invBlendRange), zero, one);
+        const __m256 vy = _mm256_mul_ps(w, vyDyn);
+        const __m256 r = _mm256_add_ps(rKin, _mm256_mul_ps(w, _mm256_sub_ps(rDyn, rKin)));
+
+        // 4. pose with the new velocities
+        const __m256 psiNew = _mm256_add_ps(_mm256_loadu_ps(state.psi + i), _mm256_mul_ps(dt, r));
+        const __m256 psi = _mm256_sub_ps(psiNew, _mm256_mul_ps(twoPi, roundPs(_mm256_mul_ps(psiNew, invTwoPi))));
+        __m256 s, c;
+        sinCosPs(psi, s, c);
+        const __m256 dx = _mm256_sub_ps(_mm256_mul_ps(vx, c), _mm256_mul_ps(vy, s));
+        const __m256 dy = _mm256_add_ps(_mm256_mul_ps(vx, s), _mm256_mul_ps(vy, c));
+        _mm256_storeu_ps(state.x + i, _mm256_add_ps(_mm256_loadu_ps(state.x + i), _mm256_mul_ps(dt, dx)));
+        _mm256_storeu_ps(state.y + i, _mm256_add_ps(_mm256_loadu_ps(state.y + i), _mm256_mul_ps(dt, dy)));
+        _mm256_storeu_ps(state.psi + i, psi);
+        _mm256_storeu_ps(state.velocity + i, vx);
+        _mm256_storeu_ps(state.delta + i, steer);
+        _mm256_storeu_ps(state.vy + i, vy);
+        _mm256_storeu_ps(state.yawRate + i, r);
+    }
+
+    return blocks * 8;
+}
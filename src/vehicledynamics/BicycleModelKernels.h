@@ -0,0 +1,64 @@
+#ifndef BICYCLEMODELKERNELS_H
+#define BICYCLEMODELKERNELS_H
+
+#include <cstddef>
+
+#include "VehicleTypes.h"
+
+
+/**
+ * Batch kernels of BicycleModel::kinematicActBatch and dynamicActBatch
+ * ---------------------------
+ * Each kernel lives in its own translation unit compiled with the matching instruction set flags
+ * (see CMakeLists.txt) and is only called after cpuFeatures() reports support.
+ * Kernels only use intrinsics and local helpers so that no inline function from a shared header
+ * is instantiated with wider instructions than the rest of the program.
+ */
+// the SIMD kernels load actions as interleaved {acceleration, steeringAngle} float pairs
+static_assert(sizeof(Action) == 2 * sizeof(float), "Action must be two packed floats");
+
+struct KinematicBatchParams {
+    float dt;
+    float invLength;
+    float deltaMax;
+    float aMax;
+    float vMax;
+};
+
+// constants of the dynamic step, see BicycleModel::dynamicAct
+struct DynamicBatchParams {
+    float dt;
+    float lf, lr;               // CG to front / rear axle
+    float invLength;
+    float invMass;
+    float invInertia;
+    float corneringFront;
+    float corneringRear;
+    float blendSpeedLow;
+    float invBlendRange;        // 1 / (blendSpeedHigh - blendSpeedLow)
+    float deltaMax;
+    float aMax;
+    float vMax;
+};
+
+// process vehicles [begin, end) with plain C++ and the FastMath.h polynomials
+void kinematicBatchScalar(const Action* actions, const VehicleStateSoA& state, std::size_t begin, std::size_t end, const KinematicBatchParams& p);
+
+// same interface, exact arc integration (KinematicIntegrator::Arc)
+void kinematicArcBatchScalar(const Action* actions, const VehicleStateSoA& state, std::size_t begin, std::size_t end, const KinematicBatchParams& p);
+
+// dynamic step of vehicles [begin, end), state.vy and state.yawRate must be set
+void dynamicBatchScalar(const Action* actions, const VehicleStateSoA& state, std::size_t begin, std::size_t end, const DynamicBatchParams& p);
+
+#if defined(CAR_HAVE_X86_SIMD)
+// process vehicles [0, count) in blocks of 4 and return the number of vehicles processed
+std::size_t kinematicBatchSSE41(const Action* actions, const VehicleStateSoA& state, const KinematicBatchParams& p);
+
+// process vehicles [0, count) in blocks of 8 and return the number of vehicles processed
+std::size_t kinematicBatchAVX2(const Action* actions, const VehicleStateSoA& state, const KinematicBatchParams& p);
+
+// dynamic step in blocks of 8, returns the number of vehicles processed
+std::size_t dynamicBatchAVX2(const Action* actions, const VehicleStateSoA& state, const DynamicBatchParams& p);
+#endif
+
+#endif
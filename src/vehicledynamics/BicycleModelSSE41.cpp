@@ -0,0 +1,98 @@
+#include "BicycleModelKernels.h"
+
+#include <smmintrin.h>
+
+
+// SSE4.1 kernel of BicycleModel::kinematicActBatch, 4 vehicles per iteration.
+// Mirrors kinematicBatchScalar and the polynomials of FastMath.h lane by lane.
+namespace {
+
+    inline __m128 clampPs(__m128 x, __m128 lo, __m128 hi) {
+        return _mm_min_ps(_mm_max_ps(x, lo), hi);
+    }
+
+    inline __m128 roundPs(__m128 x) {
+        return _mm_round_ps(x, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    }
+
+    // sin(x) and cos(x), see fastSinCos
+    inline void sinCosPs(__m128 x, __m128& s, __m128& c) {
+        const __m128 q = roundPs(_mm_mul_ps(x, _mm_set1_ps(0.636619772367581343f)));
+        __m128 r = _mm_sub_ps(x, _mm_mul_ps(q, _mm_set1_ps(1.5703125f)));
+        r = _mm_sub_ps(r, _mm_mul_ps(q, _mm_set1_ps(4.837512969970703125e-4f)));
+        r = _mm_sub_ps(r, _mm_mul_ps(q, _mm_set1_ps(7.54978995489188216e-8f)));
+        const __m128 z = _mm_mul_ps(r, r);
+
+        __m128 ps = _mm_add_ps(_mm_set1_ps(8.3321608736e-3f), _mm_mul_ps(z, _mm_set1_ps(-1.9515295891e-4f)));
+        ps = _mm_add_ps(_mm_set1_ps(-1.6666654611e-1f), _mm_mul_ps(z, ps));
+        const __m128 sr = _mm_add_ps(r, _mm_mul_ps(_mm_mul_ps(r, z), ps));
+
+        __m128 pc = _mm_add_ps(_mm_set1_ps(-1.388731625493765e-3f), _mm_mul_ps(z, _mm_set1_ps(2.443315711809948e-5f)));
+        pc = _mm_add_ps(_mm_set1_ps(4.166664568298827e-2f), _mm_mul_ps(z, pc));
+        const __m128 cr = _mm_add_ps(_mm_sub_ps(_mm_set1_ps(1.0f), _mm_mul_ps(_mm_set1_ps(0.5f), z)), _mm_mul_ps(_mm_mul_ps(z, z), pc));
+
+        // quadrant selection
+        const __m128i qi = _mm_cvtps_epi32(q);
+        const __m128 swap = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(qi, _mm_set1_epi32(1)), _mm_set1_epi32(1)));
+        const __m128 sv = _mm_blendv_ps(sr, cr, swap);
+        const __m128 cv = _mm_blendv_ps(cr, sr, swap);
+        const __m128 signS = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(qi, _mm_set1_epi32(2)), 30));
+        const __m128 signC = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(_mm_add_epi32(qi, _mm_set1_epi32(1)), _mm_set1_epi32(2)), 30));
+        s = _mm_xor_ps(sv, signS);
+        c = _mm_xor_ps(cv, signC);
+    }
+
+    // tan(x) for |x| <= PI/4, see fastTanQuarterPi
+    inline __m128 tanQuarterPiPs(__m128 x) {
+        const __m128 z = _mm_mul_ps(x, x);
+        __m128 p = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(9.38540185543e-3f), z), _mm_set1_ps(3.11992232697e-3f));
+        p = _mm_add_ps(_mm_mul_ps(p, z), _mm_set1_ps(2.44301354525e-2f));
+        p = _mm_add_ps(_mm_mul_ps(p, z), _mm_set1_ps(5.34112807005e-2f));
+        p = _mm_add_ps(_mm_mul_ps(p, z), _mm_set1_ps(1.33387994085e-1f));
+        p = _mm_add_ps(_mm_mul_ps(p, z), _mm_set1_ps(3.33331568548e-1f));
+        return _mm_add_ps(x, _mm_mul_ps(_mm_mul_ps(x, z), p));
+    }
+}
+
+// process vehicles in blocks of 4
+// ------------------------------------------------------------------------
+std::size_t kinematicBatchSSE41(const Action* actions, const VehicleStateSoA& state, const KinematicBatchParams& p) {
+    const __m128 dt = _mm_set1_ps(p.dt);
+    const __m128 invLength = _mm_set1_ps(p.invLength);
+    const __m128 deltaMax = _mm_set1_ps(p.deltaMax), deltaMin = _mm_set1_ps(-p.deltaMax);
+    const __m128 aMax = _mm_set1_ps(p.aMax), aMin = _mm_set1_ps(-p.aMax);
+    const __m128 vMax = _mm_set1_ps(p.vMax), vMin = _mm_set1_ps(-p.vMax);
+    const __m128 twoPi = _mm_set1_ps(6.28318530717958647f);
+    const __m128 invTwoPi = _mm_set1_ps(1.0f / 6.28318530717958647f);
+
+    const float* a = reinterpret_cast<const float*>(actions);
+    const std::size_t blocks = state.count / 4;
+
+    for (std::size_t b = 0; b < blocks; ++b) {
+        const std::size_t i = b * 4;
+
+        // de-interleave {acceleration, steeringAngle} pairs
+        const __m128 a01 = _mm_loadu_ps(a + 2 * i);
+        const __m128 a23 = _mm_loadu_ps(a + 2 * i + 4);
+        const __m128 accel = clampPs(_mm_shuffle_ps(a01, a23, _MM_SHUFFLE(2, 0, 2, 0)), aMin, aMax);
+        const __m128 steer = clampPs(_mm_shuffle_ps(a01, a23, _MM_SHUFFLE(3, 1, 3, 1)), deltaMin, deltaMax);
+
+        const __m128 v = clampPs(_mm_add_ps(_mm_loadu_ps(state.velocity + i), _mm_mul_ps(accel, dt)), vMin, vMax);
+
+        __m128 s, c;
+        const __m128 psi0 = _mm_loadu_ps(state.psi + i);
+        sinCosPs(psi0, s, c);
+        const __m128 psiDot = _mm_mul_ps(_mm_mul_ps(v, tanQuarterPiPs(steer)), invLength);
+
+        const __m128 dv = _mm_mul_ps(dt, v);
+        _mm_storeu_ps(state.x + i, _mm_add_ps(_mm_loadu_ps(state.x + i), _mm_mul_ps(dv, c)));
+        _mm_storeu_ps(state.y + i, _mm_add_ps(_mm_loadu_ps(state.y + i), _mm_mul_ps(dv, s)));
+
+        const __m128 psi = _mm_add_ps(psi0, _mm_mul_ps(dt, psiDot));
+        _mm_storeu_ps(state.psi + i, _mm_sub_ps(psi, _mm_mul_ps(twoPi, roundPs(_mm_mul_ps(psi, invTwoPi)))));
+        _mm_storeu_ps(state.velocity + i, v);
+        _mm_storeu_ps(state.delta + i, steer);
+    }
+
+    return blocks * 4;
+}
@@ -1,6 +1,8 @@
 #ifndef VEHICLETYPES_H
 #define VEHICLETYPES_H
 
+#include <cstddef>
+
 #include "../core/Config.h"
 
 // 2D position
@@ -19,8 +21,24 @@ struct Action {
 struct VehicleState {
     Position2D pos{0.0f, 0.0f};
     float psi{0.0f};
-    float velocity{0.0f};
+    float velocity{0.0f};   // longitudinal velocity in the car frame
     float delta{0.0f};
+    float vy{0.0f};         // lateral velocity in the car frame, dynamic model only
+    float yawRate{0.0f};    // dynamic model only
+};
+
+// vehicle states of many vehicles in structure-of-arrays form (non-owning)
+struct VehicleStateSoA {
+    float* x{nullptr};
+    float* y{nullptr};
+    float* psi{nullptr};
+    float* velocity{nullptr};
+    float* delta{nullptr};
+    std::size_t count{0};
+
+    // dynamic model only (BicycleModel::dynamicActBatch)
+    float* vy{nullptr};
+    float* yawRate{nullptr};
 };
 
 // wheels
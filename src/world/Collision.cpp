@@ -0,0 +1,73 @@
+#include "Collision.h"
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define CAR_COLLISION_SSE2 1
+#endif
+
+
+namespace {
+    // branch-free form of obbOverlap for box i, used by the scalar loop
+    inline bool overlapsBox(const Transform2D& a, const Position2D& ha, float ra, const OrientedBoxSoA& b, std::size_t i) {
+        const float dx = b.x[i] - a.t.x;
+        const float dy = b.y[i] - a.t.y;
+        const float rr = ra + b.r[i];
+        const float ac = std::fabs(a.c * b.c[i] + a.s * b.s[i]);
+        const float as = std::fabs(a.c * b.s[i] - a.s * b.c[i]);
+
+        const bool near = dx * dx + dy * dy <= rr * rr;
+        const bool sep = (std::fabs(dx * a.c + dy * a.s) > ha.x + b.hx[i] * ac + b.hy[i] * as) |
+                         (std::fabs(-dx * a.s + dy * a.c) > ha.y + b.hx[i] * as + b.hy[i] * ac) |
+                         (std::fabs(dx * b.c[i] + dy * b.s[i]) > b.hx[i] + ha.x * ac + ha.y * as) |
+                         (std::fabs(-dx * b.s[i] + dy * b.c[i]) > b.hy[i] + ha.x * as + ha.y * ac);
+        return near & !sep;
+    }
+}
+
+// one box against a range of SoA boxes
+// ------------------------------------------------------------------------
+bool anyOverlap(const Transform2D& a, const Position2D& ha, const OrientedBoxSoA& boxes, std::size_t begin, std::size_t end) noexcept {
+    const float ra = std::sqrt(ha.x * ha.x + ha.y * ha.y);
+    std::size_t i = begin;
+
+#ifdef CAR_COLLISION_SSE2
+    const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+    const __m128 ax = _mm_set1_ps(a.t.x), ay = _mm_set1_ps(a.t.y);
+    const __m128 ac = _mm_set1_ps(a.c), as = _mm_set1_ps(a.s);
+    const __m128 hax = _mm_set1_ps(ha.x), hay = _mm_set1_ps(ha.y);
+    const __m128 rav = _mm_set1_ps(ra);
+
+    for (; i + 4 <= end; i += 4) {
+        const __m128 dx = _mm_sub_ps(_mm_loadu_ps(boxes.x + i), ax);
+        const __m128 dy = _mm_sub_ps(_mm_loadu_ps(boxes.y + i), ay);
+        const __m128 bc = _mm_loadu_ps(boxes.c + i), bs = _mm_loadu_ps(boxes.s + i);
+        const __m128 hbx = _mm_loadu_ps(boxes.hx + i), hby = _mm_loadu_ps(boxes.hy + i);
+
+        // bounding circles
+        const __m128 rr = _mm_add_ps(rav, _mm_loadu_ps(boxes.r + i));
+        const __m128 near = _mm_cmple_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(rr, rr));
+
+        // |cos| and |sin| of the relative heading
+        const __m128 cd = _mm_and_ps(_mm_add_ps(_mm_mul_ps(ac, bc), _mm_mul_ps(as, bs)), absMask);
+        const __m128 sd = _mm_and_ps(_mm_sub_ps(_mm_mul_ps(ac, bs), _mm_mul_ps(as, bc)), absMask);
+
+        // projections of the center offset on the 4 axes
+        const __m128 pa0 = _mm_and_ps(_mm_add_ps(_mm_mul_ps(dx, ac), _mm_mul_ps(dy, as)), absMask);
+        const __m128 pa1 = _mm_and_ps(_mm_sub_ps(_mm_mul_ps(dy, ac), _mm_mul_ps(dx, as)), absMask);
+        const __m128 pb0 = _mm_and_ps(_mm_add_ps(_mm_mul_ps(dx, bc), _mm_mul_ps(dy, bs)), absMask);
+        const __m128 pb1 = _mm_and_ps(_mm_sub_ps(_mm_mul_ps(dy, bc), _mm_mul_ps(dx, bs)), absMask);
+
+        __m128 sep = _mm_cmpgt_ps(pa0, _mm_add_ps(hax, _mm_add_ps(_mm_mul_ps(hbx, cd), _mm_mul_ps(hby, sd))));
+        sep = _mm_or_ps(sep, _mm_cmpgt_ps(pa1, _mm_add_ps(hay, _mm_add_ps(_mm_mul_ps(hbx, sd), _mm_mul_ps(hby, cd)))));
+        sep = _mm_or_ps(sep, _mm_cmpgt_ps(pb0, _mm_add_ps(hbx, _mm_add_ps(_mm_mul_ps(hax, cd), _mm_mul_ps(hay, sd)))));
+        sep = _mm_or_ps(sep, _mm_cmpgt_ps(pb1, _mm_add_ps(hby, _mm_add_ps(_mm_mul_ps(hax, sd), _mm_mul_ps(hay, cd)))));
+
+        if (_mm_movemask_ps(_mm_andnot_ps(sep, near)) != 0) return true;
+    }
+#endif
+
+    for (; i < end; ++i) {
+        if (overlapsBox(a, ha, ra, boxes, i)) return true;
+    }
+    return false;
+}
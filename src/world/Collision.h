@@ -0,0 +1,71 @@
+#ifndef COLLISION_H
+#define COLLISION_H
+
+#include <cmath>
+#include <cstddef>
+
+#include "../utilities/Transform2D.h"
+#include "../vehicledynamics/VehicleTypes.h"
+
+
+// oriented boxes in structure-of-arrays form (non-owning)
+struct OrientedBoxSoA {
+    const float* x{nullptr};    // center
+    const float* y{nullptr};
+    const float* c{nullptr};    // cos/sin of the box heading
+    const float* s{nullptr};
+    const float* hx{nullptr};   // half extents along local x / y [m]
+    const float* hy{nullptr};
+    const float* r{nullptr};    // bounding circle radius, hypot(hx, hy)
+    std::size_t count{0};
+};
+
+/**
+ * @brief Separating axis test of two oriented boxes.
+ *
+ * The bounding circles are compared first; boxes whose centers are farther apart than the sum of
+ * their radii are rejected without projecting. Otherwise the boxes overlap unless one of the four
+ * face normals (2 per box) separates them. Touching boxes count as overlapping.
+ *
+ * @param a, b    Box frame -> world frame.
+ * @param ha, hb  Half extents along the local x / y axes [m].
+ *
+ * @return true if the boxes overlap.
+ */
+inline bool obbOverlap(const Transform2D& a, const Position2D& ha, const Transform2D& b, const Position2D& hb) noexcept {
+    const float dx = b.t.x - a.t.x;
+    const float dy = b.t.y - a.t.y;
+
+    // bounding circles
+    const float rr = std::sqrt(ha.x * ha.x + ha.y * ha.y) + std::sqrt(hb.x * hb.x + hb.y * hb.y);
+    if (dx * dx + dy * dy > rr * rr) return false;
+
+    // |cos| and |sin| of the relative heading: projections of one box's axes on the other's
+    const float ac = std::fabs(a.c * b.c + a.s * b.s);
+    const float as = std::fabs(a.c * b.s - a.s * b.c);
+
+    // axes of a
+    if (std::fabs(dx * a.c + dy * a.s) > ha.x + hb.x * ac + hb.y * as) return false;
+    if (std::fabs(-dx * a.s + dy * a.c) > ha.y + hb.x * as + hb.y * ac) return false;
+
+    // axes of b
+    if (std::fabs(dx * b.c + dy * b.s) > hb.x + ha.x * ac + ha.y * as) return false;
+    if (std::fabs(-dx * b.s + dy * b.c) > hb.y + ha.x * as + ha.y * ac) return false;
+    return true;
+}
+
+/** Test one box against boxes [begin, end) of a SoA set
+ * ----------------------------------------------------------------------------
+ * Same test as obbOverlap without branches per box, 4 boxes per SSE2 iteration on x86-64
+ * (SSE2 is part of the baseline, no dispatch needed) and a scalar loop elsewhere and for the tail.
+ *
+ * @param[in] a: box frame -> world frame
+ * @param[in] ha: half extents of a [m]
+ * @param[in] boxes: other boxes
+ * @param[in] begin: first box index
+ * @param[in] end: one past the last box index
+ * @return bool: true if a overlaps any of the boxes
+ */
+bool anyOverlap(const Transform2D& a, const Position2D& ha, const OrientedBoxSoA& boxes, std::size_t begin, std::size_t end) noexcept;
+
+#endif
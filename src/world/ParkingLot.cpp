@@ -0,0 +1,263 @@
+#include "ParkingLot.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "../envs/ParkingCheck.h"
+#include "../utilities/FastMath.h"
+#include "../utilities/MathUtils.h"
+#include "../utilities/Randomizer.h"
+
+
+// generate a lot from a layout
+// ------------------------------------------------------------------------
+ParkingLot ParkingLot::generate(const LotLayout& layout, uint64_t seed) {
+    ParkingLot lot;
+    Randomizer randomizer(seed);
+
+    const int aisles = std::max(layout.aisles, 1);
+    const int slotsPerRow = std::max(layout.slotsPerRow, 1);
+    const float halfLen = PARKING_LENGTH * 0.5f;
+    const float rowWidth = slotsPerRow * PARKING_WIDTH;
+    const float bayDepth = 2.0f * PARKING_LENGTH + layout.aisleWidth;  // row, aisle, row
+    const float width = 2.0f * layout.endMargin + rowWidth;
+    const float height = aisles * bayDepth + (aisles - 1) * layout.curbWidth;
+    const float x0 = -0.5f * width;
+    const float y0 = -0.5f * height;
+    const float cw = layout.curbWidth;
+
+    for (int a = 0; a < aisles; ++a) {
+        const float yb = y0 + a * (bayDepth + cw);
+
+        // lower row faces up (+y) into the aisle, upper row faces down
+        for (int row = 0; row < 2; ++row) {
+            const float yaw = (row == 0) ? PI * 0.5f : -PI * 0.5f;
+            const float cy = (row == 0) ? yb + halfLen : yb + PARKING_LENGTH + layout.aisleWidth + halfLen;
+            for (int j = 0; j < slotsPerRow; ++j) {
+                const float cx = x0 + layout.endMargin + (j + 0.5f) * PARKING_WIDTH;
+                const bool occupied = randomizer.randFloat(0.0f, 1.0f) < layout.occupancy;
+                const std::size_t s = lot.addSlot({cx, cy}, yaw, occupied);
+                if (occupied) {
+                    lot.addObstacle(Obstacle{lot.slots[s].pose, {CAR_LENGTH * 0.5f, CAR_WIDTH * 0.5f}, ObstacleKind::ParkedCar});
+                }
+            }
+        }
+
+        // curb between back-to-back rows, open at the row ends
+        if (a + 1 < aisles) {
+            lot.addObstacle(Obstacle{Transform2D::fromPose({0.0f, yb + bayDepth + 0.5f * cw}, 0.0f),
+                                     {0.5f * rowWidth, 0.5f * cw}, ObstacleKind::Curb});
+        }
+    }
+
+    // curbs just outside the bounds
+    lot.addObstacle(Obstacle{Transform2D::fromPose({0.0f, y0 - 0.5f * cw}, 0.0f), {0.5f * width + cw, 0.5f * cw}, ObstacleKind::Curb});
+    lot.addObstacle(Obstacle{Transform2D::fromPose({0.0f, -y0 + 0.5f * cw}, 0.0f), {0.5f * width + cw, 0.5f * cw}, ObstacleKind::Curb});
+    lot.addObstacle(Obstacle{Transform2D::fromPose({x0 - 0.5f * cw, 0.0f}, 0.0f), {0.5f * cw, 0.5f * height}, ObstacleKind::Curb});
+    lot.addObstacle(Obstacle{Transform2D::fromPose({-x0 + 0.5f * cw, 0.0f}, 0.0f), {0.5f * cw, 0.5f * height}, ObstacleKind::Curb});
+
+    lot.aisleWidth = layout.aisleWidth;
+    lot.build(AABB2D{x0, y0, -x0, -y0}, layout.cellSize, layout.sensorReach);
+    return lot;
+}
+
+// add a slot / an obstacle
+// ------------------------------------------------------------------------
+std::size_t ParkingLot::addSlot(const Position2D& pos, float yaw, bool occupied) {
+    slots.push_back(ParkingSlot{Transform2D::fromPose(pos, yaw), yaw, occupied});
+    return slots.size() - 1;
+}
+
+std::size_t ParkingLot::addObstacle(const Obstacle& obstacle) {
+    obstacles.push_back(obstacle);
+    return obstacles.size() - 1;
+}
+
+// build the spatial indices
+// ------------------------------------------------------------------------
+void ParkingLot::build(const AABB2D& newBounds, float cellSize, float newSensorReach) {
+    bounds = newBounds;
+    sensorReach = std::max(newSensorReach, 0.0f);
+
+    std::vector<AABB2D> boxes(slots.size());
+    freeSlotCount = 0;
+    for (std::size_t i = 0; i < slots.size(); ++i) {
+        const Position2D& c = slots[i].pose.t;
+        boxes[i] = AABB2D{c.x, c.y, c.x, c.y};
+        if (!slots[i].occupied) ++freeSlotCount;
+    }
+    slotGrid.build(bounds, cellSize, boxes.data(), boxes.size());
+
+    obstacleBoxes.resize(obstacles.size());
+    obstacleAligned.resize(obstacles.size());
+    for (std::size_t i = 0; i < obstacles.size(); ++i) {
+        const Obstacle& o = obstacles[i];
+        obstacleBoxes[i] = obstacleBounds(o);
+        obstacleAligned[i] = (std::fabs(o.pose.s) < 1e-6f || std::fabs(o.pose.c) < 1e-6f) ? 1 : 0;
+    }
+    obstacleGrid.build(bounds, cellSize, obstacleBoxes.data(), obstacleBoxes.size());
+
+    // sensor grid: boxes grown by the reach over the lot and every obstacle within reach of it
+    AABB2D sensorArea{bounds.minX - sensorReach, bounds.minY - sensorReach, bounds.maxX + sensorReach, bounds.maxY + sensorReach};
+    boxes.resize(obstacles.size());
+    for (std::size_t i = 0; i < obstacles.size(); ++i) {
+        const AABB2D& b = obstacleBoxes[i];
+        boxes[i] = AABB2D{b.minX - sensorReach, b.minY - sensorReach, b.maxX + sensorReach, b.maxY + sensorReach};
+        sensorArea = AABB2D{std::min(sensorArea.minX, boxes[i].minX), std::min(sensorArea.minY, boxes[i].minY),
+                            std::max(sensorArea.maxX, boxes[i].maxX), std::max(sensorArea.maxY, boxes[i].maxY)};
+    }
+    sensorGrid.build(sensorArea, SENSOR_CELL_SIZE, boxes.data(), boxes.size());
+
+    // obstacle boxes in cell order for the collision kernel, each cell padded to a multiple of 4
+    // with empty boxes far away (their bounding circle test always fails)
+    const int cellsX = obstacleGrid.getCellsX(), cellsY = obstacleGrid.getCellsY();
+    const std::vector<uint32_t>& items = obstacleGrid.getItems();
+    for (auto* v : {&boxX, &boxY, &boxC, &boxS, &boxHX, &boxHY, &boxR}) v->clear();
+    boxCellX.clear();
+    boxCellY.clear();
+    cellBoxStart.assign(1, 0u);
+    auto pushBox = [&](float x, float y, float c, float s, float hx, float hy, int cx0, int cy0) {
+        boxX.push_back(x); boxY.push_back(y); boxC.push_back(c); boxS.push_back(s);
+        boxHX.push_back(hx); boxHY.push_back(hy); boxR.push_back(std::sqrt(hx * hx + hy * hy));
+        boxCellX.push_back(cx0); boxCellY.push_back(cy0);
+    };
+    for (int cy = 0; cy < cellsY; ++cy) {
+        for (int cx = 0; cx < cellsX; ++cx) {
+            for (uint32_t k = obstacleGrid.cellBegin(cx, cy); k < obstacleGrid.cellEnd(cx, cy); ++k) {
+                const Obstacle& o = obstacles[items[k]];
+                const AABB2D b = obstacleBounds(o);
+                pushBox(o.pose.t.x, o.pose.t.y, o.pose.c, o.pose.s, o.halfExtents.x, o.halfExtents.y,
+                        obstacleGrid.cellX(b.minX), obstacleGrid.cellY(b.minY));
+            }
+            while (boxX.size() % 4 != 0) pushBox(1e18f, 1e18f, 1.0f, 0.0f, 0.0f, 0.0f, cx, cy);
+            cellBoxStart.push_back(static_cast<uint32_t>(boxX.size()));
+        }
+    }
+}
+
+// obstacle boxes in grid order
+// ------------------------------------------------------------------------
+OrientedBoxSoA ParkingLot::getCellBoxes() const noexcept {
+    return OrientedBoxSoA{boxX.data(), boxY.data(), boxC.data(), boxS.data(), boxHX.data(), boxHY.data(), boxR.data(), boxX.size()};
+}
+
+// nearest slot center, ring search over the grid cells
+// ------------------------------------------------------------------------
+int ParkingLot::nearestSlot(const Position2D& p, bool freeOnly) const noexcept {
+    if (slots.empty() || (freeOnly && freeSlotCount == 0)) return -1;
+
+    const int cx = slotGrid.cellX(p.x);
+    const int cy = slotGrid.cellY(p.y);
+    const int maxRing = std::max(slotGrid.getCellsX(), slotGrid.getCellsY());
+    const float cellSize = slotGrid.getCellSize();
+
+    int best = -1;
+    float bestD2 = std::numeric_limits<float>::max();
+    auto visit = [&](uint32_t i) {
+        if (freeOnly && slots[i].occupied) return;
+        const float dx = slots[i].pose.t.x - p.x;
+        const float dy = slots[i].pose.t.y - p.y;
+        const float d2 = dx * dx + dy * dy;
+        if (d2 < bestD2 || (d2 == bestD2 && static_cast<int>(i) < best)) {
+            bestD2 = d2;
+            best = static_cast<int>(i);
+        }
+    };
+
+    for (int ring = 0; ring <= maxRing; ++ring) {
+        // cells at Chebyshev distance ring from (cx, cy)
+        for (int dy = -ring; dy <= ring; ++dy) {
+            const int y = cy + dy;
+            if (y < 0 || y >= slotGrid.getCellsY()) continue;
+            const int step = (dy == -ring || dy == ring) ? 1 : std::max(2 * ring, 1);
+            for (int dx = -ring; dx <= ring; dx += step) {
+                const int x = cx + dx;
+                if (x < 0 || x >= slotGrid.getCellsX()) continue;
+                slotGrid.forEachInCell(x, y, visit);
+            }
+        }
+
+        // slots in the next ring are at least ring cells away
+        const float reach = ring * cellSize;
+        if (best >= 0 && bestD2 <= reach * reach) break;
+    }
+    return best;
+}
+
+// slot the car is parked in, only the slots around the car center are tested
+// ------------------------------------------------------------------------
+int ParkingLot::slotContaining(const Transform2D& car) const noexcept {
+    const float halfLen = PARKING_LENGTH * 0.5f;
+    const float halfWid = PARKING_WIDTH * 0.5f;
+    const float reach = std::sqrt(halfLen * halfLen + halfWid * halfWid);
+    const AABB2D box{car.t.x - reach, car.t.y - reach, car.t.x + reach, car.t.y + reach};
+
+    int found = -1;
+    slotGrid.query(box, [&](uint32_t i) {
+        if (found >= 0) return;
+        const Transform2D& slot = slots[i].pose;
+        if (isCarNearSlot(car.t.x, car.t.y, slot.t.x, slot.t.y) && isCarInSlot(car, slot)) found = static_cast<int>(i);
+    });
+    return found;
+}
+
+// collision candidates of a box
+// ------------------------------------------------------------------------
+std::size_t ParkingLot::queryObstacles(const AABB2D& box, uint32_t* out, std::size_t maxOut) const noexcept {
+    std::size_t count = 0;
+    obstacleGrid.query(box, [&](uint32_t i) {
+        if (count < maxOut) out[count] = i;
+        ++count;
+    });
+    return count;
+}
+
+// car body against the obstacles in the cells under it
+// ------------------------------------------------------------------------
+bool ParkingLot::carCollides(const Transform2D& car) const noexcept {
+    if (boxX.empty()) return false;
+
+    const Position2D half{CAR_LENGTH * 0.5f, CAR_WIDTH * 0.5f};
+    const float ex = std::fabs(car.c) * half.x + std::fabs(car.s) * half.y;
+    const float ey = std::fabs(car.s) * half.x + std::fabs(car.c) * half.y;
+    const int cx0 = obstacleGrid.cellX(car.t.x - ex), cx1 = obstacleGrid.cellX(car.t.x + ex);
+    const int cy0 = obstacleGrid.cellY(car.t.y - ey), cy1 = obstacleGrid.cellY(car.t.y + ey);
+
+    const OrientedBoxSoA boxes = getCellBoxes();
+    const int cellsX = obstacleGrid.getCellsX();
+    for (int cy = cy0; cy <= cy1; ++cy) {
+        for (int cx = cx0; cx <= cx1; ++cx) {
+            const std::size_t cell = static_cast<std::size_t>(cy) * cellsX + cx;
+            if (anyOverlap(car, half, boxes, cellBoxStart[cell], cellBoxStart[cell + 1])) return true;
+        }
+    }
+    return false;
+}
+
+// batched car collisions
+// ------------------------------------------------------------------------
+void ParkingLot::collideBatch(const float* x, const float* y, const float* psi, std::size_t n, uint8_t* contact) const noexcept {
+    for (std::size_t i = 0; i < n; ++i) {
+        Transform2D car{1.0f, 0.0f, {x[i], y[i]}};
+        fastSinCos(psi[i], car.s, car.c);
+        contact[i] = carCollides(car) ? 1 : 0;
+    }
+}
+
+// episode start on the aisle in front of a random slot
+// ------------------------------------------------------------------------
+bool ParkingLot::sampleStart(const float* u, VehicleState& car, int& targetSlot) const noexcept {
+    if (slots.empty()) return false;
+
+    const std::size_t n = slots.size();
+    const ParkingSlot& spawn = slots[std::min(static_cast<std::size_t>(u[0] * n), n - 1)];
+    const float lateral = CAR_SPAWN_MARGIN * (2.0f * u[1] - 1.0f);
+
+    car = VehicleState{};
+    car.pos = spawn.pose.apply({PARKING_LENGTH * 0.5f + aisleWidth * 0.5f, lateral});
+    car.psi = wrapPi(spawn.yaw + ((u[2] < 0.5f) ? PI * 0.5f : -PI * 0.5f));
+
+    targetSlot = nearestSlot(car.pos, true);
+    if (targetSlot < 0) targetSlot = nearestSlot(car.pos, false);
+    return true;
+}
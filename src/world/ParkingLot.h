@@ -0,0 +1,257 @@
+#ifndef PARKINGLOT_H
+#define PARKINGLOT_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Collision.h"
+#include "UniformGrid.h"
+#include "../core/Config.h"
+#include "../envs/ParkingParams.h"
+#include "../utilities/Transform2D.h"
+#include "../vehicledynamics/VehicleTypes.h"
+
+
+// parking slot of a lot, PARKING_LENGTH x PARKING_WIDTH
+struct ParkingSlot {
+    Transform2D pose{};      // slot frame -> world, local x along the slot length, the aisle is on the +x side
+    float yaw{0.0f};         // heading of the slot x axis in world frame [rad]
+    bool occupied{false};    // a parked car stands in the slot
+};
+
+enum class ObstacleKind : uint8_t {
+    ParkedCar,
+    Curb
+};
+
+// static obstacle, an oriented box
+struct Obstacle {
+    Transform2D pose{};              // box frame -> world
+    Position2D halfExtents{0, 0};    // half length along local x, half width along local y [m]
+    ObstacleKind kind{ObstacleKind::Curb};
+};
+
+// obstacles near a range sensor, see ParkingLot::sensorCandidates
+struct SensorCandidates {
+    const uint32_t* index{nullptr};   // indices into ParkingLot::getObstacles()
+    std::size_t count{0};
+};
+
+// sensor grid of a lot: candidate lists for beams up to SENSOR_REACH (the RangeSensorConfig::maxRange default)
+constexpr float SENSOR_REACH = 10.0f;     // [m]
+constexpr float SENSOR_CELL_SIZE = 2.0f;  // [m]
+
+// layout of a generated lot: aisles with a row of perpendicular slots on both sides
+struct LotLayout {
+    int aisles{2};                      // number of aisles, each has 2 rows of slots
+    int slotsPerRow{10};                // slots per row
+    float aisleWidth{7.0f};             // driving lane between two rows [m]
+    float endMargin{CAR_SPAWN_MARGIN + CAR_LENGTH};  // free space before the first and after the last slot of a row [m]
+    float curbWidth{0.3f};              // curbs around the lot and between back-to-back rows [m]
+    float occupancy{0.5f};              // probability that a slot holds a parked car
+    float cellSize{PARKING_LENGTH};     // spatial index cell size [m]
+    float sensorReach{SENSOR_REACH};    // longest beam served by the sensor grid [m]
+};
+
+/**
+ * Parking Lot Class
+ * ---------------------------
+ * Static world of many parking slots and obstacles (parked cars, curbs) with uniform grid indices,
+ * one over the slot centers and one over the obstacle boxes.
+ *
+ * Lookups only visit the cells around the query, so their cost depends on the local slot density,
+ * not on the lot size: nearestSlot() searches rings of cells outwards from the query point and
+ * stops once no farther ring can hold a closer slot, slotContaining() tests the slots within a slot
+ * half diagonal of the car center, queryObstacles() returns the collision candidates of a box.
+ *
+ * For collisions the obstacle boxes are also stored cell by cell in structure-of-arrays form
+ * (an obstacle spanning several cells is copied into each, every cell is padded to a multiple of 4
+ * with far-away empty boxes), so the narrowphase of a car walks the contiguous ranges of the 1-4
+ * cells under it with the SSE2 SAT kernel (anyOverlap) without gathers or scalar tails.
+ *
+ * Range sensors use a third grid of SENSOR_CELL_SIZE cells: each cell lists every obstacle whose
+ * bounding box comes within sensorReach of it, so a scan reads one short list instead of walking
+ * the obstacle grid around the sensor.
+ *
+ * A lot is built once (generate(), or addSlot/addObstacle then build()) and is read-only afterwards,
+ * so one lot can be shared by any number of envs (ParkingEnv::setLot, VecParkingEnv::setLot).
+ */
+class ParkingLot {
+public:
+    /** Generate a lot from a layout, centered at the world origin
+     * ----------------------------------------------------------------------------
+     * Slot occupancy is drawn from Randomizer(seed), stream (0, 0). Every occupied slot gets a parked
+     * car obstacle; curbs enclose the lot and separate back-to-back rows.
+     *
+     * @param[in] layout: lot layout
+     * @param[in] seed: occupancy seed
+     * @return ParkingLot: built lot
+     */
+    static ParkingLot generate(const LotLayout& layout, uint64_t seed);
+
+    // add a slot / an obstacle, returns its index; call build() afterwards
+    std::size_t addSlot(const Position2D& pos, float yaw, bool occupied = false);
+    std::size_t addObstacle(const Obstacle& obstacle);
+
+    /** Build the spatial indices
+     * ----------------------------------------------------------------------------
+     * @param[in] bounds: lot bounds, an episode terminates when the car center leaves them
+     * @param[in] cellSize: grid cell size [m], about one slot length is a good choice
+     * @param[in] sensorReach: longest range sensor beam served by sensorCandidates() [m]
+     * @return void
+     */
+    void build(const AABB2D& bounds, float cellSize = PARKING_LENGTH, float sensorReach = SENSOR_REACH);
+
+    /** Index of the slot whose center is closest to p
+     * ----------------------------------------------------------------------------
+     * @param[in] p: query point in world frame
+     * @param[in] freeOnly: skip occupied slots
+     * @return int: slot index, -1 if there is no (free) slot
+     */
+    int nearestSlot(const Position2D& p, bool freeOnly = true) const noexcept;
+
+    /** Index of a slot the car is parked in (isCarInSlot)
+     * ----------------------------------------------------------------------------
+     * @param[in] car: car frame -> world
+     * @return int: slot index, -1 if the car is not inside any slot
+     */
+    int slotContaining(const Transform2D& car) const noexcept;
+
+    /** Collision candidates: obstacles whose bounding box overlaps box
+     * ----------------------------------------------------------------------------
+     * @param[in] box: query box in world frame
+     * @param[out] out: up to maxOut obstacle indices
+     * @param[in] maxOut: capacity of out
+     * @return std::size_t: number of overlapping obstacles (may exceed maxOut, only maxOut are written)
+     */
+    std::size_t queryObstacles(const AABB2D& box, uint32_t* out, std::size_t maxOut) const noexcept;
+
+    /** Collision of a car body (CAR_LENGTH x CAR_WIDTH) with the obstacles
+     * ----------------------------------------------------------------------------
+     * Broadphase: the grid cells under the car bounding box. Narrowphase: bounding circles, then
+     * oriented box SAT (anyOverlap) against the obstacles stored in those cells.
+     *
+     * @param[in] car: car frame -> world
+     * @return bool: true if the car touches a parked car or a curb
+     */
+    bool carCollides(const Transform2D& car) const noexcept;
+
+    /** Batched carCollides for n cars in SoA form
+     * ----------------------------------------------------------------------------
+     * cos/sin of the headings come from the FastMath.h polynomials, as in kinematicActBatch.
+     *
+     * @param[in] x, y, psi: n car poses
+     * @param[in] n: number of cars
+     * @param[out] contact: n flags, 1 if car i collides
+     * @return void
+     */
+    void collideBatch(const float* x, const float* y, const float* psi, std::size_t n, uint8_t* contact) const noexcept;
+
+    /** Call f(k) once for every obstacle stored in the grid cells that box overlaps
+     * ----------------------------------------------------------------------------
+     * k indexes getCellBoxes(). Same rule as UniformGrid::query (an obstacle is reported from the
+     * cell holding the lower-left corner of its overlap with the query cells), but on precomputed
+     * integer cell ranges and without the obstacle boxes, so the sensors can walk many cells cheaply.
+     * The padding boxes are reported too; they are far away and fail any distance test.
+     *
+     * @param[in] box: query box in world frame
+     * @param[in] f: callable taking a std::size_t index into getCellBoxes()
+     * @return void
+     */
+    template <class F>
+    void queryCellBoxes(const AABB2D& box, F&& f) const {
+        if (boxX.empty()) return;
+        const int cx0 = obstacleGrid.cellX(box.minX), cx1 = obstacleGrid.cellX(box.maxX);
+        const int cy0 = obstacleGrid.cellY(box.minY), cy1 = obstacleGrid.cellY(box.maxY);
+        const int cellsX = obstacleGrid.getCellsX();
+        for (int cy = cy0; cy <= cy1; ++cy) {
+            for (int cx = cx0; cx <= cx1; ++cx) {
+                const std::size_t cell = static_cast<std::size_t>(cy) * cellsX + cx;
+                for (std::size_t k = cellBoxStart[cell]; k < cellBoxStart[cell + 1]; ++k) {
+                    if (std::max(boxCellX[k], cx0) != cx || std::max(boxCellY[k], cy0) != cy) continue;
+                    f(k);
+                }
+            }
+        }
+    }
+
+    /** Range sensor candidates: obstacles within getSensorReach() of the sensor grid cell holding p
+     * ----------------------------------------------------------------------------
+     * Any obstacle a ray from p can hit within the reach is listed (with some farther ones). A point
+     * outside the grid is clamped into a border cell; nothing is within reach of it.
+     *
+     * @param[in] p: sensor position in world frame
+     * @return SensorCandidates: obstacle indices
+     */
+    SensorCandidates sensorCandidates(const Position2D& p) const noexcept {
+        if (sensorGrid.getCellsX() == 0) return {};
+        const int cx = sensorGrid.cellX(p.x), cy = sensorGrid.cellY(p.y);
+        const uint32_t begin = sensorGrid.cellBegin(cx, cy);
+        return SensorCandidates{sensorGrid.getItems().data() + begin, sensorGrid.cellEnd(cx, cy) - begin};
+    }
+
+    /** Draw an episode start from SPAWN_DRAW_COUNT uniform numbers in [0, 1)
+     * ----------------------------------------------------------------------------
+     * The car starts at rest on the aisle center line in front of a random slot (u[0]), shifted
+     * along the aisle by up to ±CAR_SPAWN_MARGIN (u[1]) and heading either way along the aisle (u[2]).
+     * The target is the free slot nearest to the car, or the nearest slot if all are occupied.
+     * Used by ParkingEnv::reset and VecParkingEnv::resetEnv so both draw the same episodes.
+     *
+     * @param[in] u: SPAWN_DRAW_COUNT uniform numbers
+     * @param[out] car: initial vehicle state
+     * @param[out] targetSlot: index of the target slot
+     * @return bool: false if the lot has no slot
+     */
+    bool sampleStart(const float* u, VehicleState& car, int& targetSlot) const noexcept;
+
+    // true if (x, y) is inside the lot bounds
+    bool contains(float x, float y) const noexcept { return bounds.contains(x, y); }
+
+    // getter
+    const std::vector<ParkingSlot>& getSlots() const noexcept { return slots; }
+    const std::vector<Obstacle>& getObstacles() const noexcept { return obstacles; }
+    const AABB2D& getBounds() const noexcept { return bounds; }
+    const UniformGrid& getSlotGrid() const noexcept { return slotGrid; }
+    const UniformGrid& getObstacleGrid() const noexcept { return obstacleGrid; }
+    OrientedBoxSoA getCellBoxes() const noexcept;  // padded obstacle boxes in cell order, see cellBoxStart
+    const std::vector<AABB2D>& getObstacleBoxes() const noexcept { return obstacleBoxes; }  // obstacleBounds() by index
+    bool isAxisAligned(std::size_t obstacle) const noexcept { return obstacleAligned[obstacle] != 0; }  // box == its bounds
+    float getSensorReach() const noexcept { return sensorReach; }
+    float getAisleWidth() const noexcept { return aisleWidth; }
+    std::size_t getFreeSlotCount() const noexcept { return freeSlotCount; }
+
+    // setter
+    void setAisleWidth(float width) noexcept { aisleWidth = width; }  // spawn distance in front of the slots
+
+private:
+    std::vector<ParkingSlot> slots;
+    std::vector<Obstacle> obstacles;
+    AABB2D bounds{LOT_X_MIN, LOT_Y_MIN, LOT_X_MAX, LOT_Y_MAX};
+    float aisleWidth{7.0f};
+    std::size_t freeSlotCount{0};
+
+    UniformGrid slotGrid;       // slot centers
+    UniformGrid obstacleGrid;   // obstacle bounding boxes
+    UniformGrid sensorGrid;     // obstacle bounding boxes grown by sensorReach, SENSOR_CELL_SIZE cells
+    float sensorReach{0.0f};
+
+    std::vector<AABB2D> obstacleBoxes;     // world bounds of each obstacle
+    std::vector<uint8_t> obstacleAligned;  // 1 if the obstacle is axis-aligned (its box equals its bounds)
+
+    // obstacle boxes copied cell by cell (SoA), cell i owns [cellBoxStart[i], cellBoxStart[i + 1]), a multiple of 4
+    std::vector<float> boxX, boxY, boxC, boxS, boxHX, boxHY, boxR;
+    std::vector<uint32_t> cellBoxStart;
+    std::vector<int32_t> boxCellX, boxCellY;  // lower-left grid cell of each box (queryCellBoxes)
+};
+
+// world-frame bounding box of an oriented box
+inline AABB2D obstacleBounds(const Obstacle& o) {
+    const float ex = std::fabs(o.pose.c) * o.halfExtents.x + std::fabs(o.pose.s) * o.halfExtents.y;
+    const float ey = std::fabs(o.pose.s) * o.halfExtents.x + std::fabs(o.pose.c) * o.halfExtents.y;
+    return AABB2D{o.pose.t.x - ex, o.pose.t.y - ey, o.pose.t.x + ex, o.pose.t.y + ey};
+}
+
+#endif
@@ -0,0 +1,40 @@
+#include "UniformGrid.h"
+
+#include <cmath>
+
+
+// build the cell lists with a counting sort
+// ------------------------------------------------------------------------
+void UniformGrid::build(const AABB2D& newBounds, float newCellSize, const AABB2D* newBoxes, std::size_t n) {
+    bounds = newBounds;
+    cellSize = newCellSize;
+    invCellSize = 1.0f / newCellSize;
+    cellsX = std::max(1, static_cast<int>(std::ceil((bounds.maxX - bounds.minX) * invCellSize)));
+    cellsY = std::max(1, static_cast<int>(std::ceil((bounds.maxY - bounds.minY) * invCellSize)));
+    boxes.assign(newBoxes, newBoxes + n);
+
+    // 1: count the items of every cell
+    cellStart.assign(static_cast<std::size_t>(cellsX) * cellsY + 1, 0u);
+    for (const AABB2D& b : boxes) {
+        for (int cy = cellY(b.minY); cy <= cellY(b.maxY); ++cy) {
+            for (int cx = cellX(b.minX); cx <= cellX(b.maxX); ++cx) {
+                ++cellStart[static_cast<std::size_t>(cy) * cellsX + cx + 1];
+            }
+        }
+    }
+
+    // 2: prefix sum -> offsets
+    for (std::size_t c = 1; c < cellStart.size(); ++c) cellStart[c] += cellStart[c - 1];
+
+    // 3: scatter the indices, item order is kept inside every cell
+    items.resize(cellStart.back());
+    std::vector<uint32_t> fill(cellStart.begin(), cellStart.end() - 1);
+    for (std::size_t i = 0; i < boxes.size(); ++i) {
+        const AABB2D& b = boxes[i];
+        for (int cy = cellY(b.minY); cy <= cellY(b.maxY); ++cy) {
+            for (int cx = cellX(b.minX); cx <= cellX(b.maxX); ++cx) {
+                items[fill[static_cast<std::size_t>(cy) * cellsX + cx]++] = static_cast<uint32_t>(i);
+            }
+        }
+    }
+}
@@ -0,0 +1,105 @@
+#ifndef UNIFORMGRID_H
+#define UNIFORMGRID_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+
+// axis-aligned box in world frame [m]
+struct AABB2D {
+    float minX{0.0f}, minY{0.0f};
+    float maxX{0.0f}, maxY{0.0f};
+
+    bool contains(float x, float y) const noexcept { return x >= minX && x <= maxX && y >= minY && y <= maxY; }
+    bool overlaps(const AABB2D& o) const noexcept { return minX <= o.maxX && o.minX <= maxX && minY <= o.maxY && o.minY <= maxY; }
+};
+
+/**
+ * Uniform Grid Class
+ * ---------------------------
+ * Static spatial index over items with an axis-aligned box (a point is a box with min == max).
+ *
+ * The bounds are split into square cells; every item is stored in each cell its box overlaps.
+ * Cells are kept in compressed form (one offset per cell into a flat index array), so the grid is
+ * two vectors built once by a counting sort and queries do not allocate.
+ * Items outside the bounds are clamped into the border cells.
+ *
+ * Queries are const and keep no state, so one grid can be shared by envs on several threads.
+ */
+class UniformGrid {
+public:
+    /** Build the index, replaces the previous content
+     * ----------------------------------------------------------------------------
+     * @param[in] bounds: area covered by the cells
+     * @param[in] cellSize: cell edge length [m], > 0
+     * @param[in] boxes: n item boxes, item i is reported as index i
+     * @param[in] n: number of items
+     * @return void
+     */
+    void build(const AABB2D& bounds, float cellSize, const AABB2D* boxes, std::size_t n);
+
+    /** Call f(index) once for every item whose box overlaps box
+     * ----------------------------------------------------------------------------
+     * An item spanning several cells is reported only from the cell that holds the lower-left
+     * corner of its overlap with box, so no visited set is needed.
+     *
+     * @param[in] box: query box in world frame
+     * @param[in] f: callable taking a uint32_t item index
+     * @return void
+     */
+    template <class F>
+    void query(const AABB2D& box, F&& f) const {
+        if (cellsX == 0) return;
+        const int cx0 = cellX(box.minX), cx1 = cellX(box.maxX);
+        const int cy0 = cellY(box.minY), cy1 = cellY(box.maxY);
+        for (int cy = cy0; cy <= cy1; ++cy) {
+            for (int cx = cx0; cx <= cx1; ++cx) {
+                const std::size_t cell = static_cast<std::size_t>(cy) * cellsX + cx;
+                for (uint32_t k = cellStart[cell]; k < cellStart[cell + 1]; ++k) {
+                    const uint32_t item = items[k];
+                    const AABB2D& b = boxes[item];
+                    if (!b.overlaps(box)) continue;
+                    if (cellX(std::max(b.minX, box.minX)) != cx || cellY(std::max(b.minY, box.minY)) != cy) continue;
+                    f(item);
+                }
+            }
+        }
+    }
+
+    // call f(index) for every item stored in cell (cx, cy), items spanning several cells are seen in each
+    template <class F>
+    void forEachInCell(int cx, int cy, F&& f) const {
+        const std::size_t cell = static_cast<std::size_t>(cy) * cellsX + cx;
+        for (uint32_t k = cellStart[cell]; k < cellStart[cell + 1]; ++k) f(items[k]);
+    }
+
+    // range [cellBegin, cellEnd) of cell (cx, cy) in the flat index array (getItems)
+    uint32_t cellBegin(int cx, int cy) const noexcept { return cellStart[static_cast<std::size_t>(cy) * cellsX + cx]; }
+    uint32_t cellEnd(int cx, int cy) const noexcept { return cellStart[static_cast<std::size_t>(cy) * cellsX + cx + 1]; }
+
+    // cell coordinates of a world position, clamped to the grid
+    int cellX(float x) const noexcept { return std::clamp(static_cast<int>((x - bounds.minX) * invCellSize), 0, cellsX - 1); }
+    int cellY(float y) const noexcept { return std::clamp(static_cast<int>((y - bounds.minY) * invCellSize), 0, cellsY - 1); }
+
+    // getter
+    const AABB2D& getBounds() const noexcept { return bounds; }
+    float getCellSize() const noexcept { return cellSize; }
+    int getCellsX() const noexcept { return cellsX; }
+    int getCellsY() const noexcept { return cellsY; }
+    std::size_t size() const noexcept { return boxes.size(); }
+    const std::vector<uint32_t>& getItems() const noexcept { return items; }  // item indices grouped by cell
+
+private:
+    AABB2D bounds{};
+    float cellSize{1.0f};
+    float invCellSize{1.0f};
+    int cellsX{0}, cellsY{0};
+
+    std::vector<AABB2D> boxes;          // item boxes, by item index
+    std::vector<uint32_t> cellStart;    // cellsX * cellsY + 1 offsets into items
+    std::vector<uint32_t> items;        // item indices grouped by cell
+};
+
+#endif
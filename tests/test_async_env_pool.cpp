@@ -0,0 +1,118 @@
+#include <gtest/gtest.h>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "rollout/AsyncEnvPool.h"
+
+
+namespace {
+    Action actionFor(uint32_t env, int round) {
+        return Action{0.4f + 0.1f * static_cast<float>(env % 4), 0.03f * static_cast<float>((round + static_cast<int>(env)) % 5) - 0.06f};
+    }
+}
+
+
+// results come back in any order but every env follows the trajectory of a sequentially stepped env
+TEST(AsyncEnvPool, MatchesSequentialEnvs) {
+    AsyncEnvPoolConfig config;
+    config.numEnvs = 12;
+    config.numThreads = 3;
+    config.maxChunk = 2;
+    config.maxEpisodeSteps = 5;
+    config.seed = 3;
+    AsyncEnvPool pool(config);
+
+    std::vector<std::unique_ptr<Randomizer>> randomizers;
+    std::vector<ParkingEnv> reference;
+    reference.reserve(config.numEnvs);
+    for (std::size_t i = 0; i < config.numEnvs; ++i) {
+        randomizers.push_back(std::make_unique<Randomizer>(config.seed));
+        reference.emplace_back(randomizers.back().get());
+        reference.back().setEnvIndex(i);
+        reference.back().setMaxEpisodeSteps(config.maxEpisodeSteps);
+    }
+
+    std::vector<AsyncEnvResult> results(config.numEnvs);
+    ASSERT_TRUE(pool.asyncReset());
+    ASSERT_EQ(pool.recvResults(config.numEnvs, results.data()), config.numEnvs);
+    for (const AsyncEnvResult& r : results) {
+        reference[r.envId].reset();
+        const Observation expected = reference[r.envId].getObservation();
+        EXPECT_EQ(std::memcmp(&r.obs, &expected, sizeof(Observation)), 0) << "env " << r.envId;
+    }
+
+    std::vector<uint32_t> ids(config.numEnvs);
+    std::vector<Action> actions(config.numEnvs);
+    int episodesEnded = 0;
+    for (int round = 0; round < 12; ++round) {
+        for (uint32_t i = 0; i < config.numEnvs; ++i) {
+            ids[i] = i;
+            actions[i] = actionFor(i, round);
+        }
+        ASSERT_TRUE(pool.sendActions(ids.data(), actions.data(), ids.size()));
+
+        std::vector<int> seen(config.numEnvs, 0);
+        for (std::size_t received = 0; received < config.numEnvs;) {
+            const std::size_t got = pool.recvResults(5, results.data());
+            ASSERT_GT(got, 0u);
+            for (std::size_t k = 0; k < got; ++k) {
+                const AsyncEnvResult& r = results[k];
+                ++seen[r.envId];
+
+                ParkingEnv& env = reference[r.envId];
+                Observation expected;
+                StepResult step;
+                env.stepInto(actionFor(r.envId, round), config.simDt, expected, step);
+                EXPECT_EQ(r.reward, step.reward);
+                EXPECT_EQ(r.terminated, step.terminated);
+                EXPECT_EQ(r.truncated, step.truncated);
+                if (step.done) {
+                    EXPECT_EQ(std::memcmp(&r.finalObs, &expected, sizeof(Observation)), 0) << "env " << r.envId;
+                    env.reset();
+                    env.observe(expected);
+                    ++episodesEnded;
+                }
+                EXPECT_EQ(std::memcmp(&r.obs, &expected, sizeof(Observation)), 0) << "env " << r.envId << " round " << round;
+            }
+            received += got;
+        }
+        for (int s : seen) EXPECT_EQ(s, 1);
+    }
+    EXPECT_GT(episodesEnded, 0);
+    EXPECT_EQ(pool.getPending(), 0u);
+}
+
+// an env holds one request at a time, recvResults only waits for what was sent
+TEST(AsyncEnvPool, OneRequestPerEnv) {
+    AsyncEnvPoolConfig config;
+    config.numEnvs = 4;
+    config.numThreads = 2;
+    AsyncEnvPool pool(config);
+
+    std::vector<AsyncEnvResult> results(config.numEnvs);
+    ASSERT_TRUE(pool.asyncReset());
+    EXPECT_EQ(pool.recvResults(config.numEnvs, results.data()), config.numEnvs);
+
+    const uint32_t first[] = {2};
+    const Action action{1.0f, 0.0f};
+    ASSERT_TRUE(pool.sendActions(first, &action, 1));
+    EXPECT_FALSE(pool.sendActions(first, &action, 1));          // still in flight
+
+    const uint32_t twice[] = {0, 0};
+    const Action two[] = {action, action};
+    EXPECT_FALSE(pool.sendActions(twice, two, 2));
+    const uint32_t outOfRange[] = {1, 4};
+    EXPECT_FALSE(pool.sendActions(outOfRange, two, 2));
+    EXPECT_FALSE(pool.asyncReset());
+    EXPECT_EQ(pool.getPending(), 1u);
+
+    // the rejected calls left envs 0 and 1 free
+    ASSERT_EQ(pool.recvResults(config.numEnvs, results.data()), 1u);
+    EXPECT_EQ(results[0].envId, 2u);
+    const uint32_t again[] = {0, 1, 2};
+    const Action three[] = {action, action, action};
+    EXPECT_TRUE(pool.sendActions(again, three, 3));
+    EXPECT_EQ(pool.recvResults(config.numEnvs, results.data()), 3u);
+    EXPECT_EQ(pool.recvResults(config.numEnvs, results.data()), 0u);
+}
@@ -0,0 +1,159 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "core/Config.h"
+#include "envs/VecParkingEnv.h"
+#include "sensors/BevRasterizer.h"
+#include "utilities/FastMath.h"
+#include "utilities/Randomizer.h"
+#include "world/ParkingLot.h"
+
+
+namespace {
+    // pixel (r, c) center in car frame
+    Position2D pixelCenter(const BevConfig& config, int r, int c) {
+        return {(0.5f * config.height - r - 0.5f) * config.resolution, (0.5f * config.width - c - 0.5f) * config.resolution};
+    }
+
+    // signed distance-like margin of p to a rectangle: > 0 inside, < 0 outside
+    float rectMargin(const Transform2D& rect, const Position2D& half, const Position2D& p) {
+        const Position2D q = rect.applyInverse(p);
+        return std::min(half.x - std::fabs(q.x), half.y - std::fabs(q.y));
+    }
+
+    // pixel-by-pixel reference of one layer, pixels with their center within eps of an edge are marked 128 (either value)
+    std::vector<uint8_t> bruteLayer(const BevConfig& config, const Transform2D& car,
+                                    const std::vector<Transform2D>& rects, const std::vector<Position2D>& halves) {
+        constexpr float eps = 1e-4f;
+        std::vector<uint8_t> layer(static_cast<std::size_t>(config.width) * config.height, 0);
+        for (int r = 0; r < config.height; ++r) {
+            for (int c = 0; c < config.width; ++c) {
+                const Position2D p = car.apply(pixelCenter(config, r, c));
+                uint8_t& v = layer[static_cast<std::size_t>(r) * config.width + c];
+                for (std::size_t k = 0; k < rects.size() && v != 255; ++k) {
+                    const float m = rectMargin(rects[k], halves[k], p);
+                    if (m > eps) v = 255;
+                    else if (m > -eps) v = 128;
+                }
+            }
+        }
+        return layer;
+    }
+
+    int countSet(const uint8_t* layer, std::size_t size) {
+        return static_cast<int>(std::count(layer, layer + size, uint8_t{255}));
+    }
+}
+
+
+TEST(BevRasterizer, Layout) {
+    const BevConfig config{64, 64, 0.1f};
+    BevRasterizer raster(config);
+    std::vector<uint8_t> image(raster.imageSize());
+    ASSERT_EQ(image.size(), 4u * 64u * 64u);
+
+    // no lot: the target slot 3 m ahead is drawn into the slot and target layers
+    raster.render(nullptr, Transform2D{}, Transform2D::fromPose({3.0f, 0.0f}, 0.0f), image.data());
+    const std::size_t layer = raster.layerSize();
+    const uint8_t* slots = image.data() + static_cast<int>(BevChannel::Slots) * layer;
+    const uint8_t* target = image.data() + static_cast<int>(BevChannel::Target) * layer;
+    const uint8_t* ego = image.data() + static_cast<int>(BevChannel::Ego) * layer;
+
+    EXPECT_EQ(countSet(image.data(), layer), 0);
+    EXPECT_EQ(countSet(ego, layer), 40 * 20);  // CAR_LENGTH x CAR_WIDTH at 10 cm
+    EXPECT_EQ(ego[32 * 64 + 32], 255);
+    EXPECT_EQ(target[2 * 64 + 32], 255);       // row 0 is in front of the car
+    EXPECT_EQ(target[40 * 64 + 32], 0);
+    EXPECT_TRUE(std::equal(slots, slots + layer, target));
+
+    // a car turned by 90 deg sees the slot on its right (high columns)
+    raster.render(nullptr, Transform2D::fromPose({0.0f, 0.0f}, 0.5f * PI), Transform2D::fromPose({3.0f, 0.0f}, 0.0f), image.data());
+    EXPECT_EQ(target[32 * 64 + 62], 255);
+    EXPECT_EQ(target[32 * 64 + 2], 0);
+}
+
+TEST(BevRasterizer, MatchesBruteForce) {
+    LotLayout layout;
+    layout.aisles = 3;
+    layout.slotsPerRow = 12;
+    const ParkingLot lot = ParkingLot::generate(layout, 3);
+
+    std::vector<Transform2D> obstacleRects, slotRects;
+    std::vector<Position2D> obstacleHalves, slotHalves;
+    for (const Obstacle& o : lot.getObstacles()) {
+        obstacleRects.push_back(o.pose);
+        obstacleHalves.push_back(o.halfExtents);
+    }
+    for (const ParkingSlot& s : lot.getSlots()) {
+        slotRects.push_back(s.pose);
+        slotHalves.push_back({PARKING_LENGTH * 0.5f, PARKING_WIDTH * 0.5f});
+    }
+
+    // odd sizes exercise the scalar row tail and the partial 4-row blocks
+    const BevConfig configs[] = {{64, 64, 0.1f}, {45, 70, 0.25f}};
+    for (const BevConfig& config : configs) {
+        const BevRasterizer raster(config);
+        const std::size_t layer = raster.layerSize();
+        std::vector<uint8_t> image(raster.imageSize());
+
+        Randomizer randomizer(11);
+        const AABB2D& b = lot.getBounds();
+        for (int n = 0; n < 40; ++n) {
+            const Transform2D car = Transform2D::fromPose({randomizer.randFloat(b.minX, b.maxX), randomizer.randFloat(b.minY, b.maxY)},
+                                                          randomizer.randFloat(-PI, PI));
+            const Transform2D target = lot.getSlots()[n % lot.getSlots().size()].pose;
+            raster.render(&lot, car, target, image.data());
+
+            const std::vector<uint8_t> ref[BEV_CHANNELS] = {
+                bruteLayer(config, car, obstacleRects, obstacleHalves),
+                bruteLayer(config, car, slotRects, slotHalves),
+                bruteLayer(config, car, {target}, {slotHalves[0]}),
+                bruteLayer(config, car, {car}, {{CAR_LENGTH * 0.5f, CAR_WIDTH * 0.5f}}),
+            };
+            for (int ch = 0; ch < BEV_CHANNELS; ++ch) {
+                for (std::size_t p = 0; p < layer; ++p) {
+                    if (ref[ch][p] == 128) continue;
+                    ASSERT_EQ(image[ch * layer + p], ref[ch][p]) << "pose " << n << " channel " << ch << " pixel " << p;
+                }
+            }
+        }
+    }
+}
+
+TEST(BevRasterizer, VecEnvBatch) {
+    LotLayout layout;
+    layout.aisles = 2;
+    layout.slotsPerRow = 10;
+    const ParkingLot lot = ParkingLot::generate(layout, 6);
+    constexpr std::size_t kEnvs = 6;
+
+    Randomizer randomizer(8);
+    VecParkingEnv vec(kEnvs, &randomizer, 0.01f);
+    vec.setLot(&lot);
+    vec.setBevRaster(BevConfig{48, 48, 0.2f});
+    vec.reset();
+
+    std::vector<Action> actions(kEnvs, Action{0.3f, 1.0f});
+    std::vector<Observation> obs(kEnvs);
+    std::vector<float> rewards(kEnvs);
+    std::vector<uint8_t> dones(kEnvs);
+    for (int s = 0; s < 10; ++s) vec.step(actions.data(), obs.data(), rewards.data(), dones.data());
+
+    // image i of the tensor is the render of env i
+    const BevRasterizer& raster = vec.getBevRasterizer();
+    std::vector<uint8_t> image(raster.imageSize());
+    for (std::size_t i = 0; i < kEnvs; ++i) {
+        const VehicleState state = vec.getVehicleState(i);
+        Transform2D car{1.0f, 0.0f, state.pos};
+        fastSinCos(state.psi, car.s, car.c);
+        raster.render(&lot, car, lot.getSlots()[vec.getTargetSlot(i)].pose, image.data());
+        EXPECT_EQ(vec.getBev(i), vec.getBev() + i * raster.imageSize());
+        EXPECT_EQ(countSet(vec.getBev(i) + static_cast<int>(BevChannel::Ego) * raster.layerSize(), raster.layerSize()), 20 * 10);
+        const int diff = static_cast<int>(std::mismatch(image.begin(), image.end(), vec.getBev(i)).first - image.begin());
+        EXPECT_EQ(diff, static_cast<int>(image.size())) << "env " << i;
+    }
+}
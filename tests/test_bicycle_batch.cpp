@@ -0,0 +1,194 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "vehicledynamics/BicycleModel.h"
+#include "vehicledynamics/VehicleTypes.h"
+#include "utilities/FastMath.h"
+#include "utilities/MathUtils.h"
+
+
+namespace {
+    // tolerance after kSteps steps: polynomial error (~1e-7 per trig call) accumulated over the rollout
+    constexpr float kPosEps = 1e-4f;
+    constexpr float kAngEps = 1e-4f;
+    constexpr int kSteps = 100;
+    constexpr float kDt = 0.01f;
+
+    // batch sizes that are not multiples of the SIMD widths exercise the scalar tail
+    constexpr std::size_t kCount = 1027;
+
+    struct SoABuffers {
+        std::vector<float> x, y, psi, v, delta;
+
+        explicit SoABuffers(const std::vector<VehicleState>& states) {
+            for (const auto& s : states) {
+                x.push_back(s.pos.x);
+                y.push_back(s.pos.y);
+                psi.push_back(s.psi);
+                v.push_back(s.velocity);
+                delta.push_back(s.delta);
+            }
+        }
+
+        VehicleStateSoA view() {
+            return VehicleStateSoA{x.data(), y.data(), psi.data(), v.data(), delta.data(), x.size()};
+        }
+    };
+
+    void runBatchAgainstScalar(SimdPath path) {
+        std::mt19937 rng(1234);
+        std::uniform_real_distribution<float> pos(-20.0f, 20.0f);
+        std::uniform_real_distribution<float> ang(-PI, PI);
+        std::uniform_real_distribution<float> vel(-3.0f, 3.0f);
+        std::uniform_real_distribution<float> acc(-2.0f, 2.0f);    // beyond a_max to test clamping
+        std::uniform_real_distribution<float> steer(-1.2f, 1.2f);  // beyond delta_max to test clamping
+
+        std::vector<VehicleState> ref(kCount);
+        for (auto& s : ref) s = VehicleState{{pos(rng), pos(rng)}, ang(rng), vel(rng), 0.0f};
+        SoABuffers soa(ref);
+
+        BicycleModel model(CAR_LENGTH);
+        std::vector<Action> actions(kCount);
+
+        for (int t = 0; t < kSteps; ++t) {
+            for (auto& a : actions) a = Action{acc(rng), steer(rng)};
+
+            model.kinematicActBatch(actions.data(), soa.view(), kDt, path);
+            for (std::size_t i = 0; i < kCount; ++i) {
+                Action a = actions[i];
+                model.kinematicAct(a, ref[i], kDt);
+            }
+        }
+
+        for (std::size_t i = 0; i < kCount; ++i) {
+            EXPECT_NEAR(soa.x[i], ref[i].pos.x, kPosEps) << "vehicle " << i;
+            EXPECT_NEAR(soa.y[i], ref[i].pos.y, kPosEps) << "vehicle " << i;
+            EXPECT_NEAR(wrapPi(soa.psi[i] - ref[i].psi), 0.0f, kAngEps) << "vehicle " << i;
+            EXPECT_NEAR(soa.v[i], ref[i].velocity, 1e-5f) << "vehicle " << i;
+            EXPECT_FLOAT_EQ(soa.delta[i], ref[i].delta) << "vehicle " << i;
+        }
+    }
+}
+
+
+TEST(FastMath, SinCosTanWithinDocumentedBound) {
+    for (int i = -100000; i <= 100000; ++i) {
+        const float x = static_cast<float>(i) * 1e-3f;  // [-100, 100]
+        float s, c;
+        fastSinCos(x, s, c);
+        EXPECT_NEAR(s, std::sin(static_cast<double>(x)), 2e-7);
+        EXPECT_NEAR(c, std::cos(static_cast<double>(x)), 2e-7);
+    }
+    for (int i = -1000; i <= 1000; ++i) {
+        const float x = static_cast<float>(i) * (PI * 0.25f / 1000.0f);
+        const double t = std::tan(static_cast<double>(x));
+        EXPECT_NEAR(fastTanQuarterPi(x), t, 2e-7 * std::fabs(t) + 1e-9);
+    }
+}
+
+TEST(FastMath, Atan2WithinDocumentedBound) {
+    for (int i = 0; i < 3600; ++i) {
+        const double a = -PI + i * (2.0 * PI / 3600.0);
+        for (float r : {1e-3f, 1.0f, 250.0f}) {
+            const float x = static_cast<float>(r * std::cos(a)), y = static_cast<float>(r * std::sin(a));
+            EXPECT_NEAR(fastAtan2(y, x), std::atan2(static_cast<double>(y), static_cast<double>(x)), 1.2e-5);
+        }
+    }
+    EXPECT_EQ(fastAtan2(0.0f, 0.0f), 0.0f);
+}
+
+TEST(BicycleModelBatch, ScalarPathMatchesKinematicAct) {
+    runBatchAgainstScalar(SimdPath::Scalar);
+}
+
+TEST(BicycleModelBatch, SSE41PathMatchesKinematicAct) {
+    if (!BicycleModel::isSimdPathSupported(SimdPath::SSE41)) GTEST_SKIP() << "SSE4.1 not available";
+    runBatchAgainstScalar(SimdPath::SSE41);
+}
+
+TEST(BicycleModelBatch, AVX2PathMatchesKinematicAct) {
+    if (!BicycleModel::isSimdPathSupported(SimdPath::AVX2)) GTEST_SKIP() << "AVX2 not available";
+    runBatchAgainstScalar(SimdPath::AVX2);
+}
+
+namespace {
+    // fine-step reference of the kinematic model in double: same equations as kinematicAct
+    void eulerReference(double& x, double& y, double& psi, double& v, float accel, float steer, double dt, int substeps) {
+        const BicycleModelLimits limits;
+        const double h = dt / substeps;
+        for (int k = 0; k < substeps; ++k) {
+            v = std::clamp(v + accel * h, -static_cast<double>(limits.v_max), static_cast<double>(limits.v_max));
+            x += h * v * std::cos(psi);
+            y += h * v * std::sin(psi);
+            psi += h * v * std::tan(static_cast<double>(steer)) / CAR_LENGTH;
+        }
+    }
+}
+
+// Arc integration at a 0.1 s step stays on the fine-step Euler trajectory (1e4 substeps per step, double),
+// while plain Euler at 0.1 s drifts away.
+TEST(BicycleModelArc, MatchesFineStepEulerAtLargeDt) {
+    constexpr float kBigDt = 0.1f;
+    constexpr int kBigSteps = 30;
+    constexpr std::size_t kCars = 64;
+    const BicycleModelLimits limits;
+
+    std::mt19937 rng(99);
+    std::uniform_real_distribution<float> vel(-limits.v_max, limits.v_max);
+    std::uniform_real_distribution<float> acc(-limits.a_max, limits.a_max);
+    std::uniform_real_distribution<float> steer(-limits.delta_max, limits.delta_max);
+
+    BicycleModel arcModel(CAR_LENGTH);
+    arcModel.setIntegrator(KinematicIntegrator::Arc);
+    const BicycleModel eulerModel(CAR_LENGTH);
+
+    float maxArcErr = 0.0f, maxEulerErr = 0.0f;
+    for (std::size_t car = 0; car < kCars; ++car) {
+        VehicleState arc{{0.0f, 0.0f}, 0.3f, vel(rng), 0.0f};
+        VehicleState euler = arc;
+        double x = 0.0, y = 0.0, psi = arc.psi, v = arc.velocity;
+
+        for (int t = 0; t < kBigSteps; ++t) {
+            // small steering angles too, to cover the straight-line limit
+            const Action action{acc(rng), (t % 3 == 0) ? 1e-4f * steer(rng) : steer(rng)};
+            arcModel.kinematicAct(action, arc, kBigDt);
+            eulerModel.kinematicAct(action, euler, kBigDt);
+            eulerReference(x, y, psi, v, action.acceleration, action.steeringAngle, kBigDt, 10000);
+
+            const float refPsi = static_cast<float>(std::remainder(psi, 2.0 * PI));
+            ASSERT_NEAR(arc.velocity, v, 1e-5);
+            ASSERT_NEAR(wrapPi(arc.psi - refPsi), 0.0f, 1e-4f);
+            maxArcErr = std::max(maxArcErr, static_cast<float>(std::hypot(arc.pos.x - x, arc.pos.y - y)));
+            maxEulerErr = std::max(maxEulerErr, static_cast<float>(std::hypot(euler.pos.x - x, euler.pos.y - y)));
+        }
+    }
+
+    EXPECT_LT(maxArcErr, 1e-4f);
+    EXPECT_GT(maxEulerErr, 100.0f * maxArcErr);
+}
+
+// The batch entry point uses the same arc step as kinematicAct.
+TEST(BicycleModelArc, BatchMatchesKinematicAct) {
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<float> u(-1.2f, 1.2f);
+
+    std::vector<VehicleState> ref(kCount);
+    for (auto& s : ref) s = VehicleState{{10.0f * u(rng), 10.0f * u(rng)}, 2.0f * u(rng), 2.0f * u(rng), 0.0f};
+    SoABuffers soa(ref);
+
+    BicycleModel model(CAR_LENGTH);
+    model.setIntegrator(KinematicIntegrator::Arc);
+    std::vector<Action> actions(kCount);
+    for (int t = 0; t < 20; ++t) {
+        for (auto& a : actions) a = Action{u(rng), u(rng)};
+        model.kinematicActBatch(actions.data(), soa.view(), 0.1f);
+        for (std::size_t i = 0; i < kCount; ++i) model.kinematicAct(static_cast<const Action&>(actions[i]), ref[i], 0.1f);
+    }
+    for (std::size_t i = 0; i < kCount; ++i) {
+        EXPECT_FLOAT_EQ(soa.x[i], ref[i].pos.x);
+        EXPECT_FLOAT_EQ(soa.y[i], ref[i].pos.y);
+        EXPECT_FLOAT_EQ(soa.psi[i], ref[i].psi);
+    }
+}
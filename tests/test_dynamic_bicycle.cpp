@@ -0,0 +1,126 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "vehicledynamics/BicycleModel.h"
+#include "vehicledynamics/VehicleTypes.h"
+#include "utilities/MathUtils.h"
+
+
+namespace {
+    constexpr float kDt = 0.01f;
+    constexpr float kEps = 1e-4f;
+}
+
+
+// Random full-lock steering and acceleration at simDt = 0.01 for 100 s: the state stays finite and the
+// lateral velocity and yaw rate stay within what the speed limit allows.
+TEST(DynamicBicycleModel, StableAtSimDt) {
+    constexpr std::size_t kCount = 257;
+    const BicycleModelLimits limits;
+
+    std::vector<float> x(kCount, 0.0f), y(kCount, 0.0f), psi(kCount, 0.0f), v(kCount, 0.0f), delta(kCount, 0.0f);
+    std::vector<float> vy(kCount, 0.0f), yawRate(kCount, 0.0f);
+    const VehicleStateSoA state{x.data(), y.data(), psi.data(), v.data(), delta.data(), kCount, vy.data(), yawRate.data()};
+
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> acc(-2.0f, 2.0f);
+    std::uniform_real_distribution<float> steer(-1.2f, 1.2f);
+    std::vector<Action> actions(kCount);
+
+    BicycleModel model(CAR_LENGTH);
+    for (int t = 0; t < 10000; ++t) {
+        if (t % 50 == 0) for (auto& a : actions) a = Action{acc(rng), steer(rng)};
+        model.dynamicActBatch(actions.data(), state, kDt);
+    }
+
+    for (std::size_t i = 0; i < kCount; ++i) {
+        ASSERT_TRUE(std::isfinite(x[i]) && std::isfinite(y[i]) && std::isfinite(psi[i]));
+        EXPECT_LE(std::fabs(v[i]), limits.v_max);
+        EXPECT_LE(std::fabs(vy[i]), limits.v_max);
+        EXPECT_LE(std::fabs(yawRate[i]), 2.0f * limits.v_max / CAR_LENGTH);
+        EXPECT_LE(std::fabs(psi[i]), PI + kEps);
+    }
+}
+
+// Below blendSpeedLow the dynamic model follows kinematicAct (within the FastMath.h error).
+TEST(DynamicBicycleModel, MatchesKinematicAtLowSpeed) {
+    BicycleModel model(CAR_LENGTH);
+    VehicleState dyn{{3.0f, -2.0f}, 0.4f, 0.0f, 0.0f};
+    VehicleState kin = dyn;
+
+    for (int t = 0; t < 400; ++t) {
+        // creep forward and backward at up to 0.4 m/s with full steering
+        const int phase = t % 200;
+        const float accel = (phase < 40) ? 1.0f : (phase < 120) ? -1.0f : (phase < 160) ? 1.0f : 0.0f;
+        const Action action{accel, (t < 200) ? 0.7f : -0.7f};
+        model.dynamicAct(action, dyn, kDt);
+        model.kinematicAct(action, kin, kDt);
+        ASSERT_LT(std::fabs(dyn.velocity), model.getDynamicParams().blendSpeedLow);
+    }
+
+    EXPECT_NEAR(dyn.pos.x, kin.pos.x, kEps);
+    EXPECT_NEAR(dyn.pos.y, kin.pos.y, kEps);
+    EXPECT_NEAR(dyn.psi, kin.psi, kEps);
+    EXPECT_NEAR(dyn.velocity, kin.velocity, kEps);
+    EXPECT_FLOAT_EQ(dyn.vy, 0.0f);
+}
+
+// Steady cornering at top speed: the car slips sideways and turns a little less than the kinematic
+// model predicts (understeer gradient is zero for equal axle loads and stiffness, so close to it).
+TEST(DynamicBicycleModel, SteadyStateCornering) {
+    BicycleModel model(CAR_LENGTH);
+    const BicycleModelLimits limits;
+    VehicleState s{{0.0f, 0.0f}, 0.0f, limits.v_max, 0.0f};
+    const Action action{0.0f, 0.3f};
+
+    for (int t = 0; t < 500; ++t) model.dynamicAct(action, s, kDt);
+
+    const float rKin = s.velocity * std::tan(0.3f) / CAR_LENGTH;
+    EXPECT_NEAR(s.yawRate, rKin, 0.05f * rKin);
+    EXPECT_GT(std::fabs(s.vy), 1e-3f);
+}
+
+// The AVX2 kernel follows the scalar loop (a count that is not a multiple of 8 also runs the tail)
+// through random actions across the blend range and full speed.
+TEST(DynamicBicycleModel, AVX2PathMatchesScalar) {
+    if (!BicycleModel::isSimdPathSupported(SimdPath::AVX2)) GTEST_SKIP() << "AVX2 not available";
+    constexpr std::size_t kCount = 67;
+
+    struct Fleet {
+        std::vector<float> x, y, psi, v, delta, vy, yawRate;
+        explicit Fleet(std::size_t n) : x(n), y(n), psi(n), v(n), delta(n), vy(n, 0.0f), yawRate(n, 0.0f) {}
+        VehicleStateSoA view() { return {x.data(), y.data(), psi.data(), v.data(), delta.data(), x.size(), vy.data(), yawRate.data()}; }
+    };
+    Fleet simd(kCount), scalar(kCount);
+
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<float> u(-1.0f, 1.0f);
+    for (std::size_t i = 0; i < kCount; ++i) {
+        simd.x[i] = 10.0f * u(rng);
+        simd.y[i] = 10.0f * u(rng);
+        simd.psi[i] = 3.0f * u(rng);
+        simd.v[i] = 3.0f * u(rng);
+    }
+    scalar = simd;
+
+    BicycleModel model(CAR_LENGTH);
+    std::vector<Action> actions(kCount);
+    for (int t = 0; t < 300; ++t) {
+        if (t % 30 == 0) for (auto& a : actions) a = Action{2.0f * u(rng), 1.2f * u(rng)};
+        model.dynamicActBatch(actions.data(), simd.view(), kDt, SimdPath::AVX2);
+        model.dynamicActBatch(actions.data(), scalar.view(), kDt, SimdPath::Scalar);
+    }
+
+    for (std::size_t i = 0; i < kCount; ++i) {
+        EXPECT_NEAR(simd.x[i], scalar.x[i], kEps) << "vehicle " << i;
+        EXPECT_NEAR(simd.y[i], scalar.y[i], kEps) << "vehicle " << i;
+        EXPECT_NEAR(simd.v[i], scalar.v[i], kEps) << "vehicle " << i;
+        EXPECT_NEAR(simd.vy[i], scalar.vy[i], kEps) << "vehicle " << i;
+        EXPECT_NEAR(simd.yawRate[i], scalar.yawRate[i], kEps) << "vehicle " << i;
+        EXPECT_FLOAT_EQ(simd.delta[i], scalar.delta[i]);
+        // heading compared on the circle (a wrap near +-PI may land on either side)
+        EXPECT_NEAR(std::remainder(simd.psi[i] - scalar.psi[i], 2.0f * PI), 0.0f, kEps) << "vehicle " << i;
+    }
+}
@@ -0,0 +1,137 @@
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+#include "envs/VecParkingEnv.h"
+#include "ipc/EnvServer.h"
+#include "ipc/car_env_client.h"
+#include "utilities/Randomizer.h"
+
+
+namespace {
+    EnvServerConfig testConfig(const char* tag) {
+        EnvServerConfig config;
+        config.name = std::string("/car_env_test_") + tag + "_" + std::to_string(getpid());
+        config.numEnvs = 8;
+        config.seed = 5;
+        config.maxEpisodeSteps = 30;
+        config.spin = 1000;
+        return config;
+    }
+
+    // runs serve() on a thread, stopped and joined on scope exit so a failed ASSERT does not leave it running
+    struct ServingThread {
+        EnvServer& server;
+        std::thread thread;
+        explicit ServingThread(EnvServer& s) : server(s), thread([&s] { s.serve(); }) {}
+        ~ServingThread() { join(); }
+        void join() {
+            if (!thread.joinable()) return;
+            server.stop();
+            thread.join();
+        }
+    };
+}
+
+
+TEST(EnvServer, StepMatchesLocalVecEnv) {
+    const EnvServerConfig config = testConfig("step");
+    EnvServer server(config);
+    ASSERT_TRUE(server.open());
+    ServingThread serving(server);
+
+    CarEnvClient* client = car_env_connect(config.name.c_str(), 1000);
+    ASSERT_NE(client, nullptr);
+    const std::size_t n = car_env_num_envs(client);
+    ASSERT_EQ(n, config.numEnvs);
+    ASSERT_EQ(car_env_obs_size(client) * sizeof(float), sizeof(Observation));
+
+    // the same batch in this process
+    Randomizer randomizer(config.seed);
+    VecParkingEnv local(n, &randomizer, config.simDt);
+    local.setMaxEpisodeSteps(config.maxEpisodeSteps);
+    local.setAutoReset(true);
+    local.reset();
+    std::vector<Observation> obs(n);
+    local.observe(obs.data());
+    EXPECT_EQ(std::memcmp(car_env_obs(client), obs.data(), n * sizeof(Observation)), 0);
+
+    std::vector<Action> actions(n);
+    std::vector<float> rewards(n);
+    std::vector<uint8_t> terminated(n), truncated(n);
+    for (int s = 0; s < 35; ++s) {
+        float* shared = car_env_actions(client);
+        for (std::size_t i = 0; i < n; ++i) {
+            actions[i] = Action{0.5f + 0.1f * static_cast<float>(i % 3), 0.02f * static_cast<float>(s % 7) - 0.06f};
+            shared[2 * i] = actions[i].acceleration;
+            shared[2 * i + 1] = actions[i].steeringAngle;
+        }
+        ASSERT_EQ(car_env_step(client, 1000), CAR_ENV_OK);
+        local.step(actions.data(), obs.data(), rewards.data(), terminated.data(), truncated.data());
+
+        ASSERT_EQ(std::memcmp(car_env_obs(client), obs.data(), n * sizeof(Observation)), 0) << "step " << s;
+        ASSERT_EQ(std::memcmp(car_env_rewards(client), rewards.data(), n * sizeof(float)), 0);
+        ASSERT_EQ(std::memcmp(car_env_terminated(client), terminated.data(), n), 0);
+        ASSERT_EQ(std::memcmp(car_env_truncated(client), truncated.data(), n), 0);
+        for (std::size_t i = 0; i < n; ++i) {
+            if (!terminated[i] && !truncated[i]) continue;
+            EXPECT_EQ(std::memcmp(car_env_final_obs(client) + i * car_env_obs_size(client), &local.getFinalObservation(i), sizeof(Observation)), 0);
+        }
+    }
+
+    EXPECT_EQ(car_env_ping(client, 1000), CAR_ENV_OK);
+    EXPECT_EQ(car_env_shutdown(client, 1000), CAR_ENV_OK);
+    serving.join();
+    EXPECT_EQ(server.getCommandCount(), 37u);
+
+    // nobody answers any more
+    EXPECT_EQ(car_env_ping(client, 50), CAR_ENV_ERR_TIMEOUT);
+    car_env_disconnect(client);
+}
+
+// a client that timed out has already bumped its sequence number: the next command skips one and is still answered
+TEST(EnvServer, AnswersAfterSkippedSequence) {
+    const EnvServerConfig config = testConfig("skip");
+    EnvServer server(config);
+    ASSERT_TRUE(server.open());
+
+    CarEnvClient* client = car_env_connect(config.name.c_str(), 1000);
+    ASSERT_NE(client, nullptr);
+    car_env_set_spin(client, 0);
+    // rung twice without an answer: the server is not serving yet, both time out
+    EXPECT_EQ(car_env_ping(client, 0), CAR_ENV_ERR_TIMEOUT);
+    EXPECT_EQ(car_env_ping(client, 0), CAR_ENV_ERR_TIMEOUT);
+
+    ServingThread serving(server);
+    EXPECT_EQ(car_env_ping(client, 2000), CAR_ENV_OK);
+    EXPECT_EQ(car_env_reset(client, 2000), CAR_ENV_OK);
+    EXPECT_EQ(car_env_step(client, 2000), CAR_ENV_OK);
+    car_env_disconnect(client);
+}
+
+TEST(EnvServer, StopAndReconnect) {
+    const EnvServerConfig config = testConfig("stop");
+    EXPECT_EQ(car_env_connect(config.name.c_str(), 0), nullptr);  // no server yet
+
+    EnvServer server(config);
+    ASSERT_TRUE(server.open());
+    ServingThread serving(server);
+
+    // a second client picks up the sequence numbers where the first one left them
+    for (int c = 0; c < 2; ++c) {
+        CarEnvClient* client = car_env_connect(config.name.c_str(), 1000);
+        ASSERT_NE(client, nullptr);
+        car_env_set_spin(client, 0);  // futex path only
+        EXPECT_EQ(car_env_reset(client, 1000), CAR_ENV_OK);
+        EXPECT_EQ(car_env_step(client, 1000), CAR_ENV_OK);
+        car_env_disconnect(client);
+    }
+
+    serving.join();
+    EXPECT_EQ(server.getCommandCount(), 4u);
+}
@@ -0,0 +1,165 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "recording/EpisodeLogReader.h"
+#include "recording/EpisodeLogWriter.h"
+#include "utilities/Randomizer.h"
+
+
+namespace {
+    std::string tempPath(const char* name) {
+        return (std::filesystem::temp_directory_path() / name).string();
+    }
+
+    // expected content of one recorded episode
+    struct Expected {
+        uint32_t envId;
+        VehicleState start;
+        std::vector<EpisodeLogStep> steps;
+    };
+
+    // 3 envs on a lot with interleaved episodes of different lengths; small blocks force several flushes
+    std::vector<Expected> recordRun(const std::string& path, const ParkingLot& lot) {
+        EpisodeLogWriter writer(4096);
+        EpisodeLogInfo info;
+        info.numEnvs = 3;
+        info.seed = 9;
+        EXPECT_TRUE(writer.open(path, info, &lot));
+
+        Randomizer randomizer(info.seed);
+        std::vector<std::unique_ptr<ParkingEnv>> envs;
+        std::vector<Expected> expected;
+        std::vector<Expected> open(info.numEnvs);
+        for (uint32_t i = 0; i < info.numEnvs; ++i) {
+            envs.push_back(std::make_unique<ParkingEnv>(&randomizer));
+            envs[i]->setEnvIndex(i);
+            envs[i]->setLot(&lot);
+            envs[i]->setMaxEpisodeSteps(20 + 15 * i);
+            envs[i]->reset();
+            writer.beginEpisode(i, *envs[i]);
+            open[i] = Expected{i, envs[i]->getVehicleState(), {}};
+        }
+        for (int t = 0; t < 120; ++t) {
+            for (uint32_t i = 0; i < info.numEnvs; ++i) {
+                ParkingEnv& env = *envs[i];
+                const Action action{1.0f, 0.05f * static_cast<float>(i) - 0.05f};
+                Observation obs;
+                StepResult result;
+                env.stepInto(action, info.simDt, obs, result);
+                writer.recordStep(i, env.getVehicleState(), action, result);
+                open[i].steps.push_back(EpisodeLogStep{env.getVehicleState(), action, result.reward, episodeLogFlags(result),
+                                                       static_cast<uint32_t>(open[i].steps.size())});
+                if (!result.done) continue;
+                writer.endEpisode(i);
+                expected.push_back(open[i]);
+                env.reset();
+                writer.beginEpisode(i, env);
+                open[i] = Expected{i, env.getVehicleState(), {}};
+            }
+        }
+        EXPECT_TRUE(writer.close());   // ends the three open episodes in env order
+        for (uint32_t i = 0; i < info.numEnvs; ++i) expected.push_back(open[i]);
+        return expected;
+    }
+
+    void expectEpisodes(const EpisodeLogReader& reader, const std::vector<Expected>& expected) {
+        ASSERT_EQ(reader.getEpisodeCount(), expected.size());
+        uint64_t steps = 0;
+        for (std::size_t k = 0; k < expected.size(); ++k) {
+            const EpisodeLogEpisode& e = reader.getEpisode(k);
+            ASSERT_EQ(e.envId, expected[k].envId);
+            ASSERT_EQ(e.numSteps, expected[k].steps.size());
+            EXPECT_EQ(std::memcmp(&e.start, &expected[k].start, sizeof(VehicleState)), 0);
+            EXPECT_EQ(std::memcmp(reader.getSteps(k), expected[k].steps.data(), e.numSteps * sizeof(EpisodeLogStep)), 0) << "episode " << k;
+            steps += e.numSteps;
+        }
+        EXPECT_EQ(reader.getStepCount(), steps);
+    }
+}
+
+
+// what the writer recorded reads back bit for bit, including the lot
+TEST(EpisodeLog, RoundTrip) {
+    LotLayout layout;
+    layout.aisles = 1;
+    layout.slotsPerRow = 4;
+    const ParkingLot lot = ParkingLot::generate(layout, 2);
+    const std::string path = tempPath("car_test_roundtrip.carlog");
+    const std::vector<Expected> expected = recordRun(path, lot);
+
+    EpisodeLogReader reader;
+    ASSERT_TRUE(reader.open(path));
+    EXPECT_FALSE(reader.isRecovered());
+    EXPECT_EQ(reader.getHeader().numEnvs, 3u);
+    EXPECT_EQ(reader.getHeader().seed, 9u);
+    expectEpisodes(reader, expected);
+
+    // the target slot indexes the recorded lot
+    const EpisodeLogEpisode& e = reader.getEpisode(0);
+    EXPECT_GE(e.targetSlot, 0);
+    EXPECT_LT(static_cast<std::size_t>(e.targetSlot), lot.getSlots().size());
+
+    ParkingLot rebuilt;
+    ASSERT_TRUE(reader.buildLot(rebuilt));
+    ASSERT_EQ(rebuilt.getSlots().size(), lot.getSlots().size());
+    ASSERT_EQ(rebuilt.getObstacles().size(), lot.getObstacles().size());
+    for (std::size_t i = 0; i < lot.getObstacles().size(); ++i) {
+        EXPECT_EQ(std::memcmp(&rebuilt.getObstacles()[i].pose, &lot.getObstacles()[i].pose, sizeof(Transform2D)), 0);
+    }
+    EXPECT_EQ(rebuilt.getFreeSlotCount(), lot.getFreeSlotCount());
+    EXPECT_EQ(std::memcmp(&rebuilt.getBounds(), &lot.getBounds(), sizeof(AABB2D)), 0);
+
+    reader.close();
+    std::remove(path.c_str());
+}
+
+// a log whose writer died keeps every complete episode
+TEST(EpisodeLog, RecoversUnclosedFile) {
+    LotLayout layout;
+    layout.aisles = 1;
+    layout.slotsPerRow = 4;
+    const ParkingLot lot = ParkingLot::generate(layout, 2);
+    const std::string path = tempPath("car_test_recover.carlog");
+    std::vector<Expected> expected = recordRun(path, lot);
+
+    // cut off the index and half of the last episode, clear the index offset as an unclosed writer leaves it
+    std::vector<char> bytes;
+    {
+        std::ifstream in(path, std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+    EpisodeLogHeader header;
+    std::memcpy(&header, bytes.data(), sizeof(header));
+    const std::size_t lastBytes = sizeof(EpisodeLogEpisode) + expected.back().steps.size() * sizeof(EpisodeLogStep);
+    const std::size_t cut = static_cast<std::size_t>(header.indexOffset) - lastBytes / 2;
+    header.indexOffset = 0;
+    header.episodeCount = 0;
+    std::memcpy(bytes.data(), &header, sizeof(header));
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out.write(bytes.data(), static_cast<std::streamsize>(cut));
+    }
+    expected.pop_back();
+
+    EpisodeLogReader reader;
+    ASSERT_TRUE(reader.open(path));
+    EXPECT_TRUE(reader.isRecovered());
+    expectEpisodes(reader, expected);
+
+    reader.close();
+    std::remove(path.c_str());
+
+    // not a log
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out << "tab\tseparated\ttext\n";
+    }
+    EXPECT_FALSE(reader.open(path));
+    std::remove(path.c_str());
+}
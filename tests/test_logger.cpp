@@ -0,0 +1,57 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <string>
+
+#include "utilities/Logger.h"
+
+
+namespace {
+    std::string readAll(std::FILE* f) {
+        std::string text;
+        std::rewind(f);
+        char buf[256];
+        std::size_t n;
+        while ((n = std::fread(buf, 1, sizeof(buf), f)) > 0) text.append(buf, n);
+        return text;
+    }
+}
+
+
+// Messages below the runtime level are skipped, the others reach the sink in order after flush().
+TEST(Logger, RuntimeLevelFiltersMessages) {
+    std::FILE* out = std::tmpfile();
+    ASSERT_NE(out, nullptr);
+
+    Logger& logger = Logger::instance();
+    const LogLevel previousLevel = logger.getLevel();
+    logger.setOutput(out);
+    logger.setLevel(LogLevel::Warn);
+
+    CAR_LOG_INFO("hidden %d", 1);
+    CAR_LOG_WARN("shown %d", 2);
+    CAR_LOG_ERROR("shown %s", "three");
+    logger.flush();
+
+    const std::string text = readAll(out);
+    EXPECT_EQ(text.find("hidden"), std::string::npos);
+    const auto warn = text.find("WARN  [test_logger.cpp:");
+    const auto error = text.find("ERROR [test_logger.cpp:");
+    ASSERT_NE(warn, std::string::npos);
+    ASSERT_NE(error, std::string::npos);
+    EXPECT_LT(warn, error);
+    EXPECT_NE(text.find("shown 2"), std::string::npos);
+    EXPECT_NE(text.find("shown three"), std::string::npos);
+
+    logger.setLevel(previousLevel);
+    logger.setOutput(stdout);
+    std::fclose(out);
+}
+
+TEST(Logger, ParsesLevelNames) {
+    LogLevel level = LogLevel::Info;
+    EXPECT_TRUE(parseLogLevel("off", level));
+    EXPECT_EQ(level, LogLevel::Off);
+    EXPECT_TRUE(parseLogLevel("debug", level));
+    EXPECT_EQ(level, LogLevel::Debug);
+    EXPECT_FALSE(parseLogLevel("verbose", level));
+}
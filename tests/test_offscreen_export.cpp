@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "OffscreenContext.h"
+#include "recording/FrameEncoder.h"
+#include "renderers/FrameReadback.h"
+#include "renderers/SceneRenderer.h"
+
+
+namespace {
+    // RGBA of pixel (x, y) within 1 of the expected color (drivers round differently), y counted from
+    // the bottom row as glReadPixels returns it
+    void expectPixel(const std::vector<uint8_t>& frame, int width, int x, int y, const std::array<int, 4>& rgba) {
+        const std::size_t i = (static_cast<std::size_t>(y) * width + x) * 4;
+        for (std::size_t c = 0; c < 4; ++c) EXPECT_NEAR(frame[i + c], rgba[c], 1) << "pixel " << x << "," << y << " channel " << c;
+    }
+}
+
+
+// raw output: frames in submission order, each flipped to top row first
+TEST(FrameEncoder, RawFramesTopRowFirst) {
+    const std::string path = (std::filesystem::temp_directory_path() / "car_test_frames.rgba").string();
+    FrameEncoderConfig config;
+    config.path = path;
+    config.width = 3;
+    config.height = 2;
+    config.maxQueued = 2;
+
+    FrameEncoder encoder;
+    ASSERT_TRUE(encoder.open(config));
+    for (uint8_t f = 0; f < 5; ++f) {
+        std::vector<uint8_t> frame = encoder.acquire();
+        ASSERT_EQ(frame.size(), 24u);
+        for (std::size_t i = 0; i < frame.size(); ++i) frame[i] = static_cast<uint8_t>(f * 50 + i / 12);  // row index
+        encoder.submit(std::move(frame));
+    }
+    ASSERT_TRUE(encoder.close());
+    EXPECT_EQ(encoder.getFramesWritten(), 5u);
+
+    std::ifstream in(path, std::ios::binary);
+    const std::vector<char> bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    ASSERT_EQ(bytes.size(), 5u * 24u);
+    for (std::size_t f = 0; f < 5; ++f) {
+        EXPECT_EQ(static_cast<uint8_t>(bytes[f * 24]), f * 50 + 1) << "frame " << f;        // top row = last GL row
+        EXPECT_EQ(static_cast<uint8_t>(bytes[f * 24 + 12]), f * 50 + 0) << "frame " << f;
+    }
+    std::remove(path.c_str());
+}
+
+// png output: the path is split at its one frame number conversion, never used as a format string
+TEST(FrameEncoder, PngPathPattern) {
+    if (!FrameEncoder::hasPng()) GTEST_SKIP() << "built without libpng";
+    const std::filesystem::path dir = std::filesystem::temp_directory_path() / "car_test_png_frames";
+    std::filesystem::create_directories(dir);
+    FrameEncoderConfig config;
+    config.format = FrameFormat::Png;
+    config.width = 2;
+    config.height = 2;
+
+    FrameEncoder encoder;
+    for (const char* pattern : {"frame.png", "frame_%s.png", "frame_%d_%d.png", "frame_%x.png", "frame_%-6d.png", "frame_%6d.png", "frame_%"}) {
+        config.path = (dir / pattern).string();
+        EXPECT_FALSE(encoder.open(config)) << pattern;
+    }
+
+    config.path = (dir / "100%%_%04u.png").string();
+    ASSERT_TRUE(encoder.open(config));
+    for (int f = 0; f < 2; ++f) {
+        std::vector<uint8_t> frame = encoder.acquire();
+        std::fill(frame.begin(), frame.end(), static_cast<uint8_t>(255));
+        encoder.submit(std::move(frame));
+    }
+    ASSERT_TRUE(encoder.close());
+    EXPECT_TRUE(std::filesystem::exists(dir / "100%_0000.png"));
+    EXPECT_TRUE(std::filesystem::exists(dir / "100%_0001.png"));
+    std::filesystem::remove_all(dir);
+}
+
+// the scene drawn into the FBO comes back through the PBOs one frame late and equals a synchronous read
+TEST(OffscreenExport, PboReadbackMatchesSyncRead) {
+    OffscreenContext context;
+    if (!context.isValid()) GTEST_SKIP() << "no EGL OpenGL 3.3 context on this machine";
+
+    const int width = 160, height = 120;     // 8 m x 6 m at 20 px/m
+    SceneRenderer scene(width, height, 256);
+    scene.setSlot({100.0f, 100.0f}, 0.0f);   // out of view
+    FrameReadback target(width, height);
+    ASSERT_TRUE(target.isComplete());
+    TrajectoryBuffer trajectory(256);
+
+    VehicleState car{};
+    std::vector<uint8_t> sync(target.getFrameBytes()), async(target.getFrameBytes());
+
+    // frame 0: car in the center
+    target.bind();
+    scene.draw(car, car, 0.0f, trajectory);
+    target.readNow(sync.data());
+    EXPECT_FALSE(target.capture(async.data()));
+    EXPECT_TRUE(target.hasPendingFrame());
+
+    // frame 1: car moved out of view; capture returns frame 0
+    VehicleState away = car;
+    away.pos = {50.0f, 0.0f};
+    target.bind();
+    scene.draw(away, away, 0.0f, trajectory);
+    ASSERT_TRUE(target.capture(async.data()));
+    EXPECT_EQ(async, sync);
+    expectPixel(async, width, width / 2, height / 2, {38, 166, 38, 255});   // car color
+    expectPixel(async, width, 2, 2, {51, 76, 76, 255});                     // background
+
+    // the last frame: background only
+    ASSERT_TRUE(target.finish(async.data()));
+    EXPECT_FALSE(target.hasPendingFrame());
+    expectPixel(async, width, width / 2, height / 2, {51, 76, 76, 255});
+}
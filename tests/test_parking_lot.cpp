@@ -0,0 +1,281 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "envs/ParkingCheck.h"
+#include "envs/ParkingEnv.h"
+#include "envs/VecParkingEnv.h"
+#include "utilities/Randomizer.h"
+#include "world/Collision.h"
+#include "world/ParkingLot.h"
+#include "world/UniformGrid.h"
+
+
+namespace {
+    // 8 aisles x 2 rows x 40 slots = 640 slots
+    ParkingLot makeLot() {
+        LotLayout layout;
+        layout.aisles = 8;
+        layout.slotsPerRow = 40;
+        layout.occupancy = 0.6f;
+        return ParkingLot::generate(layout, 3);
+    }
+
+    int bruteNearest(const ParkingLot& lot, const Position2D& p, bool freeOnly) {
+        int best = -1;
+        float bestD2 = 0.0f;
+        for (std::size_t i = 0; i < lot.getSlots().size(); ++i) {
+            const ParkingSlot& s = lot.getSlots()[i];
+            if (freeOnly && s.occupied) continue;
+            const float dx = s.pose.t.x - p.x, dy = s.pose.t.y - p.y;
+            const float d2 = dx * dx + dy * dy;
+            if (best < 0 || d2 < bestD2) {
+                best = static_cast<int>(i);
+                bestD2 = d2;
+            }
+        }
+        return best;
+    }
+
+    // corners of an oriented box in world frame
+    std::array<Position2D, 4> boxCorners(const Transform2D& t, const Position2D& h) {
+        return {t.apply({h.x, h.y}), t.apply({-h.x, h.y}), t.apply({-h.x, -h.y}), t.apply({h.x, -h.y})};
+    }
+
+    bool segmentsIntersect(const Position2D& p1, const Position2D& p2, const Position2D& q1, const Position2D& q2) {
+        auto cross = [](const Position2D& o, const Position2D& a, const Position2D& b) {
+            return (a.x - o.x) * (b.y - o.y) - (a.y - o.y) * (b.x - o.x);
+        };
+        const float d1 = cross(q1, q2, p1), d2 = cross(q1, q2, p2);
+        const float d3 = cross(p1, p2, q1), d4 = cross(p1, p2, q2);
+        return ((d1 > 0) != (d2 > 0)) && ((d3 > 0) != (d4 > 0));
+    }
+
+    // reference overlap test without SAT: an edge crossing or a corner inside the other box
+    bool referenceOverlap(const Transform2D& a, const Position2D& ha, const Transform2D& b, const Position2D& hb) {
+        const auto ca = boxCorners(a, ha), cb = boxCorners(b, hb);
+        for (int i = 0; i < 4; ++i) {
+            for (int j = 0; j < 4; ++j) {
+                if (segmentsIntersect(ca[i], ca[(i + 1) % 4], cb[j], cb[(j + 1) % 4])) return true;
+            }
+        }
+        const Position2D pa = b.applyInverse(a.t), pb = a.applyInverse(b.t);
+        return (std::fabs(pa.x) <= hb.x && std::fabs(pa.y) <= hb.y) || (std::fabs(pb.x) <= ha.x && std::fabs(pb.y) <= ha.y);
+    }
+}
+
+
+// grid box queries report every overlapping item exactly once
+TEST(UniformGrid, QueryMatchesBruteForce) {
+    Randomizer randomizer(11);
+    std::vector<AABB2D> boxes(500);
+    for (auto& b : boxes) {
+        b.minX = randomizer.randFloat(-50.0f, 50.0f);
+        b.minY = randomizer.randFloat(-50.0f, 50.0f);
+        b.maxX = b.minX + randomizer.randFloat(0.0f, 20.0f);   // some boxes span several cells or leave the bounds
+        b.maxY = b.minY + randomizer.randFloat(0.0f, 20.0f);
+    }
+    UniformGrid grid;
+    grid.build(AABB2D{-50.0f, -50.0f, 50.0f, 50.0f}, 6.0f, boxes.data(), boxes.size());
+
+    for (int q = 0; q < 200; ++q) {
+        AABB2D box;
+        box.minX = randomizer.randFloat(-60.0f, 60.0f);
+        box.minY = randomizer.randFloat(-60.0f, 60.0f);
+        box.maxX = box.minX + randomizer.randFloat(0.0f, 15.0f);
+        box.maxY = box.minY + randomizer.randFloat(0.0f, 15.0f);
+
+        std::vector<uint32_t> got, want;
+        grid.query(box, [&](uint32_t i) { got.push_back(i); });
+        for (uint32_t i = 0; i < boxes.size(); ++i) if (boxes[i].overlaps(box)) want.push_back(i);
+
+        std::sort(got.begin(), got.end());
+        EXPECT_EQ(got, want);
+    }
+}
+
+TEST(ParkingLot, GeneratedLayout) {
+    const ParkingLot lot = makeLot();
+    ASSERT_EQ(lot.getSlots().size(), 640u);
+
+    std::size_t parkedCars = 0;
+    for (const auto& o : lot.getObstacles()) parkedCars += (o.kind == ObstacleKind::ParkedCar) ? 1 : 0;
+    EXPECT_EQ(parkedCars, lot.getSlots().size() - lot.getFreeSlotCount());
+
+    // every slot lies inside the bounds and contains a car parked at its center
+    for (std::size_t i = 0; i < lot.getSlots().size(); ++i) {
+        const ParkingSlot& s = lot.getSlots()[i];
+        EXPECT_TRUE(lot.contains(s.pose.t.x, s.pose.t.y));
+        EXPECT_EQ(lot.slotContaining(s.pose), static_cast<int>(i));
+    }
+}
+
+TEST(ParkingLot, NearestSlotMatchesBruteForce) {
+    const ParkingLot lot = makeLot();
+    const AABB2D& b = lot.getBounds();
+    Randomizer randomizer(5);
+
+    for (int q = 0; q < 1000; ++q) {
+        // include points outside the bounds
+        const Position2D p{randomizer.randFloat(b.minX - 10.0f, b.maxX + 10.0f), randomizer.randFloat(b.minY - 10.0f, b.maxY + 10.0f)};
+        EXPECT_EQ(lot.nearestSlot(p, true), bruteNearest(lot, p, true));
+        EXPECT_EQ(lot.nearestSlot(p, false), bruteNearest(lot, p, false));
+    }
+}
+
+TEST(ParkingLot, SlotContainingMatchesBruteForce) {
+    const ParkingLot lot = makeLot();
+    Randomizer randomizer(9);
+
+    int parkedCount = 0;
+    for (int q = 0; q < 2000; ++q) {
+        // poses around random slots, about half of them inside
+        const ParkingSlot& s = lot.getSlots()[randomizer.randInt(0, static_cast<int>(lot.getSlots().size()) - 1)];
+        const Position2D p = s.pose.apply({randomizer.randFloat(-2.0f, 2.0f), randomizer.randFloat(-1.5f, 1.5f)});
+        const Transform2D car = Transform2D::fromPose(p, s.yaw + randomizer.randFloat(-0.3f, 0.3f));
+
+        int want = -1;
+        for (std::size_t i = 0; i < lot.getSlots().size() && want < 0; ++i) {
+            if (isCarInSlot(car, lot.getSlots()[i].pose)) want = static_cast<int>(i);
+        }
+        EXPECT_EQ(lot.slotContaining(car), want);
+        parkedCount += (want >= 0) ? 1 : 0;
+    }
+    EXPECT_GT(parkedCount, 0);
+}
+
+// envs on a lot start inside it with a free target slot, and VecParkingEnv draws the same episodes as ParkingEnv
+TEST(ParkingLot, EnvsStartOnTheLot) {
+    const ParkingLot lot = makeLot();
+    constexpr std::size_t kNumEnvs = 16;
+
+    Randomizer randomizer(21);
+    VecParkingEnv vecEnv(kNumEnvs, &randomizer);
+    vecEnv.setLot(&lot);
+    vecEnv.reset();
+
+    for (std::size_t i = 0; i < kNumEnvs; ++i) {
+        ParkingEnv env(&randomizer);
+        env.setLot(&lot);
+        env.setEnvIndex(i);
+        env.reset();
+
+        const VehicleState& s = env.getVehicleState();
+        EXPECT_TRUE(lot.contains(s.pos.x, s.pos.y));
+        ASSERT_GE(env.getTargetSlot(), 0);
+        EXPECT_FALSE(lot.getSlots()[env.getTargetSlot()].occupied);
+        EXPECT_EQ(env.getTargetSlot(), lot.nearestSlot(s.pos));
+
+        const VehicleState vs = vecEnv.getVehicleState(i);
+        EXPECT_EQ(vecEnv.getTargetSlot(i), env.getTargetSlot());
+        EXPECT_FLOAT_EQ(vs.pos.x, s.pos.x);
+        EXPECT_FLOAT_EQ(vs.pos.y, s.pos.y);
+        EXPECT_FLOAT_EQ(vs.psi, s.psi);
+    }
+}
+
+// SAT matches an edge/corner reference away from touching contacts, the SoA kernel matches SAT
+TEST(Collision, ObbOverlapMatchesReference) {
+    Randomizer randomizer(17);
+    constexpr std::size_t kBoxes = 1027;  // not a multiple of 4: exercises the scalar tail
+    std::vector<float> x(kBoxes), y(kBoxes), c(kBoxes), s(kBoxes), hx(kBoxes), hy(kBoxes), r(kBoxes);
+    std::vector<Transform2D> poses(kBoxes);
+    for (std::size_t i = 0; i < kBoxes; ++i) {
+        poses[i] = Transform2D::fromPose({randomizer.randFloat(-8.0f, 8.0f), randomizer.randFloat(-8.0f, 8.0f)}, randomizer.randFloat(-PI, PI));
+        x[i] = poses[i].t.x; y[i] = poses[i].t.y; c[i] = poses[i].c; s[i] = poses[i].s;
+        hx[i] = randomizer.randFloat(0.1f, 3.0f);
+        hy[i] = randomizer.randFloat(0.1f, 3.0f);
+        r[i] = std::sqrt(hx[i] * hx[i] + hy[i] * hy[i]);
+    }
+    const OrientedBoxSoA boxes{x.data(), y.data(), c.data(), s.data(), hx.data(), hy.data(), r.data(), kBoxes};
+
+    int overlaps = 0;
+    for (int q = 0; q < 200; ++q) {
+        const Transform2D a = Transform2D::fromPose({randomizer.randFloat(-8.0f, 8.0f), randomizer.randFloat(-8.0f, 8.0f)}, randomizer.randFloat(-PI, PI));
+        const Position2D ha{CAR_LENGTH * 0.5f, CAR_WIDTH * 0.5f};
+
+        for (std::size_t i = 0; i < kBoxes; ++i) {
+            const bool sat = obbOverlap(a, ha, poses[i], {hx[i], hy[i]});
+            EXPECT_EQ(sat, referenceOverlap(a, ha, poses[i], {hx[i], hy[i]}));
+            EXPECT_EQ(anyOverlap(a, ha, boxes, i, i + 1), sat);  // scalar path
+            overlaps += sat ? 1 : 0;
+        }
+
+        // 4-wide path over blocks
+        for (std::size_t i = 0; i + 8 <= kBoxes; i += 8) {
+            bool want = false;
+            for (std::size_t k = i; k < i + 8; ++k) want = want || obbOverlap(a, ha, poses[k], {hx[k], hy[k]});
+            EXPECT_EQ(anyOverlap(a, ha, boxes, i, i + 8), want);
+        }
+    }
+    EXPECT_GT(overlaps, 0);
+}
+
+TEST(Collision, CarAgainstLot) {
+    const ParkingLot lot = makeLot();
+
+    // a car on a parked car collides, a car centered in a free slot does not
+    for (std::size_t i = 0; i < lot.getSlots().size(); ++i) {
+        const ParkingSlot& slot = lot.getSlots()[i];
+        EXPECT_EQ(lot.carCollides(slot.pose), slot.occupied);
+    }
+
+    // batched check matches the single-car check
+    Randomizer randomizer(23);
+    const AABB2D& b = lot.getBounds();
+    constexpr std::size_t kCars = 4096;
+    std::vector<float> x(kCars), y(kCars), psi(kCars);
+    std::vector<uint8_t> contact(kCars);
+    for (std::size_t i = 0; i < kCars; ++i) {
+        x[i] = randomizer.randFloat(b.minX, b.maxX);
+        y[i] = randomizer.randFloat(b.minY, b.maxY);
+        psi[i] = randomizer.randFloat(-PI, PI);
+    }
+    lot.collideBatch(x.data(), y.data(), psi.data(), kCars, contact.data());
+
+    std::size_t hits = 0, mismatches = 0;
+    for (std::size_t i = 0; i < kCars; ++i) {
+        const bool want = lot.carCollides(Transform2D::fromPose({x[i], y[i]}, psi[i]));
+        mismatches += (want != (contact[i] != 0)) ? 1 : 0;  // fastSinCos may flip a grazing contact
+        hits += want ? 1 : 0;
+    }
+    EXPECT_LE(mismatches, 2u);
+    EXPECT_GT(hits, 0u);
+
+    // against every obstacle by brute force
+    for (std::size_t i = 0; i < 512; ++i) {
+        const Transform2D car = Transform2D::fromPose({x[i], y[i]}, psi[i]);
+        bool want = false;
+        for (const auto& o : lot.getObstacles()) want = want || obbOverlap(car, {CAR_LENGTH * 0.5f, CAR_WIDTH * 0.5f}, o.pose, o.halfExtents);
+        EXPECT_EQ(lot.carCollides(car), want);
+    }
+}
+
+// driving straight out of the aisle into the slot row ends the episode with a collision or a parked car
+TEST(Collision, EnvTerminatesOnContact) {
+    const ParkingLot lot = makeLot();
+    Randomizer randomizer(2);
+
+    int collisions = 0;
+    for (uint64_t e = 0; e < 32; ++e) {
+        ParkingEnv env(&randomizer);
+        env.setLot(&lot);
+        env.setEnvIndex(e);
+        env.reset();
+
+        StepResult result;
+        Observation obs;
+        for (int t = 0; t < 2000 && !result.done; ++t) {
+            env.stepInto(Action{1.0f, 0.3f}, 0.01f, obs, result);
+        }
+        ASSERT_TRUE(result.terminated);
+        if (result.collided) {
+            ++collisions;
+            EXPECT_FLOAT_EQ(result.reward, -COLLISION_PENALTY);
+        }
+    }
+    EXPECT_GT(collisions, 0);
+}
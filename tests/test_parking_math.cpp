@@ -7,6 +7,7 @@
 #include "vehicledynamics/VehicleTypes.h"
 #include "utilities/Randomizer.h"
 #include "utilities/MathUtils.h"
+#include "utilities/Transform2D.h"
 
 
 // temporal function for temporary
@@ -162,3 +163,134 @@ TEST(ParkingEnvObs, CarFrameVectors_CarYaw90_SlotYaw90) {
         ExpectPosNear(got[i], expected[i]);
     }
 }
+
+// stepInto gives the same state, observation and reward as step, without touching the action,
+// and the flat writer uses the documented OBS_FLAT_SIZE layout.
+TEST(ParkingEnvStep, StepIntoMatchesStep) {
+    Randomizer randomizerA(5), randomizerB(5);
+    ParkingEnv envA(&randomizerA), envB(&randomizerB);
+    envA.reset();
+    envB.reset();
+
+    for (int t = 0; t < 100; ++t) {
+        Action a{3.0f, 1.0f};  // beyond the limits, clamped internally
+        const Action input = a;
+        const Observation obsA = envA.step(a, 0.01f);
+
+        Observation obsB;
+        StepResult result;
+        envB.stepInto(input, 0.01f, obsB, result);
+
+        EXPECT_EQ(obsA.vehicleState.pos.x, obsB.vehicleState.pos.x);
+        EXPECT_EQ(obsA.vehicleState.pos.y, obsB.vehicleState.pos.y);
+        EXPECT_EQ(obsA.vehicleState.psi, obsB.vehicleState.psi);
+        for (int k = 0; k < 4; ++k) ExpectPosNear(obsA.distCorners[k], obsB.distCorners[k]);
+        EXPECT_EQ(envA.getReward(), result.reward);
+    }
+
+    float flat[OBS_FLAT_SIZE];
+    envB.writeObservation(flat);
+    const Observation obs = envB.getObservation();
+    for (int k = 0; k < 4; ++k) {
+        EXPECT_EQ(flat[2 * k], obs.distCorners[k].x);
+        EXPECT_EQ(flat[2 * k + 1], obs.distCorners[k].y);
+    }
+    EXPECT_EQ(flat[8], obs.vehicleState.pos.x);
+    EXPECT_EQ(flat[9], obs.vehicleState.pos.y);
+    EXPECT_EQ(flat[10], obs.vehicleState.psi);
+    EXPECT_EQ(flat[11], obs.vehicleState.velocity);
+    EXPECT_EQ(flat[12], obs.vehicleState.delta);
+}
+
+// One stepInto with an action repeat of K ends in the same state as K single steps.
+TEST(ParkingEnvStep, ActionRepeatMatchesRepeatedSteps) {
+    constexpr int kRepeat = 10;
+    Randomizer randomizerA(8), randomizerB(8);
+    ParkingEnv envA(&randomizerA), envB(&randomizerB);
+    envB.setActionRepeat(kRepeat);
+    envA.reset();
+    envB.reset();
+
+    Randomizer policy(3);
+    for (int t = 0; t < 20; ++t) {
+        const Action action{policy.randFloat(-1.0f, 1.0f), policy.randFloat(-0.7f, 0.7f)};
+
+        Observation obsA, obsB;
+        StepResult resultA, resultB;
+        for (int k = 0; k < kRepeat && !resultA.done; ++k) envA.stepInto(action, 0.01f, obsA, resultA);
+        envB.stepInto(action, 0.01f, obsB, resultB);
+
+        EXPECT_EQ(obsA.vehicleState.pos.x, obsB.vehicleState.pos.x);
+        EXPECT_EQ(obsA.vehicleState.pos.y, obsB.vehicleState.pos.y);
+        EXPECT_EQ(obsA.vehicleState.psi, obsB.vehicleState.psi);
+        EXPECT_EQ(obsA.vehicleState.velocity, obsB.vehicleState.velocity);
+        EXPECT_EQ(resultA.done, resultB.done);
+        if (!resultB.done) {
+            EXPECT_EQ(resultB.substeps, kRepeat);
+        }
+    }
+}
+
+// The episode is truncated after the max episode steps and the counter restarts on reset.
+TEST(ParkingEnvStep, TruncatesAtMaxEpisodeSteps) {
+    Randomizer randomizer(12);
+    ParkingEnv env(&randomizer);
+    env.setMaxEpisodeSteps(5);
+    env.reset();
+
+    Observation obs;
+    StepResult result;
+    for (int t = 1; t <= 5; ++t) {
+        env.stepInto(Action{0.0f, 0.0f}, 0.01f, obs, result);
+        if (result.terminated) GTEST_SKIP() << "car spawned inside the slot";
+        EXPECT_EQ(result.truncated, t == 5);
+        EXPECT_EQ(result.done, t == 5);
+    }
+    EXPECT_EQ(env.getEpisodeStep(), 5u);
+    env.reset();
+    EXPECT_EQ(env.getEpisodeStep(), 0u);
+    EXPECT_FALSE(env.getLastResult().done);
+}
+
+
+// Transform2D: compose/inverse round trip and agreement with the per-point trig formulas
+TEST(Transform2D, ComposeInverseRoundTrip) {
+    const Transform2D a = Transform2D::fromPose({3.0f, -2.0f}, 0.7f);
+    const Transform2D b = Transform2D::fromPose({-1.5f, 4.0f}, -2.3f);
+    const Position2D p{0.8f, -1.9f};
+
+    // (a * b)(p) == a(b(p))
+    ExpectPosNear(a.compose(b).apply(p), a.apply(b.apply(p)));
+
+    // inverse undoes apply, and matches applyInverse
+    ExpectPosNear(a.inverse().apply(a.apply(p)), p);
+    ExpectPosNear(a.inverse().apply(p), a.applyInverse(p));
+
+    // a^-1 * b carries the relative heading
+    EXPECT_NEAR(a.inverse().compose(b).yaw(), wrapPi(-2.3f - 0.7f), kEps);
+}
+
+TEST(Transform2D, ApplyNMatchesTrig) {
+    const float yaw = 1.1f;
+    const Position2D t{2.0f, 5.0f};
+    const Transform2D tf = Transform2D::fromPose(t, yaw);
+
+    std::array<Position2D, 4> in{{{1.0f, 0.5f}, {-2.0f, 3.0f}, {0.0f, -1.0f}, {4.0f, 4.0f}}};
+    std::array<Position2D, 4> out{};
+    std::array<float, 4> inX{}, inY{}, outX{}, outY{};
+    for (int k = 0; k < 4; ++k) { inX[k] = in[k].x; inY[k] = in[k].y; }
+
+    tf.applyN(in.data(), out.data(), in.size());
+    tf.applyN(inX.data(), inY.data(), outX.data(), outY.data(), in.size());
+
+    for (int k = 0; k < 4; ++k) {
+        const Position2D ref{t.x + in[k].x * std::cos(yaw) - in[k].y * std::sin(yaw),
+                             t.y + in[k].x * std::sin(yaw) + in[k].y * std::cos(yaw)};
+        ExpectPosNear(out[k], ref);
+        ExpectPosNear(Position2D{outX[k], outY[k]}, ref);
+    }
+
+    // back to the local frame
+    tf.applyInverseN(out.data(), out.data(), out.size());
+    for (int k = 0; k < 4; ++k) ExpectPosNear(out[k], in[k]);
+}
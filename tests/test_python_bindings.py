@@ -0,0 +1,68 @@
+"""Smoke test of the car_sim module (CAR_BUILD_PYTHON=ON), run by ctest with PYTHONPATH at the module."""
+import gc
+import unittest
+
+import numpy as np
+
+import car_sim
+
+
+class VecParkingEnvTest(unittest.TestCase):
+    def test_views_share_the_env_buffers(self):
+        env = car_sim.VecParkingEnv(16, seed=3, max_episode_steps=5)
+        obs, actions, rewards = env.obs, env.actions, env.rewards
+        self.assertEqual(obs.shape, (16, car_sim.OBS_SIZE))
+        self.assertEqual(actions.shape, (16, car_sim.ACTION_SIZE))
+        self.assertEqual(env.terminated.dtype, np.bool_)
+        self.assertFalse(obs.flags.writeable)
+        self.assertTrue(actions.flags.writeable)
+
+        # drive forward: the views taken before the steps see the new state, no copies
+        x0 = obs[:, 8].copy()
+        actions[:] = (1.0, 0.0)
+        for _ in range(4):
+            env.step()
+        self.assertTrue(np.all(obs[:, 8] > x0))
+        self.assertIs(env.obs.base, obs.base)
+
+        # the fifth step truncates the envs (auto-reset), their last state is kept in final_obs
+        env.step()
+        self.assertTrue(env.truncated.any())
+        self.assertTrue(np.all(env.final_obs[env.truncated, 11] > 0.0))
+
+    def test_views_keep_the_env_alive(self):
+        obs = car_sim.VecParkingEnv(4, seed=1).obs
+        self.assertIsInstance(obs.base, car_sim.VecParkingEnv)
+        self.assertTrue(np.all(np.isfinite(obs)))
+
+        # a view outlives the name of the env: its base is the env, which can still step
+        env = car_sim.VecParkingEnv(4, seed=1)
+        actions = env.actions
+        del env
+        gc.collect()
+        actions[:] = (1.0, 0.0)
+        actions.base.step()
+        self.assertEqual(len(actions.base), 4)
+        self.assertTrue(np.all(actions.base.obs[:, 11] > 0.0))
+
+    def test_invalid_arguments(self):
+        with self.assertRaises(ValueError):
+            car_sim.VecParkingEnv(0)
+        with self.assertRaises(TypeError):
+            car_sim.VecParkingEnv(4, no_such_setting=1)
+        env = car_sim.VecParkingEnv(2, seed=1)
+        with self.assertRaises(RuntimeError):
+            env.__init__(2)
+        self.assertEqual(len(env), 2)
+
+    def test_sensors(self):
+        env = car_sim.VecParkingEnv(8, seed=2, lot_aisles=2, lidar_beams=32, bev_size=64)
+        self.assertEqual(env.ranges.shape, (8, 32))
+        self.assertEqual(env.bev.shape, (8, car_sim.BEV_CHANNELS, 64, 64))
+        env.step()
+        self.assertTrue(np.all(env.ranges <= 10.0))
+        self.assertTrue(np.all(env.bev[:, 3].sum(axis=(1, 2)) > 0))  # ego footprint
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -0,0 +1,179 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include "envs/ParkingEnv.h"
+#include "envs/VecParkingEnv.h"
+#include "sensors/RangeSensor.h"
+#include "utilities/FastMath.h"
+#include "utilities/Randomizer.h"
+#include "world/ParkingLot.h"
+
+
+namespace {
+    // ranges of all beams against every obstacle of the lot
+    std::vector<float> bruteScan(const RangeSensor& sensor, const ParkingLot& lot, const Transform2D& car) {
+        const Transform2D s = car.compose(sensor.getConfig().mount);
+        std::vector<float> ranges(sensor.getBeams(), sensor.getMaxRange());
+        for (int k = 0; k < sensor.getBeams(); ++k) {
+            const Transform2D beam = s.compose(Transform2D::fromPose({0.0f, 0.0f}, sensor.beamAngle(k)));
+            for (const Obstacle& o : lot.getObstacles()) {
+                ranges[k] = std::min(ranges[k], rayBoxDistance(s.t, beam.c, beam.s, o.pose, o.halfExtents));
+            }
+        }
+        return ranges;
+    }
+}
+
+
+TEST(RangeSensor, BeamLayout) {
+    RangeSensor full(RangeSensorConfig{8, 10.0f, 2.0f * PI, {}});
+    EXPECT_NEAR(full.beamAngle(0), -PI, 1e-6f);
+    EXPECT_NEAR(full.beamAngle(4), 0.0f, 1e-6f);
+
+    RangeSensor front(RangeSensorConfig{3, 10.0f, PI, {}});
+    EXPECT_NEAR(front.beamAngle(0), -0.5f * PI, 1e-6f);
+    EXPECT_NEAR(front.beamAngle(1), 0.0f, 1e-6f);
+    EXPECT_NEAR(front.beamAngle(2), 0.5f * PI, 1e-6f);
+
+    // no lot: nothing to hit
+    float ranges[8];
+    full.scan(nullptr, Transform2D{}, ranges);
+    for (float r : ranges) EXPECT_FLOAT_EQ(r, 10.0f);
+}
+
+TEST(RangeSensor, SingleBox) {
+    ParkingLot lot;
+    lot.addObstacle(Obstacle{Transform2D::fromPose({5.0f, 0.0f}, 0.0f), {1.0f, 1.0f}, ObstacleKind::ParkedCar});
+    lot.build(AABB2D{-20.0f, -20.0f, 20.0f, 20.0f}, 5.0f);
+
+    // sensor 1 m in front of the car center
+    RangeSensorConfig config{8, 10.0f, 2.0f * PI, Transform2D::fromPose({1.0f, 0.0f}, 0.0f)};
+    RangeSensor sensor(config);
+    float ranges[8];
+    sensor.scan(&lot, Transform2D{}, ranges);
+    EXPECT_NEAR(ranges[4], 3.0f, 1e-5f);     // forward
+    EXPECT_FLOAT_EQ(ranges[0], 10.0f);       // backward
+    EXPECT_FLOAT_EQ(ranges[5], 10.0f);       // 45 deg left passes above the box
+
+    // car above the box heading +y: sensor at (5, 6), the backward beam hits the box top at y = 1
+    sensor.scan(&lot, Transform2D::fromPose({5.0f, 5.0f}, PI * 0.5f), ranges);
+    EXPECT_NEAR(ranges[0], 5.0f, 1e-4f);
+    EXPECT_FLOAT_EQ(ranges[4], 10.0f);
+}
+
+TEST(RangeSensor, MatchesBruteForce) {
+    LotLayout layout;
+    layout.aisles = 4;
+    layout.slotsPerRow = 20;
+    const ParkingLot lot = ParkingLot::generate(layout, 5);
+
+    const RangeSensorConfig configs[] = {
+        {64, 10.0f, 2.0f * PI, {}},
+        {31, 15.0f, 1.5f * PI, Transform2D::fromPose({1.2f, 0.3f}, 0.2f)},
+    };
+    for (const RangeSensorConfig& config : configs) {
+        const RangeSensor sensor(config);
+        const std::size_t n = 200, beams = static_cast<std::size_t>(sensor.getBeams());
+
+        Randomizer randomizer(9);
+        const AABB2D& b = lot.getBounds();
+        std::vector<float> x(n), y(n), psi(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            x[i] = randomizer.randFloat(b.minX, b.maxX);
+            y[i] = randomizer.randFloat(b.minY, b.maxY);
+            psi[i] = randomizer.randFloat(-PI, PI);
+        }
+        std::vector<float> ranges(n * beams);
+        sensor.scanBatch(&lot, x.data(), y.data(), psi.data(), n, ranges.data());
+
+        for (std::size_t i = 0; i < n; ++i) {
+            Transform2D car{1.0f, 0.0f, {x[i], y[i]}};
+            fastSinCos(psi[i], car.s, car.c);
+            const std::vector<float> ref = bruteScan(sensor, lot, car);
+            for (std::size_t k = 0; k < beams; ++k) {
+                ASSERT_NEAR(ranges[i * beams + k], ref[k], 1e-3f) << "car " << i << " beam " << k;
+            }
+        }
+    }
+}
+
+TEST(RangeSensor, RotatedObstaclesMatchBruteForce) {
+    // axis-aligned and rotated boxes (sector path) on the sensor grid, beam counts that leave an SSE2 tail
+    ParkingLot lot;
+    Randomizer randomizer(12);
+    for (int i = 0; i < 60; ++i) {
+        const float yaw = (i % 3 == 0) ? randomizer.randFloat(-PI, PI) : (i % 3) * 0.5f * PI;
+        const Position2D pos{randomizer.randFloat(-25.0f, 25.0f), randomizer.randFloat(-25.0f, 25.0f)};
+        const Position2D half{randomizer.randFloat(0.2f, 3.0f), randomizer.randFloat(0.2f, 1.5f)};
+        lot.addObstacle(Obstacle{Transform2D::fromPose(pos, yaw), half, ObstacleKind::ParkedCar});
+    }
+    lot.build(AABB2D{-20.0f, -20.0f, 20.0f, 20.0f}, 5.0f);
+    EXPECT_FALSE(lot.isAxisAligned(0));
+    EXPECT_TRUE(lot.isAxisAligned(1));
+    EXPECT_TRUE(lot.isAxisAligned(2));
+
+    const RangeSensorConfig configs[] = {
+        {12, 10.0f, 2.0f * PI, {}},
+        {1, 8.0f, 2.0f * PI, Transform2D::fromPose({1.0f, 0.0f}, 0.3f)},
+        {5, 10.0f, 0.0f, {}},
+        {37, 6.0f, 0.8f * PI, Transform2D::fromPose({1.2f, -0.3f}, -0.4f)},
+    };
+    for (const RangeSensorConfig& config : configs) {
+        const RangeSensor sensor(config);
+        std::vector<float> ranges(sensor.getBeams());
+        for (int i = 0; i < 300; ++i) {
+            const Transform2D car = Transform2D::fromPose({randomizer.randFloat(-35.0f, 35.0f), randomizer.randFloat(-35.0f, 35.0f)},
+                                                          randomizer.randFloat(-PI, PI));
+            sensor.scan(&lot, car, ranges.data());
+            const std::vector<float> ref = bruteScan(sensor, lot, car);
+            for (int k = 0; k < sensor.getBeams(); ++k) {
+                ASSERT_NEAR(ranges[k], ref[k], 1e-3f) << "beams " << config.beams << " car " << i << " beam " << k;
+            }
+        }
+    }
+}
+
+TEST(RangeSensor, VecEnvMatchesParkingEnv) {
+    LotLayout layout;
+    layout.aisles = 3;
+    layout.slotsPerRow = 12;
+    const ParkingLot lot = ParkingLot::generate(layout, 2);
+    const RangeSensorConfig config{32, 12.0f, 2.0f * PI, {}};
+    constexpr std::size_t kEnvs = 8;
+
+    Randomizer vecRandomizer(4);
+    VecParkingEnv vec(kEnvs, &vecRandomizer, 0.01f);
+    vec.setLot(&lot);
+    vec.setRangeSensor(config);
+    vec.reset();
+
+    std::vector<Action> actions(kEnvs, Action{0.4f, 1.0f});
+    std::vector<Observation> obs(kEnvs);
+    std::vector<float> rewards(kEnvs);
+    std::vector<uint8_t> dones(kEnvs);
+    for (int s = 0; s < 20; ++s) vec.step(actions.data(), obs.data(), rewards.data(), dones.data());
+
+    Randomizer randomizer(4);
+    for (std::size_t i = 0; i < kEnvs; ++i) {
+        ParkingEnv env(&randomizer);
+        env.setLot(&lot);
+        env.setEnvIndex(i);
+        env.setRangeSensor(config);
+        env.reset();
+        for (int s = 0; s < 20; ++s) {
+            StepResult result;
+            Observation o;
+            env.stepInto(actions[i], 0.01f, o, result);
+        }
+
+        // the envs use std:: vs polynomial trig for the heading, so allow a grazing beam to differ
+        int mismatches = 0;
+        for (int k = 0; k < config.beams; ++k) {
+            if (std::fabs(vec.getRanges(i)[k] - env.getRanges()[k]) > 1e-3f) ++mismatches;
+        }
+        EXPECT_LE(mismatches, 1) << "env " << i;
+    }
+}
@@ -0,0 +1,145 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "recording/EpisodeLogWriter.h"
+#include "simulator/ReplayPlayer.h"
+#include "utilities/Randomizer.h"
+
+
+namespace {
+    // one env, two episodes cut by the step limit; returns the states of each episode (index 0 = after reset)
+    std::vector<std::vector<VehicleState>> recordEpisodes(const std::string& path, const ParkingLot& lot) {
+        EpisodeLogWriter writer;
+        EpisodeLogInfo info;
+        info.actionRepeat = 2;
+        EXPECT_TRUE(writer.open(path, info, &lot));
+
+        Randomizer randomizer(5);
+        ParkingEnv env(&randomizer);
+        env.setLot(&lot);
+        env.setActionRepeat(info.actionRepeat);
+        env.setMaxEpisodeSteps(60);
+        std::vector<std::vector<VehicleState>> states;
+        for (int e = 0; e < 2; ++e) {
+            env.reset();
+            writer.beginEpisode(0, env);
+            states.push_back({env.getVehicleState()});
+            StepResult result;
+            while (!result.done) {
+                const Action action{0.6f, 0.2f};
+                Observation obs;
+                env.stepInto(action, info.simDt, obs, result);
+                writer.recordStep(0, env.getVehicleState(), action, result);
+                states.back().push_back(env.getVehicleState());
+            }
+            writer.endEpisode(0);
+        }
+        EXPECT_TRUE(writer.close());
+        return states;
+    }
+
+    void expectState(const VehicleState& a, const VehicleState& b) {
+        EXPECT_EQ(std::memcmp(&a, &b, sizeof(VehicleState)), 0);
+    }
+}
+
+
+// seeking and playing show exactly the recorded states
+TEST(ReplayPlayer, SeekAndPlayback) {
+    LotLayout layout;
+    layout.aisles = 1;
+    layout.slotsPerRow = 4;
+    const ParkingLot lot = ParkingLot::generate(layout, 3);
+    const std::string path = (std::filesystem::temp_directory_path() / "car_test_replay.carlog").string();
+    const std::vector<std::vector<VehicleState>> states = recordEpisodes(path, lot);
+
+    ReplayPlayer player(1024);
+    ASSERT_TRUE(player.open(path));
+    ASSERT_EQ(player.getEpisodeCount(), 2u);
+    ASSERT_TRUE(player.hasLot());
+    EXPECT_EQ(player.getLot().getObstacles().size(), lot.getObstacles().size());
+    EXPECT_NEAR(player.getStepDt(), 0.02, 1e-6);
+    ASSERT_EQ(player.getNumSteps() + 1, states[0].size());
+
+    // random access
+    for (std::size_t i : {std::size_t{40}, std::size_t{0}, std::size_t{17}, states[0].size() - 1}) {
+        player.seek(static_cast<double>(i));
+        EXPECT_EQ(player.getStep(), i);
+        expectState(player.stateAt(i), states[0][i]);
+        expectState(player.getPrevState(), states[0][std::min(i, player.getNumSteps() - 1)]);
+    }
+    player.seek(12.25);
+    expectState(player.getPrevState(), states[0][12]);
+    expectState(player.getCurState(), states[0][13]);
+    EXPECT_FLOAT_EQ(player.getAlpha(), 0.25f);
+
+    // 0.1 s at speed 2 covers 10 steps of 20 ms
+    player.seek(0.0);
+    player.setSpeed(2.0);
+    player.advance(0.1);
+    EXPECT_EQ(player.getStep(), 10u);
+    EXPECT_FALSE(player.isPaused());
+
+    // playback stops at the end, resuming starts over
+    player.advance(10.0);
+    EXPECT_TRUE(player.isPaused());
+    EXPECT_EQ(player.getStep(), player.getNumSteps());
+    ASSERT_NE(player.getCurrentRecord(), nullptr);
+    EXPECT_TRUE(player.getCurrentRecord()->flags & EPISODE_LOG_TRUNCATED);
+    player.setPaused(false);
+    EXPECT_EQ(player.getStep(), 0u);
+
+    // reverse play and single steps
+    player.seek(30.0);
+    player.setSpeed(-1.0);
+    player.advance(0.09);
+    EXPECT_NEAR(player.getCursor(), 25.5, 1e-5);
+    player.stepFrames(-5);
+    EXPECT_TRUE(player.isPaused());
+    EXPECT_EQ(player.getStep(), 20u);
+    player.advance(1.0);
+    EXPECT_EQ(player.getStep(), 20u);
+
+    // second episode, out of range is rejected
+    ASSERT_TRUE(player.selectEpisode(1));
+    EXPECT_EQ(player.getNumSteps() + 1, states[1].size());
+    expectState(player.getCurState(), states[1][1]);
+    expectState(player.getPrevState(), states[1][0]);
+    EXPECT_FALSE(player.selectEpisode(2));
+    EXPECT_EQ(player.getEpisodeIndex(), 1u);
+
+    player.close();
+    std::remove(path.c_str());
+}
+
+// the path follows the cursor: extended while playing forward, rebuilt after a backward seek
+TEST(ReplayPlayer, TrajectoryFollowsCursor) {
+    LotLayout layout;
+    layout.aisles = 1;
+    layout.slotsPerRow = 4;
+    const ParkingLot lot = ParkingLot::generate(layout, 3);
+    const std::string path = (std::filesystem::temp_directory_path() / "car_test_replay_path.carlog").string();
+    const std::vector<std::vector<VehicleState>> states = recordEpisodes(path, lot);
+
+    ReplayPlayer player(1024);
+    ASSERT_TRUE(player.open(path));
+    player.seek(50.0);
+    const std::size_t atFifty = player.getTrajectory().size();
+    EXPECT_GT(atFifty, 1u);
+    EXPECT_NEAR(player.getTrajectory().back().x, states[0][50].pos.x, 0.01f);
+
+    player.seek(20.0);
+    EXPECT_LT(player.getTrajectory().size(), atFifty);
+    EXPECT_NEAR(player.getTrajectory().back().x, states[0][20].pos.x, 0.01f);
+
+    player.seek(50.0);
+    EXPECT_EQ(player.getTrajectory().size(), atFifty);
+
+    player.close();
+    std::remove(path.c_str());
+}
@@ -0,0 +1,88 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <vector>
+
+#include "rollout/RolloutRunner.h"
+#include "utilities/WorkStealingPool.h"
+
+
+// every task runs exactly once, whichever worker executes it
+TEST(WorkStealingPool, RunsEveryTaskOnce) {
+    WorkStealingPool pool(4);
+    std::vector<std::atomic<int>> hits(1000);
+
+    for (int round = 0; round < 3; ++round) {
+        pool.parallelFor(hits.size(), [&](std::size_t task, std::size_t worker) {
+            EXPECT_LT(worker, pool.size());
+            hits[task].fetch_add(1);
+        });
+    }
+    for (const auto& h : hits) EXPECT_EQ(h.load(), 3);
+}
+
+// transitions are chained per env and carry the policy's actions
+TEST(RolloutRunner, RecordsChainedTransitions) {
+    RolloutConfig config;
+    config.numEnvs = 10;
+    config.shardSize = 3;
+    config.stepsPerRun = 4;
+    config.numThreads = 2;
+    config.maxEpisodeSteps = 3;
+
+    RolloutRunner runner(config);
+    runner.reset();
+    runner.run([](std::size_t firstEnv, const Observation*, Action* actions, std::size_t count) {
+        for (std::size_t i = 0; i < count; ++i) {
+            actions[i] = Action{0.5f, 0.01f * static_cast<float>(firstEnv + i)};
+        }
+    });
+
+    uint64_t steps = 0;
+    for (const auto& s : runner.getWorkerStats()) steps += s.steps;
+    EXPECT_EQ(steps, config.numEnvs * config.stepsPerRun);
+
+    for (std::size_t e = 0; e < config.numEnvs; ++e) {
+        for (std::size_t t = 0; t < config.stepsPerRun; ++t) {
+            const Transition& tr = runner.getTransition(e, t);
+            EXPECT_EQ(tr.envIndex, e);
+            EXPECT_EQ(tr.step, t);
+            EXPECT_FLOAT_EQ(tr.action.steeringAngle, 0.01f * static_cast<float>(e));
+            if (t > 0) {
+                const Transition& prev = runner.getTransition(e, t - 1);
+                if (prev.terminated || prev.truncated) {
+                    // the env was reset after the previous step
+                    EXPECT_FLOAT_EQ(tr.obs.vehicleState.velocity, 0.0f);
+                } else {
+                    EXPECT_FLOAT_EQ(tr.obs.vehicleState.pos.x, prev.nextObs.vehicleState.pos.x);
+                    EXPECT_FLOAT_EQ(tr.obs.vehicleState.velocity, prev.nextObs.vehicleState.velocity);
+                }
+            }
+            // the third step of an episode is truncated unless it terminated before
+            if (t == 2 && !runner.getTransition(e, 0).terminated && !runner.getTransition(e, 1).terminated) {
+                EXPECT_TRUE(tr.truncated || tr.terminated);
+            }
+        }
+    }
+}
+
+// transitions record the action the env applied, i.e. the policy's action clamped to the model limits
+TEST(RolloutRunner, RecordsClampedActions) {
+    RolloutConfig config;
+    config.numEnvs = 4;
+    config.shardSize = 2;
+    config.stepsPerRun = 2;
+    config.numThreads = 1;
+
+    RolloutRunner runner(config);
+    runner.reset();
+    runner.run([](std::size_t, const Observation*, Action* actions, std::size_t count) {
+        for (std::size_t i = 0; i < count; ++i) actions[i] = Action{100.0f, -100.0f};
+    });
+
+    const BicycleModelLimits limits;
+    for (std::size_t e = 0; e < config.numEnvs; ++e) {
+        const Transition& tr = runner.getTransition(e, 0);
+        EXPECT_FLOAT_EQ(tr.action.acceleration, limits.a_max);
+        EXPECT_FLOAT_EQ(tr.action.steeringAngle, -limits.delta_max);
+    }
+}
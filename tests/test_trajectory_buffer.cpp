@@ -0,0 +1,31 @@
+#include <gtest/gtest.h>
+
+#include "simulator/TrajectoryBuffer.h"
+
+
+// Points are returned oldest first, and once full the oldest point is overwritten.
+TEST(TrajectoryBuffer, WrapsAndKeepsOrder) {
+    TrajectoryBuffer traj(4);
+    for (int i = 0; i < 3; ++i) traj.push(TrajectoryPoint{static_cast<float>(i), 0.0f, 0.0f});
+    EXPECT_EQ(traj.size(), 3u);
+    EXPECT_EQ(traj.getHead(), 3u);
+    EXPECT_FLOAT_EQ(traj[0].x, 0.0f);
+    EXPECT_FLOAT_EQ(traj.back().x, 2.0f);
+
+    for (int i = 3; i < 10; ++i) traj.push(TrajectoryPoint{static_cast<float>(i), 0.0f, 0.0f});
+    EXPECT_EQ(traj.size(), 4u);
+    EXPECT_EQ(traj.capacity(), 4u);
+    EXPECT_EQ(traj.getTotalPushed(), 10u);
+    for (std::size_t i = 0; i < traj.size(); ++i) {
+        EXPECT_FLOAT_EQ(traj[i].x, static_cast<float>(6 + i));
+    }
+    EXPECT_FLOAT_EQ(traj.back().x, 9.0f);
+
+    // clear keeps the push counter so a GPU mirror can still detect new slots
+    traj.clear();
+    EXPECT_TRUE(traj.empty());
+    EXPECT_EQ(traj.getTotalPushed(), 10u);
+    traj.push(TrajectoryPoint{42.0f, 0.0f, 0.0f});
+    EXPECT_FLOAT_EQ(traj[0].x, 42.0f);
+    EXPECT_EQ(traj.getHead(), 1u);
+}
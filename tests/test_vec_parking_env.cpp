@@ -0,0 +1,185 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <vector>
+
+#include "envs/ParkingEnv.h"
+#include "envs/VecParkingEnv.h"
+#include "vehicledynamics/BicycleModel.h"
+#include "vehicledynamics/VehicleTypes.h"
+#include "utilities/Randomizer.h"
+
+
+namespace {
+    constexpr float kEps = 1e-4f;
+    constexpr std::size_t kNumEnvs = 64;
+}
+
+
+// Every env of VecParkingEnv must follow the same kinematics as BicycleModel::kinematicAct (within the FastMath.h error)
+// and produce the same slot corners as ParkingEnv::calculateRelCorners.
+TEST(VecParkingEnv, MatchesSingleEnvMath) {
+    Randomizer randomizer;
+    VecParkingEnv vecEnv(kNumEnvs, &randomizer);
+    vecEnv.reset();
+
+    ParkingEnv env(&randomizer);
+    BicycleModel model(CAR_LENGTH);
+
+    // reference states taken from the batched env after reset
+    std::vector<VehicleState> ref(kNumEnvs);
+    for (std::size_t i = 0; i < kNumEnvs; ++i) ref[i] = vecEnv.getVehicleState(i);
+
+    std::vector<Action> actions(kNumEnvs);
+    std::vector<Observation> obs(kNumEnvs);
+    std::vector<float> rewards(kNumEnvs);
+    std::vector<uint8_t> dones(kNumEnvs);
+
+    for (int t = 0; t < 50; ++t) {
+        for (std::size_t i = 0; i < kNumEnvs; ++i) {
+            actions[i].acceleration = randomizer.randFloat(-2.0f, 2.0f);
+            actions[i].steeringAngle = randomizer.randFloat(-1.0f, 1.0f);
+        }
+        vecEnv.step(actions.data(), obs.data(), rewards.data(), dones.data());
+
+        for (std::size_t i = 0; i < kNumEnvs; ++i) {
+            Action a = actions[i];
+            model.kinematicAct(a, ref[i], vecEnv.getSimDt());
+
+            EXPECT_NEAR(obs[i].vehicleState.pos.x, ref[i].pos.x, kEps);
+            EXPECT_NEAR(obs[i].vehicleState.pos.y, ref[i].pos.y, kEps);
+            EXPECT_NEAR(obs[i].vehicleState.psi, ref[i].psi, kEps);
+            EXPECT_NEAR(obs[i].vehicleState.velocity, ref[i].velocity, kEps);
+
+            const auto corners = env.getCalculateRelCorners(ref[i].pos, ref[i].psi, vecEnv.getParkingPos(i), vecEnv.getParkingYaw(i));
+            for (int k = 0; k < 4; ++k) {
+                EXPECT_NEAR(obs[i].distCorners[k].x, corners[k].x, kEps);
+                EXPECT_NEAR(obs[i].distCorners[k].y, corners[k].y, kEps);
+            }
+
+            const VehicleState& got = obs[i].vehicleState;
+            const bool parked = isCarInSlot(got.pos.x, got.pos.y, got.psi,
+                                            vecEnv.getParkingPos(i).x, vecEnv.getParkingPos(i).y, vecEnv.getParkingYaw(i));
+            EXPECT_EQ(dones[i], (parked || !isCarInLot(got.pos.x, got.pos.y)) ? 1 : 0);
+            EXPECT_FLOAT_EQ(rewards[i], parked ? 1.0f : 0.0f);
+        }
+    }
+}
+
+// With an action repeat, env i of VecParkingEnv still follows a ParkingEnv with the same stream and repeat.
+TEST(VecParkingEnv, ActionRepeatMatchesParkingEnv) {
+    constexpr int kRepeat = 5;
+    constexpr std::size_t kEnvs = 16;
+    Randomizer vecRandomizer(21), envRandomizer(21), policy(4);
+
+    VecParkingEnv vecEnv(kEnvs, &vecRandomizer);
+    vecEnv.setActionRepeat(kRepeat);
+    vecEnv.reset();
+
+    std::vector<ParkingEnv> envs;
+    for (std::size_t i = 0; i < kEnvs; ++i) {
+        envs.emplace_back(&envRandomizer);
+        envs.back().setEnvIndex(i);
+        envs.back().setActionRepeat(kRepeat);
+        envs.back().reset();
+    }
+
+    std::vector<Action> actions(kEnvs);
+    std::vector<Observation> obs(kEnvs);
+    std::vector<float> rewards(kEnvs);
+    std::vector<uint8_t> dones(kEnvs);
+
+    for (int t = 0; t < 40; ++t) {
+        for (auto& a : actions) a = Action{policy.randFloat(-1.0f, 1.0f), policy.randFloat(-0.7f, 0.7f)};
+        vecEnv.step(actions.data(), obs.data(), rewards.data(), dones.data());
+
+        for (std::size_t i = 0; i < kEnvs; ++i) {
+            Observation ref;
+            StepResult result;
+            envs[i].stepInto(actions[i], vecEnv.getSimDt(), ref, result);
+
+            EXPECT_NEAR(obs[i].vehicleState.pos.x, ref.vehicleState.pos.x, kEps);
+            EXPECT_NEAR(obs[i].vehicleState.pos.y, ref.vehicleState.pos.y, kEps);
+            EXPECT_NEAR(obs[i].vehicleState.psi, ref.vehicleState.psi, kEps);
+            EXPECT_EQ(dones[i], result.done ? 1 : 0);
+            EXPECT_FLOAT_EQ(rewards[i], result.reward);
+        }
+    }
+}
+
+// Auto-reset re-randomizes only the finished envs inside step(): the returned observation starts the
+// next episode (same stream as ParkingEnv's second reset) and the final one is kept aside.
+TEST(VecParkingEnv, AutoResetsFinishedEnvs) {
+    constexpr std::size_t kEnvs = 8;
+    constexpr std::size_t kMaxSteps = 3;
+    Randomizer randomizer(17), envRandomizer(17);
+
+    VecParkingEnv vecEnv(kEnvs, &randomizer);
+    vecEnv.setMaxEpisodeSteps(kMaxSteps);
+    vecEnv.setAutoReset(true);
+    vecEnv.reset();
+
+    std::vector<Action> actions(kEnvs, Action{0.0f, 0.0f});
+    std::vector<Observation> obs(kEnvs);
+    std::vector<float> rewards(kEnvs);
+    std::vector<uint8_t> terminated(kEnvs), truncated(kEnvs);
+
+    // env 0 drives off, the others stand still until the time limit
+    actions[0] = Action{1.0f, 0.0f};
+    std::vector<VehicleState> before(kEnvs);
+    for (std::size_t t = 1; t <= kMaxSteps; ++t) {
+        for (std::size_t i = 0; i < kEnvs; ++i) before[i] = vecEnv.getVehicleState(i);
+        vecEnv.step(actions.data(), obs.data(), rewards.data(), terminated.data(), truncated.data());
+
+        for (std::size_t i = 1; i < kEnvs; ++i) {
+            if (terminated[i]) continue;  // spawned inside the slot
+            if (t < kMaxSteps) {
+                EXPECT_EQ(truncated[i], 0);
+                EXPECT_EQ(vecEnv.getEpisodeStep(i), t);
+                continue;
+            }
+            // truncated and reset within the same call
+            EXPECT_EQ(truncated[i], 1);
+            EXPECT_EQ(vecEnv.getEpisodeStep(i), 0u);
+            EXPECT_EQ(vecEnv.getEpisodeIndex(i), 2u);
+            EXPECT_FLOAT_EQ(vecEnv.getFinalObservation(i).vehicleState.pos.x, before[i].pos.x);
+
+            ParkingEnv ref(&envRandomizer);
+            ref.setEnvIndex(i);
+            ref.setEpisodeIndex(1);
+            ref.reset();
+            EXPECT_FLOAT_EQ(obs[i].vehicleState.pos.x, ref.getVehicleState().pos.x);
+            EXPECT_FLOAT_EQ(obs[i].vehicleState.pos.y, ref.getVehicleState().pos.y);
+            EXPECT_FLOAT_EQ(vecEnv.getParkingPos(i).x, ref.getParkingPos().x);
+        }
+    }
+}
+
+// A car that drives out of the lot bounds terminates its episode without reward.
+TEST(VecParkingEnv, LeavingTheLotTerminates) {
+    EXPECT_TRUE(isCarInLot(0.0f, 0.0f));
+    EXPECT_TRUE(isCarInLot(LOT_X_MAX, LOT_Y_MIN));
+    EXPECT_FALSE(isCarInLot(LOT_X_MAX + 0.01f, 0.0f));
+    EXPECT_FALSE(isCarInLot(0.0f, LOT_Y_MIN - 0.01f));
+
+    Randomizer randomizer(2);
+    ParkingEnv env(&randomizer);
+    env.reset();
+    StepResult result;
+    Observation obs;
+    int steps = 0;
+    while (!result.done && steps < 100000) {
+        env.stepInto(Action{1.0f, 0.0f}, 0.01f, obs, result);
+        ++steps;
+    }
+    ASSERT_TRUE(result.terminated);
+    EXPECT_FALSE(result.truncated);
+    EXPECT_FALSE(isCarInLot(obs.vehicleState.pos.x, obs.vehicleState.pos.y));
+}
+
+// A car placed at the slot center with the slot heading is parked.
+TEST(VecParkingEnv, CarCenteredInSlotIsParked) {
+    EXPECT_TRUE(isCarInSlot(5.0f, 5.0f, 0.0f, 5.0f, 5.0f, 0.0f));
+    EXPECT_TRUE(isCarInSlot(5.0f, 5.0f, PI * 0.5f, 5.0f, 5.0f, PI * 0.5f));
+    EXPECT_FALSE(isCarInSlot(5.0f, 5.0f, PI * 0.5f, 5.0f, 5.0f, 0.0f));
+    EXPECT_FALSE(isCarInSlot(8.0f, 5.0f, 0.0f, 5.0f, 5.0f, 0.0f));
+}